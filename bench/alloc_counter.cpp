@@ -0,0 +1,115 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef DX_PLATFORM_WINDOWS
+#include <malloc.h>
+#endif
+
+using namespace dx::bench;
+
+//
+// allocation hook
+//
+namespace {
+    std::atomic< size_t > g_alloc_count{}; // allocations since start-up
+    std::atomic< size_t > g_alloc_bytes{}; // bytes allocated since start-up
+
+    void *counted_alloc( size_t size ) {
+        g_alloc_count.fetch_add( 1, std::memory_order_relaxed );
+        g_alloc_bytes.fetch_add( size, std::memory_order_relaxed );
+
+        return std::malloc( size ? size : 1 );
+    }
+
+    void *counted_aligned_alloc( size_t size, size_t alignment ) {
+        g_alloc_count.fetch_add( 1, std::memory_order_relaxed );
+        g_alloc_bytes.fetch_add( size, std::memory_order_relaxed );
+
+#ifdef DX_PLATFORM_WINDOWS
+        return _aligned_malloc( size ? size : 1, alignment );
+#else
+        return std::aligned_alloc( alignment, ( ( size ? size : 1 ) + alignment - 1 ) / alignment * alignment );
+#endif
+    }
+
+    void counted_aligned_free( void *ptr ) {
+#ifdef DX_PLATFORM_WINDOWS
+        _aligned_free( ptr );
+#else
+        std::free( ptr );
+#endif
+    }
+}
+
+void *operator new( size_t size ) {
+    if ( auto *ptr = counted_alloc( size ) )
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void *operator new[]( size_t size ) {
+    return operator new( size );
+}
+
+void *operator new( size_t size, const std::nothrow_t & ) noexcept {
+    return counted_alloc( size );
+}
+
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept {
+    return counted_alloc( size );
+}
+
+void *operator new( size_t size, std::align_val_t alignment ) {
+    if ( auto *ptr = counted_aligned_alloc( size, ( size_t ) alignment ) )
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void *operator new[]( size_t size, std::align_val_t alignment ) {
+    return operator new( size, alignment );
+}
+
+void operator delete( void *ptr ) noexcept {
+    std::free( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept {
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, size_t ) noexcept {
+    std::free( ptr );
+}
+
+void operator delete[]( void *ptr, size_t ) noexcept {
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, std::align_val_t ) noexcept {
+    counted_aligned_free( ptr );
+}
+
+void operator delete[]( void *ptr, std::align_val_t ) noexcept {
+    counted_aligned_free( ptr );
+}
+
+void operator delete( void *ptr, size_t, std::align_val_t ) noexcept {
+    counted_aligned_free( ptr );
+}
+
+void operator delete[]( void *ptr, size_t, std::align_val_t ) noexcept {
+    counted_aligned_free( ptr );
+}
+
+size_t AllocCounter::count() {
+    return g_alloc_count.load( std::memory_order_relaxed );
+}
+
+size_t AllocCounter::bytes() {
+    return g_alloc_bytes.load( std::memory_order_relaxed );
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx::bench {
+    /**
+     * @brief This class counts the heap allocations done through the global operator new
+    */
+    class AllocCounter {
+    public:
+        /**
+         * @brief This function returns the number of allocations since start-up
+         * @return allocation count
+        */
+        NOINLINE static size_t count();
+
+        /**
+         * @brief This function returns the number of bytes allocated since start-up
+         * @return allocated bytes
+        */
+        NOINLINE static size_t bytes();
+    };
+}
@@ -0,0 +1,183 @@
+#include "bench.h"
+
+#if defined( __linux__ )
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace dx::bench;
+
+//
+// hardware counters
+//
+PerfCounters::PerfCounters() : m_fds{ -1, -1, -1, -1 }, m_available{} {
+#if defined( __linux__ )
+    static constexpr uint64_t configs[ COUNTER_COUNT ] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    m_available = true;
+
+    for ( size_t i{}; i < COUNTER_COUNT; ++i ) {
+        perf_event_attr attr{};
+
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof( perf_event_attr );
+        attr.config         = configs[ i ];
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        m_fds[ i ] = ( int ) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+        if ( m_fds[ i ] < 0 )
+            m_available = false;
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined( __linux__ )
+    for ( const int fd : m_fds ) {
+        if ( fd >= 0 )
+            close( fd );
+    }
+#endif
+}
+
+void PerfCounters::start() {
+#if defined( __linux__ )
+    if ( !m_available )
+        return;
+
+    for ( const int fd : m_fds ) {
+        ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+        ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+    }
+#endif
+}
+
+void PerfCounters::stop( double *values ) {
+    for ( size_t i{}; i < COUNTER_COUNT; ++i )
+        values[ i ] = 0.0;
+
+#if defined( __linux__ )
+    if ( !m_available )
+        return;
+
+    for ( size_t i{}; i < COUNTER_COUNT; ++i ) {
+        uint64_t value{};
+
+        ioctl( m_fds[ i ], PERF_EVENT_IOC_DISABLE, 0 );
+
+        if ( read( m_fds[ i ], &value, sizeof( value ) ) == sizeof( value ) )
+            values[ i ] = ( double ) value;
+    }
+#endif
+}
+
+//
+// runner
+//
+std::vector< size_t > Runner::sizes() const {
+    std::vector< size_t > ret;
+
+    for ( size_t size{ 1000 }; size <= m_options.m_max_calls; size *= SIZE_GROWTH )
+        ret.push_back( size );
+
+    return ret;
+}
+
+void Runner::report( const char *name, const size_t size, const Sample_t &sample, const double ops, std::initializer_list< Metric_t > metrics ) {
+    static constexpr const char *perf_names[ PerfCounters::COUNTER_COUNT ] = { "cycles/op", "instr/op", "cache-miss/op", "branch-miss/op" };
+
+    std::printf( "%-28s %9zu", name, size );
+
+    for ( const auto &m : metrics )
+        std::printf( "  %s=%.3f", m.m_name, m.m_value );
+
+    std::printf( "  allocs/frame=%.1f", sample.m_allocs );
+
+    if ( sample.m_perf_valid ) {
+        for ( size_t i{}; i < PerfCounters::COUNTER_COUNT; ++i )
+            std::printf( "  %s=%.2f", perf_names[ i ], sample.m_perf[ i ] / ops );
+    }
+
+    std::printf( "\n" );
+    std::fflush( stdout );
+}
+
+void Runner::skip( const char *name, const size_t size, const char *reason ) {
+    std::printf( "%-28s %9zu  skipped (%s)\n", name, size, reason );
+    std::fflush( stdout );
+}
+
+const char *Runner::should_skip( const Sample_t &sample, const double mib ) const {
+    if ( sample.m_ns * SIZE_GROWTH > m_options.m_time_limit * 1e9 )
+        return "time limit";
+
+    if ( mib * SIZE_GROWTH > m_options.m_max_mib )
+        return "memory limit";
+
+    return nullptr;
+}
+
+//
+// suite registry
+//
+Suite_t *&dx::bench::suites() {
+    static Suite_t *head{};
+
+    return head;
+}
+
+Suite_t::Suite_t( const char *name, fn_t fn ) : m_name{ name }, m_fn{ fn }, m_next{} {
+    Suite_t **it = &suites();
+
+    // append to keep the suites in link order
+    while ( *it )
+        it = &( *it )->m_next;
+
+    *it = this;
+}
+
+int main( int argc, char **argv ) {
+    Options_t options{ {}, 1000000, 0.25, 2.0, 1024.0 };
+
+    for ( int i{ 1 }; i < argc; ++i ) {
+        const std::string arg{ argv[ i ] };
+
+        if ( arg == "--filter" && i + 1 < argc )
+            options.m_filter = argv[ ++i ];
+
+        else if ( arg == "--max-calls" && i + 1 < argc )
+            options.m_max_calls = std::strtoull( argv[ ++i ], nullptr, 10 );
+
+        else if ( arg == "--min-time" && i + 1 < argc )
+            options.m_min_time = std::strtod( argv[ ++i ], nullptr );
+
+        else if ( arg == "--time-limit" && i + 1 < argc )
+            options.m_time_limit = std::strtod( argv[ ++i ], nullptr );
+
+        else if ( arg == "--max-mib" && i + 1 < argc )
+            options.m_max_mib = std::strtod( argv[ ++i ], nullptr );
+
+        else {
+            std::printf( "usage: %s [--filter name] [--max-calls n] [--min-time sec] [--time-limit sec] [--max-mib mib]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    Runner runner{ options };
+
+    std::printf( "hardware counters: %s\n", runner.perf_available() ? "perf_event" : "unavailable" );
+
+    for ( auto *suite = suites(); suite; suite = suite->m_next )
+        suite->m_fn( runner );
+
+    return 0;
+}
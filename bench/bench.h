@@ -0,0 +1,351 @@
+#pragma once
+
+#include "includes.h"
+#include "alloc_counter.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <initializer_list>
+
+namespace dx::bench {
+    /**
+     * @brief This struct holds the command line options of the benchmark runner
+    */
+    struct Options_t {
+        std::string m_filter;     // substring a case name must contain to run
+        size_t      m_max_calls;  // largest calls-per-frame size to run
+        double      m_min_time;   // minimum measured seconds per sample
+        double      m_time_limit; // frame seconds after which larger sizes are skipped
+        double      m_max_mib;    // estimated recorded MiB after which larger sizes are skipped
+    };
+
+    /**
+     * @brief This struct holds one named value printed beside a sample
+    */
+    struct Metric_t {
+        const char *m_name;  // metric name
+        double      m_value; // metric value
+    };
+
+    /**
+     * @brief This struct holds the per-iteration averages of a measured sample
+    */
+    struct Sample_t {
+        size_t m_iterations;    // measured iterations
+        double m_ns;            // nanoseconds per iteration
+        double m_split_ns;      // nanoseconds per iteration before the split point
+        double m_allocs;        // heap allocations per iteration
+        double m_alloc_bytes;   // heap bytes allocated per iteration
+        bool   m_perf_valid;    // hardware counters were available
+        double m_perf[ 4 ];     // cycles, instructions, cache misses, branch misses per iteration
+    };
+
+    /**
+     * @brief This struct holds the outcome of one case size, the next size is skipped based on it
+    */
+    struct Result_t {
+        Sample_t m_sample; // measured sample
+        double   m_mib;    // estimated MiB recorded per iteration
+    };
+
+    /**
+     * @brief This class reads the hardware performance counters through perf_event where available
+    */
+    class PerfCounters {
+    public:
+        static constexpr size_t COUNTER_COUNT = 4; // number of hardware counters
+
+        /**
+         * @brief The constructor for the PerfCounters class, it opens the counters
+        */
+        NOINLINE PerfCounters();
+
+        /**
+         * @brief The destructor for the PerfCounters class, it closes the counters
+        */
+        NOINLINE ~PerfCounters();
+
+        /**
+         * @brief This function returns whether the counters could be opened
+         * @return true, if available. false, otherwise
+        */
+        FORCEINLINE bool available() const {
+            return m_available;
+        }
+
+        /**
+         * @brief This function resets and enables the counters
+        */
+        NOINLINE void start();
+
+        /**
+         * @brief This function disables the counters and reads their values
+         * @param values output array of counter values
+        */
+        NOINLINE void stop( double *values );
+
+    private:
+        int  m_fds[ COUNTER_COUNT ]; // counter file descriptors
+        bool m_available;            // counters opened
+    };
+
+    /**
+     * @brief This class is passed to each measured iteration to mark its split point
+    */
+    class Frame {
+    public:
+        /**
+         * @brief This function marks the end of the first phase of the iteration
+        */
+        FORCEINLINE void split() {
+            m_split = std::chrono::steady_clock::now();
+            m_has_split = true;
+        }
+
+    private:
+        friend class Runner;
+
+        std::chrono::steady_clock::time_point m_split;     // split timestamp
+        bool                                  m_has_split; // split was marked
+    };
+
+    /**
+     * @brief This class runs and reports the benchmark cases
+    */
+    class Runner {
+    public:
+        /**
+         * @brief The constructor for the Runner class
+         * @param options command line options
+        */
+        FORCEINLINE Runner( const Options_t &options ) : m_options{ options }, m_perf{} {
+
+        }
+
+        /**
+         * @brief This function returns the command line options
+         * @return options
+        */
+        FORCEINLINE const Options_t &options() const {
+            return m_options;
+        }
+
+        /**
+         * @brief This function returns whether hardware counters are reported
+         * @return true, if available. false, otherwise
+        */
+        FORCEINLINE bool perf_available() const {
+            return m_perf.available();
+        }
+
+        /**
+         * @brief This function checks if a case passes the name filter
+         * @param name case name
+         * @return true, if the case should run. false, otherwise
+        */
+        FORCEINLINE bool enabled( const char *name ) const {
+            return m_options.m_filter.empty() || std::string( name ).find( m_options.m_filter ) != std::string::npos;
+        }
+
+        /**
+         * @brief This function returns the calls-per-frame sizes every case runs at
+         * @return sizes up to the configured maximum
+        */
+        NOINLINE std::vector< size_t > sizes() const;
+
+        /**
+         * @brief This function measures an iteration after the warm-up runs, repeating it
+         * until the minimum sample time is reached
+         * @param fn iteration taking a Frame reference
+         * @return per-iteration averages
+        */
+        template< typename Fn >
+        Sample_t measure( Fn &&fn ) {
+            Sample_t sample{};
+            Frame    frame{};
+            double   perf[ PerfCounters::COUNTER_COUNT ]{};
+            double   total_ns{};
+
+            // warm-up, lets containers and buffers reach their steady-state capacity
+            for ( size_t i{}; i < WARM_UP_ITERATIONS; ++i )
+                fn( frame );
+
+            sample.m_perf_valid = m_perf.available();
+
+            do {
+                const size_t allocs      = AllocCounter::count();
+                const size_t alloc_bytes = AllocCounter::bytes();
+
+                frame.m_has_split = false;
+
+                m_perf.start();
+                const auto start = std::chrono::steady_clock::now();
+
+                fn( frame );
+
+                const auto end = std::chrono::steady_clock::now();
+                m_perf.stop( perf );
+
+                const double ns = std::chrono::duration< double, std::nano >( end - start ).count();
+
+                total_ns              += ns;
+                sample.m_ns           += ns;
+                sample.m_split_ns     += frame.m_has_split ? std::chrono::duration< double, std::nano >( frame.m_split - start ).count() : ns;
+                sample.m_allocs       += ( double ) ( AllocCounter::count() - allocs );
+                sample.m_alloc_bytes  += ( double ) ( AllocCounter::bytes() - alloc_bytes );
+
+                for ( size_t i{}; i < PerfCounters::COUNTER_COUNT; ++i )
+                    sample.m_perf[ i ] += perf[ i ];
+
+                ++sample.m_iterations;
+            } while ( total_ns < m_options.m_min_time * 1e9 );
+
+            // average over the measured iterations
+            const double n = ( double ) sample.m_iterations;
+
+            sample.m_ns          /= n;
+            sample.m_split_ns    /= n;
+            sample.m_allocs      /= n;
+            sample.m_alloc_bytes /= n;
+
+            for ( auto &p : sample.m_perf )
+                p /= n;
+
+            return sample;
+        }
+
+        /**
+         * @brief This function prints a sample
+         * @param name case name
+         * @param size case size
+         * @param sample measured sample
+         * @param ops operations per iteration the hardware counters are divided by
+         * @param metrics case specific metrics
+        */
+        NOINLINE void report( const char *name, const size_t size, const Sample_t &sample, const double ops, std::initializer_list< Metric_t > metrics );
+
+        /**
+         * @brief This function prints a skipped case size
+         * @param name case name
+         * @param size case size
+         * @param reason reason the size was skipped
+        */
+        NOINLINE void skip( const char *name, const size_t size, const char *reason );
+
+        /**
+         * @brief This function runs a case at every size that passes the name filter. A size is skipped once the previous
+         * one exceeded the time or memory limit scaled by the growth to it
+         * @param name case name
+         * @param fn case taking the calls-per-frame size and returning its Result_t
+        */
+        template< typename Fn >
+        void for_sizes( const char *name, Fn &&fn ) {
+            const char *skip_reason{};
+
+            if ( !enabled( name ) )
+                return;
+
+            for ( const size_t size : sizes() ) {
+                if ( skip_reason ) {
+                    skip( name, size, skip_reason );
+                    continue;
+                }
+
+                const Result_t result = fn( size );
+
+                skip_reason = should_skip( result.m_sample, result.m_mib );
+            }
+        }
+
+        /**
+         * @brief This function runs a case at every size on a renderer created on a null backend, it is destroyed after each size
+         * @param name case name
+         * @param font_path baked font file the renderer maps, or nullptr for the built-in font
+         * @param fn case taking the renderer, its backend and the calls-per-frame size, and returning its Result_t
+        */
+        template< typename Fn >
+        void for_renderer( const char *name, const char *font_path, Fn &&fn ) {
+            for_sizes( name, [ & ]( const size_t size ) {
+                NullBackend backend;
+                Renderer    renderer;
+
+                renderer.create( &backend, font_path );
+
+                const Result_t result = fn( renderer, backend, size );
+
+                renderer.destroy();
+
+                return result;
+            } );
+        }
+
+        /**
+         * @brief This function runs a case at every size on a renderer with the built-in font
+         * @param name case name
+         * @param fn case taking the renderer, its backend and the calls-per-frame size, and returning its Result_t
+        */
+        template< typename Fn >
+        FORCEINLINE void for_renderer( const char *name, Fn &&fn ) {
+            for_renderer( name, nullptr, std::forward< Fn >( fn ) );
+        }
+
+        /**
+         * @brief This function converts bytes to MiB
+         * @param bytes byte count
+         * @return MiB
+        */
+        FORCEINLINE static double mib( const double bytes ) {
+            return bytes / ( 1024.0 * 1024.0 );
+        }
+
+    private:
+        static constexpr size_t WARM_UP_ITERATIONS = 2;  // unmeasured iterations before a sample
+        static constexpr size_t SIZE_GROWTH        = 10; // factor from one calls-per-frame size to the next
+
+        /**
+         * @brief This function checks whether a larger size should be skipped based on the previous one
+         * @param sample sample of the previous size
+         * @param mib estimated MiB recorded by the previous size
+         * @return reason to skip, or nullptr to run it
+        */
+        NOINLINE const char *should_skip( const Sample_t &sample, const double mib ) const;
+
+        Options_t    m_options; // command line options
+        PerfCounters m_perf;    // hardware counters
+    };
+
+    /**
+     * @brief This struct registers a benchmark suite with the runner at start-up
+    */
+    struct Suite_t {
+        using fn_t = void( * )( Runner &runner );
+
+        /**
+         * @brief The constructor for the Suite_t struct, it links the suite into the global list
+         * @param name suite name
+         * @param fn suite entry point
+        */
+        NOINLINE Suite_t( const char *name, fn_t fn );
+
+        const char *m_name; // suite name
+        fn_t        m_fn;   // suite entry point
+        Suite_t    *m_next; // next registered suite
+    };
+
+    /**
+     * @brief This function returns the head of the registered suite list
+     * @return first suite
+    */
+    Suite_t *&suites();
+}
+
+//
+// defines and registers a benchmark suite
+//
+#define DX_BENCH_SUITE( name )                                          \
+    static void bench_suite_##name( dx::bench::Runner &runner );        \
+    static dx::bench::Suite_t bench_suite_reg_##name{ #name, bench_suite_##name }; \
+    static void bench_suite_##name( dx::bench::Runner &runner )
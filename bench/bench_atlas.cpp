@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a sprite benchmark case
+    */
+    struct SpriteCase_t {
+        const char *m_name;        // case name
+        uint32_t   m_image_count;  // distinct images drawn round-robin
+        uint32_t   m_image_size;   // image width and height in texels
+        uint32_t   m_window;       // distinct images a frame draws
+        uint32_t   m_frame_stride; // first image advance per frame, forces evictions when the images outgrow the atlas
+    };
+
+    const SpriteCase_t sprite_cases[] = {
+        { "draw_image", 256, 16, 256, 0 },
+        { "draw_image/evicting", 16384, 32, 1024, 997 }
+    };
+}
+
+DX_BENCH_SUITE( sprites ) {
+    for ( const auto &c : sprite_cases ) {
+        const std::vector< uint32_t > pixels( ( size_t ) c.m_image_size * c.m_image_size, 0xffffffff );
+
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            size_t first{};
+
+            for ( uint32_t i{}; i < c.m_image_count; ++i )
+                renderer.add_image( c.m_image_size, c.m_image_size, pixels );
+
+            // record the sprites, then flush them through the null backend
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                for ( size_t i{}; i < calls; ++i )
+                    renderer.draw_image( ( uint32_t ) ( ( first + i % c.m_window ) % c.m_image_count ), { ( float ) ( i % 640 ), ( float ) ( ( i / 640 ) % 480 ) }, { 16.f, 16.f } );
+
+                frame.split();
+
+                renderer.perform();
+
+                first += c.m_frame_stride;
+            } );
+
+            // counters of the last measured frame
+            const auto   &stats   = renderer.stats();
+            const double uploaded = ( double ) ( stats.m_uploaded_bytes + stats.m_texture_bytes );
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_split_ns / ( double ) calls },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "texture_KiB/frame", ( double ) stats.m_texture_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls },
+                { "pages", ( double ) renderer.atlas().pages().size() },
+                { "evictions", ( double ) renderer.atlas().evictions() }
+            } );
+
+            return Result_t{ sample, Runner::mib( uploaded ) };
+        } );
+    }
+}
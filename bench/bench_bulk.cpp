@@ -0,0 +1,126 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This enum holds the shapes of a bulk drawing benchmark case
+    */
+    enum class BulkShape : uint8_t {
+        RECT,  // filled rects
+        LINE,  // lines of some thickness
+        CIRCLE // filled circles
+    };
+
+    /**
+     * @brief This struct holds a bulk drawing benchmark case
+    */
+    struct BulkCase_t {
+        const char *m_name;       // case name
+        BulkShape  m_shape;      // shape drawn
+        bool       m_bulk;       // drawn with one bulk call instead of a call per shape
+        bool       m_instancing; // shapes are recorded as instances
+    };
+
+    const BulkCase_t bulk_cases[] = {
+        { "bulk/rects/calls", BulkShape::RECT, false, false },
+        { "bulk/rects/span", BulkShape::RECT, true, false },
+        { "bulk/rects/calls_instanced", BulkShape::RECT, false, true },
+        { "bulk/rects/span_instanced", BulkShape::RECT, true, true },
+        { "bulk/lines/calls", BulkShape::LINE, false, false },
+        { "bulk/lines/span", BulkShape::LINE, true, false },
+        { "bulk/circles/calls", BulkShape::CIRCLE, false, false },
+        { "bulk/circles/span", BulkShape::CIRCLE, true, false }
+    };
+
+    /**
+     * @brief This function draws the points of a scatter plot as the shape of a case
+     * @param context context to record to
+     * @param c benchmark case
+     * @param rects points as rects
+     * @param lines points as lines
+     * @param circles points as circles
+    */
+    void record_scatter( RecordContext &context, const BulkCase_t &c, std::span< const RectInstance_t > rects, std::span< const LineInstance_t > lines,
+                         std::span< const CircleInstance_t > circles ) {
+        switch ( c.m_shape ) {
+        case BulkShape::RECT:
+            if ( c.m_bulk )
+                context.draw_filled_rects( rects );
+
+            else {
+                for ( const auto &rect : rects )
+                    context.draw_filled_rect( rect.m_pos, rect.m_size, rect.m_color );
+            }
+
+            break;
+
+        case BulkShape::LINE:
+            if ( c.m_bulk )
+                context.draw_lines( lines, 2.f );
+
+            else {
+                for ( const auto &line : lines )
+                    context.draw_line( line.m_start, line.m_end, line.m_color, 2.f );
+            }
+
+            break;
+
+        case BulkShape::CIRCLE:
+            if ( c.m_bulk )
+                context.draw_filled_circles( circles, 8 );
+
+            else {
+                for ( const auto &circle : circles )
+                    context.draw_filled_circle( circle.m_pos, circle.m_radius, circle.m_color, 8 );
+            }
+
+            break;
+        }
+    }
+}
+
+DX_BENCH_SUITE( bulk ) {
+    for ( const auto &c : bulk_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            std::vector< RectInstance_t >   rects( calls );
+            std::vector< LineInstance_t >   lines( calls );
+            std::vector< CircleInstance_t > circles( calls );
+
+            renderer.set_instancing( c.m_instancing );
+
+            // scatter points along a noisy curve, colored by their index
+            for ( size_t i{}; i < calls; ++i ) {
+                const Vector2 pos{ ( float ) ( i * 7919 % 640 ), 240.f + 160.f * std::sin( ( float ) i * 0.01f ) + ( float ) ( i * 104729 % 61 ) - 30.f };
+                const Color   color( ( uint8_t ) i, ( uint8_t ) ( i >> 3 ), 200, 255 );
+
+                rects[ i ]   = { pos - Vector2( 1.5f, 1.5f ), { 3.f, 3.f }, color };
+                lines[ i ]   = { pos, pos + Vector2( 4.f, 2.f ), color };
+                circles[ i ] = { pos, 2.f, color };
+            }
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                record_scatter( renderer, c, rects, lines, circles );
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/shape", sample.m_split_ns / ( double ) calls },
+                { "record_us", sample.m_split_ns / 1000.0 },
+                { "vertices", ( double ) stats.m_vertices },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
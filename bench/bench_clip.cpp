@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <charconv>
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a clip benchmark case
+    */
+    struct ClipCase_t {
+        const char *m_name;   // case name
+        bool       m_clipped; // rows are clipped to the panel, otherwise every row is drawn
+    };
+
+    const ClipCase_t clip_cases[] = {
+        { "clip/list", true },
+        { "clip/list/unclipped", false }
+    };
+
+    constexpr float ROW_HEIGHT = 20.f;          // height of a list row
+    const Vector2   panel_pos{ 100.f, 100.f };  // top-left corner of the scrolled panel
+    const Vector2   panel_size{ 300.f, 200.f }; // dimensions of the scrolled panel
+}
+
+DX_BENCH_SUITE( clip ) {
+    for ( const auto &c : clip_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            float scroll{};
+
+            // a scrolled list of rows, each a background, an icon, and a label, only the rows in the panel are visible
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                char label[ 32 ] = "item ";
+
+                if ( c.m_clipped )
+                    renderer.push_clip_rect( panel_pos, panel_size );
+
+                for ( size_t i{}; i < calls; ++i ) {
+                    const float y   = panel_pos.y + ( float ) i * ROW_HEIGHT - scroll;
+                    const auto  end = std::to_chars( label + 5, std::end( label ), i % 256 ).ptr;
+
+                    renderer.draw_filled_rect( { panel_pos.x, y }, { panel_size.x, ROW_HEIGHT - 2.f }, Color( 40, 40, 40, 255 ) );
+                    renderer.draw_filled_smooth_circle( { panel_pos.x + 10.f, y + ROW_HEIGHT * 0.5f }, 6.f, Color( 0, 160, 255, 255 ) );
+                    renderer.draw_text( { panel_pos.x + 22.f, y + 2.f }, { label, ( size_t ) ( end - label ) }, Color::white() );
+                }
+
+                if ( c.m_clipped )
+                    renderer.pop_clip_rect();
+
+                frame.split();
+
+                renderer.perform();
+
+                // scroll by a fraction of a row, so the rows on the panel edges are cut
+                scroll = std::fmod( scroll + 7.5f, std::max( ( float ) calls * ROW_HEIGHT - panel_size.y, ROW_HEIGHT ) );
+            } );
+
+            // counters of the last measured frame
+            const auto   &stats     = renderer.stats();
+            const double uploaded   = ( double ) ( stats.m_uploaded_bytes + stats.m_texture_bytes );
+            const double primitives = ( double ) std::max< size_t >( stats.m_primitives, 1 );
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/row", sample.m_split_ns / ( double ) calls },
+                { "rejected_%", 100.0 * ( double ) stats.m_rejected / primitives },
+                { "clipped_%", 100.0 * ( double ) stats.m_clipped / primitives },
+                { "scissored_%", 100.0 * ( double ) stats.m_scissored / primitives },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls },
+                { "scissors/frame", ( double ) stats.m_scissors }
+            } );
+
+            return Result_t{ sample, Runner::mib( uploaded ) };
+        } );
+    }
+}
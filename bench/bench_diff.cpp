@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a diffed upload benchmark case
+    */
+    struct DiffCase_t {
+        const char *m_name;    // case name
+        bool       m_diff;    // upload into the persistent buffers, writing the changed blocks only
+        size_t     m_percent; // share of the primitives that move every frame
+    };
+
+    const DiffCase_t diff_cases[] = {
+        { "diff/5pct/ring", false, 5 },
+        { "diff/5pct/diffed", true, 5 },
+        { "diff/100pct/ring", false, 100 },
+        { "diff/100pct/diffed", true, 100 }
+    };
+}
+
+DX_BENCH_SUITE( diff ) {
+    for ( const auto &c : diff_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            size_t tick{};
+
+            renderer.set_diff_upload( c.m_diff );
+
+            // every primitive keeps its place in the frame, the moving ones are spread over it
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                for ( size_t i{}; i < calls; ++i ) {
+                    const bool  moving = i % ( 100 / c.m_percent ) == 0;
+                    const float x      = ( float ) ( i % 64 ) * 10.f + ( moving ? ( float ) ( tick % 8 ) : 0.f );
+                    const float y      = ( float ) ( i / 64 % 48 ) * 10.f;
+
+                    if ( i % 2 )
+                        renderer.draw_filled_rect( { x, y }, { 8.f, 8.f }, Color( 30, 30, 30, 255 ) );
+
+                    else
+                        renderer.draw_filled_circle( { x + 4.f, y + 4.f }, 4.f, Color( 0, 160, 255, 255 ) );
+                }
+
+                frame.split();
+
+                renderer.perform();
+
+                ++tick;
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_ns / ( double ) calls },
+                { "flush_us", ( sample.m_ns - sample.m_split_ns ) / 1000.0 },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "saved_KiB/frame", ( double ) stats.m_saved_bytes / 1024.0 },
+                { "diff_us", ( double ) stats.m_diff_ns / 1000.0 },
+                { "updates/frame", ( double ) stats.m_updates },
+                { "fallbacks/frame", ( double ) stats.m_diff_fallbacks }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) ( stats.m_uploaded_bytes + stats.m_saved_bytes ) ) };
+        } );
+    }
+}
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <string>
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a partial redraw benchmark case
+    */
+    struct DirtyCase_t {
+        const char *m_name;      // case name
+        bool       m_partial;   // only the regions that changed are redrawn
+        size_t     m_scattered; // panel primitives recolored every frame, spread over the screen
+    };
+
+    const DirtyCase_t dirty_cases[] = {
+        { "dirty/clock/full", false, 0 },
+        { "dirty/clock/partial", true, 0 },
+        { "dirty/scattered/full", false, 16 },
+        { "dirty/scattered/partial", true, 16 }
+    };
+
+    /**
+     * @brief This function records a panel of rects and circles over a background, a few of them recolored
+     * @param context context to record to
+     * @param calls primitive count
+     * @param scattered primitives recolored
+     * @param frame frame number picking the recolored primitives
+    */
+    void record_panel( RecordContext &context, const size_t calls, const size_t scattered, const size_t frame ) {
+        const size_t stride = scattered ? calls / scattered : 0;
+
+        context.draw_filled_rect( { 0.f, 0.f }, { 640.f, 480.f }, Color( 20, 20, 20, 255 ) );
+
+        for ( size_t i{}; i < calls; ++i ) {
+            const float x     = ( float ) ( i % 64 ) * 10.f;
+            const float y     = ( float ) ( i / 64 % 48 ) * 10.f;
+            const bool  lit   = stride && i % stride == frame % stride;
+            const Color color = lit ? Color( 255, 160, 0, 255 ) : Color( 30, 30, 30, 255 );
+
+            if ( i % 4 )
+                context.draw_filled_rect( { x, y }, { 9.f, 9.f }, color );
+
+            else
+                context.draw_filled_circle( { x + 5.f, y + 5.f }, 4.f, color );
+        }
+    }
+}
+
+DX_BENCH_SUITE( dirty ) {
+    for ( const auto &c : dirty_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            size_t frames{};
+
+            renderer.set_partial_redraw( c.m_partial );
+
+            // a clock widget ticking every frame, the first frames rasterize its digits and are drawn whole
+            const auto record = [ & ]() {
+                record_panel( renderer, calls, c.m_scattered, frames );
+
+                renderer.draw_filled_rect( { 560.f, 8.f }, { 72.f, 20.f }, Color::black() );
+                renderer.draw_text( { 564.f, 10.f }, std::to_string( frames % 100000 ), Color::white() );
+
+                ++frames;
+            };
+
+            for ( size_t warm{}; warm < 12; ++warm ) {
+                record();
+                renderer.perform();
+            }
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                record();
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_ns / ( double ) calls },
+                { "flush_us", ( sample.m_ns - sample.m_split_ns ) / 1000.0 },
+                { "region_us", stats.m_region_ns / 1000.0 },
+                { "dirty_rects", ( double ) stats.m_dirty_rects },
+                { "dirty_%", stats.m_dirty_rects ? 100.0 * ( double ) stats.m_dirty_pixels / ( 640.0 * 480.0 ) : 100.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
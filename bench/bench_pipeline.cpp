@@ -0,0 +1,108 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+#include "frame_queue.h"
+
+#include <thread>
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a pipeline benchmark case
+    */
+    struct PipelineCase_t {
+        const char *m_name;  // case name
+        size_t     m_depth; // frames in flight, zero records and submits on the same thread
+    };
+
+    const PipelineCase_t pipeline_cases[] = {
+        { "pipeline/sequential", 0 },
+        { "pipeline/depth1", 1 },
+        { "pipeline/depth2", 2 },
+        { "pipeline/depth3", 3 }
+    };
+
+    /**
+     * @brief This function records the mixed primitives of a frame
+     * @param context context to record to
+     * @param calls primitive count
+    */
+    void record_frame( RecordContext &context, const size_t calls ) {
+        for ( size_t i{}; i < calls; ++i ) {
+            const float x = ( float ) ( i % 64 ) * 10.f;
+            const float y = ( float ) ( i / 64 % 48 ) * 10.f;
+
+            if ( i % 2 )
+                context.draw_filled_rect( { x, y }, { 8.f, 8.f }, Color( 40, 40, 40, 255 ) );
+
+            else
+                context.draw_line( { x, y }, { x + 8.f, y + 6.f }, Color( 255, 255, 255, 255 ), 2.f );
+        }
+    }
+}
+
+DX_BENCH_SUITE( pipeline ) {
+    for ( const auto &c : pipeline_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            FrameQueue  frames{ std::max< size_t >( c.m_depth, 1 ) };
+            std::thread producer;
+
+            // the producer records ahead until the queue is closed, the measured frame is the submission of one of them
+            if ( c.m_depth ) {
+                producer = std::thread{ [ & ] {
+                    while ( auto *frame = frames.begin_record() ) {
+                        record_frame( *frame, calls );
+
+                        frames.end_record();
+                    }
+                } };
+            }
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                if ( !c.m_depth ) {
+                    record_frame( renderer, calls );
+
+                    frame.split();
+
+                    renderer.perform();
+                }
+
+                else if ( auto *frame = frames.acquire() ) {
+                    renderer.perform( *frame );
+
+                    frames.release();
+                }
+            } );
+
+            auto stats = frames.stats();
+
+            // on one thread the stages follow each other, the split point separates them
+            if ( !c.m_depth )
+                stats = { 1, sample.m_split_ns, sample.m_ns - sample.m_split_ns, 0.0, 0.0, 0.0, sample.m_ns };
+
+            frames.close();
+
+            // the producer may be blocked on a full queue or still recording, drain it so it sees the close
+            while ( c.m_depth && frames.acquire() )
+                frames.release();
+
+            if ( producer.joinable() )
+                producer.join();
+
+            const double n = ( double ) std::max< size_t >( stats.m_frames, 1 );
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "record_us/frame", stats.m_record_ns / n * 1e-3 },
+                { "submit_us/frame", stats.m_submit_ns / n * 1e-3 },
+                { "producer_wait_us/frame", stats.m_producer_wait_ns / n * 1e-3 },
+                { "consumer_wait_us/frame", stats.m_consumer_wait_ns / n * 1e-3 },
+                { "latency_us/frame", stats.m_latency_ns / n * 1e-3 },
+                { "overlap_%", 100.0 * stats.overlap() }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) renderer.stats().m_uploaded_bytes ) };
+        } );
+    }
+}
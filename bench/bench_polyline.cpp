@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a polyline benchmark case
+    */
+    struct PolylineCase_t {
+        const char *m_name;     // case name
+        bool       m_polyline; // drawn as one polyline instead of a line per segment
+        LineJoin   m_join;     // join of the polyline
+    };
+
+    const PolylineCase_t polyline_cases[] = {
+        { "polyline/segments", false, LineJoin::MITER },
+        { "polyline/miter", true, LineJoin::MITER },
+        { "polyline/bevel", true, LineJoin::BEVEL },
+        { "polyline/round", true, LineJoin::ROUND }
+    };
+}
+
+DX_BENCH_SUITE( polyline ) {
+    for ( const auto &c : polyline_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            std::vector< Vector2 > points( calls + 1 );
+
+            // a trace sweeping across the screen, bending at every point
+            for ( size_t i{}; i < points.size(); ++i )
+                points[ i ] = { ( float ) ( i % 600 ) + 20.f, 240.f + 180.f * std::sin( ( float ) i * 0.07f ) };
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                if ( c.m_polyline )
+                    renderer.draw_polyline( points, Color::white(), 2.f, c.m_join );
+
+                else {
+                    for ( size_t i{}; i < calls; ++i )
+                        renderer.draw_line( points[ i ], points[ i + 1 ], Color::white(), 2.f );
+                }
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "points/us", ( double ) calls / ( sample.m_split_ns / 1000.0 ) },
+                { "record_us", sample.m_split_ns / 1000.0 },
+                { "vertices", ( double ) stats.m_vertices },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a primitive benchmark case
+    */
+    struct PrimitiveCase_t {
+        const char *m_name;                                            // case name
+        void       ( *m_record )( Renderer &renderer, const size_t i ); // records the i-th primitive
+        bool       m_instancing;                                       // record shapes as instances
+    };
+
+    /**
+     * @brief This function spreads primitives over the screen so their vertices differ
+     * @param i primitive index
+     * @return primitive position
+    */
+    FORCEINLINE Vector2 position( const size_t i ) {
+        return { ( float ) ( i % 640 ), ( float ) ( ( i / 640 ) % 480 ) };
+    }
+
+    const PrimitiveCase_t primitive_cases[] = {
+        { "draw_filled_rect", []( Renderer &r, const size_t i ) { r.draw_filled_rect( position( i ), { 8.f, 8.f }, Color::red() ); }, false },
+        { "draw_rect", []( Renderer &r, const size_t i ) { r.draw_rect( position( i ), { 8.f, 8.f }, Color::red() ); }, false },
+        { "draw_outlined_filled_rect", []( Renderer &r, const size_t i ) { r.draw_outlined_filled_rect( position( i ), { 8.f, 8.f }, Color::green(), Color::black() ); }, false },
+        { "draw_outlined_rect", []( Renderer &r, const size_t i ) { r.draw_outlined_rect( position( i ), { 8.f, 8.f }, Color::green(), Color::black() ); }, false },
+        { "draw_line_thin", []( Renderer &r, const size_t i ) { r.draw_line( position( i ), position( i + 17 ), Color::blue() ); }, false },
+        { "draw_line_thick", []( Renderer &r, const size_t i ) { r.draw_line( position( i ), position( i + 17 ), Color::blue(), 4.f ); }, false },
+        { "draw_circle", []( Renderer &r, const size_t i ) { r.draw_circle( position( i ), 6.f, Color::black() ); }, false },
+        { "draw_filled_circle", []( Renderer &r, const size_t i ) { r.draw_filled_circle( position( i ), 6.f, Color::black() ); }, false },
+        { "draw_circle_37", []( Renderer &r, const size_t i ) { r.draw_circle( position( i ), 6.f, Color::black(), 37 ); }, false },
+        { "draw_filled_ellipse", []( Renderer &r, const size_t i ) { r.draw_filled_ellipse( position( i ), { 8.f, 4.f }, Color::black() ); }, false },
+        { "draw_arc", []( Renderer &r, const size_t i ) { r.draw_arc( position( i ), 6.f, 0.5f, 2.f, Color::black() ); }, false },
+        { "draw_filled_rect/instanced", []( Renderer &r, const size_t i ) { r.draw_filled_rect( position( i ), { 8.f, 8.f }, Color::red() ); }, true },
+        { "draw_line_thick/instanced", []( Renderer &r, const size_t i ) { r.draw_line( position( i ), position( i + 17 ), Color::blue(), 4.f ); }, true },
+        { "draw_filled_circle/instanced", []( Renderer &r, const size_t i ) { r.draw_filled_circle( position( i ), 6.f, Color::black() ); }, true },
+        { "draw_filled_smooth_circle", []( Renderer &r, const size_t i ) { r.draw_filled_smooth_circle( position( i ), 6.f, Color::black() ); }, false },
+        { "draw_smooth_circle", []( Renderer &r, const size_t i ) { r.draw_smooth_circle( position( i ), 6.f, Color::black(), 2.f ); }, false },
+        { "draw_filled_rounded_rect", []( Renderer &r, const size_t i ) { r.draw_filled_rounded_rect( position( i ), { 8.f, 8.f }, 2.f, Color::red() ); }, false },
+    };
+}
+
+DX_BENCH_SUITE( primitives ) {
+    for ( const auto &c : primitive_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            renderer.set_instancing( c.m_instancing );
+
+            // record the primitives, then flush them through the null backend
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                for ( size_t i{}; i < calls; ++i )
+                    c.m_record( renderer, i );
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            // counters of the last measured frame
+            const auto   &stats   = renderer.stats();
+            const double vertices = ( double ) stats.m_vertices;
+            const double uploaded = ( double ) stats.m_uploaded_bytes;
+            const double flush_ns = sample.m_ns - sample.m_split_ns;
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_split_ns / ( double ) calls },
+                { "flush_ns/vtx", vertices > 0.0 ? flush_ns / vertices : 0.0 },
+                { "Mvtx/s", vertices / sample.m_ns * 1e3 },
+                { "upload_KiB/frame", uploaded / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls },
+                { "chunks/frame", ( double ) stats.m_chunks },
+                { "arena_KiB", stats.m_arena_bytes / 1024.0 }
+            } );
+
+            return Result_t{ sample, Runner::mib( uploaded ) };
+        } );
+    }
+}
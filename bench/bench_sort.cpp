@@ -0,0 +1,80 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a batch sorting benchmark case
+    */
+    struct SortCase_t {
+        const char *m_name;    // case name
+        bool       m_sorted;  // batches are sorted and merged
+        bool       m_clipped; // widgets alternate between two clip rects as well
+    };
+
+    const SortCase_t sort_cases[] = {
+        { "sort/interleaved/unsorted", false, false },
+        { "sort/interleaved/sorted", true, false },
+        { "sort/clipped/unsorted", false, true },
+        { "sort/clipped/sorted", true, true }
+    };
+
+    /**
+     * @brief This function records widgets that each draw a fill, an outline, and a line, switching topology between them
+     * @param context context to record to
+     * @param calls primitive count
+     * @param clipped alternate the widgets between two clip rects
+    */
+    void record_widgets( RecordContext &context, const size_t calls, const bool clipped ) {
+        for ( size_t i{}; i < calls; i += 3 ) {
+            const float x = ( float ) ( i / 3 % 40 ) * 16.f;
+            const float y = ( float ) ( i / 3 / 40 % 30 ) * 16.f;
+
+            if ( clipped )
+                context.push_clip_rect( { i / 3 % 2 ? 0.f : 320.f, 0.f }, { 320.f, 480.f } );
+
+            context.draw_filled_rect( { x + 1.f, y + 1.f }, { 12.f, 12.f }, Color( 40, 40, 40, 255 ) );
+            context.draw_circle( { x + 7.f, y + 7.f }, 5.f, Color( 200, 200, 200, 255 ) );
+            context.draw_line( { x + 1.f, y + 14.f }, { x + 13.f, y + 14.f }, Color( 255, 160, 0, 255 ) );
+
+            if ( clipped )
+                context.pop_clip_rect();
+        }
+    }
+}
+
+DX_BENCH_SUITE( sort ) {
+    for ( const auto &c : sort_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            renderer.set_sort_batches( c.m_sorted );
+
+            // sorting takes effect on the lists recorded after the next flush
+            record_widgets( renderer, calls, c.m_clipped );
+            renderer.perform();
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                record_widgets( renderer, calls, c.m_clipped );
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_ns / ( double ) calls },
+                { "flush_us", ( sample.m_ns - sample.m_split_ns ) / 1000.0 },
+                { "sort_us", stats.m_sort_ns / 1000.0 },
+                { "merged", ( double ) stats.m_merged },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
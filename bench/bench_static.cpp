@@ -0,0 +1,85 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a static geometry benchmark case
+    */
+    struct StaticCase_t {
+        const char *m_name;     // case name
+        bool       m_retained; // the grid is captured once and drawn as static geometry, otherwise it is recorded every frame
+    };
+
+    const StaticCase_t static_cases[] = {
+        { "static/grid/dynamic", false },
+        { "static/grid/retained", true }
+    };
+
+    /**
+     * @brief This function records a background grid of panels and lines that never changes
+     * @param context context to record to
+     * @param calls primitive count
+     * @param offset position of the grid
+    */
+    void record_grid( RecordContext &context, const size_t calls, const Vector2 &offset = {} ) {
+        for ( size_t i{}; i < calls; ++i ) {
+            const float x = offset.x + ( float ) ( i % 64 ) * 10.f;
+            const float y = offset.y + ( float ) ( i / 64 % 48 ) * 10.f;
+
+            // the panels go first and the lines on top, so each shares a batch
+            if ( i < calls / 2 )
+                context.draw_filled_rect( { x, y }, { 9.f, 9.f }, Color( 30, 30, 30, 255 ) );
+
+            else
+                context.draw_line( { x, y }, { x + 10.f, y }, Color( 60, 60, 60, 255 ), 1.f );
+        }
+    }
+}
+
+DX_BENCH_SUITE( static ) {
+    for ( const auto &c : static_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &backend, const size_t calls ) {
+            uint32_t grid{ Batch_t::NO_STATIC };
+            float    scroll{};
+
+            if ( c.m_retained ) {
+                renderer.begin_static();
+                record_grid( renderer, calls );
+                grid = renderer.end_static();
+            }
+
+            // the grid scrolls, a recorded one is tessellated again at its new position and a retained one only changes its translation
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                if ( c.m_retained )
+                    renderer.draw_static( grid, { 0.f, scroll } );
+
+                else
+                    record_grid( renderer, calls, { 0.f, scroll } );
+
+                renderer.draw_filled_rect( { 10.f, 10.f }, { 100.f, 20.f }, Color( 0, 160, 255, 255 ) );
+
+                frame.split();
+
+                renderer.perform();
+
+                scroll = std::fmod( scroll + 1.f, 10.f );
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_ns / ( double ) calls },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls },
+                { "static_KiB", ( double ) backend.stats().m_static_bytes / 1024.0 }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
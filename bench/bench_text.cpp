@@ -0,0 +1,81 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <charconv>
+#include <filesystem>
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds a text benchmark case
+    */
+    struct TextCase_t {
+        const char *m_name;     // case name
+        bool       m_changing;  // labels change every frame, so each one is laid out again
+        bool       m_baked;     // labels use a baked distance field font instead of the bitmap font
+    };
+
+    const TextCase_t text_cases[] = {
+        { "draw_text", false, false },
+        { "draw_text/changing", true, false },
+        { "draw_text/baked", false, true },
+        { "draw_text/baked/changing", true, true }
+    };
+}
+
+DX_BENCH_SUITE( text ) {
+    const std::string font_path = ( std::filesystem::temp_directory_path() / "dx11-renderer-bench.dxbf" ).string();
+    bool              font_baked{};
+
+    for ( const auto &c : text_cases ) {
+        if ( !runner.enabled( c.m_name ) )
+            continue;
+
+        // bake the bitmap font once for the baked cases
+        if ( c.m_baked && !font_baked ) {
+            BitmapFont source;
+
+            if ( !( font_baked = BakedFont::bake( source, font_path.c_str() ) ) ) {
+                runner.skip( c.m_name, 0, "cannot bake the font" );
+                continue;
+            }
+        }
+
+        runner.for_renderer( c.m_name, c.m_baked ? font_path.c_str() : nullptr, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            size_t frames{};
+
+            // hud style labels, a fixed caption followed by a counter
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                char label[ 32 ] = "frame time: ";
+
+                for ( size_t i{}; i < calls; ++i ) {
+                    const auto end = std::to_chars( label + 12, std::end( label ), c.m_changing ? frames * calls + i : i % 64 ).ptr;
+
+                    renderer.draw_text( { ( float ) ( i % 640 ), ( float ) ( ( i / 640 ) % 480 ) }, { label, ( size_t ) ( end - label ) }, Color::white() );
+                }
+
+                frame.split();
+
+                renderer.perform();
+
+                ++frames;
+            } );
+
+            // counters of the last measured frame
+            const auto   &stats   = renderer.stats();
+            const double uploaded = ( double ) ( stats.m_uploaded_bytes + stats.m_texture_bytes );
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "labels/ms", ( double ) calls * 1e6 / sample.m_split_ns },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "texture_KiB/frame", ( double ) stats.m_texture_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( uploaded ) };
+        } );
+    }
+}
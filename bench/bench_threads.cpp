@@ -0,0 +1,131 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <barrier>
+#include <map>
+#include <string>
+#include <thread>
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This function records a slice of the mixed primitives of a frame
+     * @param context recording context of the thread
+     * @param first index of the first primitive
+     * @param count primitive count
+    */
+    void record_slice( RecordContext &context, const size_t first, const size_t count ) {
+        for ( size_t i{ first }; i < first + count; ++i ) {
+            const float x = ( float ) ( i % 64 ) * 12.f;
+            const float y = ( float ) ( i / 64 % 64 ) * 12.f;
+
+            switch ( i % 3 ) {
+                case 0:
+                    context.draw_line( { x, y }, { x + 10.f, y + 8.f }, Color( 255, 255, 255, 255 ), 1.f );
+                    break;
+                case 1:
+                    context.draw_filled_rect( { x, y }, { 10.f, 10.f }, Color( 40, 40, 40, 255 ) );
+                    break;
+                default:
+                    context.draw_filled_circle( { x + 5.f, y + 5.f }, 5.f, Color( 0, 160, 255, 255 ) );
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief This function returns the thread counts the scaling case runs at, doubling up to the hardware threads
+     * @return thread counts
+    */
+    std::vector< size_t > thread_counts() {
+        const size_t          hardware = std::max< size_t >( std::thread::hardware_concurrency(), 1 );
+        std::vector< size_t > counts;
+
+        for ( size_t n{ 1 }; n < hardware; n *= 2 )
+            counts.push_back( n );
+
+        counts.push_back( hardware );
+
+        return counts;
+    }
+}
+
+DX_BENCH_SUITE( threads ) {
+    std::map< size_t, double > single_rates; // primitives per second of one thread, by calls per frame
+
+    for ( const size_t threads : thread_counts() ) {
+        const std::string name = "threads/" + std::to_string( threads );
+
+        runner.for_renderer( name.c_str(), [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            std::vector< RecordContext * > contexts;
+            std::vector< std::thread >     workers;
+            std::barrier                   sync{ ( std::ptrdiff_t ) threads };
+            bool                           stop{};
+
+            for ( size_t t{}; t < threads; ++t )
+                contexts.push_back( renderer.create_context() );
+
+            const auto slice = [ & ]( const size_t t ) {
+                const size_t first = calls * t / threads;
+
+                record_slice( *contexts[ t ], first, calls * ( t + 1 ) / threads - first );
+            };
+
+            // the workers wait for the frame to start, record their slice, and wait for the others to finish
+            for ( size_t t{ 1 }; t < threads; ++t ) {
+                workers.emplace_back( [ &, t ] {
+                    for ( ;; ) {
+                        sync.arrive_and_wait();
+
+                        if ( stop )
+                            break;
+
+                        slice( t );
+
+                        sync.arrive_and_wait();
+                    }
+                } );
+            }
+
+            // the calling thread records the first slice, the split point is after every thread finished recording
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                sync.arrive_and_wait();
+
+                slice( 0 );
+
+                sync.arrive_and_wait();
+
+                frame.split();
+
+                renderer.perform();
+            } );
+
+            stop = true;
+            sync.arrive_and_wait();
+
+            for ( auto &worker : workers )
+                worker.join();
+
+            // counters of the last measured frame
+            const auto   &stats = renderer.stats();
+            const double rate   = ( double ) calls / sample.m_split_ns * 1e3;
+
+            if ( threads == 1 )
+                single_rates[ calls ] = rate;
+
+            const auto single = single_rates.find( calls );
+
+            runner.report( name.c_str(), calls, sample, ( double ) calls, {
+                { "Mprims/s", rate },
+                { "speedup", single != single_rates.end() ? rate / single->second : 0.0 },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
@@ -0,0 +1,83 @@
+#include "bench.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    /**
+     * @brief This struct holds an unchanged frame benchmark case
+    */
+    struct UnchangedCase_t {
+        const char *m_name;   // case name
+        bool       m_skip;   // unchanged frames are skipped
+        bool       m_moving; // one primitive moves every frame, so no frame is the same as the last
+    };
+
+    const UnchangedCase_t unchanged_cases[] = {
+        { "unchanged/idle/drawn", false, false },
+        { "unchanged/idle/skipped", true, false },
+        { "unchanged/moving/hashed", true, true }
+    };
+
+    /**
+     * @brief This function records a panel of rects and circles
+     * @param context context to record to
+     * @param calls primitive count
+    */
+    void record_panel( RecordContext &context, const size_t calls ) {
+        for ( size_t i{}; i < calls; ++i ) {
+            const float x = ( float ) ( i % 64 ) * 10.f;
+            const float y = ( float ) ( i / 64 % 48 ) * 10.f;
+
+            if ( i % 4 )
+                context.draw_filled_rect( { x, y }, { 9.f, 9.f }, Color( 30, 30, 30, 255 ) );
+
+            else
+                context.draw_filled_circle( { x + 5.f, y + 5.f }, 4.f, Color( 0, 160, 255, 255 ) );
+        }
+    }
+}
+
+DX_BENCH_SUITE( unchanged ) {
+    for ( const auto &c : unchanged_cases ) {
+        runner.for_renderer( c.m_name, [ & ]( Renderer &renderer, NullBackend &, const size_t calls ) {
+            float  cursor{};
+            size_t frames{};
+            size_t drawn{};
+
+            renderer.set_skip_unchanged( c.m_skip );
+
+            // the lists are hashed from the frame after skipping was switched on
+            renderer.perform();
+
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                record_panel( renderer, calls );
+
+                renderer.draw_filled_rect( { cursor, 470.f }, { 8.f, 8.f }, Color::white() );
+
+                frame.split();
+
+                drawn += renderer.perform();
+                ++frames;
+
+                if ( c.m_moving )
+                    cursor = std::fmod( cursor + 1.f, 640.f );
+            } );
+
+            // counters of the last measured frame
+            const auto &stats = renderer.stats();
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "ns/prim", sample.m_ns / ( double ) calls },
+                { "flush_us", ( sample.m_ns - sample.m_split_ns ) / 1000.0 },
+                { "drawn/frame", ( double ) drawn / ( double ) frames },
+                { "upload_KiB/frame", ( double ) stats.m_uploaded_bytes / 1024.0 },
+                { "draws/frame", ( double ) stats.m_draw_calls }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) stats.m_uploaded_bytes ) };
+        } );
+    }
+}
@@ -0,0 +1,71 @@
+#include "bench.h"
+#include "vector_array.h"
+
+using namespace dx;
+using namespace dx::bench;
+
+namespace {
+    const Affine2_t rotation{ { 0.8f, 0.6f }, { -0.6f, 0.8f }, { 320.f, 240.f } }; // transform of the transform cases
+
+    /**
+     * @brief This struct holds a vector kernel benchmark case
+    */
+    struct VectorCase_t {
+        const char *m_name;                                 // case name
+        void       ( *m_run )( std::span< Vector2 > points ); // runs the kernel or the scalar loop over the points
+    };
+
+    const VectorCase_t vector_cases[] = {
+        { "vector/add/loop", []( std::span< Vector2 > p ) { for ( auto &v : p ) v += Vector2( 1.f, -1.f ); } },
+        { "vector/add/kernel", []( std::span< Vector2 > p ) { VectorArray::add( p, { 1.f, -1.f } ); } },
+        { "vector/transform/loop", []( std::span< Vector2 > p ) {
+            for ( auto &v : p )
+                v = { rotation.m_x.x * v.x + rotation.m_y.x * v.y + rotation.m_origin.x, rotation.m_x.y * v.x + rotation.m_y.y * v.y + rotation.m_origin.y };
+        } },
+        { "vector/transform/kernel", []( std::span< Vector2 > p ) { VectorArray::transform( p, rotation ); } },
+        { "vector/normalize/loop", []( std::span< Vector2 > p ) { for ( auto &v : p ) v.normalize(); } },
+        { "vector/normalize/kernel", []( std::span< Vector2 > p ) { VectorArray::normalize( p ); } },
+        { "vector/bounds/loop", []( std::span< Vector2 > p ) {
+            Vector2 min{ p[ 0 ] }, max{ p[ 0 ] };
+
+            for ( const auto &v : p ) {
+                min = { std::min( min.x, v.x ), std::min( min.y, v.y ) };
+                max = { std::max( max.x, v.x ), std::max( max.y, v.y ) };
+            }
+
+            p[ 0 ] = min + max * 0.f;
+        } },
+        { "vector/bounds/kernel", []( std::span< Vector2 > p ) {
+            Vector2 min, max;
+
+            VectorArray::bounds( p, min, max );
+
+            p[ 0 ] = min + max * 0.f;
+        } }
+    };
+}
+
+DX_BENCH_SUITE( vector ) {
+    for ( const auto &c : vector_cases ) {
+        runner.for_sizes( c.m_name, [ & ]( const size_t calls ) {
+            std::vector< Vector2 > points( calls );
+
+            // points spread over the screen, refreshed every iteration so normalizing does not settle
+            const auto sample = runner.measure( [ & ]( Frame &frame ) {
+                for ( size_t i{}; i < calls; ++i )
+                    points[ i ] = { ( float ) ( i % 640 ), ( float ) ( i / 640 % 480 ) + 1.f };
+
+                frame.split();
+
+                c.m_run( points );
+            } );
+
+            runner.report( c.m_name, calls, sample, ( double ) calls, {
+                { "points/us", ( double ) calls / ( ( sample.m_ns - sample.m_split_ns ) / 1000.0 ) },
+                { "kernel_us", ( sample.m_ns - sample.m_split_ns ) / 1000.0 }
+            } );
+
+            return Result_t{ sample, Runner::mib( ( double ) ( calls * sizeof( Vector2 ) ) ) };
+        } );
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "includes.h"
+#include "render_list.h"
+#include "upload_ring.h"
+
+namespace dx {
+    /**
+     * @brief This enum holds the dynamic buffers a backend submits the render list from
+    */
+    enum class BufferType : uint8_t {
+        VERTEX,
+        INDEX,
+        INSTANCE
+    };
+
+    /**
+     * @brief This class contains the interface between the platform independent renderer
+     * and the graphics api that submits its render list
+    */
+    class Backend {
+    public:
+        /**
+         * @brief The virtual destructor for the Backend class
+        */
+        virtual ~Backend() = default;
+
+        /**
+         * @brief This function destroys the backend resources
+        */
+        virtual void destroy() = 0;
+
+        /**
+         * @brief This function retrieves the current screen size of the render target
+         * @return render target width and height
+        */
+        virtual Vector2 get_screen_size() = 0;
+
+        /**
+         * @brief This function prepares the backend for submission, saving any state it overrides
+         * @return true, if ready to submit. false, otherwise
+        */
+        virtual bool begin() = 0;
+
+        /**
+         * @brief This function finishes the submission, restoring any state it overrode
+        */
+        virtual void end() = 0;
+
+        /**
+         * @brief This function recreates a dynamic buffer with a new size, dropping its contents
+         * @param type buffer type
+         * @param size buffer size in bytes
+         * @return true, if created. false, otherwise
+        */
+        virtual bool resize( BufferType type, const size_t size ) = 0;
+
+        /**
+         * @brief This function maps a dynamic buffer for writing
+         * @param type buffer type
+         * @param mode map mode
+         * @return writable memory of the whole buffer, or nullptr if it cannot be mapped
+        */
+        virtual void *map( BufferType type, MapMode mode ) = 0;
+
+        /**
+         * @brief This function unmaps a dynamic buffer
+         * @param type buffer type
+        */
+        virtual void unmap( BufferType type ) = 0;
+
+        /**
+         * @brief This function draws a range of the uploaded indices
+         * @param topology primitive topology
+         * @param format index format
+         * @param index_count number of indices
+         * @param start_index first index location, in units of the index format
+         * @param base_vertex value added to each index before reading a vertex
+         * @param texture texture multiplied with the vertex colors, or Batch_t::NO_TEXTURE
+        */
+        virtual void draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) = 0;
+
+        /**
+         * @brief This function sets the rectangle the following draws are clipped to, reset to the whole render target by begin
+         * @param clip clip rect in pixels, or nullptr to draw to the whole render target
+        */
+        virtual void set_scissor( const ClipRect_t *clip ) = 0;
+
+        /**
+         * @brief This function creates an immutable unit mesh shape instances are expanded from
+         * @param mesh mesh id, ids are created in increasing order starting at zero
+         * @param vertices unit positions
+         * @param indices triangle list indices
+         * @return true, if created. false, otherwise
+        */
+        virtual bool create_mesh( const uint32_t mesh, std::span< const Vector2 > vertices, std::span< const uint16_t > indices ) = 0;
+
+        /**
+         * @brief This function draws a range of the uploaded shape instances from a unit mesh
+         * @param mesh mesh id
+         * @param index_count number of mesh indices
+         * @param instance_count number of instances
+         * @param start_instance first instance location
+        */
+        virtual void draw_instanced( const uint32_t mesh, const size_t index_count, const size_t instance_count, const size_t start_instance ) = 0;
+
+        /**
+         * @brief This function creates an rgba8 texture sampled by textured batches, cleared to transparent black
+         * @param texture texture id, ids are created in increasing order starting at zero
+         * @param width width in texels
+         * @param height height in texels
+         * @return true, if created. false, otherwise
+        */
+        virtual bool create_texture( const uint32_t texture, const uint32_t width, const uint32_t height ) = 0;
+
+        /**
+         * @brief This function writes a region of a texture, ordered before the draws submitted after it
+         * @param texture texture id
+         * @param x left edge in texels
+         * @param y top edge in texels
+         * @param width region width in texels
+         * @param height region height in texels
+         * @param pixels tightly packed rgba8 rows, red in the lowest byte
+        */
+        virtual void update_texture( const uint32_t texture, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) = 0;
+
+        /**
+         * @brief This function creates an immutable single channel texture of signed distances, textured batches sampling it
+         * draw the vertex color with the coverage of the distance field instead of multiplying with the texels
+         * @param texture texture id, shares the ids of create_texture
+         * @param width width in texels
+         * @param height height in texels
+         * @param distances tightly packed rows of 8-bit distances, 128 on the edge and larger inside
+         * @return true, if created. false, otherwise
+        */
+        virtual bool create_distance_texture( const uint32_t texture, const uint32_t width, const uint32_t height, std::span< const uint8_t > distances ) = 0;
+
+        /**
+         * @brief This function creates the immutable buffers of static geometry
+         * @param geometry static geometry id, the id of destroyed geometry may be created again
+         * @param vertices vertices
+         * @param indices index bytes, batches of 16-bit and 32-bit indices each starting on a multiple of their size
+         * @param instances shape instances
+         * @return true, if created. false, otherwise
+        */
+        virtual bool create_static( const uint32_t geometry, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) = 0;
+
+        /**
+         * @brief This function destroys the buffers of static geometry
+         * @param geometry static geometry id
+        */
+        virtual void destroy_static( const uint32_t geometry ) = 0;
+
+        /**
+         * @brief This function sets the buffers the following draws read from, reset to the dynamic buffers by begin
+         * @param geometry static geometry id, or Batch_t::NO_STATIC for the dynamic buffers
+         * @param translation offset added to the drawn positions
+        */
+        virtual void set_static( const uint32_t geometry, const Vector2 &translation ) = 0;
+
+        /**
+         * @brief This function recreates a buffer written in place instead of mapped, dropping its contents. The draws read
+         * from it instead of the dynamic buffer of its type while the persistent buffers are selected
+         * @param type buffer type
+         * @param size buffer size in bytes
+         * @return true, if created. false, otherwise
+        */
+        virtual bool resize_persistent( BufferType type, const size_t size ) = 0;
+
+        /**
+         * @brief This function writes a range of a persistent buffer, the draws submitted before it read the previous contents
+         * @param type buffer type
+         * @param offset byte offset
+         * @param bytes bytes written
+        */
+        virtual void update_persistent( BufferType type, const size_t offset, std::span< const uint8_t > bytes ) = 0;
+
+        /**
+         * @brief This function sets whether the following draws read from the persistent buffers, reset to the dynamic buffers by begin
+         * @param persistent read from the persistent buffers
+        */
+        virtual void set_persistent( const bool persistent ) = 0;
+    };
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "includes.h"
+#include "font.h"
+#include "mapped_file.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds the header of a baked font file. The file is read in place, so every field
+     * is little-endian and naturally aligned
+    */
+    struct BakedFontHeader_t {
+        uint32_t m_magic;        // BakedFont::MAGIC
+        uint32_t m_version;      // BakedFont::VERSION
+        float    m_em_size;      // font size in pixels the glyphs were baked at
+        float    m_spread;       // distance in baked pixels from the edge to either end of the stored range
+        float    m_line_height;  // line height at the baked size
+        uint32_t m_page_width;   // page width in texels
+        uint32_t m_page_height;  // page height in texels
+        uint32_t m_page_count;   // number of pages
+        uint32_t m_glyph_count;  // number of glyphs
+        uint32_t m_glyph_offset; // byte offset of the glyph table
+        uint64_t m_page_offset;  // byte offset of the first page
+        uint64_t m_page_stride;  // bytes from one page to the next, pages start on PAGE_ALIGNMENT
+    };
+
+    /**
+     * @brief This struct holds a glyph of a baked font file, glyphs are sorted by codepoint
+    */
+    struct BakedGlyph_t {
+        uint32_t m_codepoint; // unicode codepoint
+        uint16_t m_page;      // page holding the distance field
+        uint16_t m_x;         // left edge in texels
+        uint16_t m_y;         // top edge in texels
+        uint16_t m_width;     // width in texels, zero for blank glyphs
+        uint16_t m_height;    // height in texels
+        uint16_t m_reserved;  // zero
+        float    m_offset_x;  // left edge relative to the pen at the baked size
+        float    m_offset_y;  // top edge relative to the top of the line at the baked size
+        float    m_advance;   // horizontal pen advance at the baked size
+    };
+
+    static_assert( sizeof( BakedFontHeader_t ) == 56, "baked font header has to match the file format" );
+    static_assert( sizeof( BakedGlyph_t ) == 28, "baked glyph has to match the file format" );
+
+    /**
+     * @brief This class contains a signed distance field font baked offline into a memory-mapped file. Opening
+     * it only checks the header, glyphs are looked up in place and a page is read when its first glyph is drawn.
+     * One set of pages serves every text size
+    */
+    class BakedFont : public Font {
+    public:
+        static constexpr uint32_t MAGIC          = 0x46425844; // "DXBF"
+        static constexpr uint32_t VERSION        = 1;          // file format version
+        static constexpr size_t   PAGE_ALIGNMENT = 4096;       // page alignment in the file, so untouched pages are never paged in
+
+        /**
+         * @brief The constructor for the BakedFont class
+        */
+        FORCEINLINE BakedFont() : m_file{}, m_header{}, m_glyphs{} {
+
+        }
+
+        /**
+         * @brief This function maps a baked font file and checks its header and table bounds
+         * @param path file path
+         * @return true, if opened. false, otherwise
+        */
+        NOINLINE bool open( const char *path );
+
+        /**
+         * @brief This function finds a glyph
+         * @param codepoint unicode codepoint
+         * @return glyph, or nullptr if the font does not have it or its record is out of bounds
+        */
+        NOINLINE const BakedGlyph_t *find( const uint32_t codepoint ) const;
+
+        /**
+         * @brief This function returns the distances of a page, reading them pages the file in
+         * @param page page index
+         * @return tightly packed rows of 8-bit distances
+        */
+        FORCEINLINE std::span< const uint8_t > page( const uint32_t page ) const {
+            return m_file.data().subspan( m_header->m_page_offset + page * m_header->m_page_stride, ( size_t ) m_header->m_page_width * m_header->m_page_height );
+        }
+
+        /**
+         * @brief This function returns the file header
+         * @return header
+        */
+        FORCEINLINE const BakedFontHeader_t &header() const {
+            return *m_header;
+        }
+
+        /**
+         * @brief This function rasterizes a glyph from its distance field, for callers without a distance field shader
+         * @param codepoint unicode codepoint
+         * @param size font size in pixels
+         * @param glyph output glyph
+         * @return true, if the font has the glyph. false, otherwise
+        */
+        NOINLINE bool rasterize( const uint32_t codepoint, const float size, Glyph_t &glyph ) override;
+
+        NOINLINE float line_height( const float size ) override;
+
+        FORCEINLINE BakedFont *baked() override {
+            return this;
+        }
+
+        /**
+         * @brief This function bakes the glyphs of a font into a distance field font file
+         * @param font source font
+         * @param path output file path
+         * @param em_size font size in pixels the glyphs are baked at
+         * @param spread distance in baked pixels the field extends past the edge
+         * @param first first codepoint
+         * @param last last codepoint
+         * @param page_size page width and height in texels
+         * @return true, if written. false, otherwise
+        */
+        NOINLINE static bool bake( Font &font, const char *path, const float em_size = 32.f, const float spread = 4.f,
+                                   const uint32_t first = 32, const uint32_t last = 126, const uint32_t page_size = 512 );
+
+    private:
+        static constexpr uint32_t SUPERSAMPLES = 4; // source resolution per baked texel and axis
+
+        MappedFile              m_file;   // mapped file
+        const BakedFontHeader_t *m_header; // header within the mapping
+        const BakedGlyph_t      *m_glyphs; // glyph table within the mapping
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "includes.h"
+#include "render_list.h"
+
+namespace dx {
+    /**
+     * @brief This class contains the sort that reorders the batches of a render list so compatible ones are drawn together and merged.
+     * Each batch gets a 64-bit key of its level, its group within the level, and its submission order. A batch is placed
+     * above every level holding an incompatible batch it overlaps, and joins the group of compatible batches of its level,
+     * so batches that overlap keep their painter's order while the others are free to move. The keys are radix sorted and
+     * consecutive compatible batches are merged into one, their indices offset by the vertices merged before them
+    */
+    class BatchSorter {
+    public:
+        static constexpr float    PADDING    = 1.f;       // pixels the bounds are grown by when tested for overlap, covering rasterization at their edges
+        static constexpr size_t   MAX_TESTS  = 256;       // groups a batch is tested against, it is placed above the levels it was not tested against past it
+        static constexpr uint32_t MAX_GROUPS = 0xff;      // groups of a level, its group index takes 8 bits of the key
+        static constexpr uint32_t MAX_LEVELS = 0xffffff;  // levels, the level takes the top 24 bits of the key
+
+        /**
+         * @brief The constructor for the BatchSorter class
+        */
+        FORCEINLINE BatchSorter() : m_groups{}, m_levels{}, m_keys{}, m_sorted{}, m_tracked_first{} {
+
+        }
+
+        /**
+         * @brief This function sorts the batches of a render list and merges the compatible ones, the list has to be bounded
+         * by sorting while recorded. Its tracked primitives are moved along with their batches
+         * @param list render list
+         * @return batches merged into others
+        */
+        NOINLINE size_t sort( RenderList &list );
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX; // no group
+
+        /**
+         * @brief This struct holds compatible batches of a level
+        */
+        struct Group_t {
+            ClipRect_t m_bounds; // union of the bounds of the batches
+            uint32_t   m_batch;  // first batch, the state of the group
+            uint32_t   m_index;  // index within the level
+            uint32_t   m_next;   // next group of the level, or NONE
+        };
+
+        /**
+         * @brief This struct holds the groups of a level as a list
+        */
+        struct Level_t {
+            uint32_t m_first; // first group
+            uint32_t m_last;  // last group
+            uint32_t m_count; // group count
+        };
+
+        std::vector< Group_t >  m_groups; // groups of every level
+        std::vector< Level_t >  m_levels; // levels, drawn in increasing order
+        std::vector< uint64_t > m_keys;   // sort keys, level, group index, and batch
+        std::vector< uint64_t > m_sorted; // radix sort scratch
+
+        std::vector< uint32_t > m_tracked_first; // first tracked primitive of each batch of the list
+
+        /**
+         * @brief This function checks if two batches can be drawn as one
+         * @param a batch
+         * @param b batch
+         * @return true, if compatible. false, otherwise
+        */
+        FORCEINLINE static bool compatible( const Batch_t &a, const Batch_t &b ) {
+            return !a.retained() && !b.retained() && a.m_topology == b.m_topology && a.m_mesh == b.m_mesh && a.m_texture == b.m_texture && a.m_clip == b.m_clip;
+        }
+
+        /**
+         * @brief This function places a batch into a level and group
+         * @param batches batches of the list
+         * @param batch batch placed
+         * @param key output sort key
+         * @return true, if placed. false, if out of levels
+        */
+        NOINLINE bool place( const FrameVector< Batch_t > &batches, const uint32_t batch, uint64_t &key );
+
+        /**
+         * @brief This function sorts the keys by level and group, the batches of a group stay in submission order
+        */
+        NOINLINE void radix_sort();
+
+        /**
+         * @brief This function lays out the list in sorted order, merging consecutive compatible batches. The sorted list is
+         * allocated from the frame allocator of the list and swapped with it
+         * @param list render list
+         * @return batches merged into others
+        */
+        NOINLINE size_t merge( RenderList &list );
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "includes.h"
+#include "vector.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds an axis-aligned rectangle primitives are clipped to, in pixels
+    */
+    struct ClipRect_t {
+        Vector2 m_min; // top-left corner
+        Vector2 m_max; // bottom-right corner
+
+        /**
+         * @brief This function checks if the rectangle covers no pixels
+         * @return true, if empty. false, otherwise
+        */
+        FORCEINLINE bool empty() const {
+            return m_max.x <= m_min.x || m_max.y <= m_min.y;
+        }
+
+        /**
+         * @brief This function returns the intersection with another rectangle
+         * @param other rectangle
+         * @return intersection, empty if they do not overlap
+        */
+        FORCEINLINE ClipRect_t intersect( const ClipRect_t &other ) const {
+            return { { std::max( m_min.x, other.m_min.x ), std::max( m_min.y, other.m_min.y ) },
+                     { std::min( m_max.x, other.m_max.x ), std::min( m_max.y, other.m_max.y ) } };
+        }
+
+        /**
+         * @brief This function returns the smallest rectangle covering both rectangles
+         * @param other rectangle
+         * @return union bounds
+        */
+        FORCEINLINE ClipRect_t unite( const ClipRect_t &other ) const {
+            return { { std::min( m_min.x, other.m_min.x ), std::min( m_min.y, other.m_min.y ) },
+                     { std::max( m_max.x, other.m_max.x ), std::max( m_max.y, other.m_max.y ) } };
+        }
+
+        /**
+         * @brief This function checks if bounds are entirely outside of the rectangle
+         * @param min top-left corner of the bounds
+         * @param max bottom-right corner of the bounds
+         * @return true, if outside or the rectangle is empty. false, if they overlap
+        */
+        FORCEINLINE bool outside( const Vector2 &min, const Vector2 &max ) const {
+            return empty() || max.x <= m_min.x || max.y <= m_min.y || min.x >= m_max.x || min.y >= m_max.y;
+        }
+
+        /**
+         * @brief This function checks if bounds are entirely inside of the rectangle
+         * @param min top-left corner of the bounds
+         * @param max bottom-right corner of the bounds
+         * @return true, if inside. false, if they cross an edge
+        */
+        FORCEINLINE bool contains( const Vector2 &min, const Vector2 &max ) const {
+            return min.x >= m_min.x && min.y >= m_min.y && max.x <= m_max.x && max.y <= m_max.y;
+        }
+
+        /**
+         * @brief This function clips an axis-aligned quad to the rectangle, its texture coordinates are
+         * interpolated so the visible part samples the same texels
+         * @param min top-left corner of the quad, clipped in place
+         * @param max bottom-right corner of the quad, clipped in place
+         * @param uv_min texture coordinates of the top-left corner, clipped in place
+         * @param uv_max texture coordinates of the bottom-right corner, clipped in place
+         * @return true, if some of the quad is left. false, otherwise
+        */
+        FORCEINLINE bool clip( Vector2 &min, Vector2 &max, Vector2 &uv_min, Vector2 &uv_max ) const {
+            if ( outside( min, max ) )
+                return false;
+
+            const Vector2 size    = max - min;
+            const Vector2 uv_size = uv_max - uv_min;
+            const Vector2 lo{ std::max( min.x, m_min.x ), std::max( min.y, m_min.y ) };
+            const Vector2 hi{ std::min( max.x, m_max.x ), std::min( max.y, m_max.y ) };
+
+            uv_max = { uv_min.x + uv_size.x * ( hi.x - min.x ) / size.x, uv_min.y + uv_size.y * ( hi.y - min.y ) / size.y };
+            uv_min = { uv_min.x + uv_size.x * ( lo.x - min.x ) / size.x, uv_min.y + uv_size.y * ( lo.y - min.y ) / size.y };
+            min    = lo;
+            max    = hi;
+
+            return true;
+        }
+    };
+}
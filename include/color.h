@@ -78,7 +78,9 @@ namespace dx {
          * @return this color instance
         */
         FORCEINLINE Color &operator += ( const std::array< float, 4 > &rgba ) {
-            *this += rgba;
+            for ( size_t i{}; i < m_rgba.size(); ++i )
+                m_rgba[ i ] += rgba[ i ];
+
             return *this;
         }
 
@@ -98,7 +100,9 @@ namespace dx {
          * @return this color instance
         */
         FORCEINLINE Color &operator -= ( const std::array< float, 4 > &rgba ) {
-            *this -= rgba;
+            for ( size_t i{}; i < m_rgba.size(); ++i )
+                m_rgba[ i ] -= rgba[ i ];
+
             return *this;
         }
 
@@ -190,6 +194,19 @@ namespace dx {
             return m_rgba.data();
         }
 
+        /**
+         * @brief This function packs the rgba components into 8-bit unsigned normalized channels
+         * @return packed color, red in the lowest byte
+        */
+        FORCEINLINE uint32_t pack() const {
+            uint32_t ret{};
+
+            for ( size_t i{}; i < m_rgba.size(); ++i )
+                ret |= ( uint32_t ) ( std::clamp( m_rgba[ i ], 0.f, 1.f ) * 255.f + 0.5f ) << ( i * 8 );
+
+            return ret;
+        }
+
         /**
          * @brief This function returns the color red
          * @return instance of red Color
@@ -0,0 +1,409 @@
+#pragma once
+
+#include "includes.h"
+#include "backend.h"
+
+#ifdef DX_PLATFORM_WINDOWS
+
+namespace dx {
+    /**
+     * @brief This class contains the backup of the current DirectX 11 render state
+    */
+    class RenderStateBackup {
+    public:
+        /**
+         * @brief The constructor for the RenderStateBackup class
+        */
+        NOINLINE RenderStateBackup() : m_dev_ctx{}, m_scissor_rects_count {}, m_viewports_count{}, m_scissor_rects{}, m_viewports{}, m_rasterizer_state{}, m_blend_state{},
+            m_blend_factor{}, m_sample_mask{}, m_stencil_ref{}, m_depth_stencil_state{}, m_shader_resource{}, m_sampler{}, m_pixel_shader{}, m_vertex_shader{}, m_geometry_shader{},
+            m_ps_instance_count{}, m_vs_instance_count{}, m_gs_instance_count{}, m_ps_instances{}, m_vs_instances{}, m_gs_instances{}, m_primitive_topology{},
+            m_index_buffer{}, m_vertex_buffer{}, m_instance_buffer{}, m_constant_buffer{}, m_index_buffer_offset{}, m_vertex_buffer_stride{}, m_vertex_buffer_offset{},
+            m_instance_buffer_stride{}, m_instance_buffer_offset{}, m_index_buffer_format{}, m_input_layout{} {
+
+        }
+
+        /**
+         * @brief This function creates the backup of the current DirectX 11 render state
+         * @param dev_ctx directx device context
+         * @return true, if able to capture stateblock. false, otherwise
+        */
+        NOINLINE bool capture( ID3D11DeviceContext *dev_ctx );
+
+        /**
+         * @brief This function restores the stored backup of the current DirectX 11 render state
+        */
+        NOINLINE void apply();
+
+        static constexpr size_t CALLS = 32; // device context calls of a capture and apply, not counting the references released
+
+    private:
+        static constexpr size_t  MAX_D3D11_CLASS_INSTANCE = 256;
+
+        ID3D11DeviceContext      *m_dev_ctx;
+
+        UINT                     m_scissor_rects_count, m_viewports_count;
+        D3D11_RECT               m_scissor_rects[ D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE ];
+        D3D11_VIEWPORT           m_viewports[ D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE ];
+        ID3D11RasterizerState    *m_rasterizer_state;
+        ID3D11BlendState         *m_blend_state;
+        float                    m_blend_factor[ 4 ];
+        UINT                     m_sample_mask;
+        UINT                     m_stencil_ref;
+        ID3D11DepthStencilState  *m_depth_stencil_state;
+        ID3D11ShaderResourceView *m_shader_resource;
+        ID3D11SamplerState       *m_sampler;
+        ID3D11PixelShader        *m_pixel_shader;
+        ID3D11VertexShader       *m_vertex_shader;
+        ID3D11GeometryShader     *m_geometry_shader;
+        UINT                     m_ps_instance_count, m_vs_instance_count, m_gs_instance_count;
+        ID3D11ClassInstance      *m_ps_instances[ MAX_D3D11_CLASS_INSTANCE ], *m_vs_instances[ MAX_D3D11_CLASS_INSTANCE ], *m_gs_instances[ MAX_D3D11_CLASS_INSTANCE ];
+        D3D11_PRIMITIVE_TOPOLOGY m_primitive_topology;
+        ID3D11Buffer             *m_index_buffer, *m_vertex_buffer, *m_instance_buffer, *m_constant_buffer;
+        UINT                     m_index_buffer_offset, m_vertex_buffer_stride, m_vertex_buffer_offset, m_instance_buffer_stride, m_instance_buffer_offset;
+        DXGI_FORMAT              m_index_buffer_format;
+        ID3D11InputLayout        *m_input_layout;
+    };
+
+    /**
+     * @brief This struct holds the device context state calls of a frame
+    */
+    struct StateStats_t {
+        size_t m_calls; // state set through the device context
+        size_t m_saved; // state calls skipped, already set or captured and restored by a skipped backup
+    };
+
+    /**
+     * @brief This class contains the DirectX 11 backend, it owns the device objects
+     * and submits the render list through the device context
+    */
+    class D3D11Backend : public Backend {
+    public:
+        /**
+         * @brief The constructor for the D3D11Backend class
+        */
+        FORCEINLINE D3D11Backend() : m_dev_ctx{}, m_dev{}, m_vertex_shader{}, m_pixel_shader{}, m_input_layout{}, m_shape_vertex_shader{}, m_shape_input_layout{}, m_shape_pixel_shader{},
+            m_sprite_vertex_shader{}, m_sprite_pixel_shader{}, m_distance_pixel_shader{}, m_sampler_state{}, m_blend_state{}, m_rasterizer_state{}, m_vertex_buffer{}, m_index_buffer{}, m_instance_buffer{}, m_proj_buffer{},
+            m_persistent_vertex_buffer{}, m_persistent_index_buffer{}, m_persistent_instance_buffer{},
+            m_meshes{}, m_textures{}, m_statics{}, m_in_frame{}, m_pipeline{}, m_index_format{}, m_bound_mesh{}, m_bound_texture{}, m_bound_static{ Batch_t::NO_STATIC }, m_persistent{}, m_screen_size{},
+            m_translation{}, m_render_state_backup{}, m_owns_context{}, m_cache{}, m_state_stats{} {
+
+        }
+
+        /**
+         * @brief This function creates the directx objects of the backend
+         * @param dev directx device
+         * @param dev_ctx directx device context
+         * @return true if created. false, otherwise
+        */
+        NOINLINE bool create( ID3D11Device *dev, ID3D11DeviceContext *dev_ctx );
+
+        NOINLINE void destroy() override;
+
+        NOINLINE Vector2 get_screen_size() override;
+
+        NOINLINE bool begin() override;
+
+        NOINLINE void end() override;
+
+        NOINLINE bool resize( BufferType type, const size_t size ) override;
+
+        NOINLINE void *map( BufferType type, MapMode mode ) override;
+
+        NOINLINE void unmap( BufferType type ) override;
+
+        NOINLINE void draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) override;
+
+        NOINLINE void set_scissor( const ClipRect_t *clip ) override;
+
+        NOINLINE bool create_mesh( const uint32_t mesh, std::span< const Vector2 > vertices, std::span< const uint16_t > indices ) override;
+
+        NOINLINE void draw_instanced( const uint32_t mesh, const size_t index_count, const size_t instance_count, const size_t start_instance ) override;
+
+        NOINLINE bool create_texture( const uint32_t texture, const uint32_t width, const uint32_t height ) override;
+
+        NOINLINE void update_texture( const uint32_t texture, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) override;
+
+        NOINLINE bool create_distance_texture( const uint32_t texture, const uint32_t width, const uint32_t height, std::span< const uint8_t > distances ) override;
+
+        NOINLINE bool create_static( const uint32_t geometry, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) override;
+
+        NOINLINE void destroy_static( const uint32_t geometry ) override;
+
+        NOINLINE void set_static( const uint32_t geometry, const Vector2 &translation ) override;
+
+        NOINLINE bool resize_persistent( BufferType type, const size_t size ) override;
+
+        NOINLINE void update_persistent( BufferType type, const size_t offset, std::span< const uint8_t > bytes ) override;
+
+        NOINLINE void set_persistent( const bool persistent ) override;
+
+        /**
+         * @brief This function sets whether the backend owns the device context. Nothing else sets the state of an owned
+         * context, so begin does not capture it, end does not restore it, and the state set by the previous frame is kept.
+         * A shared context, like one the renderer is injected into, is backed up every frame
+         * @param owns_context the backend owns the device context, set outside of begin and end
+        */
+        NOINLINE void set_owns_context( const bool owns_context );
+
+        /**
+         * @brief This function returns the state calls of the last frame
+         * @return state call counters, reset by begin
+        */
+        FORCEINLINE const StateStats_t &state_stats() const {
+            return m_state_stats;
+        }
+
+    private:
+        /**
+         * @brief This enum holds the pipelines the input assembler can be bound for
+        */
+        enum class Pipeline : uint8_t {
+            NONE,     // bindings have to be set before the next draw
+            GEOMETRY, // render list vertices and indices
+            SPRITE,   // render list vertices and indices sampling a texture
+            SHAPE     // unit mesh and shape instances
+        };
+
+        /**
+         * @brief This struct holds the state last set through the device context, a null or zero member is not known.
+         * The backend never binds null for a draw that reads it, so those are never skipped wrongly
+        */
+        struct StateCache_t {
+            ID3D11VertexShader                       *m_vertex_shader;    // vertex shader
+            ID3D11PixelShader                        *m_pixel_shader;     // pixel shader
+            ID3D11InputLayout                        *m_input_layout;     // input layout
+            ID3D11Buffer                             *m_vertex_buffer;    // vertex buffer of slot 0, vertices or unit mesh positions
+            ID3D11Buffer                             *m_instance_buffer;  // vertex buffer of slot 1, shape instances
+            std::pair< ID3D11Buffer *, DXGI_FORMAT > m_index_buffer;      // index buffer and the format it is read with
+            D3D11_PRIMITIVE_TOPOLOGY                 m_topology;          // primitive topology
+            ID3D11ShaderResourceView                 *m_view;             // pixel shader resource of slot 0
+            ID3D11SamplerState                       *m_sampler;          // pixel shader sampler of slot 0
+            ID3D11Buffer                             *m_constant_buffer;  // vertex shader constant buffer of slot 0
+            ID3D11BlendState                         *m_blend_state;      // blend state
+            ID3D11RasterizerState                    *m_rasterizer_state; // rasterizer state
+            D3D11_RECT                               m_scissor;           // scissor rect
+            bool                                     m_scissor_known;     // the scissor rect was set
+        };
+
+        /**
+         * @brief This struct holds the immutable buffers of a unit mesh
+        */
+        struct Mesh_t {
+            ID3D11Buffer *m_vertex_buffer; // unit positions
+            ID3D11Buffer *m_index_buffer;  // 16-bit triangle list indices
+        };
+
+        /**
+         * @brief This struct holds a texture and the view it is sampled through
+        */
+        struct Texture_t {
+            ID3D11Texture2D          *m_texture;  // rgba8 or distance texture
+            ID3D11ShaderResourceView *m_view;     // shader resource view
+            bool                     m_distance; // sampled with the distance field pixel shader
+        };
+
+        /**
+         * @brief This struct holds the immutable buffers of static geometry, a buffer is null when it would be empty
+        */
+        struct Static_t {
+            ID3D11Buffer *m_vertex_buffer;   // vertices
+            ID3D11Buffer *m_index_buffer;    // 16-bit and 32-bit indices
+            ID3D11Buffer *m_instance_buffer; // shape instances
+        };
+
+        static constexpr UINT VERTEX_BUFFER_STRIDE = sizeof( Vertex ); // stride of vertex buffer
+        static constexpr UINT VERTEX_BUFFER_OFFSET = 0;                // offset of vertex buffer
+        static constexpr UINT MESH_BUFFER_STRIDE     = sizeof( Vector2 );         // stride of mesh vertex buffer
+        static constexpr UINT INSTANCE_BUFFER_STRIDE = sizeof( ShapeInstance_t ); // stride of instance buffer
+
+        ID3D11DeviceContext *m_dev_ctx; // directx device context
+        ID3D11Device        *m_dev;     // directx device
+
+        ID3D11VertexShader *m_vertex_shader; // directx vertex shader
+        ID3D11PixelShader  *m_pixel_shader;  // directx pixel shader
+        ID3D11InputLayout  *m_input_layout;  // directx input layout
+
+        ID3D11VertexShader *m_shape_vertex_shader; // directx instanced shape vertex shader
+        ID3D11InputLayout  *m_shape_input_layout;  // directx instanced shape input layout
+        ID3D11PixelShader  *m_shape_pixel_shader;  // directx shape pixel shader, covers signed distance shapes
+
+        ID3D11VertexShader *m_sprite_vertex_shader;  // directx textured vertex shader
+        ID3D11PixelShader  *m_sprite_pixel_shader;   // directx textured pixel shader
+        ID3D11PixelShader  *m_distance_pixel_shader; // directx distance field text pixel shader
+        ID3D11SamplerState *m_sampler_state;         // directx texture sampler state
+
+        ID3D11BlendState      *m_blend_state;      // directx blend state
+        ID3D11RasterizerState *m_rasterizer_state; // directx rasterizer state with the scissor test enabled
+
+        ID3D11Buffer *m_vertex_buffer;   // vertex buffer
+        ID3D11Buffer *m_index_buffer;    // index buffer
+        ID3D11Buffer *m_instance_buffer; // shape instance buffer
+        ID3D11Buffer *m_proj_buffer;     // projection buffer
+
+        ID3D11Buffer *m_persistent_vertex_buffer;   // vertex buffer written in place
+        ID3D11Buffer *m_persistent_index_buffer;    // index buffer written in place
+        ID3D11Buffer *m_persistent_instance_buffer; // shape instance buffer written in place
+
+        std::vector< Mesh_t >    m_meshes;   // unit meshes, indexed by mesh id
+        std::vector< Texture_t > m_textures; // textures, indexed by texture id
+        std::vector< Static_t >  m_statics;  // static geometry, indexed by static geometry id
+
+        bool        m_in_frame;     // between begin and end, the custom state is set
+        Pipeline    m_pipeline;     // pipeline the input assembler is bound for
+        IndexFormat m_index_format; // format the index buffer is bound with
+        uint32_t    m_bound_mesh;    // mesh bound for the shape pipeline
+        uint32_t    m_bound_texture; // texture bound for the sprite pipeline
+        uint32_t    m_bound_static;  // static geometry the draws read from, or Batch_t::NO_STATIC
+        bool        m_persistent;    // the draws read from the persistent buffers instead of the dynamic ones
+
+        Vector2 m_screen_size; // current screen size
+        Vector2 m_translation; // offset the projection matrix translates by
+
+        RenderStateBackup m_render_state_backup; // render state backup, captured and restored unless the backend owns the device context
+        bool              m_owns_context;        // nothing else sets the state of the device context
+        StateCache_t      m_cache;               // state last set through the device context, forgotten when another user may have changed it
+        StateStats_t      m_state_stats;         // state calls of the current frame
+
+        /**
+         * @brief This function sets the custom render state settings
+        */
+        NOINLINE void set_custom_state();
+
+        /**
+         * @brief This function sets a state through the device context unless the cache holds it already
+         * @param cached cached state, updated to the value
+         * @param value state to set
+         * @param set function setting the state
+        */
+        template < typename T, typename F >
+        FORCEINLINE void set_state( T &cached, const T &value, F &&set ) {
+            if ( cached == value ) {
+                ++m_state_stats.m_saved;
+                return;
+            }
+
+            cached = value;
+            set();
+
+            ++m_state_stats.m_calls;
+        }
+
+        /**
+         * @brief This function sets the vertex shader unless it is set already
+         * @param shader vertex shader
+        */
+        FORCEINLINE void set_vertex_shader( ID3D11VertexShader *shader ) {
+            set_state( m_cache.m_vertex_shader, shader, [ & ]() { m_dev_ctx->VSSetShader( shader, nullptr, 0 ); } );
+        }
+
+        /**
+         * @brief This function sets the pixel shader unless it is set already
+         * @param shader pixel shader
+        */
+        FORCEINLINE void set_pixel_shader( ID3D11PixelShader *shader ) {
+            set_state( m_cache.m_pixel_shader, shader, [ & ]() { m_dev_ctx->PSSetShader( shader, nullptr, 0 ); } );
+        }
+
+        /**
+         * @brief This function sets the input layout unless it is set already
+         * @param layout input layout
+        */
+        FORCEINLINE void set_input_layout( ID3D11InputLayout *layout ) {
+            set_state( m_cache.m_input_layout, layout, [ & ]() { m_dev_ctx->IASetInputLayout( layout ); } );
+        }
+
+        /**
+         * @brief This function sets the vertex buffer of a slot unless it is set already, a buffer is always read with the same stride
+         * @param slot input slot, 0 for vertices and unit meshes or 1 for shape instances
+         * @param buffer vertex buffer
+         * @param stride vertex stride
+        */
+        FORCEINLINE void set_vertex_buffer( const UINT slot, ID3D11Buffer *buffer, const UINT &stride ) {
+            set_state( slot ? m_cache.m_instance_buffer : m_cache.m_vertex_buffer, buffer, [ & ]() { m_dev_ctx->IASetVertexBuffers( slot, 1, &buffer, &stride, &VERTEX_BUFFER_OFFSET ); } );
+        }
+
+        /**
+         * @brief This function sets the index buffer unless it is set already with the same format
+         * @param buffer index buffer
+         * @param format index format
+        */
+        FORCEINLINE void set_index_buffer( ID3D11Buffer *buffer, const DXGI_FORMAT format ) {
+            set_state( m_cache.m_index_buffer, { buffer, format }, [ & ]() { m_dev_ctx->IASetIndexBuffer( buffer, format, 0 ); } );
+        }
+
+        /**
+         * @brief This function sets the primitive topology unless it is set already
+         * @param topology primitive topology
+        */
+        FORCEINLINE void set_topology( const D3D11_PRIMITIVE_TOPOLOGY topology ) {
+            set_state( m_cache.m_topology, topology, [ & ]() { m_dev_ctx->IASetPrimitiveTopology( topology ); } );
+        }
+
+        /**
+         * @brief This function returns the dynamic buffer of a buffer type
+         * @param type buffer type
+         * @return buffer reference
+        */
+        FORCEINLINE ID3D11Buffer *&buffer( BufferType type ) {
+            return type == BufferType::VERTEX ? m_vertex_buffer : type == BufferType::INDEX ? m_index_buffer : m_instance_buffer;
+        }
+
+        /**
+         * @brief This function returns the persistent buffer of a buffer type
+         * @param type buffer type
+         * @return buffer reference
+        */
+        FORCEINLINE ID3D11Buffer *&persistent_buffer( BufferType type ) {
+            return type == BufferType::VERTEX ? m_persistent_vertex_buffer : type == BufferType::INDEX ? m_persistent_index_buffer : m_persistent_instance_buffer;
+        }
+
+        /**
+         * @brief This function returns the buffer the draws read from, the dynamic or persistent buffer or the one of the bound static geometry
+         * @param type buffer type
+         * @return buffer
+        */
+        FORCEINLINE ID3D11Buffer *source( BufferType type ) {
+            if ( m_bound_static == Batch_t::NO_STATIC )
+                return m_persistent ? persistent_buffer( type ) : buffer( type );
+
+            const auto &geometry = m_statics[ m_bound_static ];
+
+            return type == BufferType::VERTEX ? geometry.m_vertex_buffer : type == BufferType::INDEX ? geometry.m_index_buffer : geometry.m_instance_buffer;
+        }
+
+        /**
+         * @brief This function binds the shaders and buffers drawing the render list vertices
+         * @param format index format
+        */
+        NOINLINE void bind_geometry( IndexFormat format );
+
+        /**
+         * @brief This function creates the directx projection matrix and allocates its buffer
+         * @return true, if allocated. false, otherwise
+        */
+        NOINLINE bool project();
+
+        /**
+         * @brief This function writes the projection matrix, translated by an offset
+         * @param translation offset added to the drawn positions
+         * @return true, if written. false, otherwise
+        */
+        NOINLINE bool translate( const Vector2 &translation );
+
+        /**
+         * @brief This function converts a platform independent topology to its directx counterpart
+         * @param topology primitive topology
+         * @return directx primitive topology
+        */
+        static D3D11_PRIMITIVE_TOPOLOGY to_d3d11( Topology topology );
+
+        /**
+         * @brief This function converts a platform independent index format to its dxgi counterpart
+         * @param format index format
+         * @return dxgi index format
+        */
+        static DXGI_FORMAT to_dxgi( IndexFormat format );
+    };
+}
+
+#endif
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds the counters of a diffed upload
+    */
+    struct DiffResult_t {
+        size_t m_compared; // bytes compared against the buffer contents
+        size_t m_written;  // bytes written, the changed blocks and the unchanged gaps merged between them
+        size_t m_ranges;   // ranges written
+        bool   m_fallback; // the changed blocks needed more ranges than the frame had left and were written as one range
+    };
+
+    /**
+     * @brief This class contains the allocator of a buffer written in place, keeping a copy of its contents in system memory.
+     * A frame is laid out from the start of the buffer, so a frame like the previous one lands on the same bytes and only
+     * the blocks that differ from the copy have to be written
+    */
+    class DiffBuffer {
+    public:
+        static constexpr size_t BLOCK_SIZE = 64;  // bytes compared at once, a block that differs is written whole
+        static constexpr size_t MERGE_GAP  = 512; // unchanged bytes between two changed ranges written along with them, saving a write
+        static constexpr size_t MAX_RANGES = 64;  // ranges written per frame, past them the changed blocks of a range are written as one
+
+        /**
+         * @brief The constructor for the DiffBuffer class
+        */
+        FORCEINLINE DiffBuffer() : m_contents{}, m_staged{}, m_changed{}, m_valid{}, m_cursor{}, m_offset{}, m_size{}, m_ranges{} {
+
+        }
+
+        /**
+         * @brief This function restarts on a newly created buffer, its contents are unknown until written
+         * @param capacity buffer size in bytes
+        */
+        FORCEINLINE void reset( const size_t capacity ) {
+            m_contents.resize( capacity );
+            m_valid  = 0;
+            m_cursor = 0;
+        }
+
+        /**
+         * @brief This function starts laying out a frame from the start of the buffer
+        */
+        FORCEINLINE void begin_frame() {
+            m_cursor = 0;
+            m_ranges = 0;
+        }
+
+        /**
+         * @brief This function allocates a range after the previous one, its bytes are committed from memory the caller keeps
+         * @param size range size in bytes
+         * @param alignment range offset alignment in bytes, need not be a power of two
+         * @param offset output byte offset into the buffer
+         * @return true, if the range fits the buffer. false, otherwise
+        */
+        FORCEINLINE bool allocate( const size_t size, const size_t alignment, size_t &offset ) {
+            offset = ( m_cursor + alignment - 1 ) / alignment * alignment;
+
+            if ( offset + size > m_contents.size() )
+                return false;
+
+            m_offset = offset;
+            m_size   = size;
+            m_cursor = offset + size;
+
+            return true;
+        }
+
+        /**
+         * @brief This function allocates a range after the previous one and returns memory to stage its bytes in, for ranges
+         * that are not laid out in memory as they are uploaded
+         * @param size range size in bytes
+         * @param alignment range offset alignment in bytes, need not be a power of two
+         * @param offset output byte offset into the buffer
+         * @return staging memory of the range, or nullptr if it does not fit the buffer
+        */
+        FORCEINLINE uint8_t *stage( const size_t size, const size_t alignment, size_t &offset ) {
+            if ( !allocate( size, alignment, offset ) )
+                return nullptr;
+
+            m_staged.resize( size );
+
+            return m_staged.data();
+        }
+
+        /**
+         * @brief This function compares the bytes of the allocated range where they are with the buffer contents and writes
+         * the ranges that differ. When they would take the frame past MAX_RANGES writes, the changed blocks of the range are
+         * written as a single range from the first to the last, trading written bytes for fewer writes
+         * @param bytes bytes of the range, as many as were allocated
+         * @param write function writing a range, called with its byte offset and bytes
+         * @return diff counters
+        */
+        template < typename F >
+        FORCEINLINE DiffResult_t commit( const uint8_t *bytes, F &&write ) {
+            const size_t size = m_size;
+            uint8_t      *dst = m_contents.data() + m_offset;
+            DiffResult_t result{ size, 0, 0, false };
+            size_t       first{ SIZE_MAX };
+            size_t       last{};
+
+            m_changed.clear();
+
+            for ( size_t i{}; i < size; i += BLOCK_SIZE ) {
+                const size_t block = std::min( BLOCK_SIZE, size - i );
+
+                // bytes past what was ever written are unknown and always differ
+                if ( m_offset + i + block <= m_valid && !memcmp( dst + i, bytes + i, block ) )
+                    continue;
+
+                // the copy takes the changed block while it is in cache, unchanged bytes merged into a range already match
+                memcpy( dst + i, bytes + i, block );
+
+                // a changed block close to the previous range extends it
+                if ( first != SIZE_MAX && i - last > MERGE_GAP ) {
+                    m_changed.emplace_back( first, last );
+                    first = SIZE_MAX;
+                }
+
+                if ( first == SIZE_MAX )
+                    first = i;
+
+                last = i + block;
+            }
+
+            if ( first != SIZE_MAX )
+                m_changed.emplace_back( first, last );
+
+            // past the budget every write costs more than the unchanged bytes between the ranges
+            if ( m_changed.size() > 1 && m_ranges + m_changed.size() > MAX_RANGES ) {
+                m_changed = { { m_changed.front().first, m_changed.back().second } };
+                result.m_fallback = true;
+            }
+
+            for ( const auto &[ from, to ] : m_changed ) {
+                write( m_offset + from, std::span< const uint8_t >{ dst + from, to - from } );
+
+                result.m_written += to - from;
+                ++result.m_ranges;
+            }
+
+            m_ranges += result.m_ranges;
+            m_valid   = std::max( m_valid, m_offset + size );
+
+            return result;
+        }
+
+        /**
+         * @brief This function returns the capacity the buffer should grow to
+         * @param size bytes that have to fit
+         * @return power of two multiple of the capacity covering the size
+        */
+        FORCEINLINE size_t wanted_capacity( const size_t size ) const {
+            size_t capacity = m_contents.empty() ? 1 : m_contents.size();
+
+            while ( capacity < size )
+                capacity *= 2;
+
+            return capacity;
+        }
+
+        /**
+         * @brief This function returns the bytes of the last staged range
+         * @return staging memory
+        */
+        FORCEINLINE const uint8_t *staged() const {
+            return m_staged.data();
+        }
+
+        /**
+         * @brief This function returns the buffer size
+         * @return capacity in bytes
+        */
+        FORCEINLINE size_t capacity() const {
+            return m_contents.size();
+        }
+
+    private:
+        std::vector< uint8_t >                     m_contents; // copy of the buffer contents
+        std::vector< uint8_t >                     m_staged;   // bytes of the last staged range
+        std::vector< std::pair< size_t, size_t > > m_changed;  // changed byte ranges of the range being committed, kept for their capacity
+        size_t                                     m_valid;    // bytes from the start of the buffer that were written
+        size_t                                     m_cursor;   // end of the last allocated range
+        size_t                                     m_offset;   // offset of the last allocated range
+        size_t                                     m_size;     // size of the last allocated range
+        size_t                                     m_ranges;   // ranges written this frame
+    };
+}
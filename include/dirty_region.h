@@ -0,0 +1,101 @@
+#pragma once
+
+#include "includes.h"
+#include "clip_rect.h"
+
+namespace dx {
+    /**
+     * @brief This class contains the regions of the screen that changed since the previous frame. The primitives of a frame are
+     * compared with those drawn at the same place of the previous one, and the bounds of those that differ, before and after,
+     * are merged into a few disjoint pixel rects. Pixels outside of them are covered by the same primitives in the same order
+     * as before, so a back buffer that kept the previous frame only has to be redrawn inside them
+    */
+    class DirtyRegion {
+    public:
+        static constexpr size_t MAX_RECTS    = 8;    // rects the changes are merged into, the pair adding the least area is merged past it
+        static constexpr float  PADDING      = 1.f;  // pixels a changed primitive is grown by, covering rasterization at its edges
+        static constexpr float  MAX_COVERAGE = 0.5f; // share of the screen the rects can cover before the frame is drawn whole
+
+        /**
+         * @brief The constructor for the DirtyRegion class
+        */
+        FORCEINLINE DirtyRegion() : m_current{}, m_previous{}, m_rects{}, m_screen_size{}, m_valid{}, m_full{ true } {
+
+        }
+
+        /**
+         * @brief This function starts collecting the primitives of a frame
+        */
+        FORCEINLINE void begin_frame() {
+            m_current.clear();
+        }
+
+        /**
+         * @brief This function adds the next primitive of the frame in the order it is drawn
+         * @param bounds screen bounds
+         * @param key hash of what the primitive draws, including its bounds
+        */
+        FORCEINLINE void add( const ClipRect_t &bounds, const uint64_t key ) {
+            m_current.push_back( { bounds, key } );
+        }
+
+        /**
+         * @brief This function compares the frame with the previous one and merges the changes into rects, the frame becomes the previous one
+         * @param screen_size screen size of the frame
+         * @param complete every primitive of the frame was added, so the next frame can be compared with it
+         * @param redraw the frame has to be drawn whole regardless, like when the texels it samples changed
+        */
+        NOINLINE void update( const Vector2 &screen_size, const bool complete, const bool redraw );
+
+        /**
+         * @brief This function forgets the previous frame, for when it was not drawn, so the next one is drawn whole
+        */
+        FORCEINLINE void invalidate() {
+            m_valid = false;
+        }
+
+        /**
+         * @brief This function returns the rects that changed
+         * @return disjoint pixel rects, empty if the frame is drawn whole or nothing changed
+        */
+        FORCEINLINE const std::vector< ClipRect_t > &rects() const {
+            return m_rects;
+        }
+
+        /**
+         * @brief This function checks if the frame has to be drawn whole
+         * @return true, if drawn whole. false, if only the rects have to be redrawn
+        */
+        FORCEINLINE bool full() const {
+            return m_full;
+        }
+
+    private:
+        /**
+         * @brief This struct holds a primitive of a frame
+        */
+        struct DirtyPrimitive_t {
+            ClipRect_t m_bounds; // screen bounds
+            uint64_t   m_key;    // hash of what the primitive draws
+        };
+
+        std::vector< DirtyPrimitive_t > m_current;     // primitives of the frame
+        std::vector< DirtyPrimitive_t > m_previous;    // primitives of the previous frame
+        std::vector< ClipRect_t >       m_rects;       // disjoint rects that changed
+        Vector2                         m_screen_size; // screen size of the previous frame
+        bool                            m_valid;       // the previous frame was drawn and all of its primitives are known
+        bool                            m_full;        // the frame is drawn whole
+
+        /**
+         * @brief This function adds the bounds of a changed primitive, grown to whole pixels and cut to the screen
+         * @param bounds screen bounds
+        */
+        NOINLINE void add_changed( const ClipRect_t &bounds );
+
+        /**
+         * @brief This function inserts a rect, absorbing the rects it overlaps so they stay disjoint
+         * @param rect pixel rect
+        */
+        NOINLINE void insert( ClipRect_t rect );
+    };
+}
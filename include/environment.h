@@ -2,6 +2,10 @@
 
 #include "includes.h"
 #include "renderer.h"
+#include "d3d11_backend.h"
+#include "frame_queue.h"
+
+#include <thread>
 
 namespace dx {
     /**
@@ -12,7 +16,7 @@ namespace dx {
         /**
          * @brief The constructor for the Environment class
         */
-        FORCEINLINE Environment() : m_wnd{}, m_swapchain{}, m_render_target{}, m_dev_ctx{}, m_dev{}, m_renderer{} {
+        FORCEINLINE Environment() : m_wnd{}, m_swapchain{}, m_swapchain1{}, m_render_target{}, m_dev_ctx{}, m_dev{}, m_backend{}, m_renderer{}, m_frames{ FRAME_DEPTH }, m_producer{} {
 
         }
 
@@ -44,12 +48,15 @@ namespace dx {
         static constexpr size_t WND_WIDTH  = 640; // window start width
         static constexpr size_t WND_HEIGHT = 480; // window start height
 
+        static constexpr size_t FRAME_DEPTH = 2; // frames recorded ahead of the submission
+
         HWND m_wnd; // window handle
 
         /**
          * @brief directx
         */
         IDXGISwapChain         *m_swapchain;     // directx swapchain interface
+        IDXGISwapChain1        *m_swapchain1;    // directx swapchain interface presenting dirty rects, nullptr before dxgi 1.2
         ID3D11RenderTargetView *m_render_target; // directx rendertarget
         ID3D11DeviceContext    *m_dev_ctx;       // directx device context
         ID3D11Device           *m_dev;           // directx device
@@ -57,7 +64,14 @@ namespace dx {
         /**
          * @brief renderer
         */
-        Renderer m_renderer; // directx renderer
+        D3D11Backend m_backend;  // directx renderer backend
+        Renderer     m_renderer; // directx renderer
+
+        /**
+         * @brief frame pipeline
+        */
+        FrameQueue  m_frames;   // frames recorded by the producer thread
+        std::thread m_producer; // records the next frame while the current one is submitted
 
         /**
          * @brief This function creates the win32 window for the directx environment
@@ -81,6 +95,16 @@ namespace dx {
         */
         NOINLINE void destroy_directx();
 
+        /**
+         * @brief This function presents the back buffer, only the dirty rects when the frame was redrawn in them
+        */
+        NOINLINE void present();
+
+        /**
+         * @brief This function records frames into the frame queue until it is closed, run on the producer thread
+        */
+        NOINLINE void record_frames();
+
         /**
          * @brief This function handles the window callback messages
          * @param wnd current window instance
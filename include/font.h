@@ -0,0 +1,72 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    class BakedFont;
+
+    /**
+     * @brief This struct holds a rasterized glyph and its placement relative to the pen
+    */
+    struct Glyph_t {
+        uint32_t                m_width;    // bitmap width in pixels, zero for blank glyphs
+        uint32_t                m_height;   // bitmap height in pixels
+        float                   m_offset_x; // left edge relative to the pen
+        float                   m_offset_y; // top edge relative to the top of the line
+        float                   m_advance;  // horizontal pen advance
+        std::vector< uint32_t > m_pixels;   // tightly packed rgba8 rows, white with the coverage in alpha
+    };
+
+    /**
+     * @brief This class contains the interface of a font the text cache rasterizes glyphs from
+    */
+    class Font {
+    public:
+        /**
+         * @brief The virtual destructor for the Font class
+        */
+        virtual ~Font() = default;
+
+        /**
+         * @brief This function rasterizes a glyph
+         * @param codepoint unicode codepoint
+         * @param size font size in pixels
+         * @param glyph output glyph
+         * @return true, if the font has the glyph. false, otherwise
+        */
+        virtual bool rasterize( const uint32_t codepoint, const float size, Glyph_t &glyph ) = 0;
+
+        /**
+         * @brief This function returns the distance between the tops of two lines
+         * @param size font size in pixels
+         * @return line height in pixels
+        */
+        virtual float line_height( const float size ) = 0;
+
+        /**
+         * @brief This function returns the font as a baked distance field font, its glyphs are drawn from its own pages instead of the atlas
+         * @return baked font, or nullptr if the glyphs are rasterized
+        */
+        virtual BakedFont *baked() {
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief This class contains the built-in 8x8 bitmap font covering printable ascii. Glyphs are box-filtered
+     * to the requested size, so it needs no font files and rasterizes the same on every platform
+    */
+    class BitmapFont : public Font {
+    public:
+        static constexpr uint32_t CELL_SIZE = 8;   // glyph cell width and height in font texels
+        static constexpr uint32_t FIRST     = 32;  // first codepoint of the font
+        static constexpr uint32_t LAST      = 126; // last codepoint of the font
+
+        NOINLINE bool rasterize( const uint32_t codepoint, const float size, Glyph_t &glyph ) override;
+
+        NOINLINE float line_height( const float size ) override;
+
+    private:
+        static constexpr uint32_t SUPERSAMPLES = 4; // samples per pixel and axis the cells are filtered with
+    };
+}
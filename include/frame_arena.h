@@ -0,0 +1,218 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    /**
+     * @brief This class contains the interface of the allocator a recording context takes its render list and tessellation scratch from.
+     * Everything allocated in a frame is released at once when the render list is cleared, so an allocator is free to ignore deallocations.
+     * An allocator serves one context, which is recorded by one thread at a time
+    */
+    class FrameAllocator {
+    public:
+        /**
+         * @brief The virtual destructor for the FrameAllocator class
+        */
+        virtual ~FrameAllocator() = default;
+
+        /**
+         * @brief This function allocates storage that lives until the next reset
+         * @param size size in bytes
+         * @param alignment alignment in bytes, a power of two
+         * @return storage
+        */
+        virtual void *allocate( const size_t size, const size_t alignment ) = 0;
+
+        /**
+         * @brief This function gives storage back before the reset, such as the old storage of a vector that grew
+         * @param ptr storage
+         * @param size size in bytes
+        */
+        virtual void deallocate( void *ptr, const size_t size ) = 0;
+
+        /**
+         * @brief This function releases everything allocated since the last reset, nothing allocated may be used afterwards
+        */
+        virtual void reset() = 0;
+
+        /**
+         * @brief This function returns the bytes allocated since the last reset, the high-water mark of the frame
+         * @return used bytes
+        */
+        virtual size_t used() const = 0;
+    };
+
+    /**
+     * @brief This class contains the linear arena a recording context allocates from by default. Allocations are bumped
+     * off one block and released all at once by moving the cursor back to its start. A frame that runs out adds blocks
+     * of its own, which the reset folds into one block holding the largest frame so far, so later frames allocate nothing from the heap
+    */
+    class FrameArena final : public FrameAllocator {
+    public:
+        static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024; // bytes of the first block, and of the least block added when it runs out
+
+        /**
+         * @brief The constructor for the FrameArena class, the first block is allocated when first needed
+        */
+        FORCEINLINE FrameArena() : m_block{}, m_capacity{}, m_overflow{}, m_cursor{}, m_end{}, m_used{}, m_high_water{} {
+
+        }
+
+        FrameArena( const FrameArena & ) = delete;
+        FrameArena &operator=( const FrameArena & ) = delete;
+
+        /**
+         * @brief This function bumps storage off the current block, adding a block if it does not fit
+         * @param size size in bytes
+         * @param alignment alignment in bytes, a power of two
+         * @return storage
+        */
+        FORCEINLINE void *allocate( const size_t size, const size_t alignment ) override {
+            const uintptr_t start = ( ( uintptr_t ) m_cursor + alignment - 1 ) & ~( uintptr_t ) ( alignment - 1 );
+
+            if ( !m_end || start + size > ( uintptr_t ) m_end )
+                return grow( size, alignment );
+
+            m_used  += start + size - ( uintptr_t ) m_cursor;
+            m_cursor = ( std::byte * ) ( start + size );
+
+            return ( void * ) start;
+        }
+
+        /**
+         * @brief This function ignores a deallocation, the storage is released by the reset along with the rest of the frame
+        */
+        FORCEINLINE void deallocate( void *, const size_t ) override {
+
+        }
+
+        /**
+         * @brief This function moves the cursor back to the start of the block, folding the blocks the frame added into one first
+        */
+        NOINLINE void reset() override;
+
+        /**
+         * @brief This function returns the bytes allocated since the last reset, including alignment padding
+         * @return used bytes
+        */
+        FORCEINLINE size_t used() const override {
+            return m_used;
+        }
+
+        /**
+         * @brief This function returns the largest number of bytes a frame has used
+         * @return high-water mark in bytes
+        */
+        FORCEINLINE size_t high_water() const {
+            return m_high_water;
+        }
+
+        /**
+         * @brief This function returns the size of the block frames are allocated from
+         * @return capacity in bytes
+        */
+        FORCEINLINE size_t capacity() const {
+            return m_capacity;
+        }
+
+    private:
+        std::unique_ptr< std::byte[] >                m_block;      // block frames are allocated from
+        size_t                                        m_capacity;   // size of the block
+        std::vector< std::unique_ptr< std::byte[] > > m_overflow;   // blocks added since the last reset when the block ran out
+        std::byte                                     *m_cursor;    // next free byte of the current block
+        std::byte                                     *m_end;       // end of the current block
+        size_t                                        m_used;       // bytes allocated since the last reset
+        size_t                                        m_high_water; // largest number of bytes a frame used
+
+        /**
+         * @brief This function adds a block the allocation fits in and allocates from it
+         * @param size size in bytes
+         * @param alignment alignment in bytes, a power of two
+         * @return storage
+        */
+        NOINLINE void *grow( const size_t size, const size_t alignment );
+    };
+
+    /**
+     * @brief This class contains the standard allocator adapter containers use to allocate from a frame allocator.
+     * Without a frame allocator it allocates from the heap. The frame allocator moves along with the storage
+     * when containers are assigned or swapped, so storage is always given back to where it came from
+    */
+    template< class T >
+    class ArenaAllocator {
+    public:
+        using value_type                             = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        /**
+         * @brief The constructor for the ArenaAllocator class
+         * @param allocator frame allocator, or nullptr to allocate from the heap
+        */
+        FORCEINLINE ArenaAllocator( FrameAllocator *allocator = nullptr ) : m_allocator{ allocator } {
+
+        }
+
+        /**
+         * @brief The converting constructor for the ArenaAllocator class
+         * @param other allocator of another type
+        */
+        template< class U >
+        FORCEINLINE ArenaAllocator( const ArenaAllocator< U > &other ) : m_allocator{ other.allocator() } {
+
+        }
+
+        /**
+         * @brief This function allocates storage for elements
+         * @param count element count
+         * @return storage
+        */
+        FORCEINLINE T *allocate( const size_t count ) {
+            if ( !m_allocator )
+                return std::allocator< T >{}.allocate( count );
+
+            return static_cast< T * >( m_allocator->allocate( sizeof( T ) * count, alignof( T ) ) );
+        }
+
+        /**
+         * @brief This function gives storage back
+         * @param ptr storage
+         * @param count element count
+        */
+        FORCEINLINE void deallocate( T *ptr, const size_t count ) {
+            if ( !m_allocator )
+                std::allocator< T >{}.deallocate( ptr, count );
+
+            else
+                m_allocator->deallocate( ptr, sizeof( T ) * count );
+        }
+
+        /**
+         * @brief This function returns the frame allocator
+         * @return frame allocator, or nullptr if allocated from the heap
+        */
+        FORCEINLINE FrameAllocator *allocator() const {
+            return m_allocator;
+        }
+
+        /**
+         * @brief This function checks if two allocators allocate from the same place, so one can give back the storage of the other
+         * @param other allocator
+         * @return true, if equal. false, otherwise
+        */
+        template< class U >
+        FORCEINLINE bool operator==( const ArenaAllocator< U > &other ) const {
+            return m_allocator == other.allocator();
+        }
+
+    private:
+        FrameAllocator *m_allocator; // frame allocator, or nullptr
+    };
+
+    /**
+     * @brief This alias holds a vector allocated from a frame allocator
+    */
+    template< class T >
+    using FrameVector = std::vector< T, ArenaAllocator< T > >;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    /**
+     * @brief This class contains a 64-bit hash built up while a frame is recorded, so an unchanged frame can be found
+     * without comparing its contents. Ranges are folded eight bytes per multiply into four independent lanes, so the
+     * multiplies of a range overlap. The hash depends on the order of its input
+    */
+    class FrameHash {
+    public:
+        /**
+         * @brief The constructor for the FrameHash class
+        */
+        FORCEINLINE FrameHash() : m_lanes{ SEEDS } {
+
+        }
+
+        /**
+         * @brief This function resets the hash to an empty one
+        */
+        FORCEINLINE void clear() {
+            m_lanes = SEEDS;
+        }
+
+        /**
+         * @brief This function adds a 64-bit word
+         * @param word word
+        */
+        FORCEINLINE void add( const uint64_t word ) {
+            m_lanes[ 0 ] = mix( m_lanes[ 0 ], word );
+        }
+
+        /**
+         * @brief This function adds a range of bytes
+         * @param data bytes
+         * @param size byte count
+        */
+        FORCEINLINE void add( const void *data, const size_t size ) {
+            const auto *bytes = ( const uint8_t * ) data;
+            size_t     i{};
+            uint64_t   words[ LANES ];
+
+            for ( ; i + sizeof( words ) <= size; i += sizeof( words ) ) {
+                memcpy( words, bytes + i, sizeof( words ) );
+
+                for ( size_t lane{}; lane < LANES; ++lane )
+                    m_lanes[ lane ] = mix( m_lanes[ lane ], words[ lane ] );
+            }
+
+            for ( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) ) {
+                memcpy( words, bytes + i, sizeof( uint64_t ) );
+                add( words[ 0 ] );
+            }
+
+            // the tail is padded with zeroes and tagged with its length
+            if ( i < size ) {
+                words[ 0 ] = 0;
+                memcpy( words, bytes + i, size - i );
+                add( words[ 0 ] ^ ( uint64_t ) ( size - i ) << 56 );
+            }
+        }
+
+        /**
+         * @brief This function returns the hash
+         * @return 64-bit hash
+        */
+        FORCEINLINE uint64_t value() const {
+            uint64_t hash = m_lanes[ 0 ];
+
+            for ( size_t lane{ 1 }; lane < LANES; ++lane )
+                hash = mix( hash, m_lanes[ lane ] );
+
+            // spread the last words over every bit
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+
+            return hash;
+        }
+
+    private:
+        static constexpr size_t   LANES      = 4;                     // independent lanes ranges are folded into
+        static constexpr uint64_t MULTIPLIER = 0x9e3779b97f4a7c15ull; // odd multiplier spreading each word over the lane
+
+        static constexpr std::array< uint64_t, LANES > SEEDS = { 0x243f6a8885a308d3ull, 0x13198a2e03707344ull, 0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull }; // lanes of an empty hash
+
+        std::array< uint64_t, LANES > m_lanes; // hash of the input so far, per lane
+
+        /**
+         * @brief This function folds a word into a lane, the rotation carries the high bits of the product back down
+         * @param lane lane
+         * @param word word
+         * @return new lane
+        */
+        FORCEINLINE static uint64_t mix( const uint64_t lane, const uint64_t word ) {
+            const uint64_t product = ( lane ^ word ) * MULTIPLIER;
+
+            return product << 31 | product >> 33;
+        }
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "includes.h"
+#include "record_context.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace dx {
+    /**
+     * @brief This struct holds the stage timings of the frames handed through a frame queue. The producer records while the
+     * render thread submits the previous frames, so with overlap the wall time is less than the recording and submission added
+    */
+    struct FrameQueueStats_t {
+        size_t m_frames;           // submitted frames
+        double m_record_ns;        // time spent recording, from begin_record to end_record
+        double m_submit_ns;        // time spent submitting, from acquire to release
+        double m_producer_wait_ns; // time the producer was blocked on a full queue
+        double m_consumer_wait_ns; // time the render thread was blocked on an empty queue
+        double m_latency_ns;       // time recorded frames waited in the queue before being acquired
+        double m_wall_ns;          // time from the first begin_record to the last release
+
+        /**
+         * @brief This function returns the share of the shorter stage that overlapped the other one
+         * @return overlap from zero, strictly sequential, to one, fully hidden
+        */
+        FORCEINLINE double overlap() const {
+            const double shorter = std::min( m_record_ns, m_submit_ns );
+
+            return shorter > 0.0 ? std::clamp( ( m_record_ns + m_submit_ns - m_wall_ns ) / shorter, 0.0, 1.0 ) : 0.0;
+        }
+    };
+
+    /**
+     * @brief This class contains a queue of frames recorded ahead of the render thread. A producer thread records frame
+     * N + 1 into one of its contexts while the render thread uploads and submits frame N, the producer blocks once
+     * every frame is recorded but not yet submitted. Frames are submitted in the order they were recorded
+    */
+    class FrameQueue {
+    public:
+        static constexpr size_t MAX_DEPTH = 8; // largest number of frames in flight
+
+        /**
+         * @brief The constructor for the FrameQueue class
+         * @param depth frames in flight, one records and submits in lockstep, two or three overlap recording with submission
+         * @param layer layer the frames are drawn in
+        */
+        NOINLINE FrameQueue( const size_t depth = 2, const int32_t layer = 0 );
+
+        /**
+         * @brief This function waits for a free frame and starts recording it, called by the producer thread
+         * @return context to record the frame to, or nullptr if the queue was closed
+        */
+        NOINLINE RecordContext *begin_record();
+
+        /**
+         * @brief This function hands the frame being recorded to the render thread
+        */
+        NOINLINE void end_record();
+
+        /**
+         * @brief This function waits for the oldest recorded frame, called by the render thread
+         * @return recorded frame, or nullptr if the queue was closed and every frame was submitted
+        */
+        NOINLINE RecordContext *acquire();
+
+        /**
+         * @brief This function returns the acquired frame to the producer once it was submitted
+        */
+        NOINLINE void release();
+
+        /**
+         * @brief This function closes the queue, waking the threads blocked on it. Frames already recorded are still acquired
+        */
+        NOINLINE void close();
+
+        /**
+         * @brief This function returns the number of frames in flight
+         * @return depth
+        */
+        FORCEINLINE size_t depth() const {
+            return m_depth;
+        }
+
+        /**
+         * @brief This function returns the stage timings since the queue was created or its stats were reset
+         * @return stats
+        */
+        NOINLINE FrameQueueStats_t stats();
+
+        /**
+         * @brief This function resets the stage timings
+        */
+        NOINLINE void reset_stats();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief This struct holds a frame of the queue
+        */
+        struct Frame_t {
+            std::unique_ptr< RecordContext > m_context;  // context the frame is recorded to
+            Clock::time_point                m_recorded; // time the recording ended
+        };
+
+        size_t                  m_depth;               // frames in flight
+        Frame_t                 m_frames[ MAX_DEPTH ]; // frames, used in turn
+        size_t                  m_recorded;            // frames handed to the render thread
+        size_t                  m_acquired;            // frames acquired by the render thread
+        size_t                  m_released;            // frames submitted and returned to the producer
+        bool                    m_closed;              // the queue was closed
+        std::mutex              m_mutex;               // guards the counters and the stats
+        std::condition_variable m_free;                // signaled when a frame is released or the queue is closed
+        std::condition_variable m_ready;               // signaled when a frame is recorded or the queue is closed
+
+        FrameQueueStats_t m_stats;        // stage timings
+        Clock::time_point m_record_start; // time the current recording started
+        Clock::time_point m_submit_start; // time the current submission started
+        Clock::time_point m_first;        // time the first recording started
+        bool              m_started;      // a frame was recorded since the stats were reset
+
+        /**
+         * @brief This function returns the nanoseconds between two points in time
+         * @param start start time
+         * @param end end time
+         * @return nanoseconds
+        */
+        FORCEINLINE static double elapsed( const Clock::time_point start, const Clock::time_point end ) {
+            return std::chrono::duration< double, std::nano >( end - start ).count();
+        }
+    };
+}
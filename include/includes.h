@@ -1,12 +1,22 @@
 #pragma once
 
+//
+// platform
+//
+#if defined( _WIN32 )
+#define DX_PLATFORM_WINDOWS
+#endif
+
+#if defined( _MSC_VER )
 #pragma comment ( lib, "d3d11.lib"  )
 #pragma comment ( lib, "d3dx11.lib" )
 #pragma comment ( lib, "d3dx10.lib" )
+#endif
 
 //
 // macros
 //
+#ifdef DX_PLATFORM_WINDOWS
 #define VC_EXTRALEAN
 #define WIN32_LEAN_AND_MEAN
 #define _HAS_EXCEPTIONS 0
@@ -18,6 +28,11 @@
 
 #define NOINLINE __declspec( noinline )
 #define EXPORT __declspec( dllexport )
+#else
+#define FORCEINLINE inline __attribute__( ( always_inline ) )
+#define NOINLINE __attribute__( ( noinline ) )
+#define EXPORT __attribute__( ( visibility( "default" ) ) )
+#endif
 
 //
 // types
@@ -27,19 +42,36 @@ using ulong_t = unsigned long;
 //
 // windows and stl
 //
+#ifdef DX_PLATFORM_WINDOWS
 #include <Windows.h>
+#endif
 
 #include <cstdint>
+#include <cstring>
+#include <cmath>
 #include <array>
 #include <utility>
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <numbers>
+#include <span>
+
+//
+// simd, sse2 is part of every x64 target and the other targets take the scalar paths
+//
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define DX_SSE2
+#include <emmintrin.h>
+#endif
 
 //
 // directx
 //
+#ifdef DX_PLATFORM_WINDOWS
 #include <d3d11.h>
+#include <dxgi1_2.h>
 #include <d3dx11.h>
 #include <d3dx10.h>
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    /**
+     * @brief This class contains a read-only memory mapping of a file. The operating system pages the file in
+     * on first access, so bytes that are never read are never loaded
+    */
+    class MappedFile {
+    public:
+        /**
+         * @brief The constructor for the MappedFile class
+        */
+#ifdef DX_PLATFORM_WINDOWS
+        FORCEINLINE MappedFile() : m_data{}, m_size{}, m_file{ INVALID_HANDLE_VALUE }, m_mapping{} {
+
+        }
+#else
+        FORCEINLINE MappedFile() : m_data{}, m_size{} {
+
+        }
+#endif
+
+        /**
+         * @brief The destructor for the MappedFile class, it unmaps the file
+        */
+        FORCEINLINE ~MappedFile() {
+            close();
+        }
+
+        MappedFile( const MappedFile & )             = delete;
+        MappedFile &operator=( const MappedFile & ) = delete;
+
+        /**
+         * @brief This function maps a file, unmapping the previous one
+         * @param path file path
+         * @return true, if mapped. false, otherwise
+        */
+        NOINLINE bool open( const char *path );
+
+        /**
+         * @brief This function unmaps the file
+        */
+        NOINLINE void close();
+
+        /**
+         * @brief This function returns the mapped bytes
+         * @return file contents, empty if no file is mapped
+        */
+        FORCEINLINE std::span< const uint8_t > data() const {
+            return { m_data, m_size };
+        }
+
+    private:
+        const uint8_t *m_data; // first mapped byte
+        size_t        m_size;  // mapped byte count
+
+#ifdef DX_PLATFORM_WINDOWS
+        HANDLE m_file;    // file handle
+        HANDLE m_mapping; // file mapping handle
+#endif
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "includes.h"
+#include "backend.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds the counters of the work submitted to a backend
+    */
+    struct BackendStats_t {
+        size_t m_frames;            // frame count
+        size_t m_draw_calls;        // draw call count
+        size_t m_scissors;          // clip rect changes
+        size_t m_indices;           // drawn index count
+        size_t m_instances;         // drawn shape instance count
+        size_t m_meshes;            // created unit meshes
+        size_t m_textures;          // created textures
+        size_t m_texture_bytes;     // bytes written to textures
+        size_t m_discard_maps;      // maps discarding the buffer
+        size_t m_no_overwrite_maps; // maps appending to the buffer
+        size_t m_resizes;           // buffer recreations
+        size_t m_statics;           // created static geometry
+        size_t m_static_bytes;      // bytes written to static geometry
+        size_t m_static_binds;      // static geometry bound for drawing
+        size_t m_updates;           // ranges written to the persistent buffers
+        size_t m_update_bytes;      // bytes written to the persistent buffers
+    };
+
+    /**
+     * @brief This class contains a backend without a graphics api, it maps system memory and counts the submitted work.
+     * It allows the renderer to be recorded and measured with no gpu present
+    */
+    class NullBackend : public Backend {
+    public:
+        /**
+         * @brief The constructor for the NullBackend class
+         * @param screen_size reported render target size
+        */
+        FORCEINLINE NullBackend( const Vector2 &screen_size = { 640.f, 480.f } ) : m_screen_size{ screen_size }, m_stats{}, m_vertex_memory{}, m_index_memory{}, m_instance_memory{} {
+
+        }
+
+        NOINLINE void destroy() override;
+
+        NOINLINE Vector2 get_screen_size() override;
+
+        NOINLINE bool begin() override;
+
+        NOINLINE void end() override;
+
+        NOINLINE bool resize( BufferType type, const size_t size ) override;
+
+        NOINLINE void *map( BufferType type, MapMode mode ) override;
+
+        NOINLINE void unmap( BufferType type ) override;
+
+        NOINLINE void draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) override;
+
+        NOINLINE void set_scissor( const ClipRect_t *clip ) override;
+
+        NOINLINE bool create_mesh( const uint32_t mesh, std::span< const Vector2 > vertices, std::span< const uint16_t > indices ) override;
+
+        NOINLINE void draw_instanced( const uint32_t mesh, const size_t index_count, const size_t instance_count, const size_t start_instance ) override;
+
+        NOINLINE bool create_texture( const uint32_t texture, const uint32_t width, const uint32_t height ) override;
+
+        NOINLINE void update_texture( const uint32_t texture, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) override;
+
+        NOINLINE bool create_distance_texture( const uint32_t texture, const uint32_t width, const uint32_t height, std::span< const uint8_t > distances ) override;
+
+        NOINLINE bool create_static( const uint32_t geometry, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) override;
+
+        NOINLINE void destroy_static( const uint32_t geometry ) override;
+
+        NOINLINE void set_static( const uint32_t geometry, const Vector2 &translation ) override;
+
+        NOINLINE bool resize_persistent( BufferType type, const size_t size ) override;
+
+        NOINLINE void update_persistent( BufferType type, const size_t offset, std::span< const uint8_t > bytes ) override;
+
+        NOINLINE void set_persistent( const bool persistent ) override;
+
+        /**
+         * @brief This function returns the accumulated submission counters
+         * @return submission counters
+        */
+        FORCEINLINE const BackendStats_t &stats() const {
+            return m_stats;
+        }
+
+        /**
+         * @brief This function resets the accumulated submission counters
+        */
+        FORCEINLINE void reset_stats() {
+            m_stats = {};
+        }
+
+    private:
+        Vector2        m_screen_size; // reported render target size
+        BackendStats_t m_stats;       // submission counters
+
+        std::vector< uint8_t > m_vertex_memory;   // system memory standing in for the vertex buffer
+        std::vector< uint8_t > m_index_memory;    // system memory standing in for the index buffer
+        std::vector< uint8_t > m_instance_memory; // system memory standing in for the instance buffer
+
+        /**
+         * @brief This function returns the system memory of a buffer type
+         * @param type buffer type
+         * @return buffer memory
+        */
+        FORCEINLINE std::vector< uint8_t > &memory( BufferType type ) {
+            return type == BufferType::VERTEX ? m_vertex_memory : type == BufferType::INDEX ? m_index_memory : m_instance_memory;
+        }
+    };
+}
@@ -0,0 +1,608 @@
+#pragma once
+
+#include "includes.h"
+#include "vertex.h"
+#include "render_list.h"
+#include "unit_circle.h"
+#include "sdf.h"
+#include "stroke.h"
+#include "vector_array.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds the counters of the last flushed frame. The rejection rate of the clip rects
+     * is the share of rejected primitives
+    */
+    struct RenderStats_t {
+        size_t m_vertices;       // uploaded vertex count
+        size_t m_indices;        // uploaded index count
+        size_t m_uploaded_bytes; // uploaded vertex and index bytes
+        size_t m_instances;      // uploaded shape instance count
+        size_t m_chunks;         // ring uploads the frame was split into
+        size_t m_draw_calls;     // draw call count
+        size_t m_texture_bytes;  // image bytes written to the atlas
+        size_t m_primitives;     // recorded primitive count, including the rejected ones
+        size_t m_rejected;       // primitives outside of the clip rect, dropped before tessellation
+        size_t m_clipped;        // rects, sprites, and strings crossing the clip rect, cut on the cpu
+        size_t m_scissored;      // other primitives crossing the clip rect, recorded into scissored batches
+        size_t m_scissors;       // clip rect changes between draws
+        size_t m_static_draws;   // static geometry draws, drawn without uploading
+        size_t m_unchanged;      // one if the frame was the same as the last one drawn and was not uploaded or drawn again
+        size_t m_diffed_bytes;   // bytes the diffed upload compared against the previous frame
+        size_t m_saved_bytes;    // compared bytes that were the same and not uploaded
+        size_t m_updates;        // ranges the diffed upload wrote
+        size_t m_diff_fallbacks; // diffed ranges with more changed blocks than the frame had writes left, written as one range
+        size_t m_diff_ns;        // nanoseconds spent comparing and writing the changed ranges
+        size_t m_dirty_rects;    // rects redrawn while only the regions that changed are redrawn, zero if drawn whole
+        size_t m_dirty_pixels;   // pixels of the redrawn rects
+        size_t m_region_ns;      // nanoseconds spent comparing the primitives and merging the regions that changed
+        size_t m_merged;         // batches merged into others once sorted
+        size_t m_sort_ns;        // nanoseconds spent sorting and merging the batches
+        size_t m_arena_bytes;    // bytes the render lists and the tessellation scratch took from the frame allocators, their high-water mark of the frame
+    };
+
+    /**
+     * @brief This struct holds a filled rectangle drawn in bulk
+    */
+    struct RectInstance_t {
+        Vector2 m_pos;   // position
+        Vector2 m_size;  // dimensions
+        Color   m_color; // rgba color
+    };
+
+    /**
+     * @brief This struct holds a line drawn in bulk
+    */
+    struct LineInstance_t {
+        Vector2 m_start; // start position
+        Vector2 m_end;   // end position
+        Color   m_color; // rgba color
+    };
+
+    /**
+     * @brief This struct holds a filled circle drawn in bulk
+    */
+    struct CircleInstance_t {
+        Vector2 m_pos;    // center position
+        float   m_radius; // circle radius
+        Color   m_color;  // rgba color
+    };
+
+    /**
+     * @brief This class contains a recording context, it owns a render list and tessellates the shapes drawn to it.
+     * The renderer is a context itself, additional contexts are created by the renderer so other threads can record
+     * without locks. Each context is recorded by one thread at a time, recording has to finish before the renderer performs
+    */
+    class RecordContext {
+    public:
+        /**
+         * @brief The constructor for the RecordContext class
+         * @param layer layer the render list is drawn in
+        */
+        FORCEINLINE RecordContext( const int32_t layer = 0 ) : m_arena{}, m_allocator{ &m_arena }, m_render_list{ &m_arena }, m_unit_circles{}, m_instancing{}, m_recorded{},
+            m_clip_stack{}, m_clip{ Batch_t::NO_CLIP }, m_layer{ layer } {
+
+        }
+
+        /**
+         * @brief The virtual destructor for the RecordContext class
+        */
+        virtual ~RecordContext() = default;
+
+        /**
+         * @brief This function returns the layer the render list is drawn in, lists are drawn in increasing layer
+         * and lists of the same layer in the order their contexts were created, the renderer first
+         * @return layer
+        */
+        FORCEINLINE int32_t layer() const {
+            return m_layer;
+        }
+
+        /**
+         * @brief This function sets the allocator the render list and the tessellation scratch are allocated from, it is reset when the render list
+         * is cleared after the frame was drawn. It has to be set between frames and serve this context alone
+         * @param allocator frame allocator, or nullptr for the arena of the context
+        */
+        FORCEINLINE void set_allocator( FrameAllocator *allocator ) {
+            m_allocator = allocator ? allocator : &m_arena;
+
+            m_render_list.set_allocator( m_allocator );
+        }
+
+        /**
+         * @brief This function returns the allocator the render list and the tessellation scratch are allocated from
+         * @return frame allocator
+        */
+        FORCEINLINE FrameAllocator *allocator() const {
+            return m_allocator;
+        }
+
+        /**
+         * @brief This function sets whether filled rects, thick lines, and filled circles and ellipses are recorded
+         * as shape instances expanded on the gpu instead of tessellated vertices
+         * @param instancing record shape instances
+        */
+        FORCEINLINE void set_instancing( const bool instancing ) {
+            m_instancing = instancing;
+        }
+
+        /**
+         * @brief This function returns whether shapes are recorded as instances
+         * @return true, if instanced. false, otherwise
+        */
+        FORCEINLINE bool instancing() const {
+            return m_instancing;
+        }
+
+        /**
+         * @brief This function pushes a clip rect, primitives recorded until it is popped are clipped to its intersection with the current one.
+         * Primitives outside of it are rejected before they are tessellated, rects, sprites, and strings crossing it are cut on the cpu,
+         * and the other primitives crossing it are recorded into batches scissored to it
+         * @param pos top-left corner
+         * @param size dimensions
+        */
+        NOINLINE void push_clip_rect( const Vector2 &pos, const Vector2 &size );
+
+        /**
+         * @brief This function pops the current clip rect, restoring the one pushed before it
+        */
+        NOINLINE void pop_clip_rect();
+
+        /**
+         * @brief This function returns the current clip rect
+         * @return clip rect, or nullptr if primitives are not clipped
+        */
+        FORCEINLINE const ClipRect_t *clip_rect() const {
+            return m_clip_stack.empty() ? nullptr : &m_clip_stack.back();
+        }
+
+        /**
+         * @brief This function reserves vertices and indices at the end of the render list, custom shapes
+         * write them in place and commit them afterwards. They are scissored to the current clip rect, which also bounds them while tracked
+         * @param vertex_count number of vertices
+         * @param index_count number of indices
+         * @param topology primitive topology
+         * @param texture texture sampled by the primitives, or Batch_t::NO_TEXTURE
+         * @return writable vertices and indices, indices written have to be offset by the base index
+        */
+        FORCEINLINE Reservation_t reserve( const size_t vertex_count, const size_t index_count, Topology topology, const uint32_t texture = Batch_t::NO_TEXTURE ) {
+            track_unbounded();
+
+            return m_render_list.reserve( vertex_count, index_count, topology, texture, m_clip_stack.empty() ? Batch_t::NO_CLIP : clip_index() );
+        }
+
+        /**
+         * @brief This function commits the written part of the last reservation
+         * @param vertex_count number of written vertices
+         * @param index_count number of written indices
+        */
+        FORCEINLINE void commit( const size_t vertex_count, const size_t index_count ) {
+            m_render_list.commit( vertex_count, index_count );
+        }
+
+        /**
+         * @brief This function draws a line of specific thickness
+         * @param start start position
+         * @param end end position
+         * @param color rgba color
+         * @param thickness pixel thickness
+        */
+        NOINLINE void draw_line( const Vector2 &start, const Vector2 &end, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws a line of specific thickness
+         * @param start_x start x-position
+         * @param start_y start y-position
+         * @param end_x end x-position
+         * @param end_y end y-position
+         * @param color rgba color
+         * @param thickness pixel thickness
+        */
+        NOINLINE void draw_line( const float start_x, const float start_y, const float end_x, const float end_y, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws connected lines of specific thickness as one primitive. The segments share the vertices
+         * at their joins, so the outline has no cracks or overlaps where it bends, and the whole line is recorded into one batch
+         * @param points points the lines connect, at least two
+         * @param color rgba color
+         * @param thickness pixel thickness, a pixel thick line has no joins or caps
+         * @param join how the segments are joined
+         * @param cap how the ends are capped
+        */
+        NOINLINE void draw_polyline( std::span< const Vector2 > points, const Color &color, const float thickness = 1.f, const LineJoin join = LineJoin::MITER,
+                                     const LineCap cap = LineCap::BUTT );
+
+        /**
+         * @brief This function draws lines of the same thickness in bulk. They are tessellated into one reservation, or appended
+         * as consecutive instances, and drawn as if each was drawn on its own. While a clip rect is pushed they are scissored to it
+         * @param lines lines
+         * @param thickness pixel thickness
+        */
+        NOINLINE void draw_lines( std::span< const LineInstance_t > lines, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws a filled rectangle
+         * @param pos position
+         * @param size dimensions
+         * @param color rgba color
+        */
+        NOINLINE void draw_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &color );
+
+        /**
+         * @brief This function draws a filled rectangle
+         * @param x start x-position
+         * @param y start y-position
+         * @param w width
+         * @param h height
+         * @param color rgba color
+        */
+        NOINLINE void draw_filled_rect( const float x, const float y, const float w, const float h, const Color &color );
+
+        /**
+         * @brief This function draws filled rectangles in bulk. They are tessellated into one reservation, or appended
+         * as consecutive instances, and drawn as if each was drawn on its own
+         * @param rects rectangles
+        */
+        NOINLINE void draw_filled_rects( std::span< const RectInstance_t > rects );
+
+        /**
+         * @brief This function draws a filled rectangle
+         * @param pos position
+         * @param size dimensions
+         * @param color rgba color
+         * @param thickness pixel thickness
+        */
+        NOINLINE void draw_rect( const Vector2 &pos, const Vector2 &size, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws a filled rectangle
+         * @param x start x-position
+         * @param y start y-position
+         * @param w width
+         * @param h height
+         * @param color rgba color
+         * @param thickness pixel thickness
+        */
+        NOINLINE void draw_rect( const float x, const float y, const float w, const float h, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws an outlined filled rectangle
+         * @param pos position
+         * @param size dimensions
+         * @param fill_color inside color
+         * @param outline_color border color
+        */
+        NOINLINE void draw_outlined_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &fill_color, const Color &outline_color );
+
+        /**
+         * @brief This function draws an outlined filled rectangle
+         * @param x start x-position
+         * @param y start y-position
+         * @param w width
+         * @param h height
+         * @param fill_color inside color
+         * @param outline_color border color
+        */
+        NOINLINE void draw_outlined_filled_rect( const float x, const float y, const float w, const float h, const Color &fill_color, const Color &outline_color );
+
+        /**
+         * @brief This function draws an outlined rectangle
+         * @param pos position
+         * @param size dimensions
+         * @param fill_color inside color
+         * @param outline_color border color
+        */
+        NOINLINE void draw_outlined_rect( const Vector2 &pos, const Vector2 &size, const Color &inner_color, const Color &outline_color );
+
+        /**
+         * @brief This function draws an outlined rectangle
+         * @param x start x-position
+         * @param y start y-position
+         * @param w width
+         * @param h height
+         * @param fill_color inside color
+         * @param outline_color border color
+        */
+        NOINLINE void draw_outlined_rect( const float x, const float y, const float w, const float h, const Color &inner_color, const Color &outline_color );
+
+        /**
+         * @brief This function draws a circle
+         * @param pos position
+         * @param radius circle radius
+         * @param color rgba color
+         * @param segment_count number of circle segments
+        */
+        NOINLINE void draw_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a circle
+         * @param x start x-position
+         * @param y start y-position
+         * @param radius circle radius
+         * @param color rgba color
+         * @param segment_count number of circle segments
+        */
+        NOINLINE void draw_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a filled circle
+         * @param pos position
+         * @param radius circle radius
+         * @param color rgba color
+         * @param segment_count number of circle segments
+        */
+        NOINLINE void draw_filled_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a filled circle
+         * @param x start x-position
+         * @param y start y-position
+         * @param radius circle radius
+         * @param color rgba color
+         * @param segment_count number of circle segments
+        */
+        NOINLINE void draw_filled_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws filled circles of the same segment count in bulk. They are tessellated into one reservation, or appended
+         * as consecutive instances, and drawn as if each was drawn on its own. While a clip rect is pushed they are scissored to it
+         * @param circles circles
+         * @param segment_count number of circle segments
+        */
+        NOINLINE void draw_filled_circles( std::span< const CircleInstance_t > circles, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws an ellipse
+         * @param pos center position
+         * @param radii horizontal and vertical radius
+         * @param color rgba color
+         * @param segment_count number of ellipse segments
+        */
+        NOINLINE void draw_ellipse( const Vector2 &pos, const Vector2 &radii, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a filled ellipse
+         * @param pos center position
+         * @param radii horizontal and vertical radius
+         * @param color rgba color
+         * @param segment_count number of ellipse segments
+        */
+        NOINLINE void draw_filled_ellipse( const Vector2 &pos, const Vector2 &radii, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a circular arc
+         * @param pos center position
+         * @param radius circle radius
+         * @param start_angle start angle in radians
+         * @param sweep_angle swept angle in radians, negative sweeps clockwise
+         * @param color rgba color
+         * @param segment_count number of segments of the whole circle
+        */
+        NOINLINE void draw_arc( const Vector2 &pos, const float radius, const float start_angle, const float sweep_angle, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws a filled circular sector
+         * @param pos center position
+         * @param radius circle radius
+         * @param start_angle start angle in radians
+         * @param sweep_angle swept angle in radians, negative sweeps clockwise
+         * @param color rgba color
+         * @param segment_count number of segments of the whole circle
+        */
+        NOINLINE void draw_filled_arc( const Vector2 &pos, const float radius, const float start_angle, const float sweep_angle, const Color &color, const size_t segment_count = 32 );
+
+        /**
+         * @brief This function draws an anti-aliased rounded rectangle outline as a single signed distance quad
+         * @param pos start position
+         * @param size dimensions
+         * @param radius corner radius
+         * @param color rgba color
+         * @param thickness outline thickness, measured inwards from the edge
+        */
+        NOINLINE void draw_rounded_rect( const Vector2 &pos, const Vector2 &size, const float radius, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws an anti-aliased filled rounded rectangle as a single signed distance quad
+         * @param pos start position
+         * @param size dimensions
+         * @param radius corner radius
+         * @param color rgba color
+        */
+        NOINLINE void draw_filled_rounded_rect( const Vector2 &pos, const Vector2 &size, const float radius, const Color &color );
+
+        /**
+         * @brief This function draws an anti-aliased ring as a single signed distance quad
+         * @param pos center position
+         * @param radius outer radius
+         * @param color rgba color
+         * @param thickness ring thickness, measured inwards from the radius
+        */
+        NOINLINE void draw_smooth_circle( const Vector2 &pos, const float radius, const Color &color, const float thickness = 1.f );
+
+        /**
+         * @brief This function draws an anti-aliased filled circle as a single signed distance quad
+         * @param pos center position
+         * @param radius circle radius
+         * @param color rgba color
+        */
+        NOINLINE void draw_filled_smooth_circle( const Vector2 &pos, const float radius, const Color &color );
+
+    protected:
+        friend class Renderer;
+
+        static constexpr float  TWO_PI        = 2.f * std::numbers::pi_v< float >; // full turn in radians
+        static constexpr size_t BULK_VERTICES = Batch_t::MAX_NARROW_VERTICES;      // vertices a bulk draw reserves at a time, so its batches keep 16-bit indices
+
+        FrameArena     m_arena;       // arena the frames are allocated from unless another allocator is set
+        FrameAllocator *m_allocator;  // allocator of the render list and the tessellation scratch
+        RenderList     m_render_list; // render list
+
+        UnitCircleCache m_unit_circles; // circle tessellation tables
+
+        bool          m_instancing; // record shapes as instances
+        RenderStats_t m_recorded;   // recording counters since the last flush
+
+        std::vector< ClipRect_t > m_clip_stack; // pushed clip rects, each intersected with the one below
+        uint32_t                  m_clip;       // render list clip rect of the top of the stack, added when a batch is first scissored to it
+
+        int32_t m_layer; // layer the render list is drawn in
+
+        /**
+         * @brief This function clears the render list after it was submitted, the clip rects stay pushed
+        */
+        FORCEINLINE void reset() {
+            m_render_list.clear();
+
+            // the clip rects went with the render list, the current one is added again when next scissored to
+            m_clip = Batch_t::NO_CLIP;
+        }
+
+        /**
+         * @brief This function allocates tessellation scratch that lives until the render list is cleared
+         * @param count element count
+         * @return default constructed elements
+        */
+        template< class T >
+        FORCEINLINE T *scratch( const size_t count ) {
+            static_assert( std::is_trivially_destructible_v< T >, "scratch is released without destroying it" );
+
+            T *elements = static_cast< T * >( m_allocator->allocate( sizeof( T ) * count, alignof( T ) ) );
+
+            std::uninitialized_default_construct_n( elements, count );
+
+            return elements;
+        }
+
+        /**
+         * @brief This function returns the render list clip rect of the current clip rect, adding it when a batch is first scissored to it
+         * @return clip rect index
+        */
+        FORCEINLINE uint32_t clip_index() {
+            if ( m_clip == Batch_t::NO_CLIP )
+                m_clip = m_render_list.add_clip( m_clip_stack.back() );
+
+            return m_clip;
+        }
+
+        /**
+         * @brief This function tests the bounds of a primitive against the current clip rect, counting the recorded and the rejected primitives
+         * @param min top-left corner of the bounds
+         * @param max bottom-right corner of the bounds
+         * @param clip output clip rect the primitive crosses, nullptr if it is entirely inside
+         * @return true, if the primitive is drawn. false, if it is entirely outside
+        */
+        FORCEINLINE bool clip_test( const Vector2 &min, const Vector2 &max, const ClipRect_t *&clip ) {
+            if ( !cull_test( min, max, clip ) )
+                return false;
+
+            // the bounds of a primitive crossing the clip rect are cut to it, the scissor keeps the rest from being drawn
+            if ( m_render_list.bounded() )
+                m_render_list.set_bounds( clip ? clip->intersect( { min, max } ) : ClipRect_t{ min, max } );
+
+            return true;
+        }
+
+        /**
+         * @brief This function tests the bounds of a primitive against the current clip rect like clip_test, without bounding the render list.
+         * The shapes drawn in bulk are bounded once per reservation instead
+         * @param min top-left corner of the bounds
+         * @param max bottom-right corner of the bounds
+         * @param clip output clip rect the primitive crosses, nullptr if it is entirely inside
+         * @return true, if the primitive is drawn. false, if it is entirely outside
+        */
+        FORCEINLINE bool cull_test( const Vector2 &min, const Vector2 &max, const ClipRect_t *&clip ) {
+            ++m_recorded.m_primitives;
+
+            clip = nullptr;
+
+            if ( !m_clip_stack.empty() ) {
+                if ( m_clip_stack.back().outside( min, max ) ) {
+                    ++m_recorded.m_rejected;
+                    return false;
+                }
+
+                if ( !m_clip_stack.back().contains( min, max ) )
+                    clip = &m_clip_stack.back();
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief This function bounds the primitives committed next by the whole clip rect, for those whose bounds are not known
+        */
+        FORCEINLINE void track_unbounded() {
+            if ( m_render_list.bounded() )
+                m_render_list.set_bounds( m_clip_stack.empty() ? ClipRect_t{ { -INFINITY, -INFINITY }, { INFINITY, INFINITY } } : m_clip_stack.back() );
+        }
+
+        /**
+         * @brief This function tests the bounds of a primitive that cannot be cut on the cpu against the current clip rect
+         * @param min top-left corner of the bounds
+         * @param max bottom-right corner of the bounds
+         * @param scissor output render list clip rect the primitive is scissored to, Batch_t::NO_CLIP if it is entirely inside
+         * @return true, if the primitive is drawn. false, if it is entirely outside
+        */
+        FORCEINLINE bool scissor_test( const Vector2 &min, const Vector2 &max, uint32_t &scissor ) {
+            const ClipRect_t *clip;
+
+            if ( !clip_test( min, max, clip ) )
+                return false;
+
+            scissor = Batch_t::NO_CLIP;
+
+            if ( clip ) {
+                scissor = clip_index();
+                ++m_recorded.m_scissored;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief This function finds the unit mesh of a shape. A context cannot create meshes on the backend, so it only
+         * draws the unit quad the renderer created and tessellates the filled ellipses instead
+         * @param segment_count number of fan segments, zero for the unit quad
+         * @return mesh id, or Batch_t::NO_MESH if the mesh cannot be created
+        */
+        virtual uint32_t mesh( const size_t segment_count ) {
+            return segment_count ? Batch_t::NO_MESH : ShapeMesh_t::QUAD;
+        }
+
+        /**
+         * @brief This function adds a filled rectangle of an already packed color
+         * @param pos position
+         * @param size dimensions
+         * @param col vertex color
+        */
+        NOINLINE void add_rect( const Vector2 &pos, const Vector2 &size, const Vertex::color_t &col );
+
+        /**
+         * @brief This function bounds the shapes of a bulk reservation before they are committed, cut to the clip rect they were recorded in
+         * @param bounds union of the bounds of the shapes drawn
+        */
+        FORCEINLINE void bound_bulk( const ClipRect_t &bounds ) {
+            if ( m_render_list.bounded() )
+                m_render_list.set_bounds( m_clip_stack.empty() ? bounds : m_clip_stack.back().intersect( bounds ) );
+        }
+
+        /**
+         * @brief This function adds an elliptic arc, outlined as connected line segments or filled as a fan around the center
+         * @param pos center position
+         * @param radii horizontal and vertical radius
+         * @param start_angle start angle in radians
+         * @param sweep_angle swept angle in radians, a full turn or more draws the whole ellipse
+         * @param col vertex color
+         * @param segment_count number of segments of the whole ellipse
+         * @param filled fill the arc
+        */
+        NOINLINE void add_arc( const Vector2 &pos, const Vector2 &radii, float start_angle, float sweep_angle,
+                               const Vertex::color_t &col, const size_t segment_count, const bool filled );
+
+        /**
+         * @brief This function adds a signed distance shape instance
+         * @param shape packed shape
+        */
+        NOINLINE void add_sdf( const ShapeInstance_t &shape );
+    };
+}
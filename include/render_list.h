@@ -0,0 +1,636 @@
+#pragma once
+
+#include "includes.h"
+#include "vertex.h"
+#include "shape_instance.h"
+#include "clip_rect.h"
+#include "frame_hash.h"
+#include "frame_arena.h"
+
+namespace dx {
+    /**
+     * @brief This enum holds the platform independent primitive topologies
+    */
+    enum class Topology : uint8_t {
+        POINT_LIST,
+        LINE_LIST,
+        LINE_STRIP,
+        TRIANGLE_LIST,
+        TRIANGLE_STRIP
+    };
+
+    /**
+     * @brief This enum holds the index formats a batch is submitted with
+    */
+    enum class IndexFormat : uint8_t {
+        U16,
+        U32
+    };
+
+    /**
+     * @brief This struct holds a draw of static geometry recorded into the render list
+    */
+    struct StaticDraw_t {
+        uint32_t m_geometry;    // static geometry handle
+        Vector2  m_translation; // offset the geometry is drawn at
+    };
+
+    /**
+     * @brief This struct holds the batch of topology, index and vertex ranges. Its indices are
+     * local to the batch and offset by the base vertex when drawn. An instanced batch holds a range
+     * of shape instances drawn from a unit mesh instead, and a static batch a draw of static geometry.
+     * Consecutive primitives share a batch while they sample the same texture and are scissored to the same clip rect.
+     * Strips are expanded into lists when committed, so a batch is only ever drawn as points, lines, or triangles
+    */
+    struct Batch_t {
+        static constexpr size_t   MAX_NARROW_VERTICES = 0xffff;     // max vertex count drawn with 16-bit indices, 0xffff is the strip cut value
+        static constexpr uint32_t NO_MESH             = UINT32_MAX; // mesh of a batch drawn from its own vertices
+        static constexpr uint32_t NO_TEXTURE          = UINT32_MAX; // texture of a batch drawn with its vertex colors only
+        static constexpr uint32_t NO_CLIP             = UINT32_MAX; // clip rect of a batch drawn to the whole screen
+        static constexpr uint32_t NO_STATIC           = UINT32_MAX; // static draw of a batch drawn from the render list
+
+        Topology   m_topology;       // primitive topology
+        size_t     m_base_vertex;    // first vertex in the render list
+        size_t     m_vertex_count;   // vertex count
+        size_t     m_start_index;    // first index in the render list
+        size_t     m_index_count;    // index count
+        uint32_t   m_mesh;           // unit mesh of an instanced batch
+        size_t     m_first_instance; // first instance in the render list
+        size_t     m_instance_count; // instance count
+        uint32_t   m_texture;        // texture sampled by the batch
+        uint32_t   m_clip;           // clip rect the batch is scissored to
+        uint32_t   m_static;         // static draw of a static batch
+        ClipRect_t m_bounds;         // screen bounds of the primitives, kept while the render list is sorted
+
+        /**
+         * @brief This constructor initializes the batch with its topology and the start of its vertex and index ranges
+         * @param topology primitive topology
+         * @param base_vertex first vertex in the render list
+         * @param start_index first index in the render list
+         * @param first_instance end of the instance range of the previous batch
+         * @param texture texture sampled by the batch
+         * @param clip clip rect the batch is scissored to
+        */
+        FORCEINLINE Batch_t( Topology topology, const size_t base_vertex = 0, const size_t start_index = 0, const size_t first_instance = 0, const uint32_t texture = NO_TEXTURE,
+            const uint32_t clip = NO_CLIP ) : m_topology{ topology }, m_base_vertex{ base_vertex }, m_vertex_count{}, m_start_index{ start_index }, m_index_count{}, m_mesh{ NO_MESH },
+            m_first_instance{ first_instance }, m_instance_count{}, m_texture{ texture }, m_clip{ clip }, m_static{ NO_STATIC }, m_bounds{ { INFINITY, INFINITY }, { -INFINITY, -INFINITY } } {
+
+        }
+
+        /**
+         * @brief This constructor initializes an instanced batch with its mesh and the start of its instance range
+         * @param mesh unit mesh
+         * @param base_vertex end of the vertex range of the previous batch
+         * @param start_index end of the index range of the previous batch
+         * @param first_instance first instance in the render list
+         * @param clip clip rect the batch is scissored to
+        */
+        FORCEINLINE Batch_t( const uint32_t mesh, const size_t base_vertex, const size_t start_index, const size_t first_instance, const uint32_t clip = NO_CLIP ) :
+            m_topology{ Topology::TRIANGLE_LIST }, m_base_vertex{ base_vertex }, m_vertex_count{}, m_start_index{ start_index }, m_index_count{}, m_mesh{ mesh },
+            m_first_instance{ first_instance }, m_instance_count{}, m_texture{ NO_TEXTURE }, m_clip{ clip }, m_static{ NO_STATIC }, m_bounds{ { INFINITY, INFINITY }, { -INFINITY, -INFINITY } } {
+
+        }
+
+        /**
+         * @brief This function checks if the batch is drawn from a unit mesh
+         * @return true, if instanced. false, otherwise
+        */
+        FORCEINLINE bool instanced() const {
+            return m_mesh != NO_MESH;
+        }
+
+        /**
+         * @brief This function checks if the batch draws static geometry
+         * @return true, if static. false, otherwise
+        */
+        FORCEINLINE bool retained() const {
+            return m_static != NO_STATIC;
+        }
+
+        /**
+         * @brief This function returns the index format the batch is submitted with
+         * @return 16-bit if every local index fits, 32-bit otherwise
+        */
+        FORCEINLINE IndexFormat index_format() const {
+            return m_vertex_count <= MAX_NARROW_VERTICES ? IndexFormat::U16 : IndexFormat::U32;
+        }
+
+        /**
+         * @brief This function returns the byte size of one submitted index
+         * @return index size
+        */
+        FORCEINLINE size_t index_size() const {
+            return index_format() == IndexFormat::U16 ? sizeof( uint16_t ) : sizeof( uint32_t );
+        }
+    };
+
+    /**
+     * @brief This struct holds the writable vertices and indices reserved at the end of the render list
+    */
+    struct Reservation_t {
+        std::span< Vertex >   m_vertices;   // reserved vertices
+        std::span< uint32_t > m_indices;    // reserved indices, local to the batch
+        uint32_t              m_base_index; // index of the first reserved vertex within the batch
+    };
+
+    /**
+     * @brief This struct holds a primitive committed to the render list while tracking, the renderer compares it
+     * with the primitive drawn at the same place of the previous frame to find the regions of the screen that changed
+    */
+    struct TrackedPrimitive_t {
+        ClipRect_t m_bounds; // screen bounds, cut to the clip rect the primitive was recorded in
+        uint64_t   m_key;    // hash of the bounds, the batch state, and the vertices and indices, an instance is folded in by the renderer
+        uint32_t   m_batch;  // batch the primitive was committed to
+        uint32_t   m_first;  // first index of the primitive within its batch, or first instance of an instanced batch
+    };
+
+    /**
+     * @brief This class holds the render list of indices, vertices, batches, and the clip rects they are scissored to.
+     * While hashing, it hashes what is committed to it while the data is still in cache, two lists with the same hash draw the same.
+     * While tracking, it keeps the bounds and a key of each committed primitive, and while sorting the bounds of each batch
+    */
+    class RenderList {
+    public:
+        /**
+         * @brief This default constructor for the RenderList class
+         * @param allocator frame allocator the list is stored in and reset along with, or nullptr to store it on the heap
+        */
+        FORCEINLINE RenderList( FrameAllocator *allocator = nullptr ) : m_allocator{ allocator }, m_vertices( allocator ), m_indices( allocator ), m_instances( allocator ),
+            m_batches( allocator ), m_clips( allocator ), m_static_draws( allocator ), m_hash{}, m_hashing{}, m_tracked( allocator ), m_bounds{}, m_tracking{}, m_sorting{},
+            m_reserved{ Topology::TRIANGLE_LIST } {
+
+        }
+
+        /**
+         * @brief This function clears the render list
+        */
+        FORCEINLINE void clear() {
+            // the storage goes back to the frame allocator at once, the vectors are reserved again to the capacity they grew to from its start
+            if ( m_allocator ) {
+                const std::array capacities{ m_vertices.capacity(), m_indices.capacity(), m_instances.capacity(), m_batches.capacity(), m_clips.capacity(),
+                                             m_static_draws.capacity(), m_tracked.capacity() };
+                size_t           i{};
+
+                visit_storage( [ this ]( auto &storage ) { storage = std::decay_t< decltype( storage ) >( m_allocator ); } );
+
+                m_allocator->reset();
+
+                visit_storage( [ &capacities, &i ]( auto &storage ) { storage.reserve( capacities[ i++ ] ); } );
+
+                m_hash.clear();
+                return;
+            }
+
+            m_vertices.clear();
+            m_indices.clear();
+            m_instances.clear();
+            m_batches.clear();
+            m_clips.clear();
+            m_static_draws.clear();
+            m_hash.clear();
+            m_tracked.clear();
+        }
+
+        /**
+         * @brief This function sets the frame allocator the list is stored in, it has to be empty
+         * @param allocator frame allocator, or nullptr to store the list on the heap
+        */
+        FORCEINLINE void set_allocator( FrameAllocator *allocator ) {
+            m_allocator = allocator;
+
+            visit_storage( [ allocator ]( auto &storage ) { storage = std::decay_t< decltype( storage ) >( allocator ); } );
+        }
+
+        /**
+         * @brief This function returns the frame allocator the list is stored in
+         * @return frame allocator, or nullptr if stored on the heap
+        */
+        FORCEINLINE FrameAllocator *allocator() const {
+            return m_allocator;
+        }
+
+        /**
+         * @brief This function adds a clip rect batches can be scissored to
+         * @param clip clip rect
+         * @return clip rect index
+        */
+        FORCEINLINE uint32_t add_clip( const ClipRect_t &clip ) {
+            m_clips.push_back( clip );
+
+            if ( m_hashing )
+                m_hash.add( &clip, sizeof( ClipRect_t ) );
+
+            return ( uint32_t ) m_clips.size() - 1;
+        }
+
+        /**
+         * @brief This function reserves vertices and indices at the end of the render list to be written in place.
+         * A previous reservation that was not committed is dropped
+         * @param vertex_count number of vertices
+         * @param index_count number of indices
+         * @param topology primitive topology, a strip is expanded into a list when committed
+         * @param texture texture sampled by the primitives, or Batch_t::NO_TEXTURE
+         * @param clip clip rect the primitives are scissored to, or Batch_t::NO_CLIP
+         * @return writable vertices and indices, indices written have to be offset by the base index
+        */
+        FORCEINLINE Reservation_t reserve( const size_t vertex_count, const size_t index_count, Topology topology, const uint32_t texture = Batch_t::NO_TEXTURE,
+                                           const uint32_t clip = Batch_t::NO_CLIP ) {
+            const size_t vertex_end = m_batches.empty() ? 0 : m_batches.back().m_base_vertex + m_batches.back().m_vertex_count;
+            const size_t index_end  = m_batches.empty() ? 0 : m_batches.back().m_start_index + m_batches.back().m_index_count;
+            const auto   listed     = topology == Topology::LINE_STRIP ? Topology::LINE_LIST : topology == Topology::TRIANGLE_STRIP ? Topology::TRIANGLE_LIST : topology;
+
+            // create new batch if needed, a batch is kept within 16-bit indices unless the primitive alone exceeds them
+            if ( m_batches.empty() || m_batches.back().instanced() || m_batches.back().retained() || ( m_batches.back().m_vertex_count && ( m_batches.back().m_topology != listed ||
+                 m_batches.back().m_texture != texture || m_batches.back().m_clip != clip || m_batches.back().m_vertex_count + vertex_count > Batch_t::MAX_NARROW_VERTICES ) ) )
+                m_batches.push_back( { listed, vertex_end, index_end, m_instances.size(), texture, clip } );
+
+            // an empty batch left by a dropped reservation is reused
+            else if ( !m_batches.back().m_vertex_count ) {
+                m_batches.back().m_topology = listed;
+                m_batches.back().m_texture  = texture;
+                m_batches.back().m_clip     = clip;
+            }
+
+            m_reserved = topology;
+
+            // the indices of a strip are expanded in place, past the ones written
+            m_vertices.resize( vertex_end + vertex_count );
+            m_indices.resize( index_end + std::max( index_count, listed != topology ? strip_size( topology, index_count ) : 0 ) );
+
+            return { { m_vertices.data() + vertex_end, vertex_count }, { m_indices.data() + index_end, index_count }, ( uint32_t ) m_batches.back().m_vertex_count };
+        }
+
+        /**
+         * @brief This function commits the written part of the last reservation to its batch
+         * @param vertex_count number of written vertices
+         * @param index_count number of written indices
+        */
+        FORCEINLINE void commit( const size_t vertex_count, size_t index_count ) {
+            auto &batch = m_batches.back();
+
+            // a strip is drawn as a list, so it does not join the previous strip of the batch
+            if ( m_reserved == Topology::LINE_STRIP || m_reserved == Topology::TRIANGLE_STRIP )
+                index_count = expand_strip( m_indices.data() + batch.m_start_index + batch.m_index_count, index_count, m_reserved );
+
+            batch.m_vertex_count += vertex_count;
+            batch.m_index_count  += index_count;
+
+            if ( m_sorting && index_count )
+                batch.m_bounds = batch.m_bounds.unite( m_bounds );
+
+            // the state of the batch and the counts are hashed along with the data, so equal bytes split differently hash differently
+            if ( m_hashing ) {
+                m_hash.add( ( uint64_t ) batch.m_texture << 32 | batch.m_clip );
+                m_hash.add( ( uint64_t ) vertex_count << 32 | ( uint64_t ) index_count << 3 | ( uint64_t ) batch.m_topology );
+                m_hash.add( m_vertices.data() + batch.m_base_vertex + batch.m_vertex_count - vertex_count, sizeof( Vertex ) * vertex_count );
+                m_hash.add( m_indices.data() + batch.m_start_index + batch.m_index_count - index_count, sizeof( uint32_t ) * index_count );
+            }
+
+            if ( m_tracking && index_count ) {
+                FrameHash      key  = track_key( batch );
+                const uint32_t base = ( uint32_t ) ( batch.m_vertex_count - vertex_count );
+                const uint32_t *src = m_indices.data() + batch.m_start_index + batch.m_index_count - index_count;
+                uint32_t       local[ 64 ];
+
+                key.add( m_vertices.data() + batch.m_base_vertex + base, sizeof( Vertex ) * vertex_count );
+
+                // the indices are made relative to the first vertex, so a primitive hashes the same wherever it lands in its batch
+                for ( size_t i{}; i < index_count; i += std::size( local ) ) {
+                    const size_t count = std::min( index_count - i, std::size( local ) );
+
+                    for ( size_t j{}; j < count; ++j )
+                        local[ j ] = src[ i + j ] - base;
+
+                    key.add( local, sizeof( uint32_t ) * count );
+                }
+
+                m_tracked.push_back( { m_bounds, key.value(), ( uint32_t ) m_batches.size() - 1, ( uint32_t ) ( batch.m_index_count - index_count ) } );
+            }
+
+            // release the unused tail of the reservation
+            m_vertices.resize( batch.m_base_vertex + batch.m_vertex_count );
+            m_indices.resize( batch.m_start_index + batch.m_index_count );
+        }
+
+        /**
+         * @brief This function appends a shape instance, consecutive instances of a mesh share a batch
+         * @param mesh unit mesh the shape is expanded from
+         * @param clip clip rect the shape is scissored to, or Batch_t::NO_CLIP
+         * @return instance to be written
+        */
+        FORCEINLINE ShapeInstance_t &add_instance( const uint32_t mesh, const uint32_t clip = Batch_t::NO_CLIP ) {
+            if ( m_batches.empty() || m_batches.back().m_mesh != mesh || m_batches.back().m_clip != clip ) {
+                const size_t vertex_end = m_batches.empty() ? 0 : m_batches.back().m_base_vertex + m_batches.back().m_vertex_count;
+                const size_t index_end  = m_batches.empty() ? 0 : m_batches.back().m_start_index + m_batches.back().m_index_count;
+
+                // drop the storage of a reservation that was not committed
+                m_vertices.resize( vertex_end );
+                m_indices.resize( index_end );
+
+                // an empty batch left by a dropped reservation is replaced
+                if ( !m_batches.empty() && !m_batches.back().instanced() && !m_batches.back().retained() && !m_batches.back().m_vertex_count )
+                    m_batches.pop_back();
+
+                m_batches.push_back( { mesh, vertex_end, index_end, m_instances.size(), clip } );
+            }
+
+            ++m_batches.back().m_instance_count;
+
+            if ( m_sorting )
+                m_batches.back().m_bounds = m_batches.back().m_bounds.unite( m_bounds );
+
+            // the instance is written after it is added, so only its place in the list is hashed here and its contents by hash()
+            if ( m_hashing )
+                m_hash.add( ( uint64_t ) mesh << 32 | clip );
+
+            if ( m_tracking )
+                m_tracked.push_back( { m_bounds, track_key( m_batches.back() ).value(), ( uint32_t ) m_batches.size() - 1, ( uint32_t ) m_batches.back().m_instance_count - 1 } );
+
+            return m_instances.emplace_back();
+        }
+
+        /**
+         * @brief This function appends a draw of static geometry as a batch of its own
+         * @param geometry static geometry handle
+         * @param translation offset the geometry is drawn at
+         * @param clip clip rect the geometry is scissored to, or Batch_t::NO_CLIP
+        */
+        FORCEINLINE void add_static( const uint32_t geometry, const Vector2 &translation, const uint32_t clip = Batch_t::NO_CLIP ) {
+            const size_t vertex_end = m_batches.empty() ? 0 : m_batches.back().m_base_vertex + m_batches.back().m_vertex_count;
+            const size_t index_end  = m_batches.empty() ? 0 : m_batches.back().m_start_index + m_batches.back().m_index_count;
+
+            // drop the storage of a reservation that was not committed
+            m_vertices.resize( vertex_end );
+            m_indices.resize( index_end );
+
+            if ( !m_batches.empty() && !m_batches.back().instanced() && !m_batches.back().retained() && !m_batches.back().m_vertex_count )
+                m_batches.pop_back();
+
+            m_batches.push_back( { Topology::TRIANGLE_LIST, vertex_end, index_end, m_instances.size(), Batch_t::NO_TEXTURE, clip } );
+            m_batches.back().m_static = ( uint32_t ) m_static_draws.size();
+
+            if ( m_sorting )
+                m_batches.back().m_bounds = m_bounds;
+
+            m_static_draws.push_back( { geometry, translation } );
+
+            if ( m_hashing ) {
+                m_hash.add( ( uint64_t ) geometry << 32 | clip );
+                m_hash.add( &translation, sizeof( Vector2 ) );
+            }
+
+            if ( m_tracking ) {
+                FrameHash key = track_key( m_batches.back() );
+
+                key.add( geometry );
+                key.add( &translation, sizeof( Vector2 ) );
+
+                m_tracked.push_back( { m_bounds, key.value(), ( uint32_t ) m_batches.size() - 1, 0 } );
+            }
+        }
+
+        /**
+         * @brief This function sets whether the render list is hashed, it has to be empty so the hash covers all of it
+         * @param hashing hash what is committed
+        */
+        FORCEINLINE void set_hashing( const bool hashing ) {
+            m_hashing = hashing;
+        }
+
+        /**
+         * @brief This function returns whether the render list is hashed
+         * @return true, if hashed. false, otherwise
+        */
+        FORCEINLINE bool hashing() const {
+            return m_hashing;
+        }
+
+        /**
+         * @brief This function returns the hash of everything committed to the render list, only meaningful while hashing
+         * @return 64-bit hash
+        */
+        FORCEINLINE uint64_t hash() const {
+            FrameHash hash{ m_hash };
+
+            hash.add( m_instances.data(), sizeof( ShapeInstance_t ) * m_instances.size() );
+
+            return hash.value();
+        }
+
+        /**
+         * @brief This function sets whether the primitives committed to the render list are tracked, it has to be empty so every primitive is
+         * @param tracking track the committed primitives
+        */
+        FORCEINLINE void set_tracking( const bool tracking ) {
+            m_tracking = tracking;
+        }
+
+        /**
+         * @brief This function returns whether the committed primitives are tracked
+         * @return true, if tracked. false, otherwise
+        */
+        FORCEINLINE bool tracking() const {
+            return m_tracking;
+        }
+
+        /**
+         * @brief This function sets whether the batches are bounded so they can be sorted, it has to be empty so every batch is
+         * @param sorting bound the batches
+        */
+        FORCEINLINE void set_sorting( const bool sorting ) {
+            m_sorting = sorting;
+        }
+
+        /**
+         * @brief This function returns whether the batches are bounded so they can be sorted
+         * @return true, if sorted. false, otherwise
+        */
+        FORCEINLINE bool sorting() const {
+            return m_sorting;
+        }
+
+        /**
+         * @brief This function returns whether the bounds of the committed primitives are kept, while tracking or sorting
+         * @return true, if kept. false, otherwise
+        */
+        FORCEINLINE bool bounded() const {
+            return m_tracking || m_sorting;
+        }
+
+        /**
+         * @brief This function sets the screen bounds of the primitives committed next, until it is called again
+         * @param bounds screen bounds
+        */
+        FORCEINLINE void set_bounds( const ClipRect_t &bounds ) {
+            m_bounds = bounds;
+        }
+
+        /**
+         * @brief This function returns the primitives committed while tracking, in the order they were committed
+         * @return tracked primitives
+        */
+        const FrameVector< TrackedPrimitive_t > &tracked() const {
+            return m_tracked;
+        }
+
+        /**
+         * @brief This function returns the primitives committed while tracking, in the order they were committed
+         * @return tracked primitives
+        */
+        FrameVector< TrackedPrimitive_t > &tracked() {
+            return m_tracked;
+        }
+
+        /**
+         * @brief This function returns the underlying vertices
+         * @return vertices vector
+        */
+        FrameVector< Vertex > &vertices() {
+            return m_vertices;
+        }
+
+        /**
+         * @brief This function returns the underlying indices
+         * @return indices vector
+        */
+        FrameVector< uint32_t > &indices() {
+            return m_indices;
+        }
+
+        /**
+         * @brief This function returns the underlying shape instances
+         * @return shape instances
+        */
+        FrameVector< ShapeInstance_t > &instances() {
+            return m_instances;
+        }
+
+        /**
+         * @brief This function returns the underlying batches
+         * @return batches vector
+        */
+        FrameVector< Batch_t > &batches() {
+            return m_batches;
+        }
+
+        /**
+         * @brief This function returns the clip rects batches are scissored to
+         * @return clip rects, indexed by Batch_t::m_clip
+        */
+        FrameVector< ClipRect_t > &clips() {
+            return m_clips;
+        }
+
+        /**
+         * @brief This function returns the draws of static geometry
+         * @return static draws, indexed by Batch_t::m_static
+        */
+        FrameVector< StaticDraw_t > &static_draws() {
+            return m_static_draws;
+        }
+
+    private:
+        FrameAllocator *m_allocator; // frame allocator the list is stored in, or nullptr
+
+        FrameVector< Vertex          > m_vertices;     // vertices
+        FrameVector< uint32_t        > m_indices;      // indices
+        FrameVector< ShapeInstance_t > m_instances;    // shape instances
+        FrameVector< Batch_t         > m_batches;      // batches
+        FrameVector< ClipRect_t      > m_clips;        // clip rects of the scissored batches
+        FrameVector< StaticDraw_t    > m_static_draws; // draws of static geometry
+
+        FrameHash m_hash;    // hash of the committed vertices and indices, the batch state, the clip rects, and the static draws
+        bool      m_hashing; // hash what is committed
+
+        FrameVector< TrackedPrimitive_t > m_tracked;  // primitives committed while tracking
+        ClipRect_t                        m_bounds;   // screen bounds of the primitives committed next
+        bool                              m_tracking; // track the committed primitives
+
+        bool     m_sorting;  // bound the batches so they can be sorted
+        Topology m_reserved; // topology of the last reservation, a strip is expanded when committed
+
+        /**
+         * @brief This function calls a function with each vector the list is stored in
+         * @param visit function taking the vector
+        */
+        template< class F >
+        FORCEINLINE void visit_storage( F &&visit ) {
+            visit( m_vertices );
+            visit( m_indices );
+            visit( m_instances );
+            visit( m_batches );
+            visit( m_clips );
+            visit( m_static_draws );
+            visit( m_tracked );
+        }
+
+        /**
+         * @brief This function returns the index count a strip expands to
+         * @param topology strip topology
+         * @param count strip index count
+         * @return list index count
+        */
+        FORCEINLINE static size_t strip_size( Topology topology, const size_t count ) {
+            if ( topology == Topology::LINE_STRIP )
+                return count < 2 ? 0 : ( count - 1 ) * 2;
+
+            return count < 3 ? 0 : ( count - 2 ) * 3;
+        }
+
+        /**
+         * @brief This function expands the indices of a strip into a list in place, the storage has to hold the list
+         * @param indices strip indices
+         * @param count strip index count
+         * @param topology strip topology
+         * @return list index count
+        */
+        FORCEINLINE static size_t expand_strip( uint32_t *indices, const size_t count, Topology topology ) {
+            const size_t size = strip_size( topology, count );
+
+            // back to front, each primitive is written past the strip indices still to be read
+            if ( topology == Topology::LINE_STRIP ) {
+                for ( size_t i{ size / 2 }; i-- > 0; ) {
+                    const uint32_t a = indices[ i ];
+                    const uint32_t b = indices[ i + 1 ];
+
+                    indices[ i * 2 ]     = a;
+                    indices[ i * 2 + 1 ] = b;
+                }
+            }
+
+            // every other triangle is flipped, so the strip keeps its winding
+            else {
+                for ( size_t i{ size / 3 }; i-- > 0; ) {
+                    const uint32_t a = indices[ i ];
+                    const uint32_t b = indices[ i + 1 ];
+                    const uint32_t c = indices[ i + 2 ];
+
+                    indices[ i * 3 ]     = i & 1 ? b : a;
+                    indices[ i * 3 + 1 ] = i & 1 ? a : b;
+                    indices[ i * 3 + 2 ] = c;
+                }
+            }
+
+            return size;
+        }
+
+        /**
+         * @brief This function starts the key of a tracked primitive with its bounds and the state of its batch, the clip rect by value
+         * since its index depends on what else was recorded
+         * @param batch batch the primitive is committed to
+         * @return key to add the data of the primitive to
+        */
+        FORCEINLINE FrameHash track_key( const Batch_t &batch ) const {
+            FrameHash key;
+
+            key.add( &m_bounds, sizeof( ClipRect_t ) );
+            key.add( ( uint64_t ) batch.m_texture << 32 | batch.m_mesh );
+            key.add( ( uint64_t ) batch.m_topology );
+
+            if ( batch.m_clip != Batch_t::NO_CLIP )
+                key.add( &m_clips[ batch.m_clip ], sizeof( ClipRect_t ) );
+
+            return key;
+        }
+    };
+}
@@ -2,365 +2,520 @@
 
 #include "includes.h"
 #include "vertex.h"
+#include "render_list.h"
+#include "record_context.h"
+#include "backend.h"
+#include "diff_buffer.h"
+#include "dirty_region.h"
+#include "batch_sorter.h"
+#include "texture_atlas.h"
+#include "text.h"
+#include "baked_font.h"
 
 namespace dx {
     /**
-     * @brief This class contains the backup of the current DirectX 11 render state
+     * @brief This struct holds an image kept in system memory, so it can be uploaded again after being evicted from the atlas
     */
-    class RenderStateBackup {
+    struct Image_t {
+        uint32_t                m_width;  // width in texels
+        uint32_t                m_height; // height in texels
+        std::vector< uint32_t > m_pixels; // tightly packed rgba8 rows
+    };
+
+    /**
+     * @brief This struct holds static geometry captured from the render list into immutable buffers. Its batches
+     * keep the layout of the render list, their index ranges are in units of their own index format
+    */
+    struct StaticGeometry_t {
+        std::vector< Batch_t >    m_batches; // batches drawn from the immutable buffers
+        std::vector< ClipRect_t > m_clips;   // clip rects pushed while capturing, translated along with the geometry
+        bool                      m_valid;   // the buffers exist, cleared when the geometry is invalidated
+    };
+
+    /**
+     * @brief This class contains the platform independent renderer including its initialization,
+     * destruction, and drawing functions. Its own render list and those of the contexts it created
+     * are submitted through a backend
+    */
+    class Renderer : public RecordContext {
     public:
+        using RecordContext::reserve;
+
         /**
-         * @brief The constructor for the RenderStateBackup class
+         * @brief The constructor for the Renderer class
         */
-        NOINLINE RenderStateBackup() : m_dev_ctx{}, m_scissor_rects_count {}, m_viewports_count{}, m_scissor_rects{}, m_viewports{}, m_rasterizer_state{}, m_blend_state{},
-            m_blend_factor{}, m_sample_mask{}, m_stencil_ref{}, m_depth_stencil_state{}, m_shader_resource{}, m_sampler{}, m_pixel_shader{}, m_vertex_shader{}, m_geometry_shader{},
-            m_ps_instance_count{}, m_vs_instance_count{}, m_gs_instance_count{}, m_ps_instances{}, m_vs_instances{}, m_gs_instances{}, m_primitive_topology{}, 
-            m_index_buffer{}, m_vertex_buffer{}, m_constant_buffer{}, m_index_buffer_offset{}, m_vertex_buffer_stride{}, m_vertex_buffer_offset{}, m_index_buffer_format{}, m_input_layout{} {
+        FORCEINLINE Renderer() : RecordContext{}, m_backend{}, m_screen_size{}, m_vertex_ring{}, m_index_ring{}, m_instance_ring{},
+            m_vertex_diff{}, m_index_diff{}, m_instance_diff{}, m_diff_upload{},
+            m_stats{}, m_meshes{}, m_atlas{}, m_images{}, m_atlas_textures{}, m_texture_count{}, m_cleared_texels{}, m_text{}, m_baked_textures{}, m_contexts{}, m_lists{},
+            m_statics{}, m_capture_list{}, m_capture_clips{}, m_capture_recorded{}, m_capture_clip{ Batch_t::NO_CLIP }, m_capturing{},
+            m_skip_unchanged{}, m_frame_hash{}, m_frame_hashed{}, m_dirty{}, m_partial_redraw{}, m_scissor{}, m_sorter{}, m_sort_batches{} {
 
         }
 
         /**
-         * @brief This function creates the backup of the current DirectX 11 render state
-         * @param dev_ctx directx device context
-         * @return true, if able to capture stateblock. false, otherwise
+         * @brief This function creates the renderer environment
+         * @param backend created backend the render list is submitted through
+         * @param font_path baked font file mapped as the default font, the built-in bitmap font is used without one or if it cannot be opened
+         * @return true if created. false, otherwise
         */
-        NOINLINE bool capture( ID3D11DeviceContext *dev_ctx );
+        NOINLINE bool create( Backend *backend, const char *font_path = nullptr );
 
         /**
-         * @brief This function restores the stored backup of the current DirectX 11 render state
+         * @brief This function destroys the renderer enviroment
         */
-        NOINLINE void apply();
+        NOINLINE void destroy();
 
-    private:
-        static constexpr size_t  MAX_D3D11_CLASS_INSTANCE = 256;
-
-        ID3D11DeviceContext      *m_dev_ctx;
-
-        size_t                   m_scissor_rects_count, m_viewports_count;
-        D3D11_RECT               m_scissor_rects[ D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE ];
-        D3D11_VIEWPORT           m_viewports[ D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE ];
-        ID3D11RasterizerState    *m_rasterizer_state;
-        ID3D11BlendState         *m_blend_state;
-        float                    m_blend_factor[ 4 ];
-        size_t                   m_sample_mask;
-        size_t                   m_stencil_ref;
-        ID3D11DepthStencilState  *m_depth_stencil_state;
-        ID3D11ShaderResourceView *m_shader_resource;
-        ID3D11SamplerState       *m_sampler;
-        ID3D11PixelShader        *m_pixel_shader;
-        ID3D11VertexShader       *m_vertex_shader;
-        ID3D11GeometryShader     *m_geometry_shader;
-        size_t                   m_ps_instance_count, m_vs_instance_count, m_gs_instance_count;
-        ID3D11ClassInstance      *m_ps_instances[ MAX_D3D11_CLASS_INSTANCE ], *m_vs_instances[ MAX_D3D11_CLASS_INSTANCE ], *m_gs_instances[ MAX_D3D11_CLASS_INSTANCE ];
-        D3D11_PRIMITIVE_TOPOLOGY m_primitive_topology;
-        ID3D11Buffer             *m_index_buffer, *m_vertex_buffer, *m_constant_buffer;
-        size_t                   m_index_buffer_offset, m_vertex_buffer_stride, m_vertex_buffer_offset;
-        DXGI_FORMAT              m_index_buffer_format;
-        ID3D11InputLayout        *m_input_layout;
-    };
+        /**
+         * @brief This function performs the rendering, a frame the same as the last one drawn is not drawn again while unchanged frames are skipped
+         * @return true, if drawn and the frame has to be presented. false, if unchanged or the backend could not begin
+        */
+        NOINLINE bool perform();
 
-    /**
-     * @brief This struct holds the batch of topology, index and vertex counts
-    */
-    struct Batch_t {
-        D3D11_PRIMITIVE_TOPOLOGY m_topology;     // primitive topology
-        size_t                   m_vertex_count; // vertex count
-        size_t                   m_index_count;  // index count
+        /**
+         * @brief This function performs the rendering of a frame recorded ahead, its render list is drawn along with
+         * those of the renderer and its contexts, after the lists of its layer. The frame is cleared afterwards
+         * @param frame recorded frame, not recorded to while the renderer performs
+         * @return true, if drawn and the frame has to be presented. false, if unchanged or the backend could not begin
+        */
+        NOINLINE bool perform( RecordContext &frame );
 
         /**
-         * @brief This constructor initializes the batch with its topology, index and vertex count
-         * @param topology primitive topology
-         * @param vertex_count count of vertices
-         * @param index_count count of indices
+         * @brief This function sets whether a frame the same as the last one drawn is skipped. The render lists are hashed
+         * while they are recorded, starting with the frame after the next flush, and a frame whose hash matches is neither
+         * uploaded nor drawn, so the swapchain does not have to be presented either
+         * @param skip skip unchanged frames
         */
-        FORCEINLINE Batch_t( D3D11_PRIMITIVE_TOPOLOGY topology, const size_t vertex_count = 0, const size_t index_count = 0 ) : m_topology{ topology }, m_vertex_count{ vertex_count }, m_index_count{ index_count } {
+        NOINLINE void set_skip_unchanged( const bool skip );
 
+        /**
+         * @brief This function sets whether the frame is uploaded into persistent buffers, writing only the blocks that differ
+         * from the previous frame instead of copying all of it into the rings. It pays off when most of the frame is laid out
+         * like the previous one and the upload bandwidth rather than the draw count is the limit
+         * @param diff diff the upload
+        */
+        FORCEINLINE void set_diff_upload( const bool diff ) {
+            m_diff_upload = diff;
         }
-    };
 
-    /**
-     * @brief This class holds the render list of indices, vertices, and batches
-    */
-    class RenderList {
-    public:
         /**
-         * @brief This default constructor for the RenderList class
+         * @brief This function sets whether only the regions of the screen that changed since the last frame drawn are redrawn.
+         * The primitives are tracked while they are recorded, starting with the frame after the next flush, and those that differ
+         * from the ones drawn at their place last frame are merged into a few dirty rects. Only the batches and primitives touching
+         * a rect are drawn again, scissored to it. The render target has to keep the last frame drawn and the frame has to cover
+         * the rects itself, usually with a background drawn first. Static geometry is drawn whole when it touches a rect, it and
+         * custom primitives count as covering their clip rect
+         * @param partial redraw the regions that changed only
         */
-        FORCEINLINE RenderList() : m_vertices{}, m_indices{}, m_batches{} {
+        NOINLINE void set_partial_redraw( const bool partial );
 
+        /**
+         * @brief This function sets whether the batches of each render list are sorted and merged before they are uploaded.
+         * The batches are bounded while they are recorded, starting with the frame after the next flush, and a batch is moved
+         * back to the compatible batches drawn before it unless it overlaps an incompatible batch in between, so the frame looks
+         * the same with fewer draw calls. It pays off when a list alternates between textures, topologies, or clip rects
+         * @param sort sort the batches
+        */
+        FORCEINLINE void set_sort_batches( const bool sort ) {
+            m_sort_batches = sort;
         }
 
         /**
-         * @brief This function clears the render list
+         * @brief This function returns the rects the last frame drawn was redrawn in, so the caller can present only them
+         * @return disjoint pixel rects, empty if the frame was drawn whole
         */
-        FORCEINLINE void clear() {
-            m_vertices.clear();
-            m_indices.clear();
-            m_batches.clear();
+        FORCEINLINE std::span< const ClipRect_t > dirty_rects() const {
+            return m_partial_redraw ? std::span< const ClipRect_t >{ m_dirty.rects() } : std::span< const ClipRect_t >{};
         }
 
         /**
-         * @brief This function returns the underlying vertices
-         * @return vertices vector
+         * @brief This function checks if the recorded frame differs from the last one drawn, so the caller can leave
+         * the render target alone when it does not
+         * @return true, if changed or unchanged frames are not skipped. false, otherwise
         */
-        std::vector< Vertex > &vertices() {
-            return m_vertices;
-        }
+        NOINLINE bool changed();
 
         /**
-         * @brief This function returns the underlying indices
-         * @return indices vector
+         * @brief This function checks if the recorded frame differs from the last one drawn, along with a frame recorded ahead
+         * @param frame recorded frame
+         * @return true, if changed or unchanged frames are not skipped. false, otherwise
         */
-        std::vector< uint32_t > &indices() {
-            return m_indices;
-        }
+        NOINLINE bool changed( RecordContext &frame );
 
         /**
-         * @brief This function returns the underlying batches
-         * @return batches vector
+         * @brief This function returns the counters of the last flushed frame
+         * @return frame counters
         */
-        std::vector< Batch_t > &batches() {
-            return m_batches;
+        FORCEINLINE const RenderStats_t &stats() const {
+            return m_stats;
         }
 
-    private:
-        std::vector< Vertex   > m_vertices; // vertices
-        std::vector< uint32_t > m_indices;  // indices
-        std::vector< Batch_t  > m_batches;  // batches
-    };
+        /**
+         * @brief This function creates a recording context another thread can draw to without locks, its render list is
+         * submitted along with the one of the renderer. Contexts draw shapes only, images and text are drawn to the renderer
+         * @param layer layer the render list is drawn in, lists are drawn in increasing layer and lists of the same layer
+         * in the order their contexts were created, the renderer first
+         * @return context owned by the renderer until it is destroyed, or nullptr if the renderer was not created
+        */
+        NOINLINE RecordContext *create_context( const int32_t layer = 0 );
 
-    /**
-     * @brief This class contains the DirectX 11 renderer including its initialization,
-     * destruction, and drawing functions
-    */
-    class Renderer {
-    public:
         /**
-         * @brief The constructor for the Renderer class
+         * @brief This function adds an image that can be drawn as a sprite, images are packed into a shared texture atlas when first drawn
+         * @param width width in texels
+         * @param height height in texels
+         * @param pixels tightly packed rgba8 rows, red in the lowest byte
+         * @return image id
+        */
+        NOINLINE uint32_t add_image( const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels );
+
+        /**
+         * @brief This function draws an image as a textured quad, sprites on the same atlas page share a draw call
+         * @param image image id
+         * @param pos start position
+         * @param size dimensions
+         * @param tint rgba color multiplied with the image
         */
-        FORCEINLINE Renderer() : m_dev_ctx{}, m_dev{}, m_vertex_shader{}, m_pixel_shader{}, m_input_layout{}, 
-            m_blend_state{}, m_vertex_buffer{}, m_index_buffer{}, m_proj_buffer{}, m_max_vertices{ MAX_VERTICES }, m_max_indices{ MAX_INDICES },
-            m_screen_size{}, m_render_list{} {
+        NOINLINE void draw_image( const uint32_t image, const Vector2 &pos, const Vector2 &size, const Color &tint = Color::white() );
 
+        /**
+         * @brief This function adds a font text can be drawn with, fonts are dropped when the renderer is destroyed
+         * @param font font
+         * @return font id
+        */
+        FORCEINLINE uint32_t add_font( std::unique_ptr< Font > font ) {
+            return m_text.add_font( std::move( font ) );
         }
 
         /**
-         * @brief This function creates the renderer environment
-         * @param dev directx device
-         * @param dev_ctx directx device context
-         * @return true if created. false, otherwise
+         * @brief This function draws a string. Glyphs are rasterized once into the texture atlas and the laid out
+         * quads of a string are cached, so drawing an unchanged label again only copies them
+         * @param pos top-left corner of the first line
+         * @param text utf-8 string, a line feed starts a new line
+         * @param color rgba color
+         * @param size font size in pixels
+         * @param font font id
         */
-        NOINLINE bool create( ID3D11Device *dev, ID3D11DeviceContext *dev_ctx );
+        NOINLINE void draw_text( const Vector2 &pos, std::string_view text, const Color &color, const float size = 16.f, const uint32_t font = TextCache::DEFAULT_FONT );
 
         /**
-         * @brief This function destroys the renderer enviroment
+         * @brief This function returns the texture atlas images are drawn from
+         * @return texture atlas
         */
-        NOINLINE void destroy();
+        FORCEINLINE const TextureAtlas &atlas() const {
+            return m_atlas;
+        }
 
         /**
-         * @brief This function performs the rendering
+         * @brief This function starts capturing static geometry, the primitives drawn to the renderer until end_static are
+         * kept out of the frame and the clip stack starts empty. Images and the text of rasterized fonts sample the atlas,
+         * which can evict them, so they are not captured, the text of baked fonts is. The capture has to end before the renderer performs
         */
-        NOINLINE void perform();
+        NOINLINE void begin_static();
 
         /**
-         * @brief This function draws a line of specific thickness
-         * @param start start position
-         * @param end end position
-         * @param color rgba color
-         * @param thickness pixel thickness
+         * @brief This function ends the capture, uploading the captured primitives into immutable buffers
+         * @return static geometry handle, or Batch_t::NO_STATIC if nothing was captured or the buffers cannot be created
         */
-        NOINLINE void draw_line( const Vector2 &start, const Vector2 &end, const Color &color, const float thickness = 1.f );
-        
+        NOINLINE uint32_t end_static();
+
         /**
-         * @brief This function draws a line of specific thickness
-         * @param start_x start x-position
-         * @param start_y start y-position
-         * @param end_x end x-position
-         * @param end_y end y-position
-         * @param color rgba color
-         * @param thickness pixel thickness
+         * @brief This function draws static geometry without tessellating or uploading it again, one draw call per batch
+         * of the capture, usually one. It is scissored to the current clip rect
+         * @param geometry static geometry handle
+         * @param translation offset the geometry is drawn at
         */
-        NOINLINE void draw_line( const float start_x, const float start_y, const float end_x, const float end_y, const Color &color, const float thickness = 1.f );
+        NOINLINE void draw_static( const uint32_t geometry, const Vector2 &translation = {} );
 
         /**
-         * @brief This function draws a filled rectangle
-         * @param pos position
-         * @param size dimensions
-         * @param color rgba color
+         * @brief This function invalidates static geometry whose content changed, releasing its buffers. Draws of it are
+         * skipped, its handle is not handed out again and a new one has to be captured
+         * @param geometry static geometry handle
         */
-        NOINLINE void draw_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &color );
+        NOINLINE void invalidate_static( const uint32_t geometry );
 
         /**
-         * @brief This function draws a filled rectangle
-         * @param x start x-position
-         * @param y start y-position
-         * @param w width
-         * @param h height
-         * @param color rgba color
+         * @brief This function checks if static geometry can be drawn
+         * @param geometry static geometry handle
+         * @return true, if captured and not invalidated. false, otherwise
         */
-        NOINLINE void draw_filled_rect( const float x, const float y, const float w, const float h, const Color &color );
+        FORCEINLINE bool static_valid( const uint32_t geometry ) const {
+            return geometry < m_statics.size() && m_statics[ geometry ].m_valid;
+        }
+
+    private:
+        static constexpr size_t INITIAL_VERTEX_BUFFER_SIZE   = sizeof( Vertex ) * 1024;          // initial vertex ring size
+        static constexpr size_t INITIAL_INDEX_BUFFER_SIZE    = sizeof( uint32_t ) * 1024;        // initial index ring size
+        static constexpr size_t INITIAL_INSTANCE_BUFFER_SIZE = sizeof( ShapeInstance_t ) * 1024; // initial instance ring size
+        static constexpr size_t MAX_BUFFER_SIZE              = 64 * 1024 * 1024;                 // size a ring grows to from its high-water mark
+
+        static constexpr float TWO_PI = 2.f * std::numbers::pi_v< float >; // full turn in radians
+
+        Backend *m_backend; // submission backend
+
+        Vector2 m_screen_size; // current screen size
+
+        UploadRing m_vertex_ring;   // vertex buffer ring
+        UploadRing m_index_ring;    // index buffer ring
+        UploadRing m_instance_ring; // instance buffer ring
+
+        DiffBuffer m_vertex_diff;   // persistent vertex buffer of the diffed upload
+        DiffBuffer m_index_diff;    // persistent index buffer of the diffed upload
+        DiffBuffer m_instance_diff; // persistent instance buffer of the diffed upload
+        bool       m_diff_upload;   // upload into the persistent buffers, writing the changed blocks only
+
+        RenderStats_t m_stats; // last frame counters
+
+        std::vector< ShapeMesh_t > m_meshes; // unit meshes created on the backend, indexed by mesh id
+
+        TextureAtlas            m_atlas;          // placement of the images in the atlas pages
+        std::vector< Image_t >  m_images;         // images, indexed by image id
+        std::vector< uint32_t > m_atlas_textures; // textures of the atlas pages, indexed by page
+        uint32_t                m_texture_count;  // textures created on the backend, ids are handed out in order
+        std::vector< uint32_t > m_cleared_texels; // transparent texels the evicted shelves are cleared with, grown to the largest shelf
+
+        TextCache                                m_text;           // fonts, glyphs, and text layouts
+        std::unordered_map< uint64_t, uint32_t > m_baked_textures; // textures of the baked font pages drawn so far, keyed by font and page
+
+        std::vector< std::unique_ptr< RecordContext > > m_contexts; // created contexts
+        std::vector< RecordContext * >                 m_lists;    // the renderer and its contexts in the order their render lists are drawn
+
+        std::vector< StaticGeometry_t > m_statics;          // static geometry, indexed by handle
+        RenderList                      m_capture_list;     // render list of the frame while static geometry is captured
+        std::vector< ClipRect_t >       m_capture_clips;    // clip stack of the frame while static geometry is captured
+        RenderStats_t                   m_capture_recorded; // recording counters of the frame while static geometry is captured
+        uint32_t                        m_capture_clip;     // clip rect index of the frame while static geometry is captured
+        bool                            m_capturing;        // static geometry is being captured
+
+        bool     m_skip_unchanged; // skip frames the same as the last one drawn
+        uint64_t m_frame_hash;     // hash of the last frame drawn
+        bool     m_frame_hashed;   // every render list of the last frame drawn was hashed
+
+        DirtyRegion m_dirty;          // regions that changed since the last frame drawn
+        bool        m_partial_redraw; // redraw the regions that changed only
+        ClipRect_t  m_scissor;        // dirty rect cut to the clip rect of the batch, the scissor of the batches while redrawing a rect
+
+        BatchSorter m_sorter;       // sort of the batches of each render list
+        bool        m_sort_batches; // sort and merge the batches before uploading them
 
         /**
-         * @brief This function draws a filled rectangle
-         * @param pos position
-         * @param size dimensions
-         * @param color rgba color
-         * @param thickness pixel thickness
+         * @brief This function draws the batched vertices
+         * @param frame recorded frame drawn along with the render lists, or nullptr
         */
-        NOINLINE void draw_rect( const Vector2 &pos, const Vector2 &size, const Color &color, const float thickness = 1.f );
+        NOINLINE void flush( RecordContext *frame );
 
         /**
-         * @brief This function draws a filled rectangle
-         * @param x start x-position
-         * @param y start y-position
-         * @param w width
-         * @param h height
-         * @param color rgba color
-         * @param thickness pixel thickness
+         * @brief This function starts the counters of the frame with those of the recording
+         * @param frame recorded frame drawn along with the render lists, or nullptr
         */
-        NOINLINE void draw_rect( const float x, const float y, const float w, const float h, const Color &color, const float thickness = 1.f );
+        NOINLINE void take_recorded( RecordContext *frame );
 
         /**
-         * @brief This function draws an outlined filled rectangle
-         * @param pos position
-         * @param size dimensions
-         * @param fill_color inside color
-         * @param outline_color border color
+         * @brief This function ends the frame, clearing the render lists and switching their hashing, tracking, and sorting on or off
+         * @param frame recorded frame drawn along with the render lists, or nullptr
         */
-        NOINLINE void draw_outlined_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &fill_color, const Color &outline_color );
+        NOINLINE void end_frame( RecordContext *frame );
 
         /**
-         * @brief This function draws an outlined filled rectangle
-         * @param x start x-position
-         * @param y start y-position
-         * @param w width
-         * @param h height
-         * @param fill_color inside color
-         * @param outline_color border color
+         * @brief This function hashes the render lists in the order they are drawn, along with the state they are drawn with
+         * @param frame recorded frame drawn along with the render lists, or nullptr
+         * @param hash output hash of the frame
+         * @return true, if every render list was hashed and no texels were written this frame. false, if the frame has to be drawn
         */
-        NOINLINE void draw_outlined_filled_rect( const float x, const float y, const float w, const float h, const Color &fill_color, const Color &outline_color );
+        NOINLINE bool hash_frame( RecordContext *frame, uint64_t &hash );
 
         /**
-         * @brief This function draws an outlined rectangle
-         * @param pos position
-         * @param size dimensions
-         * @param fill_color inside color
-         * @param outline_color border color
+         * @brief This function collects the tracked primitives in the order they are drawn and finds the regions that changed
+         * @param frame recorded frame drawn along with the render lists, or nullptr
         */
-        NOINLINE void draw_outlined_rect( const Vector2 &pos, const Vector2 &size, const Color &inner_color, const Color &outline_color );
+        NOINLINE void track_frame( RecordContext *frame );
 
         /**
-         * @brief This function draws an outlined rectangle
-         * @param x start x-position
-         * @param y start y-position
-         * @param w width
-         * @param h height
-         * @param fill_color inside color
-         * @param outline_color border color
+         * @brief This function visits the render lists in the order they are drawn, a recorded frame after the lists of its layer
+         * @param frame recorded frame drawn along with the render lists, or nullptr
+         * @param visit function called with each context, returning false stops the walk
+         * @return true, if every list was visited. false, if stopped
         */
-        NOINLINE void draw_outlined_rect( const float x, const float y, const float w, const float h, const Color &inner_color, const Color &outline_color );
+        template < typename F >
+        FORCEINLINE bool visit_lists( RecordContext *frame, F &&visit ) {
+            RecordContext *pending{ frame };
+
+            for ( auto *list : m_lists ) {
+                if ( pending && list->layer() > pending->layer() ) {
+                    if ( !visit( *pending ) )
+                        return false;
+
+                    pending = nullptr;
+                }
+
+                if ( !visit( *list ) )
+                    return false;
+            }
+
+            return !pending || visit( *pending );
+        }
 
         /**
-         * @brief This function draws a circle
-         * @param pos position
-         * @param radius circle radius
-         * @param color rgba color
-         * @param segment_count number of circle segments
+         * @brief This function performs the rendering of the render lists and a frame recorded ahead
+         * @param frame recorded frame drawn along with the render lists, or nullptr
+         * @return true, if drawn. false, if unchanged or the backend could not begin
         */
-        NOINLINE void draw_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count = 32 );
+        NOINLINE bool perform_frame( RecordContext *frame );
 
         /**
-         * @brief This function draws a circle
-         * @param x start x-position
-         * @param y start y-position
-         * @param radius circle radius
-         * @param color rgba color
-         * @param segment_count number of circle segments
+         * @brief This function recreates a dynamic buffer if it should hold more bytes
+         * @param type buffer type
+         * @param ring ring of the buffer
+         * @param size bytes that have to fit
+         * @param max_size largest size to grow to
+         * @return true, if the buffer is large enough or was grown. false, otherwise
         */
-        NOINLINE void draw_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count = 32 );
+        NOINLINE bool reserve( BufferType type, UploadRing &ring, const size_t size, const size_t max_size );
 
         /**
-         * @brief This function draws a filled circle
-         * @param pos position
-         * @param radius circle radius
-         * @param color rgba color
-         * @param segment_count number of circle segments
+         * @brief This function recreates a persistent buffer if it should hold more bytes, the diffed upload lays out the whole frame in it
+         * @param type buffer type
+         * @param size bytes that have to fit
+         * @return true, if the buffer is large enough or was grown. false, otherwise
         */
-        NOINLINE void draw_filled_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count = 32 );
+        NOINLINE bool reserve_persistent( BufferType type, const size_t size );
 
         /**
-         * @brief This function draws a filled circle
-         * @param x start x-position
-         * @param y start y-position
-         * @param radius circle radius
-         * @param color rgba color
-         * @param segment_count number of circle segments
+         * @brief This function allocates a range of the ring, or of the persistent buffer when the upload is diffed, and returns memory to write it to
+         * @param type buffer type
+         * @param size range size in bytes
+         * @param alignment range offset alignment in bytes
+         * @param offset output byte offset into the buffer
+         * @return writable memory of the range, or nullptr if it cannot be allocated or mapped
         */
-        NOINLINE void draw_filled_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count = 32 );
+        NOINLINE uint8_t *begin_upload( BufferType type, const size_t size, const size_t alignment, size_t &offset );
 
-    private:
-        static constexpr size_t MAX_VERTICES = 1024; // max number of vertices
-        static constexpr size_t MAX_INDICES  = 1024; // max number of indices
+        /**
+         * @brief This function finishes writing the range, unmapping the ring or writing the blocks of the range that changed
+         * @param type buffer type
+         * @param size range size in bytes
+        */
+        NOINLINE void end_upload( BufferType type, const size_t size );
 
-        static constexpr size_t VERTEX_BUFFER_STRIDE = sizeof( Vertex ); // stride of vertex buffer
-        static constexpr size_t VERTEX_BUFFER_OFFSET = 0;                // offset of vertex buffer
+        /**
+         * @brief This function uploads a range laid out in memory as it is drawn, copying it into the ring, or comparing it
+         * where it is with the persistent buffer when the upload is diffed so it is not staged first
+         * @param type buffer type
+         * @param data bytes of the range
+         * @param size range size in bytes
+         * @param alignment range offset alignment in bytes
+         * @param offset output byte offset into the buffer
+         * @return true, if uploaded. false, if the range cannot be allocated or mapped
+        */
+        NOINLINE bool upload( BufferType type, const void *data, const size_t size, const size_t alignment, size_t &offset );
 
-        ID3D11DeviceContext *m_dev_ctx; // directx device context
-        ID3D11Device        *m_dev;     // directx device
+        /**
+         * @brief This function writes the changed blocks of the last range allocated in a persistent buffer and counts them
+         * @param type buffer type
+         * @param bytes bytes of the range
+        */
+        NOINLINE void commit_diff( BufferType type, const uint8_t *bytes );
 
-        ID3D11VertexShader *m_vertex_shader; // directx vertex shader
-        ID3D11PixelShader  *m_pixel_shader;  // directx pixel shader
-        ID3D11InputLayout  *m_input_layout;  // directx input layout
-        ID3D11BlendState   *m_blend_state;   // directx blend state
+        /**
+         * @brief This function returns the ring of a buffer type
+         * @param type buffer type
+         * @return ring
+        */
+        FORCEINLINE UploadRing &ring( BufferType type ) {
+            return type == BufferType::VERTEX ? m_vertex_ring : type == BufferType::INDEX ? m_index_ring : m_instance_ring;
+        }
 
-        ID3D11Buffer *m_vertex_buffer; // vertex buffer
-        ID3D11Buffer *m_index_buffer;  // index buffer
-        ID3D11Buffer *m_proj_buffer;   // projection buffer
+        /**
+         * @brief This function returns the persistent buffer of a buffer type
+         * @param type buffer type
+         * @return persistent buffer
+        */
+        FORCEINLINE DiffBuffer &diff_buffer( BufferType type ) {
+            return type == BufferType::VERTEX ? m_vertex_diff : type == BufferType::INDEX ? m_index_diff : m_instance_diff;
+        }
 
-        size_t m_max_vertices; // max vertex count
-        size_t m_max_indices;  // max index count
+        /**
+         * @brief This function uploads a render list to the rings and draws it, split into chunks of whole batches that fit the rings
+         * @param list render list
+         * @param clip clip rect the backend is scissored to, updated as the batches change it
+         * @return true, if uploaded. false, otherwise
+        */
+        NOINLINE bool upload_list( RenderList &list, const ClipRect_t *&clip );
 
-        Vector2 m_screen_size; // current screen size
+        /**
+         * @brief This function uploads a range of batches to the rings and draws them
+         * @param list render list of the batches
+         * @param first first batch of the chunk
+         * @param last one past the last batch of the chunk
+         * @param vertex_size vertex bytes of the chunk
+         * @param index_size index bytes of the chunk
+         * @param instance_size instance bytes of the chunk
+         * @param clip clip rect the backend is scissored to, updated as the batches change it
+         * @return true, if uploaded. false, otherwise
+        */
+        NOINLINE bool upload_chunk( RenderList &list, const size_t first, const size_t last, const size_t vertex_size, const size_t index_size, const size_t instance_size,
+                                    const ClipRect_t *&clip );
 
-        RenderStateBackup m_render_state_backup; // render state backup
-        RenderList m_render_list;                // render list
+        /**
+         * @brief This function draws a range of the indices or instances of an uploaded batch
+         * @param b batch
+         * @param first first index, or first instance of an instanced batch, within the batch
+         * @param count index or instance count
+         * @param start_index first index of the batch in the index buffer, in units of its index format
+         * @param base_vertex first vertex of the batch in the vertex buffer
+         * @param first_instance first instance of the batch in the instance buffer
+        */
+        NOINLINE void draw_batch( const Batch_t &b, const size_t first, const size_t count, const size_t start_index, const size_t base_vertex, const size_t first_instance );
 
         /**
-         * @brief This function draws the batched vertices
+         * @brief This function finds or creates the unit mesh of a shape
+         * @param segment_count number of fan segments, zero for the unit quad
+         * @return mesh id, or Batch_t::NO_MESH if the mesh cannot be created
         */
-        NOINLINE void flush();
+        NOINLINE uint32_t mesh( const size_t segment_count ) override;
 
         /**
-         * @brief This function sets the custom render state settings
+         * @brief This function draws a static batch of the render list from the buffers of its geometry
+         * @param draw static draw
+         * @param clip clip rect the backend is scissored to for the batch, or nullptr
         */
-        NOINLINE void set_custom_state();
-        
+        NOINLINE void submit_static( const StaticDraw_t &draw, const ClipRect_t *clip );
+
         /**
-         * @brief This function allocates the directx vertex and index buffers
-         * @return true, if allocated. false, otherwise
+         * @brief This function places an image into the atlas and uploads it if it was not resident, creating the textures of new pages
+         * @param key atlas key
+         * @param width width in texels
+         * @param height height in texels
+         * @param pixels tightly packed rgba8 rows
+         * @param region output image location
+         * @return true, if the image is in the atlas. false, otherwise
         */
-        NOINLINE bool allocate();
+        NOINLINE bool acquire_image( const uint64_t key, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels, AtlasRegion_t &region );
 
         /**
-         * @brief This function creates the directx projection matrix and allocates its buffer
-         * @return true, if allocated. false, otherwise
+         * @brief This function finds the texture of a baked font page, creating it from the mapped file when first drawn
+         * @param font font id
+         * @param baked baked font
+         * @param page page index
+         * @return texture id, or Batch_t::NO_TEXTURE if it cannot be created
         */
-        NOINLINE bool project();
+        NOINLINE uint32_t baked_texture( const uint32_t font, const BakedFont &baked, const uint32_t page );
 
         /**
-         * @brief This function retrieves the current screen size from viewport
-         * @return viewport width and height
+         * @brief This function measures a string from its glyph metrics without placing them, leaving the layout to be built
+         * @param layout output layout
+         * @param font font id
+         * @param text utf-8 string
+         * @param size font size in pixels
         */
-        NOINLINE Vector2 get_screen_size();
+        NOINLINE void measure_text( TextLayout_t &layout, const uint32_t font, std::string_view text, const float size );
 
         /**
-         * @brief This function adds the vertices and indices to the render list
-         * @param vertex_array primitive vertices
-         * @param vertex_count number of vertices
-         * @param index_array primitive indices
-         * @param index_count number of indices
-         * @param topology primitive topology
+         * @brief This function lays out a measured string, placing its glyphs into the atlas
+         * @param layout output layout
+         * @param font font id
+         * @param text utf-8 string
+         * @param size font size in pixels
         */
-        NOINLINE void add_vertices( Vertex *vertex_array, const size_t vertex_count, uint32_t *index_array, const size_t index_count, D3D11_PRIMITIVE_TOPOLOGY topolog );
+        NOINLINE void layout_text( TextLayout_t &layout, const uint32_t font, std::string_view text, const float size );
+
     };
 }
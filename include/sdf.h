@@ -0,0 +1,83 @@
+#pragma once
+
+#include "includes.h"
+#include "shape_instance.h"
+
+namespace dx {
+    /**
+     * @brief This class contains the packing of signed distance shapes into shape instances and the reference
+     * evaluation of their distance function. The evaluation matches shape_pixel_shader in resource/sdf.fx
+    */
+    class Sdf {
+    public:
+        static constexpr float AA_PADDING = 1.f; // pixels the quad extends past the shape so the edge can fade out
+
+        /**
+         * @brief This function packs a rounded rectangle
+         * @param pos top-left corner
+         * @param size dimensions
+         * @param radius corner radius, limited to half the smaller dimension
+         * @param stroke outline thickness measured inwards from the edge, zero fills the shape
+         * @param color packed rgba8 color
+         * @return shape instance
+        */
+        FORCEINLINE static ShapeInstance_t rounded_rect( const Vector2 &pos, const Vector2 &size, const float radius, const float stroke, const uint32_t color ) {
+            const Vector2 half{ std::abs( size.x ) * 0.5f, std::abs( size.y ) * 0.5f };
+
+            return {
+                Vector2( std::min( pos.x, pos.x + size.x ) + half.x, std::min( pos.y, pos.y + size.y ) + half.y ),
+                half,
+                Vector2( std::clamp( radius, 0.f, std::min( half.x, half.y ) ), std::max( stroke, 0.f ) ),
+                color,
+                ShapeKind::SDF_ROUNDED_RECT
+            };
+        }
+
+        /**
+         * @brief This function packs a circle, a rounded rectangle whose corner radius is the circle radius
+         * @param pos center position
+         * @param radius outer radius
+         * @param stroke ring thickness measured inwards from the edge, zero fills the shape
+         * @param color packed rgba8 color
+         * @return shape instance
+        */
+        FORCEINLINE static ShapeInstance_t circle( const Vector2 &pos, const float radius, const float stroke, const uint32_t color ) {
+            const float r = std::abs( radius );
+
+            return { pos, Vector2( r, r ), Vector2( r, std::max( stroke, 0.f ) ), color, ShapeKind::SDF_ROUNDED_RECT };
+        }
+
+        /**
+         * @brief This function evaluates the signed distance from a point to the edge of a packed shape
+         * @param shape shape instance
+         * @param point screen position
+         * @return distance in pixels, negative inside the shape
+        */
+        FORCEINLINE static float distance( const ShapeInstance_t &shape, const Vector2 &point ) {
+            const float radius = shape.m_params.x;
+            const float stroke = shape.m_params.y;
+
+            // distance to the corner-rounded box, relative to its center
+            const float qx = std::abs( point.x - shape.m_pos.x ) - shape.m_size.x + radius;
+            const float qy = std::abs( point.y - shape.m_pos.y ) - shape.m_size.y + radius;
+
+            float dist = std::hypot( std::max( qx, 0.f ), std::max( qy, 0.f ) ) + std::min( std::max( qx, qy ), 0.f ) - radius;
+
+            // hollow out everything further inside than the stroke
+            if ( stroke > 0.f )
+                dist = std::abs( dist + stroke * 0.5f ) - stroke * 0.5f;
+
+            return dist;
+        }
+
+        /**
+         * @brief This function evaluates the anti-aliased coverage of a pixel by a packed shape
+         * @param shape shape instance
+         * @param point pixel center
+         * @return covered fraction of a pixel wide box filter across the edge, within [0, 1]
+        */
+        FORCEINLINE static float coverage( const ShapeInstance_t &shape, const Vector2 &point ) {
+            return std::clamp( 0.5f - distance( shape, point ), 0.f, 1.f );
+        }
+    };
+}
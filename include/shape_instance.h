@@ -0,0 +1,39 @@
+#pragma once
+
+#include "includes.h"
+#include "vector.h"
+
+namespace dx {
+    /**
+     * @brief This enum holds the shapes the instanced vertex shader expands, the values match resource/shape.hlsli
+    */
+    enum class ShapeKind : uint32_t {
+        RECT,            // unit quad scaled by the size from the top-left corner
+        LINE,            // unit quad stretched from start to end, extended by the thickness on both sides
+        ELLIPSE,         // unit circle fan scaled by the radii around the center
+        SDF_ROUNDED_RECT // unit quad around the center, covered by the distance to a rounded rectangle
+    };
+
+    /**
+     * @brief This struct holds the per-instance record uploaded to the instance buffer
+    */
+    struct ShapeInstance_t {
+        Vector2   m_pos;    // rect: top-left corner, line: start, ellipse and sdf: center
+        Vector2   m_size;   // rect: dimensions, line: end, ellipse: radii, sdf: half dimensions
+        Vector2   m_params; // kind specific parameters, line: thickness in x, sdf: corner radius in x and stroke in y
+        uint32_t  m_color;  // packed rgba8 color
+        ShapeKind m_kind;   // shape kind
+    };
+
+    static_assert( sizeof( ShapeInstance_t ) == 32, "shape instance has to match the instance input layout" );
+
+    /**
+     * @brief This struct holds the unit mesh instances of a shape are expanded from
+    */
+    struct ShapeMesh_t {
+        static constexpr uint32_t QUAD = 0; // id of the unit quad mesh
+
+        size_t m_segment_count; // fan segments, zero for the quad
+        size_t m_index_count;   // index count drawn per instance
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "includes.h"
+#include "vector.h"
+#include "unit_circle.h"
+
+namespace dx {
+    /**
+     * @brief This enum holds how the segments of a polyline are joined at its inner points
+    */
+    enum class LineJoin : uint8_t {
+        MITER, // outer edges extended until they meet, beveled past Stroke::MITER_LIMIT
+        BEVEL, // outer corners connected by a straight edge
+        ROUND  // outer corners connected by an arc around the point
+    };
+
+    /**
+     * @brief This enum holds how the ends of a polyline are capped
+    */
+    enum class LineCap : uint8_t {
+        BUTT,   // cut at the end point
+        SQUARE, // extended past the end point by the thickness
+        ROUND   // half circle around the end point
+    };
+
+    /**
+     * @brief This class contains the array kernels of polyline stroking. The kernels take four segments at a time
+     * with sse2 where available, the scalar path computes the same normals bit for bit
+    */
+    class Stroke {
+    public:
+        static constexpr float    MITER_LIMIT = 4.f;                                                 // miter length in thicknesses past which a miter join is beveled, the inner corner of a join is cut to it as well
+        static constexpr float    MIN_MITER   = 2.f / ( MITER_LIMIT * MITER_LIMIT );                 // one plus the dot product of the normals at the miter limit
+        static constexpr size_t   ROUND_STEPS = 8;                                                   // segments of a half turn of round joins and caps
+        static constexpr SinCos_t ROUND_STEP  = constexpr_sin_cos( std::numbers::pi / ROUND_STEPS ); // rotation of one segment of round joins and caps
+
+        /**
+         * @brief This function computes the unit normals of the segments between consecutive points, rotated a quarter
+         * turn counter-clockwise from the segment direction
+         * @param points points, at least two
+         * @param normals output normals, one less than the points, zero for segments without length
+        */
+        NOINLINE static void normals( std::span< const Vector2 > points, Vector2 *normals );
+    };
+}
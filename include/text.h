@@ -0,0 +1,230 @@
+#pragma once
+
+#include "includes.h"
+#include "vertex.h"
+#include "font.h"
+#include "clip_rect.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace dx {
+    /**
+     * @brief This struct holds consecutive glyph quads of a layout sampling the same texture
+    */
+    struct TextRun_t {
+        uint32_t m_texture; // atlas page or baked font page texture
+        uint32_t m_first;   // first vertex of the run
+        uint32_t m_count;   // vertex count, four per glyph
+    };
+
+    /**
+     * @brief This struct holds an atlas shelf the glyphs of a layout were packed into
+    */
+    struct TextShelf_t {
+        uint32_t m_page;       // atlas page
+        uint32_t m_shelf;      // shelf within the page
+        uint32_t m_generation; // shelf generation the glyphs were acquired in
+    };
+
+    /**
+     * @brief This struct holds a laid out string, its glyph quads are positioned relative to the top-left of the
+     * first line with the atlas coordinates baked in, so drawing it again only copies the quads
+    */
+    struct TextLayout_t {
+        std::vector< Vertex >      m_vertices;  // glyph quads, white
+        std::vector< TextRun_t >   m_runs;      // quads grouped by texture
+        std::vector< TextShelf_t > m_shelves;   // shelves the quads sample, the layout is rebuilt when one is evicted
+        Vector2                    m_size;      // width of the widest line and height of the lines
+        ClipRect_t                 m_bounds;    // bounds of the glyph quads from their metrics, tested against the clip rect before they are built or copied
+        size_t                     m_last_used; // last frame the layout was drawn
+        bool                       m_complete;  // the quads were built and every glyph fit into the atlas
+    };
+
+    /**
+     * @brief This class contains the fonts, the rasterized glyphs, and the layouts of recently drawn strings.
+     * Glyphs are rasterized once per font, size, and codepoint and kept in system memory, so they can be uploaded
+     * again after the atlas evicted them, until MAX_GLYPHS are cached and those not used last frame are dropped. Placing the glyphs into the atlas is left to the renderer. A new string allocates
+     * its layout until the cache first holds MAX_LAYOUTS, from then on it takes the place of a dropped one
+    */
+    class TextCache {
+    public:
+        static constexpr uint32_t DEFAULT_FONT = 0;          // font added when the renderer is created
+        static constexpr uint64_t GLYPH_KEY    = 1ull << 63; // atlas key bit separating glyphs from image ids
+        static constexpr size_t   MAX_LAYOUTS  = 4096;       // layouts kept before those not drawn last frame are dropped
+        static constexpr size_t   MAX_GLYPHS   = 4096;       // glyphs kept before those not used last frame are dropped
+        static constexpr uint32_t REPLACEMENT  = '?';        // codepoint drawn for glyphs a font does not have
+
+        /**
+         * @brief The constructor for the TextCache class
+        */
+        FORCEINLINE TextCache() : m_frame{ 1 }, m_fonts{}, m_glyphs{}, m_layouts{}, m_free{} {
+
+        }
+
+        /**
+         * @brief This function adds a font
+         * @param font font
+         * @return font id
+        */
+        FORCEINLINE uint32_t add_font( std::unique_ptr< Font > font ) {
+            m_fonts.push_back( std::move( font ) );
+
+            return ( uint32_t ) m_fonts.size() - 1;
+        }
+
+        /**
+         * @brief This function finds or rasterizes a glyph, marking it used this frame, a glyph the font does not have is replaced
+         * @param font font id
+         * @param codepoint unicode codepoint
+         * @param size font size in pixels, quantized to a quarter pixel
+         * @param key output atlas key of the glyph
+         * @return glyph valid until the frame ends, or nullptr if the font does not exist
+        */
+        NOINLINE const Glyph_t *glyph( const uint32_t font, const uint32_t codepoint, const float size, uint64_t &key );
+
+        /**
+         * @brief This function returns the line height of a font
+         * @param font font id
+         * @param size font size in pixels
+         * @return line height in pixels, zero if the font does not exist
+        */
+        FORCEINLINE float line_height( const uint32_t font, const float size ) {
+            return font < m_fonts.size() ? m_fonts[ font ]->line_height( size ) : 0.f;
+        }
+
+        /**
+         * @brief This function returns a font as a baked distance field font
+         * @param font font id
+         * @return baked font, or nullptr if the font does not exist or rasterizes its glyphs
+        */
+        FORCEINLINE BakedFont *baked( const uint32_t font ) {
+            return font < m_fonts.size() ? m_fonts[ font ]->baked() : nullptr;
+        }
+
+        /**
+         * @brief This function finds the layout of a string or adds one to be built, marking it drawn this frame
+         * @param font font id
+         * @param text utf-8 string
+         * @param size font size in pixels
+         * @param created output whether the layout was added and has to be built, it can hold a dropped string's quads until then
+         * @return layout
+        */
+        NOINLINE TextLayout_t &layout( const uint32_t font, std::string_view text, const float size, bool &created );
+
+        /**
+         * @brief This function ends the frame, dropping the layouts not drawn and the glyphs not used last frame once there are too many
+        */
+        NOINLINE void end_frame();
+
+        /**
+         * @brief This function removes every font, glyph, and layout
+        */
+        FORCEINLINE void clear() {
+            m_fonts.clear();
+            m_glyphs.clear();
+            m_layouts.clear();
+            m_free.clear();
+        }
+
+        /**
+         * @brief This function returns the number of cached layouts
+         * @return layout count
+        */
+        FORCEINLINE size_t layouts() const {
+            return m_layouts.size();
+        }
+
+        /**
+         * @brief This function returns the number of cached glyphs
+         * @return glyph count
+        */
+        FORCEINLINE size_t glyphs() const {
+            return m_glyphs.size();
+        }
+
+        /**
+         * @brief This function decodes the next codepoint of a utf-8 string, malformed sequences decode to the replacement character
+         * @param text utf-8 string
+         * @param offset byte offset, advanced past the codepoint
+         * @param codepoint output codepoint
+         * @return true, if a codepoint was decoded. false, at the end of the string
+        */
+        NOINLINE static bool decode_utf8( std::string_view text, size_t &offset, uint32_t &codepoint );
+
+    private:
+        /**
+         * @brief This struct holds a rasterized glyph and the last frame it was used
+        */
+        struct CachedGlyph_t {
+            Glyph_t m_glyph;     // rasterized glyph
+            size_t  m_last_used; // last frame the glyph was used
+        };
+
+        /**
+         * @brief This struct holds the key of a layout
+        */
+        struct LayoutKey_t {
+            uint64_t    m_font_size; // font id and quantized size
+            std::string m_text;      // utf-8 string
+        };
+
+        /**
+         * @brief This struct holds the key of a layout lookup, so finding a layout does not copy the string
+        */
+        struct LayoutView_t {
+            uint64_t         m_font_size; // font id and quantized size
+            std::string_view m_text;      // utf-8 string
+        };
+
+        /**
+         * @brief This struct contains the hash of layout keys and lookups
+        */
+        struct LayoutHash_t {
+            using is_transparent = void;
+
+            FORCEINLINE size_t operator()( const LayoutView_t &key ) const {
+                return std::hash< std::string_view >{}( key.m_text ) ^ key.m_font_size * 0x9e3779b97f4a7c15ull;
+            }
+
+            FORCEINLINE size_t operator()( const LayoutKey_t &key ) const {
+                return ( *this )( LayoutView_t{ key.m_font_size, key.m_text } );
+            }
+        };
+
+        /**
+         * @brief This struct contains the equality of layout keys and lookups
+        */
+        struct LayoutEqual_t {
+            using is_transparent = void;
+
+            template < typename A, typename B >
+            FORCEINLINE bool operator()( const A &a, const B &b ) const {
+                return a.m_font_size == b.m_font_size && std::string_view{ a.m_text } == std::string_view{ b.m_text };
+            }
+        };
+
+        using LayoutMap = std::unordered_map< LayoutKey_t, TextLayout_t, LayoutHash_t, LayoutEqual_t >;
+
+        size_t m_frame; // current frame
+
+        std::vector< std::unique_ptr< Font > >        m_fonts;   // fonts, indexed by font id
+        std::unordered_map< uint64_t, CachedGlyph_t > m_glyphs;  // rasterized glyphs, keyed by font, size, and codepoint
+        LayoutMap                                     m_layouts; // laid out strings
+        std::vector< LayoutMap::node_type >           m_free;    // dropped layouts, reused for new strings along with the capacity of their key and vectors
+
+        /**
+         * @brief This function packs a font id and a size quantized to a quarter pixel
+         * @param font font id
+         * @param size font size in pixels
+         * @return font and size key, the codepoint goes into the low 21 bits
+        */
+        FORCEINLINE static uint64_t font_size( const uint32_t font, const float size ) {
+            const uint64_t quarters = ( uint64_t ) std::clamp( std::lround( size * 4.f ), 1l, ( 1l << 19 ) - 1 );
+
+            return ( uint64_t ) font << 40 | quarters << 21;
+        }
+    };
+}
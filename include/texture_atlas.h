@@ -0,0 +1,187 @@
+#pragma once
+
+#include "includes.h"
+
+#include <unordered_map>
+
+namespace dx {
+    /**
+     * @brief This enum holds the results of acquiring an image from the atlas
+    */
+    enum class AtlasResult : uint8_t {
+        RESIDENT,  // image is already in the atlas
+        ALLOCATED, // region was allocated, the image has to be uploaded to it
+        FAILED     // image does not fit, every region is in use by the current frame
+    };
+
+    /**
+     * @brief This struct holds the location of an image in the atlas
+    */
+    struct AtlasRegion_t {
+        uint32_t m_page;   // page holding the image, also its texture id
+        uint32_t m_shelf;  // shelf holding the image within the page
+        uint32_t m_x;      // left edge in texels
+        uint32_t m_y;      // top edge in texels
+        uint32_t m_width;  // width in texels
+        uint32_t m_height; // height in texels
+    };
+
+    /**
+     * @brief This struct holds a horizontal strip of a page images of similar height are packed into
+    */
+    struct AtlasShelf_t {
+        uint32_t                m_y;          // top edge in texels
+        uint32_t                m_height;     // height in texels
+        uint32_t                m_cursor;     // end of the last packed image
+        uint32_t                m_generation; // number of times the shelf was evicted
+        size_t                  m_last_used;  // last frame an image of the shelf was acquired
+        std::vector< uint64_t > m_keys;       // images packed into the shelf
+    };
+
+    /**
+     * @brief This struct holds a texture of the atlas and its shelves
+    */
+    struct AtlasPage_t {
+        uint32_t                    m_width;     // width in texels
+        uint32_t                    m_height;    // height in texels
+        uint32_t                    m_shelf_end; // bottom edge of the last shelf
+        std::vector< AtlasShelf_t > m_shelves;   // shelves from top to bottom
+    };
+
+    /**
+     * @brief This class contains the shelf packer placing images into atlas pages. When the pages are full the
+     * least recently used shelf not needed by the current frame is evicted, pages are added up to a limit after that.
+     * It only tracks placement, uploading the images and creating the page textures is left to the caller
+    */
+    class TextureAtlas {
+    public:
+        static constexpr uint32_t PADDING = 1; // texels left between images so filtering does not bleed, kept transparent
+
+        /**
+         * @brief The constructor for the TextureAtlas class
+         * @param page_size width and height of a page in texels
+         * @param max_pages largest number of pages
+        */
+        FORCEINLINE TextureAtlas( const uint32_t page_size = 1024, const size_t max_pages = 4 ) : m_page_size{ page_size }, m_max_pages{ max_pages },
+            m_frame{ 1 }, m_evictions{}, m_pages{}, m_entries{}, m_evicted{} {
+
+        }
+
+        /**
+         * @brief This function finds an image in the atlas or allocates a region for it, marking it used by the current frame
+         * @param key image key
+         * @param width image width in texels
+         * @param height image height in texels
+         * @param region output image location
+         * @return whether the image is resident, has to be uploaded, or does not fit
+        */
+        NOINLINE AtlasResult acquire( const uint64_t key, const uint32_t width, const uint32_t height, AtlasRegion_t &region );
+
+        /**
+         * @brief This function marks the shelf of a region used by the current frame, without looking up its images.
+         * Callers caching regions check the generation to see whether the shelf was evicted since
+         * @param page page index
+         * @param shelf shelf index
+         * @param generation shelf generation the region was acquired in
+         * @return true, if the region is still resident. false, if its shelf was evicted
+        */
+        FORCEINLINE bool touch( const uint32_t page, const uint32_t shelf, const uint32_t generation ) {
+            auto &s = m_pages[ page ].m_shelves[ shelf ];
+
+            if ( s.m_generation != generation )
+                return false;
+
+            s.m_last_used = m_frame;
+
+            return true;
+        }
+
+        /**
+         * @brief This function returns the current generation of a shelf
+         * @param page page index
+         * @param shelf shelf index
+         * @return number of times the shelf was evicted
+        */
+        FORCEINLINE uint32_t generation( const uint32_t page, const uint32_t shelf ) const {
+            return m_pages[ page ].m_shelves[ shelf ].m_generation;
+        }
+
+        /**
+         * @brief This function ends the frame, the shelves it used become eligible for eviction
+        */
+        FORCEINLINE void end_frame() {
+            ++m_frame;
+        }
+
+        /**
+         * @brief This function removes every image and page
+        */
+        FORCEINLINE void clear() {
+            m_pages.clear();
+            m_entries.clear();
+            m_evicted.clear();
+        }
+
+        /**
+         * @brief This function returns the atlas pages, pages are added in order and never removed until cleared
+         * @return pages indexed by texture id
+        */
+        FORCEINLINE const std::vector< AtlasPage_t > &pages() const {
+            return m_pages;
+        }
+
+        /**
+         * @brief This function returns the number of images evicted to make room
+         * @return eviction count
+        */
+        FORCEINLINE size_t evictions() const {
+            return m_evictions;
+        }
+
+        /**
+         * @brief This function returns the shelves evicted since they were last cleared. Their texels still hold the evicted
+         * images, which filtering would blend into the padding of the images placed there next, so the caller clears them first
+         * @return evicted shelf rects, as wide as the images the shelves held
+        */
+        FORCEINLINE const std::vector< AtlasRegion_t > &evicted() const {
+            return m_evicted;
+        }
+
+        /**
+         * @brief This function forgets the evicted shelves once the caller cleared their texels
+        */
+        FORCEINLINE void clear_evicted() {
+            m_evicted.clear();
+        }
+
+    private:
+        uint32_t m_page_size; // width and height of a new page
+        size_t   m_max_pages; // largest number of pages
+        size_t   m_frame;     // current frame
+        size_t   m_evictions; // evicted image count
+
+        std::vector< AtlasPage_t >                    m_pages;   // pages indexed by texture id
+        std::unordered_map< uint64_t, AtlasRegion_t > m_entries; // resident images
+        std::vector< AtlasRegion_t >                  m_evicted; // evicted shelf rects not cleared yet
+
+        /**
+         * @brief This function places a padded image into a page, preferring shelves of a similar height
+         * @param page page index
+         * @param width padded width
+         * @param height padded height
+         * @param shelf output shelf index
+         * @return true, if placed. false, if the page is full
+        */
+        NOINLINE bool place( const uint32_t page, const uint32_t width, const uint32_t height, uint32_t &shelf );
+
+        /**
+         * @brief This function empties the least recently used shelf that fits a padded image and was not used this frame
+         * @param width padded width
+         * @param height padded height
+         * @param page output page index
+         * @param shelf output shelf index
+         * @return true, if a shelf was evicted. false, otherwise
+        */
+        NOINLINE bool evict( const uint32_t width, const uint32_t height, uint32_t &page, uint32_t &shelf );
+    };
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "includes.h"
+
+#include <unordered_map>
+
+namespace dx {
+    /**
+     * @brief This struct holds a point on the unit circle
+    */
+    struct SinCos_t {
+        float m_cos; // x-coordinate
+        float m_sin; // y-coordinate
+    };
+
+    /**
+     * @brief This function computes the sine and cosine of an angle at compile time
+     * @param angle angle in radians, within [0, 2pi)
+     * @return point on the unit circle
+    */
+    constexpr SinCos_t constexpr_sin_cos( double angle ) {
+        double sin{}, cos{};
+        double term{ 1.0 };
+
+        // reduce to [-pi, pi] where the taylor series converges quickly
+        if ( angle > std::numbers::pi )
+            angle -= 2.0 * std::numbers::pi;
+
+        // term holds angle^n / n!, alternating between the cosine and sine series
+        for ( int n{}; n < 40; ++n ) {
+            switch ( n % 4 ) {
+                case 0: cos += term; break;
+                case 1: sin += term; break;
+                case 2: cos -= term; break;
+                case 3: sin -= term; break;
+            }
+
+            term *= angle / ( double ) ( n + 1 );
+        }
+
+        return { ( float ) cos, ( float ) sin };
+    }
+
+    /**
+     * @brief This function generates the unit circle points of a segment count at compile time
+     * @return points at the start of each segment
+    */
+    template< size_t N >
+    constexpr std::array< SinCos_t, N > make_unit_circle() {
+        std::array< SinCos_t, N > ret{};
+
+        for ( size_t i{}; i < N; ++i )
+            ret[ i ] = constexpr_sin_cos( 2.0 * std::numbers::pi * ( double ) i / ( double ) N );
+
+        return ret;
+    }
+
+    /**
+     * @brief The unit circle points of the common segment counts, generated at compile time
+    */
+    template< size_t N >
+    inline constexpr std::array< SinCos_t, N > UNIT_CIRCLE = make_unit_circle< N >();
+
+    /**
+     * @brief This class contains the unit circle tables used to tessellate circles, ellipses, and arcs.
+     * Common segment counts come from the compile time tables, others are computed once and cached
+    */
+    class UnitCircleCache {
+    public:
+        /**
+         * @brief The constructor for the UnitCircleCache class
+        */
+        FORCEINLINE UnitCircleCache() : m_tables{}, m_last_count{}, m_last_table{} {
+
+        }
+
+        /**
+         * @brief This function returns the unit circle table of a segment count
+         * @param segment_count number of circle segments, greater than zero
+         * @return points at the start of each segment
+        */
+        FORCEINLINE std::span< const SinCos_t > get( const size_t segment_count ) {
+            // circles of a frame tend to share their segment count
+            if ( segment_count != m_last_count ) {
+                m_last_table = lookup( segment_count );
+                m_last_count = segment_count;
+            }
+
+            return m_last_table;
+        }
+
+    private:
+        std::unordered_map< size_t, std::vector< SinCos_t > > m_tables;     // tables computed at runtime
+        size_t                                                m_last_count; // segment count of the last table
+        std::span< const SinCos_t >                           m_last_table; // last table returned
+
+        /**
+         * @brief This function finds or computes the unit circle table of a segment count
+         * @param segment_count number of circle segments, greater than zero
+         * @return points at the start of each segment
+        */
+        NOINLINE std::span< const SinCos_t > lookup( const size_t segment_count );
+    };
+}
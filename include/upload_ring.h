@@ -0,0 +1,127 @@
+#pragma once
+
+#include "includes.h"
+
+namespace dx {
+    /**
+     * @brief This enum holds the ways a dynamic buffer can be mapped for writing
+    */
+    enum class MapMode : uint8_t {
+        DISCARD,     // previous contents are orphaned, the buffer is renamed
+        NO_OVERWRITE // previous contents stay valid, only unused ranges are written
+    };
+
+    /**
+     * @brief This struct holds a range handed out by the upload ring
+    */
+    struct RingAllocation_t {
+        size_t  m_offset; // byte offset into the buffer
+        MapMode m_mode;   // mode the buffer has to be mapped with to write the range
+    };
+
+    /**
+     * @brief This class contains the allocator of a dynamic buffer used as a ring. Ranges are appended
+     * and mapped without overwriting pending draws, the buffer is only discarded when it wraps.
+     * It tracks the bytes used per frame so the buffer can grow to the observed high-water mark
+    */
+    class UploadRing {
+    public:
+        /**
+         * @brief The constructor for the UploadRing class
+        */
+        FORCEINLINE UploadRing() : m_capacity{}, m_cursor{}, m_frame_size{}, m_high_water{}, m_discard{ true } {
+
+        }
+
+        /**
+         * @brief This function restarts the ring on a newly created buffer
+         * @param capacity buffer size in bytes
+        */
+        FORCEINLINE void reset( const size_t capacity ) {
+            m_capacity = capacity;
+            m_cursor   = 0;
+            m_discard  = true;
+        }
+
+        /**
+         * @brief This function allocates a range from the ring
+         * @param size range size in bytes
+         * @param alignment range offset alignment in bytes, need not be a power of two
+         * @param allocation output range
+         * @return true, if allocated. false, if the range is larger than the buffer
+        */
+        FORCEINLINE bool allocate( const size_t size, const size_t alignment, RingAllocation_t &allocation ) {
+            size_t offset = ( m_cursor + alignment - 1 ) / alignment * alignment;
+
+            if ( size > m_capacity )
+                return false;
+
+            // wrap around, the pending ranges are orphaned along with the buffer contents
+            if ( m_discard || offset + size > m_capacity ) {
+                offset    = 0;
+                m_discard = false;
+
+                allocation.m_mode = MapMode::DISCARD;
+            }
+
+            else
+                allocation.m_mode = MapMode::NO_OVERWRITE;
+
+            allocation.m_offset = offset;
+
+            m_cursor      = offset + size;
+            m_frame_size += size;
+
+            return true;
+        }
+
+        /**
+         * @brief This function ends the frame, folding its usage into the high-water mark
+        */
+        FORCEINLINE void end_frame() {
+            m_high_water = std::max( m_high_water, m_frame_size );
+            m_frame_size = 0;
+        }
+
+        /**
+         * @brief This function returns the capacity the buffer should grow to
+         * @param size bytes that have to fit
+         * @param max_capacity largest capacity to grow to
+         * @return power of two multiple of the capacity covering the size, limited to the max capacity
+        */
+        FORCEINLINE size_t wanted_capacity( const size_t size, const size_t max_capacity ) const {
+            size_t capacity = m_capacity ? m_capacity : 1;
+
+            if ( size <= m_capacity )
+                return m_capacity;
+
+            while ( capacity < size )
+                capacity *= 2;
+
+            return std::max( m_capacity, std::min( capacity, max_capacity ) );
+        }
+
+        /**
+         * @brief This function returns the buffer size
+         * @return capacity in bytes
+        */
+        FORCEINLINE size_t capacity() const {
+            return m_capacity;
+        }
+
+        /**
+         * @brief This function returns the largest number of bytes a frame has used
+         * @return high-water mark in bytes
+        */
+        FORCEINLINE size_t high_water() const {
+            return m_high_water;
+        }
+
+    private:
+        size_t m_capacity;   // buffer size
+        size_t m_cursor;     // end of the last allocated range
+        size_t m_frame_size; // bytes allocated in the current frame
+        size_t m_high_water; // largest frame size observed
+        bool   m_discard;    // the next allocation has to discard the buffer
+    };
+}
@@ -5,9 +5,9 @@
 namespace dx {
 
     //
-    // 4-dimensional vector implementatioon
+    // 4-dimensional vector implementatioon, kept in an sse register where available
     //
-    class Vector4 {
+    class alignas( 16 ) Vector4 {
     public:
         // vector components
         float x, y, z, w;
@@ -25,6 +25,17 @@ namespace dx {
 
         }
 
+#ifdef DX_SSE2
+        FORCEINLINE Vector4( const __m128 &xmm ) {
+            _mm_store_ps( &x, xmm );
+        }
+
+        // register
+        FORCEINLINE __m128 xmm() const {
+            return _mm_load_ps( &x );
+        }
+#endif
+
         FORCEINLINE void init( float x0, float y0, float z0, float w0 ) {
             x = x0;
             y = y0;
@@ -56,116 +67,156 @@ namespace dx {
 
         // equality
         FORCEINLINE bool operator ==( const Vector4 &other ) const {
+#ifdef DX_SSE2
+            return _mm_movemask_ps( _mm_cmpeq_ps( xmm(), other.xmm() ) ) == 0xf;
+#else
             return ( other.x == x ) && ( other.y == y ) && ( other.z == z ) && ( other.w == w );
+#endif
         }
 
         FORCEINLINE bool operator !=( const Vector4 &other ) const {
-            return ( other.x != x ) || ( other.y != y ) || ( other.z != z ) && ( other.w != w );
+#ifdef DX_SSE2
+            return _mm_movemask_ps( _mm_cmpneq_ps( xmm(), other.xmm() ) ) != 0;
+#else
+            return ( other.x != x ) || ( other.y != y ) || ( other.z != z ) || ( other.w != w );
+#endif
         }
 
         // arithmetic operations
         // copy
         FORCEINLINE Vector4 operator +( const Vector4 &other ) const {
-            return Vector4( x + other.x, y + other.y, z + other.z, w + other.w );
+            return Vector4( *this ) += other;
         }
 
         FORCEINLINE Vector4 operator -( const Vector4 &other ) const {
-            return Vector4( x - other.x, y - other.y, z - other.z, w - other.w );
+            return Vector4( *this ) -= other;
         }
 
         FORCEINLINE Vector4 operator *( const Vector4 &other ) const {
-            return Vector4( x * other.x, y * other.y, z * other.z, w * other.w );
+            return Vector4( *this ) *= other;
         }
 
         FORCEINLINE Vector4 operator /( const Vector4 &other ) const {
-            return Vector4( x / other.x, y / other.y, z / other.z, w / other.w );
+            return Vector4( *this ) /= other;
         }
 
         FORCEINLINE Vector4 operator +( float scalar ) const {
-            return Vector4( x + scalar, y + scalar, z + scalar, w + scalar );
+            return Vector4( *this ) += scalar;
         }
 
         FORCEINLINE Vector4 operator -( float scalar ) const {
-            return Vector4( x - scalar, y - scalar, z - scalar, w - scalar );
+            return Vector4( *this ) -= scalar;
         }
 
         FORCEINLINE Vector4 operator *( float scalar ) const {
-            return Vector4( x * scalar, y * scalar, z * scalar, w * scalar );
+            return Vector4( *this ) *= scalar;
         }
 
         FORCEINLINE Vector4 operator /( float scalar ) const {
-            return Vector4( x / scalar, y / scalar, z / scalar, w / scalar );
+            return Vector4( *this ) /= scalar;
         }
 
         // reference
         FORCEINLINE Vector4 &operator +=( const Vector4 &other ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_add_ps( xmm(), other.xmm() ) );
+#else
             x += other.x;
             y += other.y;
             z += other.z;
             w += other.w;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator -=( const Vector4 &other ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_sub_ps( xmm(), other.xmm() ) );
+#else
             x -= other.x;
             y -= other.y;
             z -= other.z;
             w -= other.w;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator *=( const Vector4 &other ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_mul_ps( xmm(), other.xmm() ) );
+#else
             x *= other.x;
             y *= other.y;
             z *= other.z;
             w *= other.w;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator /=( const Vector4 &other ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_div_ps( xmm(), other.xmm() ) );
+#else
             x /= other.x;
             y /= other.y;
             z /= other.z;
             w /= other.w;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator *=( float scalar ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_mul_ps( xmm(), _mm_set1_ps( scalar ) ) );
+#else
             x *= scalar;
             y *= scalar;
             z *= scalar;
             w *= scalar;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator /=( float scalar ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_div_ps( xmm(), _mm_set1_ps( scalar ) ) );
+#else
             x /= scalar;
             y /= scalar;
             z /= scalar;
             w /= scalar;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator +=( float scalar ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_add_ps( xmm(), _mm_set1_ps( scalar ) ) );
+#else
             x += scalar;
             y += scalar;
             z += scalar;
             w += scalar;
+#endif
 
             return *this;
         }
 
         FORCEINLINE Vector4 &operator -=( float scalar ) {
+#ifdef DX_SSE2
+            _mm_store_ps( &x, _mm_sub_ps( xmm(), _mm_set1_ps( scalar ) ) );
+#else
             x -= scalar;
             y -= scalar;
             z -= scalar;
             w -= scalar;
+#endif
 
             return *this;
         }
@@ -176,7 +227,7 @@ namespace dx {
         }
 
         FORCEINLINE float len() {
-            return sqrtf( x * x + y * y + z * z + w * w );
+            return sqrtf( len_sqr() );
         }
 
         FORCEINLINE float len_3d() {
@@ -188,11 +239,22 @@ namespace dx {
         }
 
         FORCEINLINE float len_sqr() {
-            return ( x * x ) + ( y * y ) + ( z * z ) + ( w * w );
+            return dot( *this );
         }
 
         FORCEINLINE float dot( const Vector4 &other ) {
+#ifdef DX_SSE2
+            // the products are multiplied at once and summed in order, so the sum rounds like the scalar one
+            const __m128 p = _mm_mul_ps( xmm(), other.xmm() );
+            __m128       s = _mm_add_ss( p, _mm_shuffle_ps( p, p, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+
+            s = _mm_add_ss( s, _mm_shuffle_ps( p, p, _MM_SHUFFLE( 2, 2, 2, 2 ) ) );
+            s = _mm_add_ss( s, _mm_shuffle_ps( p, p, _MM_SHUFFLE( 3, 3, 3, 3 ) ) );
+
+            return _mm_cvtss_f32( s );
+#else
             return ( x * other.x ) + ( y * other.y ) + ( z * other.z ) + ( w * other.w );
+#endif
         }
 
         FORCEINLINE float dist( const Vector4 &other ) {
@@ -206,12 +268,8 @@ namespace dx {
             mag = len();
 
             // create unit vector, divide each component by magnitude
-            if ( mag != 0.f ) {
-                x /= mag;
-                y /= mag;
-                z /= mag;
-                w /= mag;
-            }
+            if ( mag != 0.f )
+                *this /= mag;
 
             return mag;
         }
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "includes.h"
+#include "vector.h"
+#include "vertex.h"
+
+namespace dx {
+    /**
+     * @brief This struct holds an affine transform of 2-dimensional points, a point maps to m_x * x + m_y * y + m_origin
+    */
+    struct Affine2_t {
+        Vector2 m_x;      // image of the x-axis
+        Vector2 m_y;      // image of the y-axis
+        Vector2 m_origin; // translation
+    };
+
+    /**
+     * @brief This struct holds an affine transform of 3-dimensional points, a point maps to m_x * x + m_y * y + m_z * z + m_origin
+    */
+    struct Affine3_t {
+        Vector3 m_x;      // image of the x-axis
+        Vector3 m_y;      // image of the y-axis
+        Vector3 m_z;      // image of the z-axis
+        Vector3 m_origin; // translation
+    };
+
+    /**
+     * @brief This class contains the kernels over arrays of vectors. With sse2 they take four vectors at a time, split into
+     * registers of x, y, and z, and the rest one at a time. Both paths compute each component with the same operations in the
+     * same order as the scalar vector functions, so the results are the same bit for bit
+    */
+    class VectorArray {
+    public:
+        /**
+         * @brief This function adds an offset to points
+         * @param points points, changed in place
+         * @param offset added offset
+        */
+        NOINLINE static void add( std::span< Vector2 > points, const Vector2 &offset );
+
+        /**
+         * @brief This function adds an offset to points
+         * @param points points, changed in place
+         * @param offset added offset
+        */
+        NOINLINE static void add( std::span< Vector3 > points, const Vector3 &offset );
+
+        /**
+         * @brief This function scales points component-wise
+         * @param points points, changed in place
+         * @param factor scale of each component
+        */
+        NOINLINE static void scale( std::span< Vector2 > points, const Vector2 &factor );
+
+        /**
+         * @brief This function scales points component-wise
+         * @param points points, changed in place
+         * @param factor scale of each component
+        */
+        NOINLINE static void scale( std::span< Vector3 > points, const Vector3 &factor );
+
+        /**
+         * @brief This function transforms points
+         * @param points points, changed in place
+         * @param transform affine transform
+        */
+        NOINLINE static void transform( std::span< Vector2 > points, const Affine2_t &transform );
+
+        /**
+         * @brief This function transforms points
+         * @param points points, changed in place
+         * @param transform affine transform
+        */
+        NOINLINE static void transform( std::span< Vector3 > points, const Affine3_t &transform );
+
+        /**
+         * @brief This function normalizes vectors, those without length stay zero
+         * @param vectors vectors, changed in place
+        */
+        NOINLINE static void normalize( std::span< Vector2 > vectors );
+
+        /**
+         * @brief This function normalizes vectors, those without length stay zero
+         * @param vectors vectors, changed in place
+        */
+        NOINLINE static void normalize( std::span< Vector3 > vectors );
+
+        /**
+         * @brief This function computes the bounds of points, negative zero is below positive zero so the bounds do not depend on the order of the points
+         * @param points points, at least one
+         * @param min output smallest components
+         * @param max output largest components
+        */
+        NOINLINE static void bounds( std::span< const Vector2 > points, Vector2 &min, Vector2 &max );
+
+        /**
+         * @brief This function computes the bounds of points, negative zero is below positive zero so the bounds do not depend on the order of the points
+         * @param points points, at least one
+         * @param min output smallest components
+         * @param max output largest components
+        */
+        NOINLINE static void bounds( std::span< const Vector3 > points, Vector3 &min, Vector3 &max );
+
+        /**
+         * @brief This function moves vertices by an offset and sets their color, keeping their texture coordinates. A compact
+         * vertex fills a register, so it is moved and recolored in one go
+         * @param vertices vertices, changed in place
+         * @param offset added offset
+         * @param color vertex color
+        */
+        NOINLINE static void place( std::span< Vertex > vertices, const Vector2 &offset, const Vertex::color_t &color );
+    };
+}
@@ -6,14 +6,94 @@
 
 namespace dx {
     /**
-     * @brief This class contains the directx Vertex container
+     * @brief This class contains the directx Vertex container. With DX_COMPACT_VERTEX defined it holds
+     * a 2-dimensional position, a packed rgba8 color and 16-bit texture coordinates (16 bytes), otherwise
+     * a 3-dimensional position, a float rgba color and float texture coordinates (36 bytes)
     */
     class Vertex {
     public:
+#ifdef DX_COMPACT_VERTEX
+        using position_t = Vector2;  // position type
+        using color_t    = uint32_t; // color type, rgba8 unsigned normalized
+        using uv_t       = uint32_t; // texture coordinate type, two 16-bit unsigned normalized, u in the low half
+#else
+        using position_t = Vector3;  // position type
+        using color_t    = Color;    // color type, rgba float
+        using uv_t       = Vector2;  // texture coordinate type
+#endif
+
+        /**
+         * @brief This function converts a color into the vertex color type, done once per primitive
+         * @param color rgba color
+         * @return vertex color
+        */
+        FORCEINLINE static color_t pack( const Color &color ) {
+#ifdef DX_COMPACT_VERTEX
+            return color.pack();
+#else
+            return color;
+#endif
+        }
+
+        /**
+         * @brief This function converts a vertex color into packed rgba8
+         * @param color vertex color
+         * @return packed color, red in the lowest byte
+        */
+        FORCEINLINE static uint32_t rgba8( const color_t &color ) {
+#ifdef DX_COMPACT_VERTEX
+            return color;
+#else
+            return color.pack();
+#endif
+        }
+
+        /**
+         * @brief This function converts coordinates into the vertex position type
+         * @param coordinates vector coordinates
+         * @return vertex position
+        */
+        FORCEINLINE static position_t position( const Vector3 &coordinates ) {
+#ifdef DX_COMPACT_VERTEX
+            return { coordinates.x, coordinates.y };
+#else
+            return coordinates;
+#endif
+        }
+
+        /**
+         * @brief This function converts texture coordinates into the vertex texture coordinate type
+         * @param u horizontal texture coordinate, within [0, 1]
+         * @param v vertical texture coordinate, within [0, 1]
+         * @return vertex texture coordinates
+        */
+        FORCEINLINE static uv_t pack_uv( const float u, const float v ) {
+#ifdef DX_COMPACT_VERTEX
+            const auto unorm16 = []( const float x ) { return ( uint32_t ) ( std::clamp( x, 0.f, 1.f ) * 65535.f + 0.5f ); };
+
+            return unorm16( u ) | unorm16( v ) << 16;
+#else
+            return { u, v };
+#endif
+        }
+
+        /**
+         * @brief This function converts vertex texture coordinates back into floats
+         * @param uv vertex texture coordinates
+         * @return horizontal and vertical texture coordinate
+        */
+        FORCEINLINE static Vector2 unpack_uv( const uv_t &uv ) {
+#ifdef DX_COMPACT_VERTEX
+            return { ( float ) ( uv & 0xffff ) / 65535.f, ( float ) ( uv >> 16 ) / 65535.f };
+#else
+            return uv;
+#endif
+        }
+
         /**
          * @brief The default constructor for the Vertex class
         */
-        FORCEINLINE Vertex() : m_coordinates{}, m_color{} {
+        FORCEINLINE Vertex() : m_coordinates{}, m_color{}, m_uv{} {
 
         }
 
@@ -22,38 +102,73 @@ namespace dx {
          * @param coordinates vector coordinates
          * @param color rgba color
         */
-        FORCEINLINE Vertex( const Vector3 &coordinates, const Color &color ) : m_coordinates{ coordinates }, m_color{ color } {
+        FORCEINLINE Vertex( const Vector3 &coordinates, const Color &color ) : m_coordinates{ position( coordinates ) }, m_color{ pack( color ) }, m_uv{} {
+
+        }
+
+        /**
+         * @brief The packed color constructor
+         * @param x x-position
+         * @param y y-position
+         * @param color vertex color
+        */
+        FORCEINLINE Vertex( const float x, const float y, const color_t &color ) : m_coordinates{ position( { x, y, 0.f } ) }, m_color{ color }, m_uv{} {
+
+        }
+
+        /**
+         * @brief The textured constructor
+         * @param x x-position
+         * @param y y-position
+         * @param color vertex color, multiplied with the texture
+         * @param uv vertex texture coordinates
+        */
+        FORCEINLINE Vertex( const float x, const float y, const color_t &color, const uv_t &uv ) : m_coordinates{ position( { x, y, 0.f } ) }, m_color{ color }, m_uv{ uv } {
 
         }
-          
+
         /**
          * @brief This function initializes the vertex
          * @param coordinates vector coordinates
          * @param color rgba color
         */
         FORCEINLINE void init( const Vector3 &coordinates, const Color &color ) {
-            m_coordinates = coordinates;
-            m_color = color;
+            m_coordinates = position( coordinates );
+            m_color       = pack( color );
+            m_uv          = {};
         }
 
         /**
-         * @brief This function returns the vertex 3-dimensional coordinates
+         * @brief This function returns the vertex coordinates
          * @return coordinate vector
         */
-        FORCEINLINE Vector3 &coordinates() {
+        FORCEINLINE position_t &coordinates() {
             return m_coordinates;
         }
 
         /**
-         * @brief This functionr eturns the rgba color
-         * @return rgba color
+         * @brief This functionr eturns the vertex color
+         * @return vertex color
         */
-        FORCEINLINE Color &color() {
-            m_color;
+        FORCEINLINE color_t &color() {
+            return m_color;
+        }
+
+        /**
+         * @brief This function returns the vertex texture coordinates
+         * @return vertex texture coordinates
+        */
+        FORCEINLINE uv_t &uv() {
+            return m_uv;
         }
 
     private:
-        Vector3 m_coordinates; // 3-dimensional coordinate vector
-        Color   m_color;       // color rgba
+        position_t m_coordinates; // vertex coordinates
+        color_t    m_color;       // vertex color
+        uv_t       m_uv;          // vertex texture coordinates, unused by untextured batches
     };
+
+#ifdef DX_COMPACT_VERTEX
+    static_assert( sizeof( Vertex ) == 16, "compact vertex has to match the input layout" );
+#endif
 }
\ No newline at end of file
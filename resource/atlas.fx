@@ -0,0 +1,8 @@
+#include "sprite.hlsli"
+
+Texture2D    atlas_texture : register( t0 );
+SamplerState atlas_sampler : register( s0 );
+
+float4 sprite_pixel_shader( VS_Output_t ps_in ) : SV_TARGET {
+    return atlas_texture.Sample( atlas_sampler, ps_in.m_uv ) * ps_in.m_col;
+}
@@ -0,0 +1,12 @@
+#include "sprite.hlsli"
+
+Texture2D    distance_texture : register( t0 );
+SamplerState distance_sampler : register( s0 );
+
+float4 distance_pixel_shader( VS_Output_t ps_in ) : SV_TARGET {
+    // distances are stored around 0.5 on the edge, the screen space rate of change keeps the edge one pixel wide at any size
+    const float dist  = distance_texture.Sample( distance_sampler, ps_in.m_uv ).r;
+    const float width = max( fwidth( dist ), 1e-4f );
+
+    return float4( ps_in.m_col.rgb, ps_in.m_col.a * saturate( ( dist - 0.5f ) / width + 0.5f ) );
+}
@@ -0,0 +1,28 @@
+#include "shape.hlsli"
+
+// signed distance to the edge of a shape, matches dx::Sdf::distance
+float sdf_distance( float2 local, float4 shape ) {
+    float2 half_size = shape.xy;
+    float  radius    = shape.z;
+    float  stroke    = shape.w;
+
+    // distance to the corner-rounded box, relative to its center
+    float2 q    = abs( local ) - half_size + radius;
+    float  dist = length( max( q, 0.f ) ) + min( max( q.x, q.y ), 0.f ) - radius;
+
+    // hollow out everything further inside than the stroke
+    if ( stroke > 0.f )
+        dist = abs( dist + stroke * 0.5f ) - stroke * 0.5f;
+
+    return dist;
+}
+
+float4 shape_pixel_shader( VS_Output_t ps_in ) : SV_TARGET {
+    float4 col = ps_in.m_col;
+
+    // coverage of a pixel wide box filter across the edge, matches dx::Sdf::coverage
+    if ( ps_in.m_kind == SHAPE_SDF_ROUNDED_RECT )
+        col.a *= saturate( 0.5f - sdf_distance( ps_in.m_local, ps_in.m_shape ) );
+
+    return col;
+}
@@ -0,0 +1,48 @@
+cbuffer proj_buffer : register( b0 ) {
+    matrix proj_matrix;
+};
+
+#include "shape.hlsli"
+
+struct VS_Input_t {
+    float2 m_unit   : POSITION;  // unit mesh position
+    float2 m_pos    : INSTANCE0; // rect: top-left corner, line: start, ellipse and sdf: center
+    float2 m_size   : INSTANCE1; // rect: dimensions, line: end, ellipse: radii, sdf: half dimensions
+    float2 m_params : INSTANCE2; // line: thickness in x, sdf: corner radius in x and stroke in y
+    float4 m_col    : COLOR;
+    uint   m_kind   : KIND;
+};
+
+VS_Output_t shape_vertex_shader( VS_Input_t vs_in ) {
+    VS_Output_t ret;
+    float2      pos;
+
+    ret.m_local = 0.f;
+    ret.m_shape = 0.f;
+
+    // stretch the unit quad from start to end, extended by the thickness on both sides
+    if ( vs_in.m_kind == SHAPE_LINE ) {
+        float2 diff = vs_in.m_size - vs_in.m_pos;
+        float2 norm = normalize( float2( -diff.y, diff.x ) );
+
+        pos = vs_in.m_pos + diff * vs_in.m_unit.x + norm * vs_in.m_params.x * ( vs_in.m_unit.y * 2.f - 1.f );
+    }
+
+    // center the unit quad on the shape, padded so the pixel shader can fade out the edge
+    else if ( vs_in.m_kind == SHAPE_SDF_ROUNDED_RECT ) {
+        ret.m_local = ( vs_in.m_unit * 2.f - 1.f ) * ( vs_in.m_size + SDF_AA_PADDING );
+        ret.m_shape = float4( vs_in.m_size, vs_in.m_params );
+
+        pos = vs_in.m_pos + ret.m_local;
+    }
+
+    // scale the unit quad or circle fan
+    else
+        pos = vs_in.m_pos + vs_in.m_unit * vs_in.m_size;
+
+    ret.m_pos  = mul( proj_matrix, float4( pos, 0.f, 1.f ) );
+    ret.m_col  = vs_in.m_col;
+    ret.m_kind = vs_in.m_kind;
+
+    return ret;
+}
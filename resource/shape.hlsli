@@ -0,0 +1,16 @@
+// shape kinds, match dx::ShapeKind
+static const uint SHAPE_RECT             = 0;
+static const uint SHAPE_LINE             = 1;
+static const uint SHAPE_ELLIPSE          = 2;
+static const uint SHAPE_SDF_ROUNDED_RECT = 3;
+
+// pixels the sdf quad extends past the shape so the edge can fade out, matches dx::Sdf::AA_PADDING
+static const float SDF_AA_PADDING = 1.f;
+
+struct VS_Output_t {
+    float4                 m_pos   : SV_POSITION;
+    float4                 m_col   : COLOR;
+    float2                 m_local : LOCAL; // sdf: position relative to the center
+    nointerpolation float4 m_shape : SHAPE; // sdf: half dimensions, corner radius, stroke
+    nointerpolation uint   m_kind  : KIND;
+};
@@ -0,0 +1,21 @@
+cbuffer proj_buffer : register( b0 ) {
+    matrix proj_matrix;
+};
+
+#include "sprite.hlsli"
+
+struct VS_Input_t {
+    float4 m_pos : POSITION;
+    float4 m_col : COLOR;
+    float2 m_uv  : TEXCOORD;
+};
+
+VS_Output_t sprite_vertex_shader( VS_Input_t vs_in ) {
+    VS_Output_t ret;
+
+    ret.m_pos = mul( proj_matrix, float4( vs_in.m_pos.xy, 0.f, 1.f ) );
+    ret.m_col = vs_in.m_col;
+    ret.m_uv  = vs_in.m_uv;
+
+    return ret;
+}
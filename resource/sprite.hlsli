@@ -0,0 +1,5 @@
+struct VS_Output_t {
+    float4 m_pos : SV_POSITION;
+    float4 m_col : COLOR;
+    float2 m_uv  : TEXCOORD;
+};
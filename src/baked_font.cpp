@@ -0,0 +1,202 @@
+#include "baked_font.h"
+#include "texture_atlas.h"
+
+#include <cstdio>
+
+using namespace dx;
+
+bool BakedFont::open( const char *path ) {
+    m_header = nullptr;
+    m_glyphs = nullptr;
+
+    if ( !m_file.open( path ) )
+        return false;
+
+    const auto              data   = m_file.data();
+    const BakedFontHeader_t *header = ( const BakedFontHeader_t * ) data.data();
+
+    // only the header and the table bounds are checked, glyph records are checked when looked up.
+    // the page bounds divide instead of multiplying, so a corrupted offset or stride cannot wrap around
+    if ( data.size() < sizeof( BakedFontHeader_t ) || header->m_magic != MAGIC || header->m_version != VERSION ||
+         !( header->m_em_size > 0.f ) || !( header->m_spread > 0.f ) || header->m_glyph_offset % alignof( BakedGlyph_t ) ||
+         header->m_glyph_offset + ( uint64_t ) header->m_glyph_count * sizeof( BakedGlyph_t ) > data.size() ||
+         !header->m_page_stride || header->m_page_stride < ( uint64_t ) header->m_page_width * header->m_page_height ||
+         header->m_page_offset > data.size() || header->m_page_count > ( data.size() - header->m_page_offset ) / header->m_page_stride ) {
+        m_file.close();
+        return false;
+    }
+
+    m_header = header;
+    m_glyphs = ( const BakedGlyph_t * ) ( data.data() + header->m_glyph_offset );
+
+    return true;
+}
+
+const BakedGlyph_t *BakedFont::find( const uint32_t codepoint ) const {
+    const BakedGlyph_t *end   = m_glyphs + m_header->m_glyph_count;
+    const BakedGlyph_t *glyph = std::lower_bound( m_glyphs, end, codepoint, []( const BakedGlyph_t &g, const uint32_t cp ) { return g.m_codepoint < cp; } );
+
+    if ( glyph == end || glyph->m_codepoint != codepoint )
+        return nullptr;
+
+    // a record pointing outside its page would sample another glyph or past the file
+    if ( glyph->m_width && ( glyph->m_page >= m_header->m_page_count || glyph->m_x + glyph->m_width > m_header->m_page_width ||
+                             glyph->m_y + glyph->m_height > m_header->m_page_height ) )
+        return nullptr;
+
+    return glyph;
+}
+
+bool BakedFont::rasterize( const uint32_t codepoint, const float size, Glyph_t &glyph ) {
+    const BakedGlyph_t *baked = find( codepoint );
+
+    if ( !baked )
+        return false;
+
+    const float scale = size / m_header->m_em_size;
+    const auto  dist  = page( baked->m_page );
+
+    glyph.m_width    = baked->m_width ? ( uint32_t ) std::ceil( baked->m_width * scale ) : 0;
+    glyph.m_height   = baked->m_width ? ( uint32_t ) std::ceil( baked->m_height * scale ) : 0;
+    glyph.m_offset_x = baked->m_offset_x * scale;
+    glyph.m_offset_y = baked->m_offset_y * scale;
+    glyph.m_advance  = baked->m_advance * scale;
+    glyph.m_pixels.assign( ( size_t ) glyph.m_width * glyph.m_height, 0 );
+
+    // the stored range spans twice the spread, one screen pixel of it fades the edge
+    const float sharpness = 2.f * m_header->m_spread * scale;
+
+    const auto sample = [ & ]( const int x, const int y ) {
+        const int cx = std::clamp( x, 0, baked->m_width - 1 );
+        const int cy = std::clamp( y, 0, baked->m_height - 1 );
+
+        return ( float ) dist[ ( size_t ) ( baked->m_y + cy ) * m_header->m_page_width + baked->m_x + cx ] / 255.f;
+    };
+
+    for ( uint32_t y{}; y < glyph.m_height; ++y ) {
+        for ( uint32_t x{}; x < glyph.m_width; ++x ) {
+            // bilinear sample at the pixel center, like the sampler of the distance field shader
+            const float sx = ( ( float ) x + 0.5f ) / scale - 0.5f;
+            const float sy = ( ( float ) y + 0.5f ) / scale - 0.5f;
+            const int   x0 = ( int ) std::floor( sx );
+            const int   y0 = ( int ) std::floor( sy );
+            const float fx = sx - ( float ) x0;
+            const float fy = sy - ( float ) y0;
+
+            const float d = std::lerp( std::lerp( sample( x0, y0 ), sample( x0 + 1, y0 ), fx ),
+                                       std::lerp( sample( x0, y0 + 1 ), sample( x0 + 1, y0 + 1 ), fx ), fy );
+
+            const float alpha = std::clamp( ( d - 0.5f ) * sharpness + 0.5f, 0.f, 1.f );
+
+            glyph.m_pixels[ ( size_t ) y * glyph.m_width + x ] = 0x00ffffff | ( uint32_t ) ( alpha * 255.f + 0.5f ) << 24;
+        }
+    }
+
+    return true;
+}
+
+float BakedFont::line_height( const float size ) {
+    return m_header->m_line_height * size / m_header->m_em_size;
+}
+
+bool BakedFont::bake( Font &font, const char *path, const float em_size, const float spread, const uint32_t first, const uint32_t last, const uint32_t page_size ) {
+    const uint32_t pad    = ( uint32_t ) std::ceil( spread );
+    const float    radius = spread * SUPERSAMPLES;
+    const auto     align  = []( const uint64_t x ) { return ( x + PAGE_ALIGNMENT - 1 ) / PAGE_ALIGNMENT * PAGE_ALIGNMENT; };
+
+    std::vector< BakedGlyph_t >           glyphs;
+    std::vector< std::vector< uint8_t > > pages;
+    TextureAtlas                          atlas{ page_size, UINT16_MAX };
+    Glyph_t                               source;
+
+    if ( !( em_size > 0.f ) || !( spread > 0.f ) || first > last )
+        return false;
+
+    for ( uint32_t codepoint = first; codepoint <= last; ++codepoint ) {
+        // rasterize the source at a multiple of the baked size, the distances are measured on its edges
+        if ( !font.rasterize( codepoint, em_size * SUPERSAMPLES, source ) )
+            continue;
+
+        BakedGlyph_t glyph{ codepoint, 0, 0, 0, 0, 0, 0, 0.f, 0.f, source.m_advance / SUPERSAMPLES };
+
+        if ( !source.m_width || !source.m_height ) {
+            glyphs.push_back( glyph );
+            continue;
+        }
+
+        const uint32_t width  = ( source.m_width + SUPERSAMPLES - 1 ) / SUPERSAMPLES + pad * 2;
+        const uint32_t height = ( source.m_height + SUPERSAMPLES - 1 ) / SUPERSAMPLES + pad * 2;
+        AtlasRegion_t  region;
+
+        // every page has the same size in the file, a glyph larger than a page cannot be baked
+        if ( width + TextureAtlas::PADDING > page_size || height + TextureAtlas::PADDING > page_size ||
+             atlas.acquire( codepoint, width, height, region ) == AtlasResult::FAILED )
+            return false;
+
+        if ( region.m_page >= pages.size() )
+            pages.resize( region.m_page + 1, std::vector< uint8_t >( ( size_t ) page_size * page_size ) );
+
+        const auto inside = [ & ]( const int x, const int y ) {
+            return x >= 0 && y >= 0 && x < ( int ) source.m_width && y < ( int ) source.m_height &&
+                   source.m_pixels[ ( size_t ) y * source.m_width + x ] >> 24 >= 128;
+        };
+
+        // brute force the nearest source sample on the other side of the edge, baking is offline
+        for ( uint32_t y{}; y < height; ++y ) {
+            for ( uint32_t x{}; x < width; ++x ) {
+                const float cx      = ( ( float ) x - ( float ) pad + 0.5f ) * SUPERSAMPLES;
+                const float cy      = ( ( float ) y - ( float ) pad + 0.5f ) * SUPERSAMPLES;
+                const bool  in      = inside( ( int ) cx, ( int ) cy );
+                float       nearest = radius;
+
+                for ( int sy = ( int ) ( cy - radius ); sy <= ( int ) ( cy + radius ); ++sy ) {
+                    for ( int sx = ( int ) ( cx - radius ); sx <= ( int ) ( cx + radius ); ++sx ) {
+                        if ( inside( sx, sy ) != in )
+                            nearest = std::min( nearest, std::hypot( ( float ) sx + 0.5f - cx, ( float ) sy + 0.5f - cy ) );
+                    }
+                }
+
+                // the edge lies halfway between the samples, distances are signed positive inside
+                const float dist  = std::max( nearest - 0.5f * SUPERSAMPLES, 0.f ) / SUPERSAMPLES;
+                const float value = 0.5f + ( in ? dist : -dist ) / ( 2.f * spread );
+
+                pages[ region.m_page ][ ( size_t ) ( region.m_y + y ) * page_size + region.m_x + x ] = ( uint8_t ) std::clamp( value * 255.f + 0.5f, 0.f, 255.f );
+            }
+        }
+
+        glyph.m_page     = ( uint16_t ) region.m_page;
+        glyph.m_x        = ( uint16_t ) region.m_x;
+        glyph.m_y        = ( uint16_t ) region.m_y;
+        glyph.m_width    = ( uint16_t ) width;
+        glyph.m_height   = ( uint16_t ) height;
+        glyph.m_offset_x = source.m_offset_x / SUPERSAMPLES - ( float ) pad;
+        glyph.m_offset_y = source.m_offset_y / SUPERSAMPLES - ( float ) pad;
+
+        glyphs.push_back( glyph );
+    }
+
+    // the glyph table follows the header, the pages follow the table
+    const uint32_t glyph_offset = ( uint32_t ) sizeof( BakedFontHeader_t );
+    const uint64_t page_offset  = align( glyph_offset + glyphs.size() * sizeof( BakedGlyph_t ) );
+    const uint64_t page_stride  = align( ( uint64_t ) page_size * page_size );
+
+    const BakedFontHeader_t header{ MAGIC, VERSION, em_size, spread, font.line_height( em_size ), page_size, page_size, ( uint32_t ) pages.size(), ( uint32_t ) glyphs.size(),
+                                    glyph_offset, page_offset, page_stride };
+
+    // lay the file out in memory, the gaps up to the page alignment stay zero
+    std::vector< uint8_t > file( header.m_page_offset + pages.size() * header.m_page_stride );
+
+    std::memcpy( file.data(), &header, sizeof( header ) );
+    std::memcpy( file.data() + header.m_glyph_offset, glyphs.data(), glyphs.size() * sizeof( BakedGlyph_t ) );
+
+    for ( size_t i{}; i < pages.size(); ++i )
+        std::memcpy( file.data() + header.m_page_offset + i * header.m_page_stride, pages[ i ].data(), pages[ i ].size() );
+
+    FILE *out = std::fopen( path, "wb" );
+    if ( !out )
+        return false;
+
+    const bool written = std::fwrite( file.data(), 1, file.size(), out ) == file.size();
+
+    return std::fclose( out ) == 0 && written;
+}
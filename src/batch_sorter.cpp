@@ -0,0 +1,251 @@
+#include "batch_sorter.h"
+
+using namespace dx;
+
+size_t BatchSorter::sort( RenderList &list ) {
+    const auto &batches = list.batches();
+
+    if ( batches.size() < 2 )
+        return 0;
+
+    m_groups.clear();
+    m_levels.clear();
+    m_keys.clear();
+
+    for ( uint32_t i{}; i < batches.size(); ++i ) {
+        const auto &b = batches[ i ];
+        uint64_t   key;
+
+        // a dropped reservation can leave an empty batch behind, it is left out of the sorted list
+        if ( !b.instanced() && !b.retained() && !b.m_index_count )
+            continue;
+
+        // a list with more levels than the key holds is drawn in submission order
+        if ( !place( batches, i, key ) )
+            return 0;
+
+        m_keys.push_back( key );
+    }
+
+    if ( m_keys.empty() )
+        return 0;
+
+    radix_sort();
+
+    return merge( list );
+}
+
+bool BatchSorter::place( const FrameVector< Batch_t > &batches, const uint32_t batch, uint64_t &key ) {
+    const auto       &b = batches[ batch ];
+    const ClipRect_t bounds{ b.m_bounds.m_min - Vector2{ PADDING, PADDING }, b.m_bounds.m_max + Vector2{ PADDING, PADDING } };
+    uint32_t         level{ ( uint32_t ) m_levels.size() };
+    uint32_t         found{ NONE };
+    uint32_t         found_level{};
+    size_t           tests{};
+
+    // from the top down, the batch sinks through the levels until one holds a batch it has to be drawn after
+    for ( uint32_t l{ level }; l-- > 0; ) {
+        uint32_t match{ NONE };
+        bool     match_overlaps{};
+        bool     blocked{};
+
+        for ( uint32_t g{ m_levels[ l ].m_first }; g != NONE && !blocked; g = m_groups[ g ].m_next ) {
+            const auto &group   = m_groups[ g ];
+            const bool overlaps = !bounds.outside( group.m_bounds.m_min, group.m_bounds.m_max );
+
+            // the levels below the ones tested are treated as overlapped
+            if ( ++tests > MAX_TESTS )
+                blocked = true;
+
+            else if ( compatible( batches[ group.m_batch ], b ) ) {
+                match          = g;
+                match_overlaps = overlaps;
+            }
+
+            else
+                blocked = overlaps;
+        }
+
+        // an incompatible batch it overlaps has to be drawn first, so it stays above the level
+        if ( blocked )
+            break;
+
+        level = l;
+
+        // a compatible batch it overlaps keeps it from sinking further, it is drawn after it within the group
+        if ( match != NONE ) {
+            found       = match;
+            found_level = l;
+
+            if ( match_overlaps )
+                break;
+        }
+    }
+
+    // join the compatible group of the lowest level it can be drawn in
+    if ( found != NONE ) {
+        auto &group = m_groups[ found ];
+
+        group.m_bounds = group.m_bounds.unite( b.m_bounds );
+
+        key = ( uint64_t ) found_level << 40 | ( uint64_t ) group.m_index << 32 | batch;
+
+        return true;
+    }
+
+    // or start a group there, the levels above are clear of batches it overlaps as well when the level is full
+    while ( level < m_levels.size() && m_levels[ level ].m_count >= MAX_GROUPS )
+        ++level;
+
+    if ( level == m_levels.size() ) {
+        if ( level > MAX_LEVELS )
+            return false;
+
+        m_levels.push_back( { NONE, NONE, 0 } );
+    }
+
+    auto           &l = m_levels[ level ];
+    const uint32_t g  = ( uint32_t ) m_groups.size();
+
+    m_groups.push_back( { b.m_bounds, batch, l.m_count, NONE } );
+
+    if ( l.m_last != NONE )
+        m_groups[ l.m_last ].m_next = g;
+
+    else
+        l.m_first = g;
+
+    l.m_last = g;
+    ++l.m_count;
+
+    key = ( uint64_t ) level << 40 | ( uint64_t ) m_groups[ g ].m_index << 32 | batch;
+
+    return true;
+}
+
+void BatchSorter::radix_sort() {
+    m_sorted.resize( m_keys.size() );
+
+    // the keys are made in submission order, so a stable sort of the level and group bytes leaves the batches of a group in order
+    for ( size_t shift{ 32 }; shift < 64; shift += 8 ) {
+        size_t counts[ 256 ]{};
+        size_t offset{};
+
+        for ( const uint64_t key : m_keys )
+            ++counts[ key >> shift & 0xff ];
+
+        // a byte every key shares leaves the order as is
+        if ( counts[ m_keys.front() >> shift & 0xff ] == m_keys.size() )
+            continue;
+
+        for ( auto &count : counts )
+            offset += std::exchange( count, offset );
+
+        for ( const uint64_t key : m_keys )
+            m_sorted[ counts[ key >> shift & 0xff ]++ ] = key;
+
+        m_keys.swap( m_sorted );
+    }
+}
+
+size_t BatchSorter::merge( RenderList &list ) {
+    auto       &batches   = list.batches();
+    const auto &vertices  = list.vertices();
+    const auto &indices   = list.indices();
+    const auto &instances = list.instances();
+    auto       &tracked   = list.tracked();
+    size_t     merged{};
+    bool       changed{};
+
+    // a list already in order with no compatible neighbours is left as is
+    for ( size_t i{ 1 }; i < m_keys.size() && !changed; ++i ) {
+        const auto &a = batches[ ( uint32_t ) m_keys[ i - 1 ] ];
+        const auto &b = batches[ ( uint32_t ) m_keys[ i ] ];
+
+        changed = ( uint32_t ) m_keys[ i ] < ( uint32_t ) m_keys[ i - 1 ] || compatible( a, b );
+    }
+
+    if ( !changed )
+        return 0;
+
+    // the sorted list is as large as the list, so each vector is allocated once
+    FrameVector< Vertex >             sorted_vertices( list.allocator() );
+    FrameVector< uint32_t >           sorted_indices( list.allocator() );
+    FrameVector< ShapeInstance_t >    sorted_instances( list.allocator() );
+    FrameVector< Batch_t >            sorted_batches( list.allocator() );
+    FrameVector< TrackedPrimitive_t > sorted_tracked( list.allocator() );
+
+    sorted_vertices.reserve( vertices.size() );
+    sorted_indices.reserve( indices.size() );
+    sorted_instances.reserve( instances.size() );
+    sorted_batches.reserve( m_keys.size() );
+    sorted_tracked.reserve( tracked.size() );
+
+    // the tracked primitives are in batch order, each batch starts where the previous one ended
+    if ( !tracked.empty() ) {
+        m_tracked_first.assign( batches.size() + 1, 0 );
+
+        for ( const auto &primitive : tracked )
+            ++m_tracked_first[ primitive.m_batch + 1 ];
+
+        for ( size_t i{}; i < batches.size(); ++i )
+            m_tracked_first[ i + 1 ] += m_tracked_first[ i ];
+    }
+
+    for ( const uint64_t key : m_keys ) {
+        const uint32_t index = ( uint32_t ) key;
+        const auto     &b    = batches[ index ];
+
+        // a batch is merged into the previous one unless that would take it past 16-bit indices
+        if ( sorted_batches.empty() || !compatible( sorted_batches.back(), b ) ||
+             ( !b.instanced() && sorted_batches.back().m_vertex_count + b.m_vertex_count > Batch_t::MAX_NARROW_VERTICES ) ) {
+            auto &batch = sorted_batches.emplace_back( b );
+
+            batch.m_base_vertex    = sorted_vertices.size();
+            batch.m_vertex_count   = 0;
+            batch.m_start_index    = sorted_indices.size();
+            batch.m_index_count    = 0;
+            batch.m_first_instance = sorted_instances.size();
+            batch.m_instance_count = 0;
+        }
+
+        else
+            ++merged;
+
+        auto           &batch   = sorted_batches.back();
+        const uint32_t offset   = ( uint32_t ) batch.m_vertex_count;
+        const size_t   first    = batch.instanced() ? batch.m_instance_count : batch.m_index_count;
+        const size_t   index_at = sorted_indices.size();
+
+        sorted_vertices.insert( sorted_vertices.end(), vertices.begin() + b.m_base_vertex, vertices.begin() + b.m_base_vertex + b.m_vertex_count );
+        sorted_instances.insert( sorted_instances.end(), instances.begin() + b.m_first_instance, instances.begin() + b.m_first_instance + b.m_instance_count );
+
+        // the indices are local to the batch, so those of a merged batch are offset by the vertices before it
+        sorted_indices.resize( index_at + b.m_index_count );
+
+        for ( size_t i{}; i < b.m_index_count; ++i )
+            sorted_indices[ index_at + i ] = indices[ b.m_start_index + i ] + offset;
+
+        if ( !tracked.empty() ) {
+            for ( uint32_t p{ m_tracked_first[ index ] }; p < m_tracked_first[ index + 1 ]; ++p ) {
+                auto &primitive = sorted_tracked.emplace_back( tracked[ p ] );
+
+                primitive.m_batch  = ( uint32_t ) sorted_batches.size() - 1;
+                primitive.m_first += ( uint32_t ) first;
+            }
+        }
+
+        batch.m_vertex_count   += b.m_vertex_count;
+        batch.m_index_count    += b.m_index_count;
+        batch.m_instance_count += b.m_instance_count;
+        batch.m_bounds          = batch.m_bounds.unite( b.m_bounds );
+    }
+
+    list.vertices().swap( sorted_vertices );
+    list.indices().swap( sorted_indices );
+    list.instances().swap( sorted_instances );
+    batches.swap( sorted_batches );
+    tracked.swap( sorted_tracked );
+
+    return merged;
+}
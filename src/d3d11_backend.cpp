@@ -0,0 +1,819 @@
+#include "d3d11_backend.h"
+
+#ifdef DX_PLATFORM_WINDOWS
+
+#include "vertex_shader.h"
+#include "pixel_shader.h"
+#include "shape_vertex_shader.h"
+#include "shape_pixel_shader.h"
+#include "sprite_vertex_shader.h"
+#include "sprite_pixel_shader.h"
+#include "distance_pixel_shader.h"
+
+#include <DirectXMath.h>
+
+using namespace dx;
+using namespace DirectX;
+
+bool D3D11Backend::create( ID3D11Device *dev, ID3D11DeviceContext *dev_ctx ) {
+    D3D11_BLEND_DESC      blend_desc{};
+    D3D11_SAMPLER_DESC    sampler_desc{};
+    D3D11_RASTERIZER_DESC rasterizer_desc{};
+    HRESULT               hr;
+
+    if ( !dev || !dev_ctx )
+        return false;
+
+    m_dev_ctx = dev_ctx;
+    m_dev     = dev;
+
+    hr = m_dev->CreateVertexShader( vertex_shader.data(), sizeof( vertex_shader ), nullptr, &m_vertex_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    hr = m_dev->CreatePixelShader( pixel_shader.data(), sizeof( pixel_shader ), nullptr, &m_pixel_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize textured shaders, they read the same vertices
+    hr = m_dev->CreateVertexShader( sprite_vertex_shader, sizeof( sprite_vertex_shader ), nullptr, &m_sprite_vertex_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    hr = m_dev->CreatePixelShader( sprite_pixel_shader, sizeof( sprite_pixel_shader ), nullptr, &m_sprite_pixel_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    hr = m_dev->CreatePixelShader( distance_pixel_shader, sizeof( distance_pixel_shader ), nullptr, &m_distance_pixel_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    // missing position components are filled with the input assembler defaults, the shaders only read .xy.
+    // the layout is validated against the textured shader, the flat one ignores the texture coordinates
+    const std::array< D3D11_INPUT_ELEMENT_DESC, 3 > input_layout_desc = {
+#ifdef DX_COMPACT_VERTEX
+        D3D11_INPUT_ELEMENT_DESC{ "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,	 0, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        D3D11_INPUT_ELEMENT_DESC{ "COLOR",	  0, DXGI_FORMAT_R8G8B8A8_UNORM,	 0, 8,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        D3D11_INPUT_ELEMENT_DESC{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_UNORM,	 0, 12,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+#else
+        D3D11_INPUT_ELEMENT_DESC{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,	 0, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        D3D11_INPUT_ELEMENT_DESC{ "COLOR",	  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        D3D11_INPUT_ELEMENT_DESC{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,	 0, 28,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+#endif
+    };
+
+    hr = m_dev->CreateInputLayout( input_layout_desc.data(), input_layout_desc.size(),
+                                    sprite_vertex_shader, sizeof( sprite_vertex_shader ), &m_input_layout );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize sampler state, atlas images are padded so bilinear filtering does not bleed
+    sampler_desc.Filter         = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    sampler_desc.AddressU       = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampler_desc.AddressV       = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampler_desc.AddressW       = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampler_desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    sampler_desc.MaxLOD         = D3D11_FLOAT32_MAX;
+
+    hr = m_dev->CreateSamplerState( &sampler_desc, &m_sampler_state );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize instanced shape shader, the unit mesh is read from slot 0 and the instances from slot 1
+    hr = m_dev->CreateVertexShader( shape_vertex_shader, sizeof( shape_vertex_shader ), nullptr, &m_shape_vertex_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    const std::array< D3D11_INPUT_ELEMENT_DESC, 6 > shape_input_layout_desc = {
+        D3D11_INPUT_ELEMENT_DESC{ "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,   0, 0,  D3D11_INPUT_PER_VERTEX_DATA,   0 },
+        D3D11_INPUT_ELEMENT_DESC{ "INSTANCE", 0, DXGI_FORMAT_R32G32_FLOAT,   1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        D3D11_INPUT_ELEMENT_DESC{ "INSTANCE", 1, DXGI_FORMAT_R32G32_FLOAT,   1, 8,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        D3D11_INPUT_ELEMENT_DESC{ "INSTANCE", 2, DXGI_FORMAT_R32G32_FLOAT,   1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        D3D11_INPUT_ELEMENT_DESC{ "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 24, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        D3D11_INPUT_ELEMENT_DESC{ "KIND",     0, DXGI_FORMAT_R32_UINT,       1, 28, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    };
+
+    hr = m_dev->CreateInputLayout( shape_input_layout_desc.data(), shape_input_layout_desc.size(),
+                                    shape_vertex_shader, sizeof( shape_vertex_shader ), &m_shape_input_layout );
+    if ( FAILED( hr ) )
+        return false;
+
+    // the shape pixel shader fades out the edges of signed distance shapes and passes the other kinds through
+    hr = m_dev->CreatePixelShader( shape_pixel_shader, sizeof( shape_pixel_shader ), nullptr, &m_shape_pixel_shader );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize blend state
+    blend_desc.RenderTarget->BlendEnable           = TRUE;
+    blend_desc.RenderTarget->SrcBlend              = D3D11_BLEND_SRC_ALPHA;
+    blend_desc.RenderTarget->DestBlend             = D3D11_BLEND_INV_SRC_ALPHA;
+    blend_desc.RenderTarget->SrcBlendAlpha         = D3D11_BLEND_INV_DEST_ALPHA;
+    blend_desc.RenderTarget->DestBlendAlpha        = D3D11_BLEND_ONE;
+    blend_desc.RenderTarget->BlendOp               = D3D11_BLEND_OP_ADD;
+    blend_desc.RenderTarget->BlendOpAlpha          = D3D11_BLEND_OP_ADD;
+    blend_desc.RenderTarget->RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+    hr = m_dev->CreateBlendState( &blend_desc, &m_blend_state );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize rasterizer state, the scissor test clips the batches recorded within a clip rect
+    rasterizer_desc.FillMode        = D3D11_FILL_SOLID;
+    rasterizer_desc.CullMode        = D3D11_CULL_NONE;
+    rasterizer_desc.DepthClipEnable = TRUE;
+    rasterizer_desc.ScissorEnable   = TRUE;
+
+    hr = m_dev->CreateRasterizerState( &rasterizer_desc, &m_rasterizer_state );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize projection matrix and buffer
+    if ( !project() )
+        return false;
+
+    return true;
+}
+
+void D3D11Backend::destroy() {
+    m_vertex_shader->Release();
+    m_pixel_shader->Release();
+    m_input_layout->Release();
+    m_shape_vertex_shader->Release();
+    m_shape_input_layout->Release();
+    m_shape_pixel_shader->Release();
+    m_sprite_vertex_shader->Release();
+    m_sprite_pixel_shader->Release();
+    m_distance_pixel_shader->Release();
+    m_sampler_state->Release();
+    m_blend_state->Release();
+    m_rasterizer_state->Release();
+    m_proj_buffer->Release();
+
+    if ( m_vertex_buffer )
+        m_vertex_buffer->Release();
+
+    if ( m_index_buffer )
+        m_index_buffer->Release();
+
+    if ( m_instance_buffer )
+        m_instance_buffer->Release();
+
+    for ( auto type : { BufferType::VERTEX, BufferType::INDEX, BufferType::INSTANCE } ) {
+        if ( auto &persistent = persistent_buffer( type ) ) {
+            persistent->Release();
+            persistent = nullptr;
+        }
+    }
+
+    for ( auto &mesh : m_meshes ) {
+        mesh.m_vertex_buffer->Release();
+        mesh.m_index_buffer->Release();
+    }
+
+    m_meshes.clear();
+
+    for ( auto &texture : m_textures ) {
+        texture.m_view->Release();
+        texture.m_texture->Release();
+    }
+
+    m_textures.clear();
+
+    for ( uint32_t i{}; i < m_statics.size(); ++i )
+        destroy_static( i );
+
+    m_statics.clear();
+}
+
+bool D3D11Backend::resize( BufferType type, const size_t size ) {
+    D3D11_BUFFER_DESC buffer_desc{};
+    ID3D11Buffer      *new_buffer{};
+    HRESULT           hr;
+
+    // initialize dynamic buffer
+    buffer_desc.Usage          = D3D11_USAGE_DYNAMIC;
+    buffer_desc.ByteWidth      = size;
+    buffer_desc.BindFlags      = type == BufferType::INDEX ? D3D11_BIND_INDEX_BUFFER : D3D11_BIND_VERTEX_BUFFER;
+    buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    buffer_desc.MiscFlags      = 0;
+
+    hr = m_dev->CreateBuffer( &buffer_desc, NULL, &new_buffer );
+    if ( FAILED( hr ) )
+        return false;
+
+    // replace the previous buffer, pending draws keep their reference
+    auto &current = buffer( type );
+
+    if ( current )
+        current->Release();
+
+    current = new_buffer;
+
+    // rebind before the next draw when grown in the middle of a frame
+    if ( m_in_frame )
+        m_pipeline = Pipeline::NONE;
+
+    return true;
+}
+
+bool D3D11Backend::create_mesh( const uint32_t mesh, std::span< const Vector2 > vertices, std::span< const uint16_t > indices ) {
+    D3D11_BUFFER_DESC      buffer_desc{};
+    D3D11_SUBRESOURCE_DATA data{};
+    Mesh_t                 new_mesh{};
+    HRESULT                hr;
+
+    // initialize immutable vertex buffer
+    buffer_desc.Usage     = D3D11_USAGE_IMMUTABLE;
+    buffer_desc.ByteWidth = ( UINT ) vertices.size_bytes();
+    buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    data.pSysMem          = vertices.data();
+
+    hr = m_dev->CreateBuffer( &buffer_desc, &data, &new_mesh.m_vertex_buffer );
+    if ( FAILED( hr ) )
+        return false;
+
+    // initialize immutable index buffer
+    buffer_desc.ByteWidth = ( UINT ) indices.size_bytes();
+    buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    data.pSysMem          = indices.data();
+
+    hr = m_dev->CreateBuffer( &buffer_desc, &data, &new_mesh.m_index_buffer );
+    if ( FAILED( hr ) ) {
+        new_mesh.m_vertex_buffer->Release();
+        return false;
+    }
+
+    if ( mesh >= m_meshes.size() )
+        m_meshes.resize( mesh + 1 );
+
+    m_meshes[ mesh ] = new_mesh;
+
+    return true;
+}
+
+bool D3D11Backend::create_texture( const uint32_t texture, const uint32_t width, const uint32_t height ) {
+    D3D11_TEXTURE2D_DESC   texture_desc{};
+    D3D11_SUBRESOURCE_DATA texture_data{};
+    Texture_t              new_texture{};
+    HRESULT                hr;
+
+    // the contents of a texture created without data are undefined, the padding between images has to start transparent
+    const std::vector< uint32_t > texels( ( size_t ) width * height );
+
+    // initialize texture, its regions are written with UpdateSubresource
+    texture_desc.Width            = width;
+    texture_desc.Height           = height;
+    texture_desc.MipLevels        = 1;
+    texture_desc.ArraySize        = 1;
+    texture_desc.Format           = DXGI_FORMAT_R8G8B8A8_UNORM;
+    texture_desc.SampleDesc.Count = 1;
+    texture_desc.Usage            = D3D11_USAGE_DEFAULT;
+    texture_desc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
+
+    texture_data.pSysMem     = texels.data();
+    texture_data.SysMemPitch = width * sizeof( uint32_t );
+
+    hr = m_dev->CreateTexture2D( &texture_desc, &texture_data, &new_texture.m_texture );
+    if ( FAILED( hr ) )
+        return false;
+
+    hr = m_dev->CreateShaderResourceView( new_texture.m_texture, nullptr, &new_texture.m_view );
+    if ( FAILED( hr ) ) {
+        new_texture.m_texture->Release();
+        return false;
+    }
+
+    if ( texture >= m_textures.size() )
+        m_textures.resize( texture + 1 );
+
+    m_textures[ texture ] = new_texture;
+
+    return true;
+}
+
+void D3D11Backend::update_texture( const uint32_t texture, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) {
+    const D3D11_BOX box{ x, y, 0, x + width, y + height, 1 };
+
+    m_dev_ctx->UpdateSubresource( m_textures[ texture ].m_texture, 0, &box, pixels.data(), width * sizeof( uint32_t ), 0 );
+}
+
+bool D3D11Backend::create_distance_texture( const uint32_t texture, const uint32_t width, const uint32_t height, std::span< const uint8_t > distances ) {
+    D3D11_TEXTURE2D_DESC   texture_desc{};
+    D3D11_SUBRESOURCE_DATA texture_data{};
+    Texture_t              new_texture{};
+    HRESULT                hr;
+
+    // initialize immutable texture straight from the distances, they are never written again
+    texture_desc.Width            = width;
+    texture_desc.Height           = height;
+    texture_desc.MipLevels        = 1;
+    texture_desc.ArraySize        = 1;
+    texture_desc.Format           = DXGI_FORMAT_R8_UNORM;
+    texture_desc.SampleDesc.Count = 1;
+    texture_desc.Usage            = D3D11_USAGE_IMMUTABLE;
+    texture_desc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
+
+    texture_data.pSysMem     = distances.data();
+    texture_data.SysMemPitch = width;
+
+    hr = m_dev->CreateTexture2D( &texture_desc, &texture_data, &new_texture.m_texture );
+    if ( FAILED( hr ) )
+        return false;
+
+    hr = m_dev->CreateShaderResourceView( new_texture.m_texture, nullptr, &new_texture.m_view );
+    if ( FAILED( hr ) ) {
+        new_texture.m_texture->Release();
+        return false;
+    }
+
+    new_texture.m_distance = true;
+
+    if ( texture >= m_textures.size() )
+        m_textures.resize( texture + 1 );
+
+    m_textures[ texture ] = new_texture;
+
+    return true;
+}
+
+bool D3D11Backend::create_static( const uint32_t geometry, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) {
+    D3D11_BUFFER_DESC      buffer_desc{};
+    D3D11_SUBRESOURCE_DATA data{};
+    Static_t               new_static{};
+
+    // creates an immutable buffer of the contents, empty contents need no buffer
+    const auto create = [ & ]( const void *contents, const size_t size, const UINT bind_flags, ID3D11Buffer *&buffer ) {
+        if ( !size )
+            return true;
+
+        buffer_desc.Usage     = D3D11_USAGE_IMMUTABLE;
+        buffer_desc.ByteWidth = ( UINT ) size;
+        buffer_desc.BindFlags = bind_flags;
+        data.pSysMem          = contents;
+
+        return SUCCEEDED( m_dev->CreateBuffer( &buffer_desc, &data, &buffer ) );
+    };
+
+    if ( !create( vertices.data(), vertices.size_bytes(), D3D11_BIND_VERTEX_BUFFER, new_static.m_vertex_buffer ) ||
+         !create( indices.data(), indices.size_bytes(), D3D11_BIND_INDEX_BUFFER, new_static.m_index_buffer ) ||
+         !create( instances.data(), instances.size_bytes(), D3D11_BIND_VERTEX_BUFFER, new_static.m_instance_buffer ) ) {
+        if ( new_static.m_vertex_buffer )
+            new_static.m_vertex_buffer->Release();
+
+        if ( new_static.m_index_buffer )
+            new_static.m_index_buffer->Release();
+
+        return false;
+    }
+
+    if ( geometry >= m_statics.size() )
+        m_statics.resize( geometry + 1 );
+
+    m_statics[ geometry ] = new_static;
+
+    return true;
+}
+
+void D3D11Backend::destroy_static( const uint32_t geometry ) {
+    auto &g = m_statics[ geometry ];
+
+    if ( g.m_vertex_buffer )
+        g.m_vertex_buffer->Release();
+
+    if ( g.m_index_buffer )
+        g.m_index_buffer->Release();
+
+    if ( g.m_instance_buffer )
+        g.m_instance_buffer->Release();
+
+    g = {};
+}
+
+void D3D11Backend::set_static( const uint32_t geometry, const Vector2 &translation ) {
+    // rebind the input assembler before the next draw when the buffers change
+    if ( geometry != m_bound_static ) {
+        m_bound_static = geometry;
+        m_pipeline     = Pipeline::NONE;
+    }
+
+    if ( translation != m_translation )
+        translate( translation );
+}
+
+bool D3D11Backend::resize_persistent( BufferType type, const size_t size ) {
+    D3D11_BUFFER_DESC buffer_desc{};
+    ID3D11Buffer      *new_buffer{};
+    HRESULT           hr;
+
+    // initialize default buffer, written through the device context instead of mapped
+    buffer_desc.Usage          = D3D11_USAGE_DEFAULT;
+    buffer_desc.ByteWidth      = size;
+    buffer_desc.BindFlags      = type == BufferType::INDEX ? D3D11_BIND_INDEX_BUFFER : D3D11_BIND_VERTEX_BUFFER;
+    buffer_desc.CPUAccessFlags = 0;
+    buffer_desc.MiscFlags      = 0;
+
+    hr = m_dev->CreateBuffer( &buffer_desc, NULL, &new_buffer );
+    if ( FAILED( hr ) )
+        return false;
+
+    auto &current = persistent_buffer( type );
+
+    if ( current )
+        current->Release();
+
+    current = new_buffer;
+
+    if ( m_in_frame && m_persistent )
+        m_pipeline = Pipeline::NONE;
+
+    return true;
+}
+
+void D3D11Backend::update_persistent( BufferType type, const size_t offset, std::span< const uint8_t > bytes ) {
+    const D3D11_BOX box{ ( UINT ) offset, 0, 0, ( UINT ) ( offset + bytes.size_bytes() ), 1, 1 };
+
+    // the driver keeps the contents pending draws read intact, renaming or copying the buffer when it has to
+    m_dev_ctx->UpdateSubresource( persistent_buffer( type ), 0, &box, bytes.data(), 0, 0 );
+}
+
+void D3D11Backend::set_persistent( const bool persistent ) {
+    if ( persistent != m_persistent ) {
+        m_persistent = persistent;
+        m_pipeline   = Pipeline::NONE;
+    }
+}
+
+bool D3D11Backend::project() {
+    D3D11_BUFFER_DESC        proj_buffer_desc{};
+    XMMATRIX                 proj_matrix{};
+    D3D11_MAPPED_SUBRESOURCE resource{};
+    HRESULT                  hr;
+
+    m_screen_size = get_screen_size();
+
+    // initialize projection buffer
+    proj_buffer_desc.Usage          = D3D11_USAGE_DYNAMIC;
+    proj_buffer_desc.ByteWidth      = sizeof( XMMATRIX );
+    proj_buffer_desc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    proj_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    proj_buffer_desc.MiscFlags      = 0;
+
+    hr = m_dev->CreateBuffer( &proj_buffer_desc, NULL, &m_proj_buffer );
+    if ( FAILED( hr ) )
+        return false;
+
+    return translate( {} );
+}
+
+bool D3D11Backend::translate( const Vector2 &translation ) {
+    XMMATRIX                 proj_matrix{};
+    D3D11_MAPPED_SUBRESOURCE resource{};
+    HRESULT                  hr;
+
+    // initialize projection matrix, the translation shifts the visible area the other way
+    proj_matrix = XMMatrixOrthographicOffCenterLH(
+        -translation.x, m_screen_size.x - translation.x, m_screen_size.y - translation.y, -translation.y, 0.f, 1.f
+    );
+
+    hr = m_dev_ctx->Map( m_proj_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource );
+    if ( FAILED( hr ) )
+        return false;
+
+    memcpy( resource.pData, &proj_matrix, sizeof( XMMATRIX ) );
+
+    m_dev_ctx->Unmap( m_proj_buffer, 0 );
+
+    m_translation = translation;
+
+    return true;
+}
+
+Vector2 D3D11Backend::get_screen_size() {
+    D3D11_VIEWPORT viewport;
+    UINT           num_viewports{ 1 };
+
+    m_dev_ctx->RSGetViewports( &num_viewports, &viewport );
+
+    return Vector2( viewport.Width, viewport.Height );
+}
+
+bool D3D11Backend::begin() {
+    if ( !m_dev_ctx )
+        return false;
+
+    m_state_stats = {};
+
+    // an owned context still holds the state of the previous frame
+    if ( m_owns_context )
+        m_state_stats.m_saved += RenderStateBackup::CALLS;
+
+    // capture current render state, anything may have been set since the last frame
+    else {
+        if ( !m_render_state_backup.capture( m_dev_ctx ) )
+            return false;
+
+        m_cache = {};
+    }
+
+    // set custom rendering settings
+    set_custom_state();
+
+    m_in_frame = true;
+
+    return true;
+}
+
+void D3D11Backend::end() {
+    m_in_frame = false;
+    m_pipeline = Pipeline::NONE;
+
+    // reapply previous render state
+    if ( !m_owns_context )
+        m_render_state_backup.apply();
+}
+
+void D3D11Backend::set_owns_context( const bool owns_context ) {
+    m_owns_context = owns_context;
+    m_cache        = {};
+}
+
+void *D3D11Backend::map( BufferType type, MapMode mode ) {
+    D3D11_MAPPED_SUBRESOURCE resource{};
+
+    if ( FAILED( m_dev_ctx->Map( buffer( type ), 0, mode == MapMode::DISCARD ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &resource ) ) )
+        return nullptr;
+
+    return resource.pData;
+}
+
+void D3D11Backend::unmap( BufferType type ) {
+    m_dev_ctx->Unmap( buffer( type ), 0 );
+}
+
+void D3D11Backend::draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) {
+    const bool textured = texture != Batch_t::NO_TEXTURE;
+
+    // rebind the render list buffers after instanced draws or a resize
+    if ( m_pipeline != Pipeline::GEOMETRY && m_pipeline != Pipeline::SPRITE )
+        bind_geometry( format );
+
+    // rebind the index buffer only when the batch changes index width
+    else if ( format != m_index_format ) {
+        set_index_buffer( source( BufferType::INDEX ), to_dxgi( format ) );
+        m_index_format = format;
+    }
+
+    // switch shaders only when the batch changes between flat and textured
+    if ( textured != ( m_pipeline == Pipeline::SPRITE ) ) {
+        set_vertex_shader( textured ? m_sprite_vertex_shader : m_vertex_shader );
+        set_pixel_shader( textured ? m_sprite_pixel_shader : m_pixel_shader );
+
+        m_pipeline      = textured ? Pipeline::SPRITE : Pipeline::GEOMETRY;
+        m_bound_texture = Batch_t::NO_TEXTURE;
+    }
+
+    // rebind the texture only when the batch samples another one
+    if ( textured && texture != m_bound_texture ) {
+        const bool distance = m_textures[ texture ].m_distance;
+
+        // swap the pixel shader only when the batch changes between images and distance fields
+        if ( distance != ( m_bound_texture != Batch_t::NO_TEXTURE && m_textures[ m_bound_texture ].m_distance ) )
+            set_pixel_shader( distance ? m_distance_pixel_shader : m_sprite_pixel_shader );
+
+        set_state( m_cache.m_view, m_textures[ texture ].m_view, [ & ]() { m_dev_ctx->PSSetShaderResources( 0, 1, &m_textures[ texture ].m_view ); } );
+        m_bound_texture = texture;
+    }
+
+    set_topology( to_d3d11( topology ) );
+    m_dev_ctx->DrawIndexed( index_count, start_index, base_vertex );
+}
+
+void D3D11Backend::set_scissor( const ClipRect_t *clip ) {
+    D3D11_RECT rect{ 0, 0, ( LONG ) m_screen_size.x, ( LONG ) m_screen_size.y };
+
+    // pixels whose centers are inside the clip rect are drawn, the same ones clipped quads cover
+    if ( clip )
+        rect = { std::lround( clip->m_min.x ), std::lround( clip->m_min.y ), std::lround( clip->m_max.x ), std::lround( clip->m_max.y ) };
+
+    const auto &cached = m_cache.m_scissor;
+
+    if ( m_cache.m_scissor_known && rect.left == cached.left && rect.top == cached.top && rect.right == cached.right && rect.bottom == cached.bottom ) {
+        ++m_state_stats.m_saved;
+        return;
+    }
+
+    m_dev_ctx->RSSetScissorRects( 1, &rect );
+
+    m_cache.m_scissor       = rect;
+    m_cache.m_scissor_known = true;
+
+    ++m_state_stats.m_calls;
+}
+
+void D3D11Backend::draw_instanced( const uint32_t mesh, const size_t index_count, const size_t instance_count, const size_t start_instance ) {
+    // bind the shape shaders and instance buffer
+    if ( m_pipeline != Pipeline::SHAPE ) {
+        set_vertex_shader( m_shape_vertex_shader );
+        set_pixel_shader( m_shape_pixel_shader );
+        set_input_layout( m_shape_input_layout );
+        set_vertex_buffer( 1, source( BufferType::INSTANCE ), INSTANCE_BUFFER_STRIDE );
+        set_topology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+
+        m_pipeline   = Pipeline::SHAPE;
+        m_bound_mesh = Batch_t::NO_MESH;
+    }
+
+    // bind the unit mesh only when the batch changes shape
+    if ( mesh != m_bound_mesh ) {
+        set_vertex_buffer( 0, m_meshes[ mesh ].m_vertex_buffer, MESH_BUFFER_STRIDE );
+        set_index_buffer( m_meshes[ mesh ].m_index_buffer, DXGI_FORMAT_R16_UINT );
+
+        m_bound_mesh = mesh;
+    }
+
+    m_dev_ctx->DrawIndexedInstanced( index_count, instance_count, 0, 0, start_instance );
+}
+
+void D3D11Backend::bind_geometry( IndexFormat format ) {
+    set_vertex_shader( m_vertex_shader );
+    set_pixel_shader( m_pixel_shader );
+    set_input_layout( m_input_layout );
+    set_vertex_buffer( 0, source( BufferType::VERTEX ), VERTEX_BUFFER_STRIDE );
+    set_index_buffer( source( BufferType::INDEX ), to_dxgi( format ) );
+
+    m_index_format = format;
+    m_pipeline     = Pipeline::GEOMETRY;
+}
+
+void D3D11Backend::set_custom_state() {
+    // set blend state
+    set_state( m_cache.m_blend_state, m_blend_state, [ & ]() { m_dev_ctx->OMSetBlendState( m_blend_state, nullptr, 0xffffffff ); } );
+
+    // set sampler
+    set_state( m_cache.m_sampler, m_sampler_state, [ & ]() { m_dev_ctx->PSSetSamplers( 0, 1, &m_sampler_state ); } );
+
+    // set rasterizer state, drawing to the whole render target until a batch is clipped
+    set_state( m_cache.m_rasterizer_state, m_rasterizer_state, [ & ]() { m_dev_ctx->RSSetState( m_rasterizer_state ); } );
+    set_scissor( nullptr );
+
+    // set buffers, the draws read from the render list until static geometry is bound
+    set_state( m_cache.m_constant_buffer, m_proj_buffer, [ & ]() { m_dev_ctx->VSSetConstantBuffers( 0, 1, &m_proj_buffer ); } );
+
+    m_bound_static = Batch_t::NO_STATIC;
+    m_persistent   = false;
+
+    if ( m_translation != Vector2{} )
+        translate( {} );
+
+    // set shaders, layout and render list buffers
+    bind_geometry( IndexFormat::U16 );
+}
+
+D3D11_PRIMITIVE_TOPOLOGY D3D11Backend::to_d3d11( Topology topology ) {
+    switch ( topology ) {
+    case Topology::POINT_LIST:
+        return D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+
+    case Topology::LINE_LIST:
+        return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+
+    case Topology::LINE_STRIP:
+        return D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP;
+
+    case Topology::TRIANGLE_STRIP:
+        return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+
+    default:
+        break;
+    }
+
+    return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+}
+
+DXGI_FORMAT D3D11Backend::to_dxgi( IndexFormat format ) {
+    return format == IndexFormat::U16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+}
+
+bool RenderStateBackup::capture( ID3D11DeviceContext *dev_ctx ) {
+    if ( !dev_ctx )
+        return false;
+
+    m_dev_ctx = dev_ctx;
+
+    // save viewports
+    m_scissor_rects_count = m_viewports_count = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    m_dev_ctx->RSGetScissorRects( &m_scissor_rects_count, m_scissor_rects );
+    m_dev_ctx->RSGetViewports( &m_viewports_count, m_viewports );
+
+    // save rasterizer, blend and stencil state
+    m_dev_ctx->RSGetState( &m_rasterizer_state );
+    m_dev_ctx->OMGetBlendState( &m_blend_state, m_blend_factor, &m_sample_mask );
+    m_dev_ctx->OMGetDepthStencilState( &m_depth_stencil_state, &m_stencil_ref );
+
+    // save samplers
+    m_dev_ctx->PSGetSamplers( 0, 1, &m_sampler );
+
+    // save shaders
+    m_ps_instance_count = m_vs_instance_count = m_gs_instance_count = MAX_D3D11_CLASS_INSTANCE;
+    m_dev_ctx->PSGetShaderResources( 0, 1, &m_shader_resource );
+    m_dev_ctx->PSGetShader( &m_pixel_shader, m_ps_instances, &m_ps_instance_count );
+    m_dev_ctx->VSGetShader( &m_vertex_shader, m_vs_instances, &m_vs_instance_count );
+    m_dev_ctx->GSGetShader( &m_geometry_shader, m_gs_instances, &m_gs_instance_count );
+
+    // save topology
+    m_dev_ctx->IAGetPrimitiveTopology( &m_primitive_topology );
+
+    // save input layout
+    m_dev_ctx->IAGetInputLayout( &m_input_layout );
+
+    // save buffers
+    m_dev_ctx->VSGetConstantBuffers( 0, 1, &m_constant_buffer );
+    m_dev_ctx->IAGetVertexBuffers( 0, 1, &m_vertex_buffer, &m_vertex_buffer_stride, &m_vertex_buffer_offset );
+    m_dev_ctx->IAGetVertexBuffers( 1, 1, &m_instance_buffer, &m_instance_buffer_stride, &m_instance_buffer_offset );
+    m_dev_ctx->IAGetIndexBuffer( &m_index_buffer, &m_index_buffer_format, &m_index_buffer_offset );
+
+    return true;
+}
+
+void RenderStateBackup::apply() {
+    // set viewports
+    m_dev_ctx->RSSetScissorRects( m_scissor_rects_count, m_scissor_rects );
+    m_dev_ctx->RSSetViewports( m_viewports_count, m_viewports );
+
+    // set rasterizer, blend, and stencil state
+    m_dev_ctx->RSSetState( m_rasterizer_state );
+    if ( m_rasterizer_state )
+        m_rasterizer_state->Release();
+
+    m_dev_ctx->OMSetBlendState( m_blend_state, m_blend_factor, m_sample_mask );
+    if ( m_blend_state )
+        m_blend_state->Release();
+
+    m_dev_ctx->OMSetDepthStencilState( m_depth_stencil_state, m_stencil_ref );
+    if ( m_depth_stencil_state )
+        m_depth_stencil_state->Release();
+
+    // set samplers
+    m_dev_ctx->PSSetSamplers( 0, 1, &m_sampler );
+    if ( m_sampler )
+        m_sampler->Release();
+
+    // set shaders
+    m_dev_ctx->PSSetShaderResources( 0, 1, &m_shader_resource );
+    if ( m_shader_resource )
+        m_shader_resource->Release();
+
+    m_dev_ctx->PSSetShader( m_pixel_shader, m_ps_instances, m_ps_instance_count );
+    if ( m_pixel_shader )
+        m_pixel_shader->Release();
+
+    m_dev_ctx->VSSetShader( m_vertex_shader, m_vs_instances, m_vs_instance_count );
+    if ( m_vertex_shader )
+        m_vertex_shader->Release();
+
+    m_dev_ctx->GSSetShader( m_geometry_shader, m_gs_instances, m_gs_instance_count );
+    if ( m_geometry_shader )
+        m_geometry_shader->Release();
+
+    for ( size_t i{}; i < m_ps_instance_count; ++i ) {
+        if ( m_ps_instances[ i ] )
+            m_ps_instances[ i ]->Release();
+    }
+
+    for ( size_t i{}; i < m_vs_instance_count; ++i ) {
+        if ( m_vs_instances[ i ] )
+            m_vs_instances[ i ]->Release();
+    }
+
+    for ( size_t i{}; i < m_gs_instance_count; ++i ) {
+        if ( m_gs_instances[ i ] )
+            m_gs_instances[ i ]->Release();
+    }
+
+    // set topology
+    m_dev_ctx->IASetPrimitiveTopology( m_primitive_topology );
+
+    // set input layout
+    m_dev_ctx->IASetInputLayout( m_input_layout );
+    if ( m_input_layout )
+        m_input_layout->Release();
+
+    // set buffers
+    m_dev_ctx->VSSetConstantBuffers( 0, 1, &m_constant_buffer );
+    if ( m_constant_buffer )
+        m_constant_buffer->Release();
+
+    m_dev_ctx->IASetVertexBuffers( 0, 1, &m_vertex_buffer, &m_vertex_buffer_stride, &m_vertex_buffer_offset );
+    if ( m_vertex_buffer )
+        m_vertex_buffer->Release();
+
+    m_dev_ctx->IASetVertexBuffers( 1, 1, &m_instance_buffer, &m_instance_buffer_stride, &m_instance_buffer_offset );
+    if ( m_instance_buffer )
+        m_instance_buffer->Release();
+
+    m_dev_ctx->IASetIndexBuffer( m_index_buffer, m_index_buffer_format, m_index_buffer_offset );
+    if ( m_index_buffer )
+        m_index_buffer->Release();
+}
+
+#endif
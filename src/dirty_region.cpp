@@ -0,0 +1,131 @@
+#include "dirty_region.h"
+
+using namespace dx;
+
+void DirtyRegion::update( const Vector2 &screen_size, const bool complete, const bool redraw ) {
+    const size_t count          = m_current.size();
+    const size_t previous_count = m_previous.size();
+
+    m_rects.clear();
+    m_full = redraw || !complete || !m_valid || screen_size != m_screen_size;
+
+    m_screen_size = screen_size;
+
+    // a primitive that differs from the one drawn at its place dirties where it was and where it is
+    if ( !m_full && count == previous_count ) {
+        for ( size_t i{}; i < count && !m_full; ++i ) {
+            if ( m_current[ i ].m_key == m_previous[ i ].m_key )
+                continue;
+
+            add_changed( m_previous[ i ].m_bounds );
+            add_changed( m_current[ i ].m_bounds );
+        }
+    }
+
+    // primitives were added or removed, everything between the common start and end moved in the draw order
+    else if ( !m_full ) {
+        const size_t shorter = std::min( count, previous_count );
+        size_t       prefix{};
+        size_t       suffix{};
+
+        while ( prefix < shorter && m_current[ prefix ].m_key == m_previous[ prefix ].m_key )
+            ++prefix;
+
+        while ( suffix < shorter - prefix && m_current[ count - suffix - 1 ].m_key == m_previous[ previous_count - suffix - 1 ].m_key )
+            ++suffix;
+
+        for ( size_t i{ prefix }; i < previous_count - suffix && !m_full; ++i )
+            add_changed( m_previous[ i ].m_bounds );
+
+        for ( size_t i{ prefix }; i < count - suffix && !m_full; ++i )
+            add_changed( m_current[ i ].m_bounds );
+    }
+
+    // redrawing most of the screen costs more passes than drawing it once
+    if ( !m_full ) {
+        float area{};
+
+        for ( const auto &rect : m_rects )
+            area += ( rect.m_max.x - rect.m_min.x ) * ( rect.m_max.y - rect.m_min.y );
+
+        m_full = area > screen_size.x * screen_size.y * MAX_COVERAGE;
+    }
+
+    if ( m_full )
+        m_rects.clear();
+
+    std::swap( m_current, m_previous );
+
+    m_valid = complete;
+}
+
+void DirtyRegion::add_changed( const ClipRect_t &bounds ) {
+    const ClipRect_t rect{ { std::clamp( std::floor( bounds.m_min.x ) - PADDING, 0.f, m_screen_size.x ), std::clamp( std::floor( bounds.m_min.y ) - PADDING, 0.f, m_screen_size.y ) },
+                           { std::clamp( std::ceil( bounds.m_max.x ) + PADDING, 0.f, m_screen_size.x ), std::clamp( std::ceil( bounds.m_max.y ) + PADDING, 0.f, m_screen_size.y ) } };
+
+    // a change off screen does not show
+    if ( rect.empty() )
+        return;
+
+    // a change covering the whole screen is not worth merging
+    if ( rect.m_max.x - rect.m_min.x >= m_screen_size.x && rect.m_max.y - rect.m_min.y >= m_screen_size.y ) {
+        m_full = true;
+        return;
+    }
+
+    insert( rect );
+
+    // past the limit, merge the pair whose union adds the least area
+    while ( m_rects.size() > MAX_RECTS ) {
+        size_t merge_a{};
+        size_t merge_b{ 1 };
+        float  least{ INFINITY };
+
+        for ( size_t a{}; a < m_rects.size(); ++a ) {
+            for ( size_t b{ a + 1 }; b < m_rects.size(); ++b ) {
+                const auto  &ra    = m_rects[ a ];
+                const auto  &rb    = m_rects[ b ];
+                const float width  = std::max( ra.m_max.x, rb.m_max.x ) - std::min( ra.m_min.x, rb.m_min.x );
+                const float height = std::max( ra.m_max.y, rb.m_max.y ) - std::min( ra.m_min.y, rb.m_min.y );
+                const float added  = width * height - ( ra.m_max.x - ra.m_min.x ) * ( ra.m_max.y - ra.m_min.y ) - ( rb.m_max.x - rb.m_min.x ) * ( rb.m_max.y - rb.m_min.y );
+
+                if ( added < least ) {
+                    least   = added;
+                    merge_a = a;
+                    merge_b = b;
+                }
+            }
+        }
+
+        const ClipRect_t merged{ { std::min( m_rects[ merge_a ].m_min.x, m_rects[ merge_b ].m_min.x ), std::min( m_rects[ merge_a ].m_min.y, m_rects[ merge_b ].m_min.y ) },
+                                 { std::max( m_rects[ merge_a ].m_max.x, m_rects[ merge_b ].m_max.x ), std::max( m_rects[ merge_a ].m_max.y, m_rects[ merge_b ].m_max.y ) } };
+
+        // b comes after a, so removing it first leaves a in place
+        m_rects.erase( m_rects.begin() + merge_b );
+        m_rects.erase( m_rects.begin() + merge_a );
+
+        insert( merged );
+    }
+}
+
+void DirtyRegion::insert( ClipRect_t rect ) {
+    // the union of two rects can reach rects neither overlapped, so the search starts over after each one absorbed
+    for ( size_t i{}; i < m_rects.size(); ) {
+        const auto &other = m_rects[ i ];
+
+        if ( rect.m_min.x >= other.m_max.x || other.m_min.x >= rect.m_max.x || rect.m_min.y >= other.m_max.y || other.m_min.y >= rect.m_max.y ) {
+            ++i;
+            continue;
+        }
+
+        rect = { { std::min( rect.m_min.x, other.m_min.x ), std::min( rect.m_min.y, other.m_min.y ) },
+                 { std::max( rect.m_max.x, other.m_max.x ), std::max( rect.m_max.y, other.m_max.y ) } };
+
+        m_rects[ i ] = m_rects.back();
+        m_rects.pop_back();
+
+        i = 0;
+    }
+
+    m_rects.push_back( rect );
+}
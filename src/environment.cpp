@@ -8,7 +8,21 @@ void Environment::create( HINSTANCE instance, int cmd_show ) {
 
     create_directx();
 
-    m_renderer.create( m_dev, m_dev_ctx );
+    m_backend.create( m_dev, m_dev_ctx );
+
+    // nothing else renders with the device context, so its state is kept between frames instead of backed up
+    m_backend.set_owns_context( true );
+
+    m_renderer.create( &m_backend );
+
+    // the scene rarely changes, so frames the same as the last one are neither drawn nor presented
+    m_renderer.set_skip_unchanged( true );
+
+    // the back buffer keeps the last frame, so only the regions that changed are redrawn and presented
+    m_renderer.set_partial_redraw( true );
+
+    // the overlay interleaves lines, outlines, and fills, so compatible batches that do not overlap are merged
+    m_renderer.set_sort_batches( true );
 }
 
 void Environment::destroy() {
@@ -20,6 +34,9 @@ void Environment::destroy() {
 uint32_t Environment::perform() {
     MSG msg{};
 
+    // the scene is recorded on its own thread, the window thread owns the device context and only submits
+    m_producer = std::thread{ &Environment::record_frames, this };
+
     while ( true ) {
         // peek message and dispatch to windowproc
         if ( PeekMessage( &msg, NULL, 0, 0, PM_REMOVE ) ) {
@@ -32,22 +49,59 @@ uint32_t Environment::perform() {
 
         // perform rendering functions
         else {
-            m_dev_ctx->ClearRenderTargetView( m_render_target, Color::white().data() );
+            auto *frame = m_frames.acquire();
 
-            m_renderer.draw_filled_rect( 50.f, 50.f, 50.f, 50.f, Color::red() );
-            m_renderer.draw_outlined_filled_rect( 200.f, 200.f, 100.f, 100.f, Color::green(), Color::black() );
-            m_renderer.draw_line( 320.f, 320.f, 350.f, 350.f, Color::purple(), 4.f );
-            m_renderer.draw_filled_circle( 340.f, 240.f, 20.f, Color::black() );
+            if ( !frame )
+                break;
+
+            // the frame draws its own background, so the back buffer is not cleared and keeps what did not change
+            const bool drawn = m_renderer.perform( *frame );
 
-            m_renderer.perform();
+            m_frames.release();
 
-            m_swapchain->Present( 0, 0 );
+            if ( drawn )
+                present();
         }
     }
 
+    m_frames.close();
+    m_producer.join();
+
     return msg.wParam;
 }
 
+void Environment::present() {
+    const auto                                 dirty = m_renderer.dirty_rects();
+    std::array< RECT, DirtyRegion::MAX_RECTS > rects;
+
+    // a frame drawn whole is presented whole
+    if ( !m_swapchain1 || dirty.empty() ) {
+        m_swapchain->Present( 0, 0 );
+        return;
+    }
+
+    for ( size_t i{}; i < dirty.size(); ++i )
+        rects[ i ] = { ( LONG ) dirty[ i ].m_min.x, ( LONG ) dirty[ i ].m_min.y, ( LONG ) dirty[ i ].m_max.x, ( LONG ) dirty[ i ].m_max.y };
+
+    DXGI_PRESENT_PARAMETERS params{ ( UINT ) dirty.size(), rects.data(), nullptr, nullptr };
+
+    m_swapchain1->Present1( 0, 0, &params );
+}
+
+void Environment::record_frames() {
+    while ( auto *frame = m_frames.begin_record() ) {
+        // the background covers the dirty rects the frame is redrawn in
+        frame->draw_filled_rect( 0.f, 0.f, ( float ) WND_WIDTH, ( float ) WND_HEIGHT, Color::white() );
+
+        frame->draw_filled_rect( 50.f, 50.f, 50.f, 50.f, Color::red() );
+        frame->draw_outlined_filled_rect( 200.f, 200.f, 100.f, 100.f, Color::green(), Color::black() );
+        frame->draw_line( 320.f, 320.f, 350.f, 350.f, Color::purple(), 4.f );
+        frame->draw_filled_circle( 340.f, 240.f, 20.f, Color::black() );
+
+        m_frames.end_record();
+    }
+}
+
 void Environment::create_window( HINSTANCE instance, int cmd_show, const size_t pos_x, const size_t pos_y,
                                  const size_t width, const size_t height ) {
     WNDCLASSEX wnd_class;
@@ -88,14 +142,21 @@ void Environment::create_directx() {
     swapchain_desc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
     swapchain_desc.BufferUsage       = DXGI_USAGE_RENDER_TARGET_OUTPUT;
     swapchain_desc.OutputWindow      = m_wnd;
-    swapchain_desc.SampleDesc.Count  = 4;
+
+    // a sequential swapchain keeps the back buffer after presenting, which partial redraws build on, and cannot be multisampled
+    swapchain_desc.SampleDesc.Count  = 1;
     swapchain_desc.Windowed          = TRUE;
+    swapchain_desc.SwapEffect        = DXGI_SWAP_EFFECT_SEQUENTIAL;
 
     // create swapchain, device, and device context
     D3D11CreateDeviceAndSwapChain( NULL, D3D_DRIVER_TYPE_HARDWARE, NULL, NULL, NULL, NULL, 
                                    D3D11_SDK_VERSION, &swapchain_desc, &m_swapchain, &m_dev,
                                    NULL, &m_dev_ctx );
 
+    // dirty rects are presented through dxgi 1.2, older runtimes present the whole back buffer
+    if ( FAILED( m_swapchain->QueryInterface( __uuidof( IDXGISwapChain1 ), ( void ** ) &m_swapchain1 ) ) )
+        m_swapchain1 = nullptr;
+
     // retrieve backbuffer address 
     m_swapchain->GetBuffer( 0, __uuidof( ID3D11Texture2D ), ( LPVOID * ) &back_buffer );
 
@@ -116,6 +177,9 @@ void Environment::create_directx() {
 }
 
 void Environment::destroy_directx() {
+    if ( m_swapchain1 )
+        m_swapchain1->Release();
+
     m_swapchain->Release();
     m_render_target->Release();
     m_dev_ctx->Release();
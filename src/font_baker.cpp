@@ -0,0 +1,52 @@
+#include "includes.h"
+#include "baked_font.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace dx;
+
+int main( int argc, char **argv ) {
+    float    em_size{ 32.f };
+    float    spread{ 4.f };
+    uint32_t page_size{ 512 };
+
+    if ( argc < 2 ) {
+        std::printf( "usage: %s <output> [em size] [spread] [page size]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    if ( argc > 2 )
+        em_size = std::strtof( argv[ 2 ], nullptr );
+
+    if ( argc > 3 )
+        spread = std::strtof( argv[ 3 ], nullptr );
+
+    if ( argc > 4 )
+        page_size = ( uint32_t ) std::strtoul( argv[ 4 ], nullptr, 10 );
+
+    // the built-in bitmap font is the only font source the tree has
+    BitmapFont source;
+
+    if ( !BakedFont::bake( source, argv[ 1 ], em_size, spread, BitmapFont::FIRST, BitmapFont::LAST, page_size ) ) {
+        std::printf( "failed to bake %s\n", argv[ 1 ] );
+        return 1;
+    }
+
+    // read the file back the way the renderer maps it
+    BakedFont baked;
+
+    if ( !baked.open( argv[ 1 ] ) ) {
+        std::printf( "failed to open %s\n", argv[ 1 ] );
+        return 1;
+    }
+
+    const auto &header = baked.header();
+
+    std::printf( "glyphs:   %u\n", header.m_glyph_count );
+    std::printf( "pages:    %u x %ux%u\n", header.m_page_count, header.m_page_width, header.m_page_height );
+    std::printf( "em size:  %.1f, spread %.1f\n", header.m_em_size, header.m_spread );
+
+    return 0;
+}
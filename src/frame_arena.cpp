@@ -0,0 +1,36 @@
+#include "frame_arena.h"
+
+using namespace dx;
+
+void FrameArena::reset() {
+    m_high_water = std::max( m_high_water, m_used );
+
+    // the blocks a frame added are replaced by one block that holds the largest frame, so the next ones fit in it
+    if ( !m_overflow.empty() ) {
+        size_t capacity = std::max( m_capacity, MIN_BLOCK_SIZE );
+
+        while ( capacity < m_high_water )
+            capacity *= 2;
+
+        m_overflow.clear();
+
+        m_block.reset( new std::byte[ capacity ] );
+        m_capacity = capacity;
+    }
+
+    m_cursor = m_block.get();
+    m_end    = m_cursor + m_capacity;
+    m_used   = 0;
+}
+
+void *FrameArena::grow( const size_t size, const size_t alignment ) {
+    // the added blocks grow with the frame, so a frame far larger than the block adds few of them
+    const size_t capacity = std::max( { MIN_BLOCK_SIZE, m_used, size + alignment } );
+    auto         &block   = m_overflow.emplace_back( new std::byte[ capacity ] );
+
+    // the tail left in the previous block is not counted, the block the reset makes holds the frame without it
+    m_cursor = block.get();
+    m_end    = m_cursor + capacity;
+
+    return allocate( size, alignment );
+}
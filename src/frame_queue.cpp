@@ -0,0 +1,107 @@
+#include "frame_queue.h"
+
+using namespace dx;
+
+FrameQueue::FrameQueue( const size_t depth, const int32_t layer ) : m_depth{ std::clamp< size_t >( depth, 1, MAX_DEPTH ) }, m_frames{}, m_recorded{},
+    m_acquired{}, m_released{}, m_closed{}, m_mutex{}, m_free{}, m_ready{}, m_stats{}, m_record_start{}, m_submit_start{}, m_first{}, m_started{} {
+    for ( size_t i{}; i < m_depth; ++i )
+        m_frames[ i ].m_context = std::make_unique< RecordContext >( layer );
+}
+
+RecordContext *FrameQueue::begin_record() {
+    std::unique_lock lock{ m_mutex };
+    const auto       start = Clock::now();
+
+    // back-pressure, wait until the render thread submitted the oldest frame
+    m_free.wait( lock, [ this ] { return m_closed || m_recorded - m_released < m_depth; } );
+
+    if ( m_closed )
+        return nullptr;
+
+    m_record_start = Clock::now();
+
+    if ( !m_started ) {
+        m_first   = start;
+        m_started = true;
+    }
+
+    m_stats.m_producer_wait_ns += elapsed( start, m_record_start );
+
+    return m_frames[ m_recorded % m_depth ].m_context.get();
+}
+
+void FrameQueue::end_record() {
+    {
+        std::lock_guard lock{ m_mutex };
+        auto            &frame = m_frames[ m_recorded % m_depth ];
+
+        frame.m_recorded = Clock::now();
+
+        m_stats.m_record_ns += elapsed( m_record_start, frame.m_recorded );
+
+        ++m_recorded;
+    }
+
+    m_ready.notify_one();
+}
+
+RecordContext *FrameQueue::acquire() {
+    std::unique_lock lock{ m_mutex };
+    const auto       start = Clock::now();
+
+    m_ready.wait( lock, [ this ] { return m_closed || m_acquired < m_recorded; } );
+
+    // recorded frames are still submitted after the queue was closed
+    if ( m_acquired == m_recorded )
+        return nullptr;
+
+    auto &frame = m_frames[ m_acquired % m_depth ];
+
+    m_submit_start = Clock::now();
+
+    m_stats.m_consumer_wait_ns += elapsed( start, m_submit_start );
+    m_stats.m_latency_ns       += elapsed( frame.m_recorded, m_submit_start );
+
+    ++m_acquired;
+
+    return frame.m_context.get();
+}
+
+void FrameQueue::release() {
+    {
+        std::lock_guard lock{ m_mutex };
+        const auto      end = Clock::now();
+
+        m_stats.m_submit_ns += elapsed( m_submit_start, end );
+        m_stats.m_wall_ns    = elapsed( m_first, end );
+
+        ++m_stats.m_frames;
+        ++m_released;
+    }
+
+    m_free.notify_one();
+}
+
+void FrameQueue::close() {
+    {
+        std::lock_guard lock{ m_mutex };
+
+        m_closed = true;
+    }
+
+    m_free.notify_all();
+    m_ready.notify_all();
+}
+
+FrameQueueStats_t FrameQueue::stats() {
+    std::lock_guard lock{ m_mutex };
+
+    return m_stats;
+}
+
+void FrameQueue::reset_stats() {
+    std::lock_guard lock{ m_mutex };
+
+    m_stats   = {};
+    m_started = false;
+}
@@ -0,0 +1,46 @@
+#include "includes.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace dx;
+
+int main( int argc, char **argv ) {
+    NullBackend backend;
+    Renderer    renderer;
+    size_t      frame_count{ 1 };
+
+    if ( argc > 1 )
+        frame_count = std::strtoull( argv[ 1 ], nullptr, 10 );
+
+    // create renderer on top of the null backend
+    if ( !renderer.create( &backend ) )
+        return 1;
+
+    // record the same scene as the directx environment
+    for ( size_t i{}; i < frame_count; ++i ) {
+        renderer.draw_filled_rect( 50.f, 50.f, 50.f, 50.f, Color::red() );
+        renderer.draw_outlined_filled_rect( 200.f, 200.f, 100.f, 100.f, Color::green(), Color::black() );
+        renderer.draw_line( 320.f, 320.f, 350.f, 350.f, Color::purple(), 4.f );
+        renderer.draw_filled_circle( 340.f, 240.f, 20.f, Color::black() );
+
+        renderer.perform();
+    }
+
+    const auto &stats       = backend.stats();
+    const auto &frame_stats = renderer.stats();
+
+    std::printf( "frames:            %zu\n", stats.m_frames );
+    std::printf( "draw calls:        %zu\n", stats.m_draw_calls );
+    std::printf( "discard maps:      %zu\n", stats.m_discard_maps );
+    std::printf( "no-overwrite maps: %zu\n", stats.m_no_overwrite_maps );
+    std::printf( "buffer resizes:    %zu\n", stats.m_resizes );
+    std::printf( "last frame:        %zu vertices, %zu indices, %zu bytes, %zu chunks\n",
+                 frame_stats.m_vertices, frame_stats.m_indices, frame_stats.m_uploaded_bytes, frame_stats.m_chunks );
+
+    renderer.destroy();
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "mapped_file.h"
+
+#ifndef DX_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace dx;
+
+bool MappedFile::open( const char *path ) {
+    close();
+
+#ifdef DX_PLATFORM_WINDOWS
+    LARGE_INTEGER size{};
+
+    m_file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( m_file == INVALID_HANDLE_VALUE )
+        return false;
+
+    // an empty file cannot be mapped
+    if ( !GetFileSizeEx( m_file, &size ) || !size.QuadPart ) {
+        close();
+        return false;
+    }
+
+    m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( !m_mapping ) {
+        close();
+        return false;
+    }
+
+    m_data = ( const uint8_t * ) MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 );
+    if ( !m_data ) {
+        close();
+        return false;
+    }
+
+    m_size = ( size_t ) size.QuadPart;
+#else
+    struct stat info{};
+
+    const int fd = ::open( path, O_RDONLY );
+    if ( fd < 0 )
+        return false;
+
+    // the mapping keeps the file referenced, the descriptor is not needed past mmap
+    if ( fstat( fd, &info ) || !info.st_size ) {
+        ::close( fd );
+        return false;
+    }
+
+    void *data = mmap( nullptr, ( size_t ) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    ::close( fd );
+
+    if ( data == MAP_FAILED )
+        return false;
+
+    m_data = ( const uint8_t * ) data;
+    m_size = ( size_t ) info.st_size;
+#endif
+
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef DX_PLATFORM_WINDOWS
+    if ( m_data )
+        UnmapViewOfFile( m_data );
+
+    if ( m_mapping )
+        CloseHandle( m_mapping );
+
+    if ( m_file != INVALID_HANDLE_VALUE )
+        CloseHandle( m_file );
+
+    m_file    = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+#else
+    if ( m_data )
+        munmap( ( void * ) m_data, m_size );
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
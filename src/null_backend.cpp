@@ -0,0 +1,118 @@
+#include "null_backend.h"
+
+using namespace dx;
+
+void NullBackend::destroy() {
+    reset_stats();
+}
+
+Vector2 NullBackend::get_screen_size() {
+    return m_screen_size;
+}
+
+bool NullBackend::begin() {
+    return true;
+}
+
+void NullBackend::end() {
+    ++m_stats.m_frames;
+}
+
+bool NullBackend::resize( BufferType type, const size_t size ) {
+    auto &buffer = memory( type );
+
+    buffer.resize( size );
+    buffer.shrink_to_fit();
+
+    ++m_stats.m_resizes;
+
+    return true;
+}
+
+void *NullBackend::map( BufferType type, MapMode mode ) {
+    if ( mode == MapMode::DISCARD )
+        ++m_stats.m_discard_maps;
+
+    else
+        ++m_stats.m_no_overwrite_maps;
+
+    return memory( type ).data();
+}
+
+void NullBackend::unmap( BufferType /* type */ ) {
+
+}
+
+void NullBackend::draw( Topology /* topology */, IndexFormat /* format */, const size_t index_count, const size_t /* start_index */, const size_t /* base_vertex */, const uint32_t /* texture */ ) {
+    ++m_stats.m_draw_calls;
+
+    m_stats.m_indices += index_count;
+}
+
+void NullBackend::set_scissor( const ClipRect_t * /* clip */ ) {
+    ++m_stats.m_scissors;
+}
+
+bool NullBackend::create_mesh( const uint32_t /* mesh */, std::span< const Vector2 > /* vertices */, std::span< const uint16_t > /* indices */ ) {
+    ++m_stats.m_meshes;
+
+    return true;
+}
+
+void NullBackend::draw_instanced( const uint32_t /* mesh */, const size_t index_count, const size_t instance_count, const size_t /* start_instance */ ) {
+    ++m_stats.m_draw_calls;
+
+    m_stats.m_indices   += index_count * instance_count;
+    m_stats.m_instances += instance_count;
+}
+
+bool NullBackend::create_texture( const uint32_t /* texture */, const uint32_t /* width */, const uint32_t /* height */ ) {
+    ++m_stats.m_textures;
+
+    return true;
+}
+
+void NullBackend::update_texture( const uint32_t /* texture */, const uint32_t /* x */, const uint32_t /* y */, const uint32_t /* width */, const uint32_t /* height */, std::span< const uint32_t > pixels ) {
+    m_stats.m_texture_bytes += pixels.size_bytes();
+}
+
+bool NullBackend::create_distance_texture( const uint32_t /* texture */, const uint32_t /* width */, const uint32_t /* height */, std::span< const uint8_t > distances ) {
+    ++m_stats.m_textures;
+
+    m_stats.m_texture_bytes += distances.size_bytes();
+
+    return true;
+}
+
+bool NullBackend::create_static( const uint32_t /* geometry */, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) {
+    ++m_stats.m_statics;
+
+    m_stats.m_static_bytes += vertices.size_bytes() + indices.size_bytes() + instances.size_bytes();
+
+    return true;
+}
+
+void NullBackend::destroy_static( const uint32_t /* geometry */ ) {
+    // static geometry is only counted, nothing was allocated
+}
+
+void NullBackend::set_static( const uint32_t geometry, const Vector2 & /* translation */ ) {
+    if ( geometry != Batch_t::NO_STATIC )
+        ++m_stats.m_static_binds;
+}
+
+bool NullBackend::resize_persistent( BufferType /* type */, const size_t /* size */ ) {
+    ++m_stats.m_resizes;
+
+    return true;
+}
+
+void NullBackend::update_persistent( BufferType /* type */, const size_t /* offset */, std::span< const uint8_t > bytes ) {
+    ++m_stats.m_updates;
+
+    m_stats.m_update_bytes += bytes.size_bytes();
+}
+
+void NullBackend::set_persistent( const bool /* persistent */ ) {
+    // persistent buffers are only counted, nothing was allocated
+}
@@ -0,0 +1,768 @@
+#include "record_context.h"
+
+using namespace dx;
+
+void RecordContext::push_clip_rect( const Vector2 &pos, const Vector2 &size ) {
+    ClipRect_t clip{ { std::min( pos.x, pos.x + size.x ), std::min( pos.y, pos.y + size.y ) },
+                     { std::max( pos.x, pos.x + size.x ), std::max( pos.y, pos.y + size.y ) } };
+
+    // nested clip rects only narrow the one they are pushed into
+    if ( !m_clip_stack.empty() )
+        clip = clip.intersect( m_clip_stack.back() );
+
+    m_clip_stack.push_back( clip );
+
+    m_clip = Batch_t::NO_CLIP;
+}
+
+void RecordContext::pop_clip_rect() {
+    if ( m_clip_stack.empty() )
+        return;
+
+    m_clip_stack.pop_back();
+
+    m_clip = Batch_t::NO_CLIP;
+}
+
+void RecordContext::add_rect( const Vector2 &pos, const Vector2 &size, const Vertex::color_t &col ) {
+    Vector2          min{ std::min( pos.x, pos.x + size.x ), std::min( pos.y, pos.y + size.y ) };
+    Vector2          max{ std::max( pos.x, pos.x + size.x ), std::max( pos.y, pos.y + size.y ) };
+    Vector2          uv_min, uv_max;
+    const ClipRect_t *clip;
+
+    if ( !clip_test( min, max, clip ) )
+        return;
+
+    // a rect crossing the clip rect is cut to it, so it stays in the current batch
+    if ( clip ) {
+        clip->clip( min, max, uv_min, uv_max );
+        ++m_recorded.m_clipped;
+    }
+
+    if ( m_instancing ) {
+        m_render_list.add_instance( ShapeMesh_t::QUAD ) = { min, max - min, {}, Vertex::rgba8( col ), ShapeKind::RECT };
+        return;
+    }
+
+    auto           r    = m_render_list.reserve( 4, 6, Topology::TRIANGLE_LIST );
+    const uint32_t base = r.m_base_index;
+
+    r.m_vertices[ 0 ] = { min.x, min.y, col };
+    r.m_vertices[ 1 ] = { max.x, min.y, col };
+    r.m_vertices[ 2 ] = { max.x, max.y, col };
+    r.m_vertices[ 3 ] = { min.x, max.y, col };
+
+    r.m_indices[ 0 ] = base;
+    r.m_indices[ 1 ] = base + 1;
+    r.m_indices[ 2 ] = base + 2;
+    r.m_indices[ 3 ] = base + 2;
+    r.m_indices[ 4 ] = base + 3;
+    r.m_indices[ 5 ] = base;
+
+    commit( 4, 6 );
+}
+
+void RecordContext::add_arc( const Vector2 &pos, const Vector2 &radii, float start_angle, float sweep_angle,
+                        const Vertex::color_t &col, const size_t segment_count, const bool filled ) {
+    size_t steps;
+    bool   closed{};
+    float  cos_start{ 1.f }, sin_start{};
+
+    uint32_t scissor;
+
+    if ( !segment_count || sweep_angle == 0.f )
+        return;
+
+    // the whole ellipse bounds the arc
+    const Vector2 extent{ std::fabs( radii.x ), std::fabs( radii.y ) };
+
+    if ( !scissor_test( pos - extent, pos + extent, scissor ) )
+        return;
+
+    // filled ellipse expanded on the gpu from the unit fan
+    if ( m_instancing && filled && std::fabs( sweep_angle ) >= TWO_PI ) {
+        const uint32_t fan = mesh( segment_count );
+
+        if ( fan != Batch_t::NO_MESH ) {
+            m_render_list.add_instance( fan, scissor ) = { pos, radii, {}, Vertex::rgba8( col ), ShapeKind::ELLIPSE };
+            return;
+        }
+    }
+
+    const auto unit = m_unit_circles.get( segment_count );
+
+    // sweep counter-clockwise from the smaller angle
+    if ( sweep_angle < 0.f ) {
+        start_angle += sweep_angle;
+        sweep_angle  = -sweep_angle;
+    }
+
+    // whole ellipse, the table is used as is and the outline closes on its first point
+    if ( sweep_angle >= TWO_PI ) {
+        steps  = segment_count;
+        closed = true;
+    }
+
+    // arc, the table is rotated to the start angle and the last point is placed on the end angle
+    else {
+        steps     = std::min( segment_count, ( size_t ) std::ceil( sweep_angle / TWO_PI * ( float ) segment_count ) );
+        cos_start = std::cos( start_angle );
+        sin_start = std::sin( start_angle );
+    }
+
+    const size_t   first       = filled ? 1 : 0;
+    const size_t   point_count = steps + 1;
+    auto           r           = m_render_list.reserve( first + point_count, filled ? steps * 3 : steps * 2, filled ? Topology::TRIANGLE_LIST : Topology::LINE_LIST,
+                                                        Batch_t::NO_TEXTURE, scissor );
+    const uint32_t base        = r.m_base_index;
+
+    if ( filled )
+        r.m_vertices[ 0 ] = { pos.x, pos.y, col };
+
+    for ( size_t i{}; i < steps; ++i ) {
+        const auto &u = unit[ i ];
+
+        r.m_vertices[ first + i ] = { pos.x + radii.x * ( u.m_cos * cos_start - u.m_sin * sin_start ),
+                                      pos.y + radii.y * ( u.m_cos * sin_start + u.m_sin * cos_start ), col };
+    }
+
+    if ( closed )
+        r.m_vertices[ first + steps ] = r.m_vertices[ first ];
+
+    else
+        r.m_vertices[ first + steps ] = { pos.x + radii.x * std::cos( start_angle + sweep_angle ),
+                                          pos.y + radii.y * std::sin( start_angle + sweep_angle ), col };
+
+    // fan around the center vertex
+    if ( filled ) {
+        for ( size_t i{}; i < steps; ++i ) {
+            r.m_indices[ i * 3 ]     = base;
+            r.m_indices[ i * 3 + 1 ] = base + ( uint32_t ) i + 1;
+            r.m_indices[ i * 3 + 2 ] = base + ( uint32_t ) i + 2;
+        }
+
+        commit( first + point_count, steps * 3 );
+    }
+
+    // segments between consecutive points, a list so the outline shares a batch with lines and other outlines
+    else {
+        for ( size_t i{}; i < steps; ++i ) {
+            r.m_indices[ i * 2 ]     = base + ( uint32_t ) i;
+            r.m_indices[ i * 2 + 1 ] = base + ( uint32_t ) i + 1;
+        }
+
+        commit( point_count, steps * 2 );
+    }
+}
+
+void RecordContext::draw_line( const Vector2 &start, const Vector2 &end, const Color &color, const float thickness ) {
+    const auto    col = Vertex::pack( color );
+    const Vector2 extent{ std::max( thickness, 1.f ), std::max( thickness, 1.f ) };
+    uint32_t      scissor;
+
+    // the end points extended by the thickness bound the line
+    if ( !scissor_test( Vector2( std::min( start.x, end.x ), std::min( start.y, end.y ) ) - extent,
+                        Vector2( std::max( start.x, end.x ), std::max( start.y, end.y ) ) + extent, scissor ) )
+        return;
+
+    // draw a pixel thick line
+    if ( thickness <= 1.f ) {
+        auto r = m_render_list.reserve( 2, 2, Topology::LINE_LIST, Batch_t::NO_TEXTURE, scissor );
+
+        r.m_vertices[ 0 ] = { start.x, start.y, col };
+        r.m_vertices[ 1 ] = { end.x,   end.y,   col };
+
+        r.m_indices[ 0 ] = r.m_base_index;
+        r.m_indices[ 1 ] = r.m_base_index + 1;
+
+        commit( 2, 2 );
+    }
+
+    // draw a line with some thickness expanded on the gpu
+    else if ( m_instancing )
+        m_render_list.add_instance( ShapeMesh_t::QUAD, scissor ) = { start, end, { thickness, 0.f }, Vertex::rgba8( col ), ShapeKind::LINE };
+
+    // draw a line with some thickness
+    // https://forum.libcinder.org/topic/smooth-thick-lines-using-geometry-shader
+    else {
+        Vector2 diff, norm;
+        Vector2 a, b, c, d;
+
+        // calculate the normal vector of this line.
+        diff = end - start;
+        norm = Vector2( -diff.y, diff.x ).normalized();
+
+        // calculate corners for quad vertices.
+        a = start - norm * thickness;
+        b = start + norm * thickness;
+        c = end   - norm * thickness;
+        d = end   + norm * thickness;
+
+        auto           r    = m_render_list.reserve( 4, 6, Topology::TRIANGLE_LIST, Batch_t::NO_TEXTURE, scissor );
+        const uint32_t base = r.m_base_index;
+
+        r.m_vertices[ 0 ] = { a.x, a.y, col };
+        r.m_vertices[ 1 ] = { b.x, b.y, col };
+        r.m_vertices[ 2 ] = { c.x, c.y, col };
+        r.m_vertices[ 3 ] = { d.x, d.y, col };
+
+        r.m_indices[ 0 ] = base;
+        r.m_indices[ 1 ] = base + 2;
+        r.m_indices[ 2 ] = base + 3;
+        r.m_indices[ 3 ] = base + 3;
+        r.m_indices[ 4 ] = base + 1;
+        r.m_indices[ 5 ] = base;
+
+        commit( 4, 6 );
+    }
+};
+
+void RecordContext::draw_line( const float start_x, const float start_y, const float end_x, const float end_y, const Color &color, const float thickness ) {
+    draw_line( { start_x, start_y }, { end_x, end_y }, color, thickness );
+}
+
+void RecordContext::draw_lines( std::span< const LineInstance_t > lines, const float thickness ) {
+    const Vector2     extent{ std::max( thickness, 1.f ), std::max( thickness, 1.f ) };
+    const ClipRect_t *clip;
+    uint32_t          scissor;
+
+    // lines with some thickness expanded on the gpu, consecutive instances share a batch and are tracked one by one
+    if ( thickness > 1.f && m_instancing ) {
+        for ( const auto &line : lines ) {
+            if ( scissor_test( Vector2( std::min( line.m_start.x, line.m_end.x ), std::min( line.m_start.y, line.m_end.y ) ) - extent,
+                               Vector2( std::max( line.m_start.x, line.m_end.x ), std::max( line.m_start.y, line.m_end.y ) ) + extent, scissor ) )
+                m_render_list.add_instance( ShapeMesh_t::QUAD, scissor ) = { line.m_start, line.m_end, { thickness, 0.f }, Vertex::rgba8( Vertex::pack( line.m_color ) ), ShapeKind::LINE };
+        }
+
+        return;
+    }
+
+    // a pixel thick line is a segment of a list, a thicker one a quad
+    const bool   thin             = thickness <= 1.f;
+    const size_t vertices_per     = thin ? 2 : 4;
+    const size_t indices_per      = thin ? 2 : 6;
+    const size_t lines_per_commit = BULK_VERTICES / vertices_per;
+
+    // while a clip rect is pushed every line is scissored to it, so the lines crossing it share the batch of the others
+    scissor = m_clip_stack.empty() ? Batch_t::NO_CLIP : clip_index();
+
+    for ( size_t done{}; done < lines.size(); done += lines_per_commit ) {
+        const auto chunk = lines.subspan( done, std::min( lines.size() - done, lines_per_commit ) );
+        auto       r     = m_render_list.reserve( chunk.size() * vertices_per, chunk.size() * indices_per, thin ? Topology::LINE_LIST : Topology::TRIANGLE_LIST,
+                                                  Batch_t::NO_TEXTURE, scissor );
+        ClipRect_t bounds{ { INFINITY, INFINITY }, { -INFINITY, -INFINITY } };
+        size_t     count{};
+
+        for ( const auto &line : chunk ) {
+            const Vector2 min = Vector2( std::min( line.m_start.x, line.m_end.x ), std::min( line.m_start.y, line.m_end.y ) ) - extent;
+            const Vector2 max = Vector2( std::max( line.m_start.x, line.m_end.x ), std::max( line.m_start.y, line.m_end.y ) ) + extent;
+
+            if ( !cull_test( min, max, clip ) )
+                continue;
+
+            if ( clip )
+                ++m_recorded.m_scissored;
+
+            const auto col = Vertex::pack( line.m_color );
+            Vertex     *v  = r.m_vertices.data() + count * vertices_per;
+
+            if ( thin ) {
+                v[ 0 ] = { line.m_start.x, line.m_start.y, col };
+                v[ 1 ] = { line.m_end.x,   line.m_end.y,   col };
+            }
+
+            // the quad of draw_line, offset by the thickness on both sides
+            else {
+                const Vector2 diff = line.m_end - line.m_start;
+                const Vector2 norm = Vector2( -diff.y, diff.x ).normalized() * thickness;
+
+                v[ 0 ] = { line.m_start.x - norm.x, line.m_start.y - norm.y, col };
+                v[ 1 ] = { line.m_start.x + norm.x, line.m_start.y + norm.y, col };
+                v[ 2 ] = { line.m_end.x   - norm.x, line.m_end.y   - norm.y, col };
+                v[ 3 ] = { line.m_end.x   + norm.x, line.m_end.y   + norm.y, col };
+            }
+
+            bounds = bounds.unite( { min, max } );
+            ++count;
+        }
+
+        // every line has the same indices offset by its vertices, so they are written in a pass of their own
+        for ( size_t i{}; i < count; ++i ) {
+            const uint32_t base = r.m_base_index + ( uint32_t ) ( i * vertices_per );
+            uint32_t       *idx = r.m_indices.data() + i * indices_per;
+
+            if ( thin ) {
+                idx[ 0 ] = base;
+                idx[ 1 ] = base + 1;
+            }
+
+            else {
+                idx[ 0 ] = base;
+                idx[ 1 ] = base + 2;
+                idx[ 2 ] = base + 3;
+                idx[ 3 ] = base + 3;
+                idx[ 4 ] = base + 1;
+                idx[ 5 ] = base;
+            }
+        }
+
+        bound_bulk( bounds );
+        commit( count * vertices_per, count * indices_per );
+    }
+}
+
+void RecordContext::draw_polyline( std::span< const Vector2 > points, const Color &color, const float thickness, const LineJoin join, const LineCap cap ) {
+    const auto col = Vertex::pack( color );
+    uint32_t   scissor;
+
+    if ( points.size() < 2 )
+        return;
+
+    // the points extended by the longest miter bound the line
+    const float reach = std::max( thickness, 1.f ) * Stroke::MITER_LIMIT;
+    Vector2     min, max;
+
+    VectorArray::bounds( points, min, max );
+
+    if ( !scissor_test( min - Vector2( reach, reach ), max + Vector2( reach, reach ), scissor ) )
+        return;
+
+    const size_t segments = points.size() - 1;
+
+    // draw pixel thick lines between the shared points
+    if ( thickness <= 1.f ) {
+        auto           r    = m_render_list.reserve( points.size(), segments * 2, Topology::LINE_LIST, Batch_t::NO_TEXTURE, scissor );
+        const uint32_t base = r.m_base_index;
+
+        for ( size_t i{}; i < points.size(); ++i )
+            r.m_vertices[ i ] = { points[ i ].x, points[ i ].y, col };
+
+        for ( size_t i{}; i < segments; ++i ) {
+            r.m_indices[ i * 2 ]     = base + ( uint32_t ) i;
+            r.m_indices[ i * 2 + 1 ] = base + ( uint32_t ) i + 1;
+        }
+
+        commit( points.size(), segments * 2 );
+        return;
+    }
+
+    Vector2 *normals = scratch< Vector2 >( segments );
+
+    Stroke::normals( points, normals );
+
+    // segments without length are skipped, a line without any draws nothing
+    size_t first{};
+
+    while ( first < segments && normals[ first ] == Vector2() )
+        ++first;
+
+    if ( first == segments )
+        return;
+
+    // a miter falls back to a bevel, and a round join or cap is a fan of at most a half turn
+    const size_t join_vertices = join == LineJoin::ROUND ? Stroke::ROUND_STEPS + 2 : 3;
+    const size_t join_indices  = join == LineJoin::ROUND ? Stroke::ROUND_STEPS * 3 : 3;
+    const size_t cap_vertices  = cap == LineCap::ROUND ? Stroke::ROUND_STEPS + 2 : 2;
+    const size_t cap_indices   = cap == LineCap::ROUND ? Stroke::ROUND_STEPS * 3 : 0;
+
+    auto           r    = m_render_list.reserve( cap_vertices * 2 + join_vertices * ( segments - 1 ), cap_indices * 2 + join_indices * ( segments - 1 ) + segments * 6,
+                                                 Topology::TRIANGLE_LIST, Batch_t::NO_TEXTURE, scissor );
+    const uint32_t base = r.m_base_index;
+    size_t         vertex_count{};
+    size_t         index_count{};
+    uint32_t       left, right; // vertices the next segment starts from, on the side of its normal and on the other side
+
+    const auto add_vertex = [ & ]( const Vector2 &pos ) {
+        r.m_vertices[ vertex_count ] = { pos.x, pos.y, col };
+
+        return base + ( uint32_t ) vertex_count++;
+    };
+
+    const auto add_triangle = [ & ]( const uint32_t a, const uint32_t b, const uint32_t c ) {
+        r.m_indices[ index_count++ ] = a;
+        r.m_indices[ index_count++ ] = b;
+        r.m_indices[ index_count++ ] = c;
+    };
+
+    // the quad of a segment between the vertices it starts and ends at
+    const auto add_segment = [ & ]( const uint32_t end_left, const uint32_t end_right ) {
+        add_triangle( left, end_left, end_right );
+        add_triangle( end_right, right, left );
+
+        left  = end_left;
+        right = end_right;
+    };
+
+    // a half turn around an end from the side of the normal to the other, behind the start or ahead of the end
+    const auto add_cap = [ & ]( const Vector2 &pos, const Vector2 &normal, const bool start ) {
+        const Vector2 dir      = Vector2( normal.y, -normal.x ) * ( start ? -thickness : thickness );
+        const Vector2 side     = normal * thickness;
+        const float   step_sin = start ? Stroke::ROUND_STEP.m_sin : -Stroke::ROUND_STEP.m_sin;
+
+        if ( cap != LineCap::ROUND ) {
+            const Vector2 end = cap == LineCap::SQUARE ? pos + dir : pos;
+
+            return std::pair{ add_vertex( end + side ), add_vertex( end - side ) };
+        }
+
+        const uint32_t center   = add_vertex( pos );
+        const uint32_t cap_left = add_vertex( pos + side );
+        uint32_t       previous = cap_left;
+        Vector2        offset   = side;
+
+        for ( size_t i{ 1 }; i < Stroke::ROUND_STEPS; ++i ) {
+            offset = Vector2( offset.x * Stroke::ROUND_STEP.m_cos - offset.y * step_sin, offset.x * step_sin + offset.y * Stroke::ROUND_STEP.m_cos );
+
+            const uint32_t next = add_vertex( pos + offset );
+
+            add_triangle( center, previous, next );
+            previous = next;
+        }
+
+        const uint32_t cap_right = add_vertex( pos - side );
+
+        add_triangle( center, previous, cap_right );
+
+        return std::pair{ cap_left, cap_right };
+    };
+
+    const auto [ start_left, start_right ] = add_cap( points[ first ], normals[ first ], true );
+
+    Vector2 normal = normals[ first ];
+
+    left  = start_left;
+    right = start_right;
+
+    for ( size_t i{ first + 1 }; i < segments; ++i ) {
+        Vector2 next = normals[ i ];
+
+        if ( next == Vector2() )
+            continue;
+
+        const Vector2 &pos  = points[ i ];
+        const float   dot   = normal.dot( next );
+        const float   cross = normal.cross( next );
+        const Vector2 miter = ( normal + next ) * ( thickness / std::max( 1.f + dot, Stroke::MIN_MITER ) );
+
+        // the outer edges meet within the limit, both segments share the two miter vertices
+        if ( join == LineJoin::MITER && 1.f + dot >= Stroke::MIN_MITER ) {
+            const uint32_t miter_left = add_vertex( pos + miter );
+
+            add_segment( miter_left, add_vertex( pos - miter ) );
+        }
+
+        // the segments share the inner corner, the outer corners of both are connected around it
+        else {
+            const float    outer = cross > 0.f ? -1.f : 1.f;
+            const uint32_t inner = add_vertex( pos - miter * outer );
+            const uint32_t start = add_vertex( pos + normal * ( thickness * outer ) );
+            uint32_t       previous{ start };
+
+            if ( outer > 0.f )
+                add_segment( start, inner );
+
+            else
+                add_segment( inner, start );
+
+            // the arc rotates from the outer corner of one segment towards the other until it would pass it
+            if ( join == LineJoin::ROUND ) {
+                const float   step_sin = -outer * Stroke::ROUND_STEP.m_sin;
+                const Vector2 target   = next * outer;
+                Vector2       offset   = normal * outer;
+
+                for ( size_t step{ 1 }; step < Stroke::ROUND_STEPS; ++step ) {
+                    offset = Vector2( offset.x * Stroke::ROUND_STEP.m_cos - offset.y * step_sin, offset.x * step_sin + offset.y * Stroke::ROUND_STEP.m_cos );
+
+                    if ( offset.cross( target ) * -outer <= 0.f )
+                        break;
+
+                    const uint32_t arc = add_vertex( pos + offset * thickness );
+
+                    add_triangle( inner, previous, arc );
+                    previous = arc;
+                }
+            }
+
+            const uint32_t end = add_vertex( pos + next * ( thickness * outer ) );
+
+            add_triangle( inner, previous, end );
+
+            if ( outer > 0.f )
+                left = end;
+
+            else
+                right = end;
+        }
+
+        normal = next;
+    }
+
+    const auto [ end_left, end_right ] = add_cap( points[ segments ], normal, false );
+
+    add_segment( end_left, end_right );
+
+    commit( vertex_count, index_count );
+}
+
+void RecordContext::draw_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &color ) {
+    add_rect( pos, size, Vertex::pack( color ) );
+}
+
+void RecordContext::draw_filled_rect( const float x, const float y, const float w, const float h, const Color &color ) {
+    draw_filled_rect( { x, y }, { w, h }, color );
+}
+
+void RecordContext::draw_filled_rects( std::span< const RectInstance_t > rects ) {
+    const ClipRect_t *clip;
+    Vector2          uv_min, uv_max;
+
+    // rects expanded on the gpu, consecutive instances share a batch and are tracked one by one
+    if ( m_instancing ) {
+        for ( const auto &rect : rects ) {
+            Vector2 min{ std::min( rect.m_pos.x, rect.m_pos.x + rect.m_size.x ), std::min( rect.m_pos.y, rect.m_pos.y + rect.m_size.y ) };
+            Vector2 max{ std::max( rect.m_pos.x, rect.m_pos.x + rect.m_size.x ), std::max( rect.m_pos.y, rect.m_pos.y + rect.m_size.y ) };
+
+            if ( !clip_test( min, max, clip ) )
+                continue;
+
+            if ( clip ) {
+                clip->clip( min, max, uv_min, uv_max );
+                ++m_recorded.m_clipped;
+            }
+
+            m_render_list.add_instance( ShapeMesh_t::QUAD ) = { min, max - min, {}, Vertex::rgba8( Vertex::pack( rect.m_color ) ), ShapeKind::RECT };
+        }
+
+        return;
+    }
+
+    const size_t rects_per_commit = BULK_VERTICES / 4;
+
+    for ( size_t done{}; done < rects.size(); done += rects_per_commit ) {
+        const auto chunk = rects.subspan( done, std::min( rects.size() - done, rects_per_commit ) );
+        auto       r     = m_render_list.reserve( chunk.size() * 4, chunk.size() * 6, Topology::TRIANGLE_LIST );
+        ClipRect_t bounds{ { INFINITY, INFINITY }, { -INFINITY, -INFINITY } };
+        size_t     count{};
+
+        for ( const auto &rect : chunk ) {
+            Vector2 min{ std::min( rect.m_pos.x, rect.m_pos.x + rect.m_size.x ), std::min( rect.m_pos.y, rect.m_pos.y + rect.m_size.y ) };
+            Vector2 max{ std::max( rect.m_pos.x, rect.m_pos.x + rect.m_size.x ), std::max( rect.m_pos.y, rect.m_pos.y + rect.m_size.y ) };
+
+            if ( !cull_test( min, max, clip ) )
+                continue;
+
+            // a rect crossing the clip rect is cut to it, so it stays in the reservation
+            if ( clip ) {
+                clip->clip( min, max, uv_min, uv_max );
+                ++m_recorded.m_clipped;
+            }
+
+            const auto col = Vertex::pack( rect.m_color );
+            Vertex     *v  = r.m_vertices.data() + count * 4;
+
+            v[ 0 ] = { min.x, min.y, col };
+            v[ 1 ] = { max.x, min.y, col };
+            v[ 2 ] = { max.x, max.y, col };
+            v[ 3 ] = { min.x, max.y, col };
+
+            bounds = bounds.unite( { min, max } );
+            ++count;
+        }
+
+        // every rect has the same indices offset by its vertices, so they are written in a pass of their own
+        for ( size_t i{}; i < count; ++i ) {
+            const uint32_t base = r.m_base_index + ( uint32_t ) ( i * 4 );
+            uint32_t       *idx = r.m_indices.data() + i * 6;
+
+            idx[ 0 ] = base;
+            idx[ 1 ] = base + 1;
+            idx[ 2 ] = base + 2;
+            idx[ 3 ] = base + 2;
+            idx[ 4 ] = base + 3;
+            idx[ 5 ] = base;
+        }
+
+        bound_bulk( bounds );
+        commit( count * 4, count * 6 );
+    }
+}
+
+void RecordContext::draw_rect( const Vector2 &pos, const Vector2 &size, const Color &color, const float thickness ) {
+    const auto col = Vertex::pack( color );
+
+    // bottom line.
+    add_rect( { pos.x, pos.y + size.y - thickness }, { size.x, thickness }, col );
+
+    // top line.
+    add_rect( pos, { size.x, thickness }, col );
+
+    // left line.
+    add_rect( pos, { thickness, size.y }, col );
+
+    // right line.
+    add_rect( { pos.x + size.x - thickness, pos.y }, { thickness, size.y }, col );
+}
+
+void RecordContext::draw_rect( const float x, const float y, const float w, const float h, const Color &color, const float thickness ) {
+    draw_rect( { x, y }, { w, h }, color, thickness );
+}
+
+void RecordContext::draw_outlined_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &fill_color, const Color &outline_color ) {
+    draw_filled_rect( pos.x, pos.y, size.x, size.y, fill_color );
+    draw_rect( pos.x - 1.f, pos.y - 1.f, size.x + 2.f, size.y + 2.f, outline_color );
+}
+
+void RecordContext::draw_outlined_filled_rect( const float x, const float y, const float w, const float h, const Color &fill_color, const Color &outline_color ) {
+    draw_outlined_filled_rect( { x, y }, { w, h }, fill_color, outline_color );
+}
+
+void RecordContext::draw_outlined_rect( const Vector2 &pos, const Vector2 &size, const Color &inner_color, const Color &outline_color ) {
+    // outline
+    draw_rect( pos.x - 1.f, pos.y - 1.f, size.x + 2.f, size.y + 2.f, outline_color );
+    draw_rect( pos.x + 1.f, pos.y + 1.f, size.x - 2.f, size.y - 2.f, outline_color );
+
+    // inner line
+    draw_rect( pos.x, pos.y, size.x, size.y, inner_color );
+}
+
+void RecordContext::draw_outlined_rect( const float x, const float y, const float w, const float h, const Color &inner_color, const Color &outline_color ) {
+    draw_outlined_rect( { x, y }, { w, h }, inner_color, outline_color );
+}
+
+void RecordContext::draw_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count ) {
+    add_arc( pos, { radius, radius }, 0.f, TWO_PI, Vertex::pack( color ), segment_count, false );
+}
+
+void RecordContext::draw_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count ) {
+    draw_circle( { x, y }, radius, color, segment_count );
+}
+
+void RecordContext::draw_filled_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count ) {
+    add_arc( pos, { radius, radius }, 0.f, TWO_PI, Vertex::pack( color ), segment_count, true );
+}
+
+void RecordContext::draw_filled_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count ) {
+    draw_filled_circle( { x, y }, radius, color, segment_count );
+}
+
+void RecordContext::draw_filled_circles( std::span< const CircleInstance_t > circles, const size_t segment_count ) {
+    const ClipRect_t *clip;
+    uint32_t          scissor;
+
+    if ( !segment_count )
+        return;
+
+    // filled circles expanded on the gpu from the unit fan, consecutive instances share a batch and are tracked one by one
+    if ( m_instancing ) {
+        const uint32_t fan = mesh( segment_count );
+
+        if ( fan != Batch_t::NO_MESH ) {
+            for ( const auto &circle : circles ) {
+                const Vector2 extent{ std::fabs( circle.m_radius ), std::fabs( circle.m_radius ) };
+
+                if ( scissor_test( circle.m_pos - extent, circle.m_pos + extent, scissor ) )
+                    m_render_list.add_instance( fan, scissor ) = { circle.m_pos, { circle.m_radius, circle.m_radius }, {}, Vertex::rgba8( Vertex::pack( circle.m_color ) ),
+                                                                   ShapeKind::ELLIPSE };
+            }
+
+            return;
+        }
+    }
+
+    // each circle is the fan of add_arc, around its center and closed on its first point
+    const auto   unit               = m_unit_circles.get( segment_count );
+    const size_t vertices_per       = segment_count + 2;
+    const size_t indices_per        = segment_count * 3;
+    const size_t circles_per_commit = std::max( BULK_VERTICES / vertices_per, ( size_t ) 1 );
+
+    // while a clip rect is pushed every circle is scissored to it, so the circles crossing it share the batch of the others
+    scissor = m_clip_stack.empty() ? Batch_t::NO_CLIP : clip_index();
+
+    for ( size_t done{}; done < circles.size(); done += circles_per_commit ) {
+        const auto chunk = circles.subspan( done, std::min( circles.size() - done, circles_per_commit ) );
+        auto       r     = m_render_list.reserve( chunk.size() * vertices_per, chunk.size() * indices_per, Topology::TRIANGLE_LIST, Batch_t::NO_TEXTURE, scissor );
+        ClipRect_t bounds{ { INFINITY, INFINITY }, { -INFINITY, -INFINITY } };
+        size_t     count{};
+
+        for ( const auto &circle : chunk ) {
+            const Vector2 extent{ std::fabs( circle.m_radius ), std::fabs( circle.m_radius ) };
+            const Vector2 min = circle.m_pos - extent;
+            const Vector2 max = circle.m_pos + extent;
+
+            if ( !cull_test( min, max, clip ) )
+                continue;
+
+            if ( clip )
+                ++m_recorded.m_scissored;
+
+            const auto col = Vertex::pack( circle.m_color );
+            Vertex     *v  = r.m_vertices.data() + count * vertices_per;
+
+            v[ 0 ] = { circle.m_pos.x, circle.m_pos.y, col };
+
+            for ( size_t i{}; i < segment_count; ++i )
+                v[ i + 1 ] = { circle.m_pos.x + circle.m_radius * unit[ i ].m_cos, circle.m_pos.y + circle.m_radius * unit[ i ].m_sin, col };
+
+            v[ segment_count + 1 ] = v[ 1 ];
+
+            bounds = bounds.unite( { min, max } );
+            ++count;
+        }
+
+        // every circle has the same fan offset by its vertices, so the indices are written in a pass of their own
+        for ( size_t c{}; c < count; ++c ) {
+            const uint32_t base = r.m_base_index + ( uint32_t ) ( c * vertices_per );
+            uint32_t       *idx = r.m_indices.data() + c * indices_per;
+
+            for ( size_t i{}; i < segment_count; ++i ) {
+                idx[ i * 3 ]     = base;
+                idx[ i * 3 + 1 ] = base + ( uint32_t ) i + 1;
+                idx[ i * 3 + 2 ] = base + ( uint32_t ) i + 2;
+            }
+        }
+
+        bound_bulk( bounds );
+        commit( count * vertices_per, count * indices_per );
+    }
+}
+
+void RecordContext::draw_ellipse( const Vector2 &pos, const Vector2 &radii, const Color &color, const size_t segment_count ) {
+    add_arc( pos, radii, 0.f, TWO_PI, Vertex::pack( color ), segment_count, false );
+}
+
+void RecordContext::draw_filled_ellipse( const Vector2 &pos, const Vector2 &radii, const Color &color, const size_t segment_count ) {
+    add_arc( pos, radii, 0.f, TWO_PI, Vertex::pack( color ), segment_count, true );
+}
+
+void RecordContext::draw_arc( const Vector2 &pos, const float radius, const float start_angle, const float sweep_angle, const Color &color, const size_t segment_count ) {
+    add_arc( pos, { radius, radius }, start_angle, sweep_angle, Vertex::pack( color ), segment_count, false );
+}
+
+void RecordContext::draw_filled_arc( const Vector2 &pos, const float radius, const float start_angle, const float sweep_angle, const Color &color, const size_t segment_count ) {
+    add_arc( pos, { radius, radius }, start_angle, sweep_angle, Vertex::pack( color ), segment_count, true );
+}
+
+void RecordContext::add_sdf( const ShapeInstance_t &shape ) {
+    const Vector2 extent{ shape.m_size.x + Sdf::AA_PADDING, shape.m_size.y + Sdf::AA_PADDING };
+    uint32_t      scissor;
+
+    // the quad is extended past the shape so its edge can fade out
+    if ( scissor_test( shape.m_pos - extent, shape.m_pos + extent, scissor ) )
+        m_render_list.add_instance( ShapeMesh_t::QUAD, scissor ) = shape;
+}
+
+void RecordContext::draw_rounded_rect( const Vector2 &pos, const Vector2 &size, const float radius, const Color &color, const float thickness ) {
+    add_sdf( Sdf::rounded_rect( pos, size, radius, std::max( thickness, 1.f ), color.pack() ) );
+}
+
+void RecordContext::draw_filled_rounded_rect( const Vector2 &pos, const Vector2 &size, const float radius, const Color &color ) {
+    add_sdf( Sdf::rounded_rect( pos, size, radius, 0.f, color.pack() ) );
+}
+
+void RecordContext::draw_smooth_circle( const Vector2 &pos, const float radius, const Color &color, const float thickness ) {
+    add_sdf( Sdf::circle( pos, radius, std::max( thickness, 1.f ), color.pack() ) );
+}
+
+void RecordContext::draw_filled_smooth_circle( const Vector2 &pos, const float radius, const Color &color ) {
+    add_sdf( Sdf::circle( pos, radius, 0.f, color.pack() ) );
+}
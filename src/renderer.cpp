@@ -1,503 +1,1279 @@
 #include "renderer.h"
 #include "vertex.h"
 
-#include "vertex_shader.h"
-#include "pixel_shader.h"
-
-#include <DirectXMath.h>
+#include <chrono>
 
 using namespace dx;
-using namespace DirectX;
 
-void Renderer::perform() {
-    // capture current render state
-    if ( !m_render_state_backup.capture( m_dev_ctx ) )
-        return;
-    
-    // set custom rendering settings
-    set_custom_state();
+bool Renderer::perform() {
+    return perform_frame( nullptr );
+}
 
-    // draw the vertices
-    flush();
+bool Renderer::perform( RecordContext &frame ) {
+    return perform_frame( &frame );
+}
+
+void Renderer::set_skip_unchanged( const bool skip ) {
+    m_skip_unchanged = skip;
 
-    // reapply previous render state
-    m_render_state_backup.apply();
+    // the next frame is compared once its render lists were hashed from the start
+    if ( !skip )
+        m_frame_hashed = false;
 }
 
-bool Renderer::create( ID3D11Device *dev, ID3D11DeviceContext *dev_ctx ) {
-    D3D11_BLEND_DESC blend_desc{};
-    HRESULT          hr;
+void Renderer::set_partial_redraw( const bool partial ) {
+    m_partial_redraw = partial;
 
-    if ( !dev || !dev_ctx )
-        return false;
+    // the frames drawn meanwhile are not tracked, the first one tracked again is drawn whole
+    if ( !partial )
+        m_dirty.invalidate();
+}
+
+bool Renderer::changed() {
+    uint64_t hash{};
+
+    return !m_skip_unchanged || !m_frame_hashed || !hash_frame( nullptr, hash ) || hash != m_frame_hash;
+}
+
+bool Renderer::changed( RecordContext &frame ) {
+    uint64_t hash{};
+
+    return !m_skip_unchanged || !m_frame_hashed || !hash_frame( &frame, hash ) || hash != m_frame_hash;
+}
+
+bool Renderer::perform_frame( RecordContext *frame ) {
+    uint64_t   hash{};
+    const bool hashed = m_skip_unchanged && hash_frame( frame, hash );
+    size_t     region_ns{};
+
+    // a frame the same as the last one drawn is dropped, the image presented last still shows it
+    if ( hashed && m_frame_hashed && hash == m_frame_hash ) {
+        take_recorded( frame );
+        end_frame( frame );
 
-    m_dev_ctx = dev_ctx;
-    m_dev     = dev;
+        m_stats.m_unchanged = 1;
 
-    hr = m_dev->CreateVertexShader( vertex_shader.data(), sizeof( vertex_shader ), nullptr, &m_vertex_shader );
-    if ( FAILED( hr ) ) 
         return false;
+    }
+
+    // compare the primitives with those drawn last frame, a frame where none changed is dropped like an unchanged one
+    if ( m_partial_redraw ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        track_frame( frame );
+
+        region_ns = ( size_t ) std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count();
+
+        if ( !m_dirty.full() && m_dirty.rects().empty() ) {
+            take_recorded( frame );
+            end_frame( frame );
+
+            m_stats.m_unchanged = 1;
+            m_stats.m_region_ns = region_ns;
+
+            return false;
+        }
+    }
+
+    // prepare backend state, a frame that cannot be drawn is dropped so its lists do not carry over into the next one
+    if ( !m_backend->begin() ) {
+        take_recorded( frame );
+        end_frame( frame );
+
+        m_frame_hashed = false;
+        m_dirty.invalidate();
 
-    hr = m_dev->CreatePixelShader( pixel_shader.data(), sizeof( pixel_shader ), nullptr, &m_pixel_shader );
-    if ( FAILED( hr ) )
         return false;
+    }
 
-    const std::array< D3D11_INPUT_ELEMENT_DESC, 2 > input_layout_desc = {
-        D3D11_INPUT_ELEMENT_DESC{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,	 0, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        D3D11_INPUT_ELEMENT_DESC{ "COLOR",	  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
-    };
+    // draw the vertices
+    flush( frame );
+
+    // reapply previous backend state
+    m_backend->end();
+
+    m_frame_hash   = hash;
+    m_frame_hashed = hashed;
+
+    if ( m_partial_redraw ) {
+        m_stats.m_region_ns   = region_ns;
+        m_stats.m_dirty_rects = m_dirty.rects().size();
 
-    hr = m_dev->CreateInputLayout( input_layout_desc.data(), input_layout_desc.size(), 
-                                    vertex_shader.data(), sizeof( vertex_shader ), &m_input_layout );
-    if ( FAILED( hr ) )
+        for ( const auto &rect : m_dirty.rects() )
+            m_stats.m_dirty_pixels += ( size_t ) ( ( rect.m_max.x - rect.m_min.x ) * ( rect.m_max.y - rect.m_min.y ) );
+    }
+
+    return true;
+}
+
+bool Renderer::create( Backend *backend, const char *font_path ) {
+    if ( !backend )
         return false;
 
-    // initialize blend state
-    blend_desc.RenderTarget->BlendEnable           = TRUE;
-    blend_desc.RenderTarget->SrcBlend              = D3D11_BLEND_SRC_ALPHA;
-    blend_desc.RenderTarget->DestBlend             = D3D11_BLEND_INV_SRC_ALPHA;
-    blend_desc.RenderTarget->SrcBlendAlpha         = D3D11_BLEND_INV_DEST_ALPHA;
-    blend_desc.RenderTarget->DestBlendAlpha        = D3D11_BLEND_ONE;
-    blend_desc.RenderTarget->BlendOp               = D3D11_BLEND_OP_ADD;
-    blend_desc.RenderTarget->BlendOpAlpha          = D3D11_BLEND_OP_ADD;
-    blend_desc.RenderTarget->RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-    hr = m_dev->CreateBlendState( &blend_desc, &m_blend_state );
-    if ( FAILED( hr ) )
+    m_backend     = backend;
+    m_screen_size = m_backend->get_screen_size();
+
+    // initialize vertex, index, and instance rings
+    if ( !m_backend->resize( BufferType::VERTEX, INITIAL_VERTEX_BUFFER_SIZE ) )
         return false;
 
-    // initialize vertex and index buffers
-    if ( !allocate() )
+    m_vertex_ring.reset( INITIAL_VERTEX_BUFFER_SIZE );
+
+    if ( !m_backend->resize( BufferType::INDEX, INITIAL_INDEX_BUFFER_SIZE ) )
         return false;
 
-    // initialize projection matrix and buffer
-    if ( !project() )
+    m_index_ring.reset( INITIAL_INDEX_BUFFER_SIZE );
+
+    if ( !m_backend->resize( BufferType::INSTANCE, INITIAL_INSTANCE_BUFFER_SIZE ) )
         return false;
 
-    return true;
+    m_instance_ring.reset( INITIAL_INSTANCE_BUFFER_SIZE );
+
+    // textures are created on the backend as atlas pages are added and baked font pages are first drawn
+    m_atlas.clear();
+    m_atlas_textures.clear();
+    m_baked_textures.clear();
+    m_texture_count = 0;
+
+    // map the baked default font, the built-in bitmap font stands in without one
+    m_text.clear();
+
+    if ( auto baked = std::make_unique< BakedFont >(); font_path && baked->open( font_path ) )
+        m_text.add_font( std::move( baked ) );
+
+    else
+        m_text.add_font( std::make_unique< BitmapFont >() );
+
+    // the renderer draws its own render list before the contexts of its layer
+    m_contexts.clear();
+    m_lists = { this };
+
+    // the first frame is always drawn, and drawn whole
+    m_frame_hashed = false;
+    m_dirty.invalidate();
+
+    // initialize the unit quad shared by rects and lines
+    m_meshes.clear();
+
+    return mesh( 0 ) == ShapeMesh_t::QUAD;
+}
+
+RecordContext *Renderer::create_context( const int32_t layer ) {
+    if ( m_lists.empty() )
+        return nullptr;
+
+    auto &context = m_contexts.emplace_back( std::make_unique< RecordContext >( layer ) );
+
+    context->set_instancing( m_instancing );
+    context->m_render_list.set_hashing( m_skip_unchanged );
+    context->m_render_list.set_tracking( m_partial_redraw );
+    context->m_render_list.set_sorting( m_sort_batches );
+
+    // keep the lists sorted by layer, a context goes after the lists already in its layer
+    m_lists.insert( std::upper_bound( m_lists.begin(), m_lists.end(), layer, []( const int32_t l, const RecordContext *list ) { return l < list->layer(); } ),
+                    context.get() );
+
+    return context.get();
 }
 
 void Renderer::destroy() {
-    m_vertex_shader->Release();
-    m_pixel_shader->Release();
-    m_input_layout->Release();
-    m_blend_state->Release();
-    m_vertex_buffer->Release();
-    m_index_buffer->Release();
-}
-
-bool Renderer::allocate() {
-    D3D11_BUFFER_DESC        vertex_buffer_desc{};
-    D3D11_BUFFER_DESC        index_buffer_desc{};
-    D3D11_MAPPED_SUBRESOURCE resource{};
-    HRESULT                  hr;
-
-    // initialize vertex buffer
-    vertex_buffer_desc.Usage          = D3D11_USAGE_DYNAMIC;
-    vertex_buffer_desc.ByteWidth      = sizeof( Vertex ) * m_max_vertices;
-    vertex_buffer_desc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-    vertex_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    vertex_buffer_desc.MiscFlags      = 0;
-
-    hr = m_dev->CreateBuffer( &vertex_buffer_desc, NULL, &m_vertex_buffer );
-    if ( FAILED( hr ) )
-        return false;
+    m_render_list.clear();
+    m_meshes.clear();
+    m_atlas.clear();
+    m_images.clear();
+    m_atlas_textures.clear();
+    m_text.clear();
+    m_baked_textures.clear();
+    m_clip_stack.clear();
+    m_contexts.clear();
+    m_lists.clear();
+    m_statics.clear();
+    m_capture_list.clear();
+    m_capture_clips.clear();
+
+    m_clip         = Batch_t::NO_CLIP;
+    m_capture_clip = Batch_t::NO_CLIP;
+    m_capturing    = false;
+
+    m_backend->destroy();
+}
 
-    // initialize index buffer
-    index_buffer_desc.Usage          = D3D11_USAGE_DYNAMIC;
-    index_buffer_desc.ByteWidth      = sizeof( size_t ) * m_max_indices;
-    index_buffer_desc.BindFlags      = D3D11_BIND_INDEX_BUFFER;
-    index_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    index_buffer_desc.MiscFlags      = 0;
+void Renderer::flush( RecordContext *frame ) {
+    const ClipRect_t *clip{};
+    bool             uploaded{ true };
 
-    hr = m_dev->CreateBuffer( &index_buffer_desc, NULL, &m_index_buffer );
-    if ( FAILED( hr ) )
-        return false;
+    // the counters of the recording start the frame, the upload adds its own
+    take_recorded( frame );
 
-    return true;
+    // grow the rings to the high-water mark of the previous frames
+    reserve( BufferType::VERTEX, m_vertex_ring, m_vertex_ring.high_water(), MAX_BUFFER_SIZE );
+    reserve( BufferType::INDEX, m_index_ring, m_index_ring.high_water(), MAX_BUFFER_SIZE );
+    reserve( BufferType::INSTANCE, m_instance_ring, m_instance_ring.high_water(), MAX_BUFFER_SIZE );
+
+    // sort the lists bounded from the start of the frame, the lists themselves are still drawn in layer order
+    if ( m_sort_batches ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        visit_lists( frame, [ this ]( RecordContext &context ) {
+            if ( context.m_render_list.sorting() )
+                m_stats.m_merged += m_sorter.sort( context.m_render_list );
+
+            return true;
+        } );
+
+        m_stats.m_sort_ns = ( size_t ) std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    // the diffed upload lays out the whole frame in the persistent buffers, so it lands on the bytes of the previous frame
+    if ( m_diff_upload ) {
+        size_t vertex_size{};
+        size_t index_size{};
+        size_t instance_size{};
+
+        const auto add_size = [ & ]( RecordContext &context ) {
+            auto &list = context.m_render_list;
+
+            vertex_size   += sizeof( Vertex ) * list.vertices().size();
+            index_size    += sizeof( uint32_t ) * ( list.indices().size() + list.batches().size() );
+            instance_size += sizeof( ShapeInstance_t ) * list.instances().size();
+        };
+
+        for ( auto *list : m_lists )
+            add_size( *list );
+
+        if ( frame )
+            add_size( *frame );
+
+        uploaded = reserve_persistent( BufferType::VERTEX, vertex_size ) && reserve_persistent( BufferType::INDEX, index_size ) &&
+                   reserve_persistent( BufferType::INSTANCE, instance_size );
+
+        m_vertex_diff.begin_frame();
+        m_index_diff.begin_frame();
+        m_instance_diff.begin_frame();
+
+        m_backend->set_persistent( true );
+    }
+
+    // the render lists are appended to the same rings in layer order, so the frame is drawn the same whichever thread finished first
+    if ( uploaded )
+        visit_lists( frame, [ this, &clip ]( RecordContext &context ) { return upload_list( context.m_render_list, clip ); } );
+
+    m_vertex_ring.end_frame();
+    m_index_ring.end_frame();
+    m_instance_ring.end_frame();
+
+    end_frame( frame );
 }
 
-bool Renderer::project() {
-    D3D11_BUFFER_DESC        proj_buffer_desc{};
-    XMMATRIX                 proj_matrix{};
-    D3D11_MAPPED_SUBRESOURCE resource{};
-    HRESULT                  hr;
+void Renderer::take_recorded( RecordContext *frame ) {
+    const auto add_recorded = [ this ]( RecordContext &context ) {
+        const auto recorded = std::exchange( context.m_recorded, {} );
 
-    m_screen_size = get_screen_size();
+        m_stats.m_primitives += recorded.m_primitives;
+        m_stats.m_rejected   += recorded.m_rejected;
+        m_stats.m_clipped    += recorded.m_clipped;
+        m_stats.m_scissored  += recorded.m_scissored;
+    };
 
-    // initialize projection buffer
-    proj_buffer_desc.Usage          = D3D11_USAGE_DYNAMIC;
-    proj_buffer_desc.ByteWidth      = sizeof( XMMATRIX );
-    proj_buffer_desc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
-    proj_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    proj_buffer_desc.MiscFlags      = 0;
+    m_stats = std::exchange( m_recorded, {} );
 
-    hr = m_dev->CreateBuffer( &proj_buffer_desc, NULL, &m_proj_buffer );
-    if ( FAILED( hr ) )
-        return false;
+    for ( const auto &context : m_contexts )
+        add_recorded( *context );
 
-    // initialize projection matrix
-    proj_matrix = XMMatrixOrthographicOffCenterLH(
-        0.f, m_screen_size.x, m_screen_size.y, 0.f, 0.f, 1.f
-    );
+    if ( frame )
+        add_recorded( *frame );
+}
+
+void Renderer::end_frame( RecordContext *frame ) {
+    m_atlas.end_frame();
+    m_text.end_frame();
+
+    // the lists are empty again, so hashing, tracking, and sorting can be switched without a partial hash or missing primitives.
+    // Their allocators are reset along with them, what they used is the high-water mark of the frame
+    for ( auto *list : m_lists ) {
+        m_stats.m_arena_bytes += list->m_allocator->used();
+
+        list->reset();
+        list->m_render_list.set_hashing( m_skip_unchanged );
+        list->m_render_list.set_tracking( m_partial_redraw );
+        list->m_render_list.set_sorting( m_sort_batches );
+    }
+
+    if ( frame ) {
+        m_stats.m_arena_bytes += frame->m_allocator->used();
+
+        frame->reset();
+        frame->m_render_list.set_hashing( m_skip_unchanged );
+        frame->m_render_list.set_tracking( m_partial_redraw );
+        frame->m_render_list.set_sorting( m_sort_batches );
+    }
+}
+
+bool Renderer::hash_frame( RecordContext *frame, uint64_t &hash ) {
+    FrameHash     frame_hash;
+    const Vector2 screen_size = m_backend->get_screen_size();
+
+    const auto add_list = [ &frame_hash ]( const RecordContext &context ) {
+        if ( !context.m_render_list.hashing() )
+            return false;
+
+        frame_hash.add( context.m_render_list.hash() );
+
+        return true;
+    };
+
+    // texels written this frame can change what the same vertices sample
+    if ( m_recorded.m_texture_bytes )
+        return false;
 
-    hr = m_dev_ctx->Map( m_proj_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource );
-    if ( FAILED( hr ) )
+    // the lists are hashed in the order they are drawn, a queued frame after the lists of its layer
+    if ( !visit_lists( frame, add_list ) )
         return false;
 
-    memcpy( resource.pData, &proj_matrix, sizeof( XMMATRIX ) );
+    frame_hash.add( &screen_size, sizeof( Vector2 ) );
+    frame_hash.add( m_texture_count );
 
-    m_dev_ctx->Unmap( m_proj_buffer, 0 );
+    hash = frame_hash.value();
 
     return true;
 }
 
-void Renderer::flush() {
-    D3D11_MAPPED_SUBRESOURCE resource{};
-    size_t                   ind_idx{};
+void Renderer::track_frame( RecordContext *frame ) {
+    bool complete{ true };
 
-    // copy render list contents to vertex buffer
-    m_dev_ctx->Map( m_vertex_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource );
-    memcpy( resource.pData, m_render_list.vertices().data(), sizeof( Vertex ) * m_render_list.vertices().size() );
-    m_dev_ctx->Unmap( m_vertex_buffer, 0 );
+    m_dirty.begin_frame();
 
-    // copy render list contents to index buffer
-    m_dev_ctx->Map( m_index_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource );
-    memcpy( resource.pData, m_render_list.indices().data(), sizeof( uint32_t ) * m_render_list.indices().size() );
-    m_dev_ctx->Unmap( m_index_buffer, 0 );
+    // the primitives are compared in the order they are drawn, a list recorded before tracking was switched on is not complete
+    visit_lists( frame, [ this, &complete ]( RecordContext &context ) {
+        auto &list = context.m_render_list;
 
-    // draw batched indices/vertices
-    for ( const auto &b : m_render_list.batches() ) {
-        m_dev_ctx->IASetPrimitiveTopology( b.m_topology );
-        m_dev_ctx->DrawIndexed( b.m_index_count, ind_idx, 0 );
+        if ( !list.tracking() )
+            return complete = false;
 
-        ind_idx += b.m_index_count;
-    }
+        for ( const auto &primitive : list.tracked() ) {
+            const auto &b = list.batches()[ primitive.m_batch ];
 
-    m_render_list.clear();
-}
+            // an instance is written after it was added, so its contents are folded into the key here
+            if ( b.instanced() ) {
+                FrameHash key;
+
+                key.add( primitive.m_key );
+                key.add( &list.instances()[ b.m_first_instance + primitive.m_first ], sizeof( ShapeInstance_t ) );
 
-void Renderer::set_custom_state() {
-    // set shader
-    m_dev_ctx->VSSetShader( m_vertex_shader, nullptr, 0 );
-    m_dev_ctx->PSSetShader( m_pixel_shader, nullptr, 0 );
+                m_dirty.add( primitive.m_bounds, key.value() );
+            }
 
-    // set blend state
-    m_dev_ctx->OMSetBlendState( m_blend_state, nullptr, 0xffffffff );
+            else
+                m_dirty.add( primitive.m_bounds, primitive.m_key );
+        }
 
-    // set layout
-    m_dev_ctx->IASetInputLayout( m_input_layout );
+        return true;
+    } );
 
-    // set buffers
-    m_dev_ctx->VSSetConstantBuffers( 0, 1, &m_proj_buffer );
-    m_dev_ctx->IASetVertexBuffers( 0, 1, &m_vertex_buffer, &VERTEX_BUFFER_STRIDE, &VERTEX_BUFFER_OFFSET );
-    m_dev_ctx->IASetIndexBuffer( m_index_buffer, DXGI_FORMAT_R32_UINT, 0 );
+    // texels written this frame can change what the same primitives sample
+    m_dirty.update( m_backend->get_screen_size(), complete, m_recorded.m_texture_bytes != 0 );
 }
 
-Vector2 Renderer::get_screen_size() {
-    D3D11_VIEWPORT viewport;
-    size_t         num_viewports{ 1 };
+bool Renderer::reserve_persistent( BufferType type, const size_t size ) {
+    auto &diff = diff_buffer( type );
+
+    if ( size <= diff.capacity() )
+        return true;
+
+    const size_t capacity = diff.wanted_capacity( size );
+
+    // the new buffer starts out unknown, the next frame is written whole
+    if ( !m_backend->resize_persistent( type, capacity ) )
+        return false;
 
-    m_dev_ctx->RSGetViewports( &num_viewports, &viewport );
+    diff.reset( capacity );
 
-    return Vector2( viewport.Width, viewport.Height );
+    return true;
 }
 
-void Renderer::add_vertices( Vertex *vertex_array, const size_t vertex_count, uint32_t *index_array, const size_t index_count, D3D11_PRIMITIVE_TOPOLOGY topology ) {
-    size_t idx_offset{};
+bool Renderer::upload_list( RenderList &list, const ClipRect_t *&clip ) {
+    const auto &batches = list.batches();
+    size_t     first{};
+
+    // split the list into chunks of whole batches that fit the rings
+    while ( first < batches.size() ) {
+        size_t last{ first };
+        size_t vertex_size{};
+        size_t index_size{};
+        size_t instance_size{};
+
+        for ( ; last < batches.size(); ++last ) {
+            const auto   &b              = batches[ last ];
+            const size_t batch_size      = sizeof( Vertex ) * b.m_vertex_count;
+            const size_t batch_instances = sizeof( ShapeInstance_t ) * b.m_instance_count;
+            size_t       chunk_index     = index_size;
+
+            // 32-bit batches start on a 4-byte boundary
+            if ( b.index_format() == IndexFormat::U32 )
+                chunk_index = ( chunk_index + 3 ) & ~size_t{ 3 };
 
-    // retrive list contents
-    auto &vertices = m_render_list.vertices();
-    auto &indices  = m_render_list.indices();
-    auto &batches  = m_render_list.batches();
+            chunk_index += b.m_index_count * b.index_size();
 
-    // add vertices to render list
-    for ( size_t i{}; i < vertex_count; ++i )
-        vertices.push_back( vertex_array[ i ] );
+            if ( last > first && ( vertex_size + batch_size > m_vertex_ring.capacity() || chunk_index > m_index_ring.capacity() ||
+                                   instance_size + batch_instances > m_instance_ring.capacity() ) )
+                break;
 
-    // calculate index offset
-    if ( !indices.empty() )
-        idx_offset = *std::max_element( indices.begin(), indices.end() ) + 1;
+            vertex_size   += batch_size;
+            index_size     = chunk_index;
+            instance_size += batch_instances;
+        }
 
-    // add indices to index list
-    for ( size_t i{}; i < index_count; ++i )
-        indices.push_back( index_array[ i ] + idx_offset );
+        // a single batch larger than a ring grows it past its usual limit, the persistent buffers already hold the frame
+        if ( !m_diff_upload && ( !reserve( BufferType::VERTEX, m_vertex_ring, vertex_size, SIZE_MAX ) ||
+                                 !reserve( BufferType::INDEX, m_index_ring, index_size, SIZE_MAX ) ||
+                                 !reserve( BufferType::INSTANCE, m_instance_ring, instance_size, SIZE_MAX ) ) )
+            return false;
 
-    // create new patch if needed
-    if ( batches.empty() || batches.back().m_topology != topology )
-        batches.push_back( { topology } );
+        if ( !upload_chunk( list, first, last, vertex_size, index_size, instance_size, clip ) )
+            return false;
 
-    batches.back().m_vertex_count += vertex_count;
-    batches.back().m_index_count  += index_count;
+        first = last;
+    }
+
+    return true;
 }
 
-void Renderer::draw_line( const Vector2 &start, const Vector2 &end, const Color &color, const float thickness ) {
-    // draw a pixel thick line
-    if ( thickness <= 1.f ) {
-        std::array< Vertex,   2 > vertices_thin;
-        std::array< uint32_t, 2 > indices_thin;
+bool Renderer::reserve( BufferType type, UploadRing &ring, const size_t size, const size_t max_size ) {
+    const size_t capacity = ring.wanted_capacity( size, max_size );
 
-        vertices_thin[ 0 ] = { { start.x, start.y, 0.f }, color };
-        vertices_thin[ 1 ] = { { end.x,   end.y,   0.f }, color };
+    if ( capacity == ring.capacity() )
+        return true;
 
-        indices_thin = { 0, 1 };
+    if ( !m_backend->resize( type, capacity ) )
+        return false;
 
-        add_vertices( vertices_thin.data(), vertices_thin.size(), indices_thin.data(), indices_thin.size(), D3D11_PRIMITIVE_TOPOLOGY_LINELIST );
+    ring.reset( capacity );
+
+    return true;
+}
+
+bool Renderer::upload_chunk( RenderList &list, const size_t first, const size_t last, const size_t vertex_size, const size_t index_size, const size_t instance_size,
+                             const ClipRect_t *&clip ) {
+    const auto   &vertices     = list.vertices();
+    const auto   &indices      = list.indices();
+    const auto   &instances    = list.instances();
+    const auto   &batches      = list.batches();
+    const size_t base          = batches[ first ].m_base_vertex;
+    const size_t base_instance = batches[ first ].m_first_instance;
+    size_t       vertex_offset{};
+    size_t       index_start{};
+    size_t       instance_offset{};
+    size_t       index_offset;
+
+    // copy render list contents to vertex buffer, appending to the ring unless it wraps
+    if ( vertex_size && !upload( BufferType::VERTEX, vertices.data() + base, vertex_size, sizeof( Vertex ), vertex_offset ) )
+        return false;
+
+    // copy render list contents to index buffer, narrowing the batches that fit 16 bits
+    if ( index_size ) {
+        auto *index_data = begin_upload( BufferType::INDEX, index_size, sizeof( uint32_t ), index_start );
+        if ( !index_data )
+            return false;
+
+        index_offset = 0;
+
+        for ( size_t i{ first }; i < last; ++i ) {
+            const auto     &b  = batches[ i ];
+            const uint32_t *src = indices.data() + b.m_start_index;
+
+            if ( b.index_format() == IndexFormat::U16 ) {
+                auto *dst = ( uint16_t * ) ( index_data + index_offset );
+
+                for ( size_t j{}; j < b.m_index_count; ++j )
+                    dst[ j ] = ( uint16_t ) src[ j ];
+            }
+
+            else {
+                index_offset = ( index_offset + 3 ) & ~size_t{ 3 };
+
+                memcpy( index_data + index_offset, src, sizeof( uint32_t ) * b.m_index_count );
+            }
+
+            index_offset += b.m_index_count * b.index_size();
+        }
+
+        end_upload( BufferType::INDEX, index_size );
     }
 
-    // draw a line with some thickness
-    // https://forum.libcinder.org/topic/smooth-thick-lines-using-geometry-shader
-    else {
-        std::array< Vertex,   4 > vertices_thick;
-        std::array< uint32_t, 6 > indices_thick;
-        Vector2                   diff, norm;
-        Vector2                   a, b, c, d;
+    // copy render list contents to instance buffer
+    if ( instance_size && !upload( BufferType::INSTANCE, instances.data() + base_instance, instance_size, sizeof( ShapeInstance_t ), instance_offset ) )
+        return false;
+
+    // draw batched indices/vertices and instances, once per dirty rect while only the regions that changed are redrawn
+    const auto   &tracked = list.tracked();
+    const bool   partial  = m_partial_redraw && !m_dirty.full();
+    const size_t passes   = partial ? m_dirty.rects().size() : 1;
+
+    for ( size_t pass{}; pass < passes; ++pass ) {
+        const ClipRect_t *rect = partial ? &m_dirty.rects()[ pass ] : nullptr;
+        size_t           primitive{};
+
+        // the tracked primitives are in batch order, the cursor follows the batches
+        if ( rect )
+            primitive = std::lower_bound( tracked.begin(), tracked.end(), first, []( const TrackedPrimitive_t &p, const size_t batch ) { return p.m_batch < batch; } ) -
+                        tracked.begin();
+
+        const auto touches = [ & ]( const size_t from, const size_t to ) {
+            return std::any_of( tracked.begin() + from, tracked.begin() + to, [ rect ]( const TrackedPrimitive_t &p ) { return !rect->outside( p.m_bounds.m_min, p.m_bounds.m_max ); } );
+        };
+
+        index_offset = index_start;
+
+        for ( size_t i{ first }; i < last; ++i ) {
+            const auto &b = batches[ i ];
+            size_t     start_index{};
+            size_t     batch_primitive{ primitive };
+
+            if ( !b.instanced() && !b.retained() ) {
+                if ( b.index_format() == IndexFormat::U32 )
+                    index_offset = ( index_offset + 3 ) & ~size_t{ 3 };
+
+                start_index   = index_offset / b.index_size();
+                index_offset += b.m_index_count * b.index_size();
+            }
+
+            if ( rect ) {
+                while ( primitive < tracked.size() && tracked[ primitive ].m_batch == i )
+                    ++primitive;
+            }
+
+            // a dropped reservation can leave an empty batch behind
+            if ( !b.instanced() && !b.retained() && !b.m_index_count )
+                continue;
+
+            const ClipRect_t *batch_clip = b.m_clip == Batch_t::NO_CLIP ? nullptr : &list.clips()[ b.m_clip ];
+
+            // while redrawing a rect the batches are scissored to it as well, a batch outside of it is skipped
+            if ( rect ) {
+                const ClipRect_t scissor = batch_clip ? batch_clip->intersect( *rect ) : *rect;
+
+                if ( scissor.empty() || !touches( batch_primitive, primitive ) )
+                    continue;
+
+                if ( clip != &m_scissor || scissor.m_min != m_scissor.m_min || scissor.m_max != m_scissor.m_max ) {
+                    m_scissor = scissor;
+                    m_backend->set_scissor( &m_scissor );
+
+                    clip = &m_scissor;
+                    ++m_stats.m_scissors;
+                }
+            }
 
-        // calculate the normal vector of this line.
-        diff = end - start;
-        norm = Vector2( -diff.y, diff.x ).normalized();
+            // scissor the draws to the clip rect of the batch, consecutive batches mostly share it
+            else if ( batch_clip != clip ) {
+                m_backend->set_scissor( batch_clip );
 
-        // calculate corners for quad vertices.
-        a = start - norm * thickness;
-        b = start + norm * thickness;
-        c = end   - norm * thickness;
-        d = end   + norm * thickness;
+                clip = batch_clip;
+                ++m_stats.m_scissors;
+            }
 
-        vertices_thick[ 0 ] = { { a.x, a.y, 0.f }, color };
-        vertices_thick[ 1 ] = { { b.x, b.y, 0.f }, color };
-        vertices_thick[ 2 ] = { { c.x, c.y, 0.f }, color };
-        vertices_thick[ 3 ] = { { d.x, d.y, 0.f }, color };
+            if ( b.retained() ) {
+                submit_static( list.static_draws()[ b.m_static ], clip );
+                continue;
+            }
 
-        indices_thick = { 0, 2, 3, 3, 1, 0 };
+            const size_t count          = b.instanced() ? b.m_instance_count : b.m_index_count;
+            const size_t base_vertex    = vertex_offset / sizeof( Vertex ) + b.m_base_vertex - base;
+            const size_t first_instance = instance_offset / sizeof( ShapeInstance_t ) + b.m_first_instance - base_instance;
 
-        add_vertices( vertices_thick.data(), vertices_thick.size(), indices_thick.data(), indices_thick.size(), D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+            if ( !rect ) {
+                draw_batch( b, 0, count, start_index, base_vertex, first_instance );
+                continue;
+            }
+
+            // draw the runs of consecutive primitives touching the rect
+            for ( size_t p{ batch_primitive }; p < primitive; ) {
+                if ( rect->outside( tracked[ p ].m_bounds.m_min, tracked[ p ].m_bounds.m_max ) ) {
+                    ++p;
+                    continue;
+                }
+
+                const size_t run_first = tracked[ p ].m_first;
+
+                while ( p < primitive && !rect->outside( tracked[ p ].m_bounds.m_min, tracked[ p ].m_bounds.m_max ) )
+                    ++p;
+
+                const size_t run_last = p < primitive ? tracked[ p ].m_first : count;
+
+                draw_batch( b, run_first, run_last - run_first, start_index, base_vertex, first_instance );
+            }
+        }
     }
-};
 
-void Renderer::draw_line( const float start_x, const float start_y, const float end_x, const float end_y, const Color &color, const float thickness ) {
-    draw_line( { start_x, start_y }, { end_x, end_y }, color, thickness );
+    m_stats.m_vertices += vertex_size / sizeof( Vertex );
+    ++m_stats.m_chunks;
+
+    return true;
 }
 
-void Renderer::draw_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &color ) {
-    std::array< Vertex,   4 > vertices;
-    std::array< uint32_t, 6 > indices;
+void Renderer::draw_batch( const Batch_t &b, const size_t first, const size_t count, const size_t start_index, const size_t base_vertex, const size_t first_instance ) {
+    if ( b.instanced() ) {
+        m_backend->draw_instanced( b.m_mesh, m_meshes[ b.m_mesh ].m_index_count, count, first_instance + first );
+
+        m_stats.m_instances += count;
+    }
 
-    vertices[ 0 ] = { { pos.x,          pos.y,          0.f }, color };
-    vertices[ 1 ] = { { pos.x + size.x, pos.y,          0.f }, color };
-    vertices[ 2 ] = { { pos.x + size.x, pos.y + size.y, 0.f }, color };
-    vertices[ 3 ] = { { pos.x,          pos.y + size.y, 0.f }, color };
+    else {
+        m_backend->draw( b.m_topology, b.index_format(), count, start_index + first, base_vertex, b.m_texture );
 
-    indices = { 0, 1, 2, 2, 3, 0 };
+        m_stats.m_indices += count;
+    }
 
-    add_vertices( vertices.data(), vertices.size(), indices.data(), indices.size(), D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+    ++m_stats.m_draw_calls;
 }
 
-void Renderer::draw_filled_rect( const float x, const float y, const float w, const float h, const Color &color ) {
-    draw_filled_rect( { x, y }, { w, h }, color );
+uint8_t *Renderer::begin_upload( BufferType type, const size_t size, const size_t alignment, size_t &offset ) {
+    RingAllocation_t range{};
+
+    // the range is staged in system memory and compared with the persistent buffer when written
+    if ( m_diff_upload )
+        return diff_buffer( type ).stage( size, alignment, offset );
+
+    if ( !ring( type ).allocate( size, alignment, range ) )
+        return nullptr;
+
+    auto *data = ( uint8_t * ) m_backend->map( type, range.m_mode );
+    if ( !data )
+        return nullptr;
+
+    offset = range.m_offset;
+
+    return data + range.m_offset;
 }
 
-void Renderer::draw_rect( const Vector2 &pos, const Vector2 &size, const Color &color, const float thickness ) {
-    // bottom line.
-    draw_filled_rect( pos.x, pos.y + size.y - thickness, size.x, thickness, color );
+void Renderer::end_upload( BufferType type, const size_t size ) {
+    if ( !m_diff_upload ) {
+        m_backend->unmap( type );
 
-    // top line.
-    draw_filled_rect( pos.x, pos.y, size.x, thickness, color );
+        m_stats.m_uploaded_bytes += size;
 
-    // left line.
-    draw_filled_rect( pos.x, pos.y, thickness, size.y, color );
+        return;
+    }
 
-    // right line.
-    draw_filled_rect( pos.x + size.x - thickness, pos.y, thickness, size.y, color );
+    commit_diff( type, diff_buffer( type ).staged() );
 }
 
-void Renderer::draw_rect( const float x, const float y, const float w, const float h, const Color &color, const float thickness ) {
-    draw_rect( { x, y }, { w, h }, color, thickness );
+bool Renderer::upload( BufferType type, const void *data, const size_t size, const size_t alignment, size_t &offset ) {
+    // the diffed upload compares the bytes where they are, the staged copy is only needed for bytes written while uploading
+    if ( m_diff_upload ) {
+        if ( !diff_buffer( type ).allocate( size, alignment, offset ) )
+            return false;
+
+        commit_diff( type, ( const uint8_t * ) data );
+
+        return true;
+    }
+
+    auto *dst = begin_upload( type, size, alignment, offset );
+    if ( !dst )
+        return false;
+
+    memcpy( dst, data, size );
+    end_upload( type, size );
+
+    return true;
 }
 
-void Renderer::draw_outlined_filled_rect( const Vector2 &pos, const Vector2 &size, const Color &fill_color, const Color &outline_color ) {
-    draw_filled_rect( pos.x, pos.y, size.x, size.y, fill_color );
-    draw_rect( pos.x - 1.f, pos.y - 1.f, size.x + 2.f, size.y + 2.f, outline_color );
+void Renderer::commit_diff( BufferType type, const uint8_t *bytes ) {
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = diff_buffer( type ).commit( bytes, [ this, type ]( const size_t offset, std::span< const uint8_t > range ) {
+        m_backend->update_persistent( type, offset, range );
+    } );
+
+    m_stats.m_diff_ns        += ( size_t ) std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count();
+    m_stats.m_diffed_bytes   += result.m_compared;
+    m_stats.m_saved_bytes    += result.m_compared - result.m_written;
+    m_stats.m_uploaded_bytes += result.m_written;
+    m_stats.m_updates        += result.m_ranges;
+    m_stats.m_diff_fallbacks += result.m_fallback;
 }
 
-void Renderer::draw_outlined_filled_rect( const float x, const float y, const float w, const float h, const Color &fill_color, const Color &outline_color ) {
-    draw_outlined_filled_rect( { x, y }, { w, h }, fill_color, outline_color );
+uint32_t Renderer::mesh( const size_t segment_count ) {
+    std::vector< Vector2 >  vertices;
+    std::vector< uint16_t > indices;
+
+    for ( size_t i{}; i < m_meshes.size(); ++i ) {
+        if ( m_meshes[ i ].m_segment_count == segment_count )
+            return ( uint32_t ) i;
+    }
+
+    // unit quad, spans [0, 1] on both axes
+    if ( !segment_count ) {
+        vertices = { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+        indices  = { 0, 1, 2, 2, 3, 0 };
+    }
+
+    // unit circle fan around the center
+    else {
+        if ( segment_count + 1 > Batch_t::MAX_NARROW_VERTICES )
+            return Batch_t::NO_MESH;
+
+        const auto unit = m_unit_circles.get( segment_count );
+
+        vertices.push_back( { 0.f, 0.f } );
+
+        for ( const auto &u : unit )
+            vertices.push_back( { u.m_cos, u.m_sin } );
+
+        for ( size_t i{}; i < segment_count; ++i )
+            indices.insert( indices.end(), { 0, ( uint16_t ) ( i + 1 ), ( uint16_t ) ( ( i + 1 ) % segment_count + 1 ) } );
+    }
+
+    if ( !m_backend->create_mesh( ( uint32_t ) m_meshes.size(), vertices, indices ) )
+        return Batch_t::NO_MESH;
+
+    m_meshes.push_back( { segment_count, indices.size() } );
+
+    return ( uint32_t ) m_meshes.size() - 1;
 }
 
-void Renderer::draw_outlined_rect( const Vector2 &pos, const Vector2 &size, const Color &inner_color, const Color &outline_color ) {
-    // outline
-    draw_rect( pos.x - 1.f, pos.y - 1.f, size.x + 2.f, size.y + 2.f, outline_color );
-    draw_rect( pos.x + 1.f, pos.y + 1.f, size.x - 2.f, size.y - 2.f, outline_color );
+uint32_t Renderer::add_image( const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) {
+    auto &img = m_images.emplace_back( Image_t{ width, height, std::vector< uint32_t >( ( size_t ) width * height ) } );
 
-    // inner line
-    draw_rect( pos.x, pos.y, size.x, size.y, inner_color );
+    // missing pixels are left transparent
+    std::copy_n( pixels.begin(), std::min( pixels.size(), img.m_pixels.size() ), img.m_pixels.begin() );
+
+    return ( uint32_t ) m_images.size() - 1;
 }
 
-void Renderer::draw_outlined_rect( const float x, const float y, const float w, const float h, const Color &inner_color, const Color &outline_color ) {
-    draw_outlined_rect( { x, y }, { w, h }, inner_color, outline_color );
+void Renderer::begin_static() {
+    if ( m_capturing || m_lists.empty() )
+        return;
+
+    // set the recording state of the frame aside, the capture records into an empty render list
+    std::swap( m_render_list, m_capture_list );
+    std::swap( m_clip_stack, m_capture_clips );
+    std::swap( m_recorded, m_capture_recorded );
+    std::swap( m_clip, m_capture_clip );
+
+    m_capturing = true;
 }
 
-void Renderer::draw_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count ) {
-    std::vector< Vertex > vertices;
-    std::vector< size_t > indices;
-    float                 angle;
-    float                 x_pos, y_pos;
+uint32_t Renderer::end_static() {
+    const uint32_t         handle = ( uint32_t ) m_statics.size();
+    StaticGeometry_t       geometry{ {}, { m_render_list.clips().begin(), m_render_list.clips().end() }, true };
+    std::vector< uint8_t > indices;
+    const auto             &batches = m_render_list.batches();
+    size_t                 index_offset{};
+    bool                   created{};
+
+    if ( !m_capturing )
+        return Batch_t::NO_STATIC;
+
+    // narrow the indices the same way the rings are filled, each batch starts at a multiple of its index size
+    for ( const auto &b : batches ) {
+        auto batch = b;
+
+        if ( !b.instanced() ) {
+            if ( !b.m_index_count )
+                continue;
 
-    for ( size_t i{}; i <= segment_count; ++i ) {
-        angle = 2.f * std::numbers::pi * ( float ) i / ( float ) segment_count;
+            if ( b.index_format() == IndexFormat::U32 )
+                index_offset = ( index_offset + 3 ) & ~size_t{ 3 };
 
-        x_pos = pos.x + ( radius * std::cos( angle ) );
-        y_pos = pos.y + ( radius * std::sin( angle ) );
+            indices.resize( index_offset + b.m_index_count * b.index_size() );
 
-        vertices.push_back( { { x_pos, y_pos, 0.f },  color } );
-        indices.push_back( i );
+            const uint32_t *src = m_render_list.indices().data() + b.m_start_index;
+
+            if ( b.index_format() == IndexFormat::U16 ) {
+                auto *dst = ( uint16_t * ) ( indices.data() + index_offset );
+
+                for ( size_t j{}; j < b.m_index_count; ++j )
+                    dst[ j ] = ( uint16_t ) src[ j ];
+            }
+
+            else
+                memcpy( indices.data() + index_offset, src, sizeof( uint32_t ) * b.m_index_count );
+
+            batch.m_start_index = index_offset / b.index_size();
+
+            index_offset += b.m_index_count * b.index_size();
+        }
+
+        geometry.m_batches.push_back( batch );
+    }
+
+    if ( !geometry.m_batches.empty() )
+        created = m_backend->create_static( handle, m_render_list.vertices(), indices, m_render_list.instances() );
+
+    // restore the recording state of the frame
+    std::swap( m_render_list, m_capture_list );
+    std::swap( m_clip_stack, m_capture_clips );
+    std::swap( m_recorded, m_capture_recorded );
+    std::swap( m_clip, m_capture_clip );
+
+    m_capture_list.clear();
+    m_capture_clips.clear();
+
+    m_capture_recorded = {};
+    m_capture_clip     = Batch_t::NO_CLIP;
+    m_capturing        = false;
+
+    if ( !created )
+        return Batch_t::NO_STATIC;
+
+    m_statics.push_back( std::move( geometry ) );
+
+    return handle;
+}
+
+void Renderer::draw_static( const uint32_t geometry, const Vector2 &translation ) {
+    if ( m_capturing || !static_valid( geometry ) )
+        return;
+
+    ++m_recorded.m_primitives;
+
+    // the bounds are not kept, only an empty clip rect rejects the geometry
+    if ( !m_clip_stack.empty() && m_clip_stack.back().empty() ) {
+        ++m_recorded.m_rejected;
+        return;
     }
 
-    add_vertices( vertices.data(), vertices.size(), indices.data(), indices.size(), D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP );
+    track_unbounded();
+
+    m_render_list.add_static( geometry, translation, m_clip_stack.empty() ? Batch_t::NO_CLIP : clip_index() );
 }
 
-void Renderer::draw_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count ) {
-    draw_circle( { x, y }, radius, color, segment_count );
+void Renderer::invalidate_static( const uint32_t geometry ) {
+    if ( !static_valid( geometry ) )
+        return;
+
+    auto &g = m_statics[ geometry ];
+
+    m_backend->destroy_static( geometry );
+
+    g.m_batches.clear();
+    g.m_clips.clear();
+
+    g.m_valid = false;
 }
 
-void Renderer::draw_filled_circle( const Vector2 &pos, const float radius, const Color &color, const size_t segment_count ) {
-    std::vector< Vertex > vertices;
-    std::vector< size_t > indices;
-    float                 angle;
-    float                 x_pos, y_pos;
-    size_t                idx{};
+void Renderer::submit_static( const StaticDraw_t &draw, const ClipRect_t *clip ) {
+    const auto &geometry = m_statics[ draw.m_geometry ];
+    uint32_t   scissored{ Batch_t::NO_CLIP };
+
+    // geometry invalidated after it was drawn this frame is skipped
+    if ( !geometry.m_valid )
+        return;
+
+    m_backend->set_static( draw.m_geometry, draw.m_translation );
+
+    for ( const auto &b : geometry.m_batches ) {
+        // a clip rect of the capture moves with the geometry and is nested in the one the geometry is drawn with
+        if ( b.m_clip != scissored ) {
+            ClipRect_t batch_clip;
+
+            if ( b.m_clip != Batch_t::NO_CLIP ) {
+                batch_clip = { geometry.m_clips[ b.m_clip ].m_min + draw.m_translation, geometry.m_clips[ b.m_clip ].m_max + draw.m_translation };
+
+                if ( clip )
+                    batch_clip = batch_clip.intersect( *clip );
+            }
 
-    vertices.push_back( { { pos.x, pos.y, 0.f }, color } );
+            m_backend->set_scissor( b.m_clip != Batch_t::NO_CLIP ? &batch_clip : clip );
 
-    for ( size_t i{}; i <= segment_count; ++i ) {
-        angle = 2.f * std::numbers::pi * ( float ) i / ( float ) segment_count;
+            scissored = b.m_clip;
+            ++m_stats.m_scissors;
+        }
 
-        x_pos = pos.x + ( radius * std::cos( angle ) );
-        y_pos = pos.y + ( radius * std::sin( angle ) );
+        if ( b.instanced() )
+            m_backend->draw_instanced( b.m_mesh, m_meshes[ b.m_mesh ].m_index_count, b.m_instance_count, b.m_first_instance );
 
-        vertices.push_back( { { x_pos, y_pos, 0.f },  color } );
-        indices.insert( indices.end(), { 0, idx, ++idx } );
+        else
+            m_backend->draw( b.m_topology, b.index_format(), b.m_index_count, b.m_start_index, b.m_base_vertex, b.m_texture );
+
+        ++m_stats.m_draw_calls;
+    }
+
+    // the following batches read from the rings again, scissored to the clip rect of the draw
+    if ( scissored != Batch_t::NO_CLIP ) {
+        m_backend->set_scissor( clip );
+        ++m_stats.m_scissors;
     }
 
-    add_vertices( vertices.data(), vertices.size(), indices.data(), indices.size(), D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+    m_backend->set_static( Batch_t::NO_STATIC, {} );
+
+    ++m_stats.m_static_draws;
 }
 
-void Renderer::draw_filled_circle( const float x, const float y, const float radius, const Color &color, const size_t segment_count ) {
-    draw_filled_circle( { x, y }, radius, color, segment_count );
+void Renderer::draw_image( const uint32_t image, const Vector2 &pos, const Vector2 &size, const Color &tint ) {
+    const auto       &img = m_images[ image ];
+    Vector2          min{ pos }, max{ pos + size };
+    const ClipRect_t *clip;
+    AtlasRegion_t    region;
+
+    // the atlas can evict the sprite, so it cannot be kept in static geometry
+    if ( m_capturing )
+        return;
+
+    // a sprite outside of the clip rect is not made resident
+    if ( !clip_test( Vector2( std::min( min.x, max.x ), std::min( min.y, max.y ) ), Vector2( std::max( min.x, max.x ), std::max( min.y, max.y ) ), clip ) )
+        return;
+
+    if ( !acquire_image( image, img.m_width, img.m_height, img.m_pixels, region ) )
+        return;
+
+    const auto &page = m_atlas.pages()[ region.m_page ];
+    const auto col   = Vertex::pack( tint );
+    Vector2    uv_min{ ( float ) region.m_x / ( float ) page.m_width, ( float ) region.m_y / ( float ) page.m_height };
+    Vector2    uv_max{ ( float ) ( region.m_x + region.m_width ) / ( float ) page.m_width, ( float ) ( region.m_y + region.m_height ) / ( float ) page.m_height };
+
+    // a sprite crossing the clip rect is cut to it along with its texture coordinates, a mirrored one is flipped first
+    if ( clip ) {
+        if ( min.x > max.x ) {
+            std::swap( min.x, max.x );
+            std::swap( uv_min.x, uv_max.x );
+        }
+
+        if ( min.y > max.y ) {
+            std::swap( min.y, max.y );
+            std::swap( uv_min.y, uv_max.y );
+        }
+
+        clip->clip( min, max, uv_min, uv_max );
+        ++m_recorded.m_clipped;
+    }
+
+    // sprites of a page extend the same batch, the page index is its texture id
+    auto           r    = m_render_list.reserve( 4, 6, Topology::TRIANGLE_LIST, m_atlas_textures[ region.m_page ] );
+    const uint32_t base = r.m_base_index;
+
+    r.m_vertices[ 0 ] = { min.x, min.y, col, Vertex::pack_uv( uv_min.x, uv_min.y ) };
+    r.m_vertices[ 1 ] = { max.x, min.y, col, Vertex::pack_uv( uv_max.x, uv_min.y ) };
+    r.m_vertices[ 2 ] = { max.x, max.y, col, Vertex::pack_uv( uv_max.x, uv_max.y ) };
+    r.m_vertices[ 3 ] = { min.x, max.y, col, Vertex::pack_uv( uv_min.x, uv_max.y ) };
+
+    r.m_indices[ 0 ] = base;
+    r.m_indices[ 1 ] = base + 1;
+    r.m_indices[ 2 ] = base + 2;
+    r.m_indices[ 3 ] = base + 2;
+    r.m_indices[ 4 ] = base + 3;
+    r.m_indices[ 5 ] = base;
+
+    commit( 4, 6 );
 }
 
-bool RenderStateBackup::capture( ID3D11DeviceContext *dev_ctx ) {
-    if ( !dev_ctx )
-        return false;
+bool Renderer::acquire_image( const uint64_t key, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels, AtlasRegion_t &region ) {
+    switch ( m_atlas.acquire( key, width, height, region ) ) {
+        case AtlasResult::FAILED:
+            return false;
 
-    m_dev_ctx = dev_ctx;
+        // upload the image, creating the textures of pages the atlas added
+        case AtlasResult::ALLOCATED:
+            for ( const auto &pages = m_atlas.pages(); m_atlas_textures.size() < pages.size(); ) {
+                const auto &page = pages[ m_atlas_textures.size() ];
 
-    // save viewports
-    m_scissor_rects_count = m_viewports_count = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
-    m_dev_ctx->RSGetScissorRects( &m_scissor_rects_count, m_scissor_rects );
-    m_dev_ctx->RSGetViewports( &m_viewports_count, m_viewports );
+                if ( !m_backend->create_texture( m_texture_count, page.m_width, page.m_height ) )
+                    return false;
 
-    // save rasterizer, blend and stencil state
-    m_dev_ctx->RSGetState( &m_rasterizer_state );
-    m_dev_ctx->OMGetBlendState( &m_blend_state, m_blend_factor, &m_sample_mask );
-    m_dev_ctx->OMGetDepthStencilState( &m_depth_stencil_state, &m_stencil_ref );
+                m_atlas_textures.push_back( m_texture_count++ );
+            }
 
-    // save samplers
-    m_dev_ctx->PSGetSamplers( 0, 1, &m_sampler );
+            // clear the shelves evicted for the image, or bilinear filtering would blend their old texels in through the padding
+            for ( const auto &shelf : m_atlas.evicted() ) {
+                const size_t count = ( size_t ) shelf.m_width * shelf.m_height;
 
-    // save shaders
-    m_ps_instance_count = m_vs_instance_count = m_gs_instance_count = MAX_D3D11_CLASS_INSTANCE;
-    m_dev_ctx->PSGetShaderResources( 0, 1, &m_shader_resource );
-    m_dev_ctx->PSGetShader( &m_pixel_shader, m_ps_instances, &m_ps_instance_count );
-    m_dev_ctx->VSGetShader( &m_vertex_shader, m_vs_instances, &m_vs_instance_count );
-    m_dev_ctx->GSGetShader( &m_geometry_shader, m_gs_instances, &m_gs_instance_count );
+                if ( m_cleared_texels.size() < count )
+                    m_cleared_texels.resize( count );
 
-    // save topology
-    m_dev_ctx->IAGetPrimitiveTopology( &m_primitive_topology );
+                m_backend->update_texture( m_atlas_textures[ shelf.m_page ], shelf.m_x, shelf.m_y, shelf.m_width, shelf.m_height, std::span( m_cleared_texels ).first( count ) );
+                m_recorded.m_texture_bytes += count * sizeof( uint32_t );
+            }
 
-    // save input layout
-    m_dev_ctx->IAGetInputLayout( &m_input_layout );
+            m_atlas.clear_evicted();
 
-    // save buffers
-    m_dev_ctx->VSGetConstantBuffers( 0, 1, &m_constant_buffer );
-    m_dev_ctx->IAGetVertexBuffers( 0, 1, &m_vertex_buffer, &m_vertex_buffer_stride, &m_vertex_buffer_offset );
-    m_dev_ctx->IAGetIndexBuffer( &m_index_buffer, &m_index_buffer_format, &m_index_buffer_offset );
+            m_backend->update_texture( m_atlas_textures[ region.m_page ], region.m_x, region.m_y, width, height, pixels );
+            m_recorded.m_texture_bytes += pixels.size() * sizeof( uint32_t );
+            return true;
 
-    return true;
+        default:
+            return true;
+    }
 }
 
-void RenderStateBackup::apply() {
-    // set viewports
-    m_dev_ctx->RSSetScissorRects( m_scissor_rects_count, m_scissor_rects );
-    m_dev_ctx->RSSetViewports( m_viewports_count, m_viewports );
+uint32_t Renderer::baked_texture( const uint32_t font, const BakedFont &baked, const uint32_t page ) {
+    const uint64_t key = ( uint64_t ) font << 32 | page;
+
+    if ( const auto it = m_baked_textures.find( key ); it != m_baked_textures.end() )
+        return it->second;
 
-    // set rasterizer, blend, and stencil state
-    m_dev_ctx->RSSetState( m_rasterizer_state ); 
-    if ( m_rasterizer_state )
-        m_rasterizer_state->Release();
+    // the distances go to the backend straight from the mapping, pages no string uses are never read
+    const auto &header   = baked.header();
+    const auto distances = baked.page( page );
 
-    m_dev_ctx->OMSetBlendState( m_blend_state, m_blend_factor, m_sample_mask );
-    if ( m_blend_state ) 
-        m_blend_state->Release();
+    if ( !m_backend->create_distance_texture( m_texture_count, header.m_page_width, header.m_page_height, distances ) )
+        return Batch_t::NO_TEXTURE;
 
-    m_dev_ctx->OMSetDepthStencilState( m_depth_stencil_state, m_stencil_ref );
-    if ( m_depth_stencil_state ) 
-        m_depth_stencil_state->Release();
+    m_recorded.m_texture_bytes += distances.size();
+    m_baked_textures.emplace( key, m_texture_count );
 
-    // set samplers
-    m_dev_ctx->PSSetSamplers( 0, 1, &m_sampler ); 
-    if ( m_sampler ) 
-        m_sampler->Release();
+    return m_texture_count++;
+}
+
+void Renderer::draw_text( const Vector2 &pos, std::string_view text, const Color &color, const float size, const uint32_t font ) {
+    // the glyphs of baked fonts stay in their own pages, those of rasterized fonts can be evicted from the atlas
+    if ( m_capturing && !m_text.baked( font ) )
+        return;
 
-    // set shaders
-    m_dev_ctx->PSSetShaderResources( 0, 1, &m_shader_resource );
-    if ( m_shader_resource )
-        m_shader_resource->Release();
+    bool             created{};
+    auto             &layout = m_text.layout( font, text, size, created );
+    const ClipRect_t *clip;
 
-    m_dev_ctx->PSSetShader( m_pixel_shader, m_ps_instances, m_ps_instance_count );
-    if ( m_pixel_shader )
-        m_pixel_shader->Release();
+    // new layouts are measured from the glyph metrics, their bounds do not depend on the atlas
+    if ( created )
+        measure_text( layout, font, text, size );
 
-    m_dev_ctx->VSSetShader( m_vertex_shader, m_vs_instances, m_vs_instance_count );
-    if ( m_vertex_shader )
-        m_vertex_shader->Release();
+    // a string outside of the clip rect is dropped before its glyphs are placed or its shelves are touched
+    if ( !clip_test( pos + layout.m_bounds.m_min, pos + layout.m_bounds.m_max, clip ) )
+        return;
 
-    m_dev_ctx->GSSetShader( m_geometry_shader, m_gs_instances, m_gs_instance_count );
-    if ( m_geometry_shader )
-        m_geometry_shader->Release();
+    // new and incomplete layouts are built now they are drawn, incomplete ones retry their missing glyphs
+    if ( !layout.m_complete )
+        layout_text( layout, font, text, size );
 
-    for ( size_t i{}; i < m_ps_instance_count; ++i ) {
-        if ( m_ps_instances[ i ] )
-            m_ps_instances[ i ]->Release();
+    // keep the glyph shelves of the layout resident, the layout is rebuilt when the atlas evicted one of them
+    else {
+        for ( const auto &shelf : layout.m_shelves ) {
+            if ( !m_atlas.touch( shelf.m_page, shelf.m_shelf, shelf.m_generation ) ) {
+                layout_text( layout, font, text, size );
+                break;
+            }
+        }
     }
 
-    for ( size_t i{}; i < m_vs_instance_count; ++i ) {
-        if ( m_vs_instances[ i ] )
-            m_vs_instances[ i ]->Release();
+    const auto col = Vertex::pack( color );
+
+    if ( clip )
+        ++m_recorded.m_clipped;
+
+    // copy the cached quads of each texture, moving them to the pen and applying the color
+    for ( const auto &run : layout.m_runs ) {
+        uint32_t       quads = run.m_count / 4;
+        auto           r     = m_render_list.reserve( run.m_count, quads * 6, Topology::TRIANGLE_LIST, run.m_texture );
+        const uint32_t base  = r.m_base_index;
+
+        if ( !clip ) {
+            std::copy_n( layout.m_vertices.data() + run.m_first, run.m_count, r.m_vertices.data() );
+
+            VectorArray::place( r.m_vertices, pos, col );
+        }
+
+        // a string crossing the clip rect has its glyphs cut to it, those outside of it are dropped
+        else {
+            const Vertex *src = layout.m_vertices.data() + run.m_first;
+            const Vertex *end = src + run.m_count;
+            Vertex       *dst = r.m_vertices.data();
+
+            for ( ; src < end; src += 4 ) {
+                Vertex  top_left{ src[ 0 ] }, bottom_right{ src[ 2 ] };
+                Vector2 min{ top_left.coordinates().x + pos.x, top_left.coordinates().y + pos.y };
+                Vector2 max{ bottom_right.coordinates().x + pos.x, bottom_right.coordinates().y + pos.y };
+                Vector2 uv_min = Vertex::unpack_uv( top_left.uv() );
+                Vector2 uv_max = Vertex::unpack_uv( bottom_right.uv() );
+
+                if ( !clip->clip( min, max, uv_min, uv_max ) )
+                    continue;
+
+                dst[ 0 ] = { min.x, min.y, col, Vertex::pack_uv( uv_min.x, uv_min.y ) };
+                dst[ 1 ] = { max.x, min.y, col, Vertex::pack_uv( uv_max.x, uv_min.y ) };
+                dst[ 2 ] = { max.x, max.y, col, Vertex::pack_uv( uv_max.x, uv_max.y ) };
+                dst[ 3 ] = { min.x, max.y, col, Vertex::pack_uv( uv_min.x, uv_max.y ) };
+                dst     += 4;
+            }
+
+            quads = ( uint32_t ) ( dst - r.m_vertices.data() ) / 4;
+        }
+
+        for ( uint32_t i{}; i < quads; ++i ) {
+            uint32_t       *idx  = r.m_indices.data() + i * 6;
+            const uint32_t first = base + i * 4;
+
+            idx[ 0 ] = first;
+            idx[ 1 ] = first + 1;
+            idx[ 2 ] = first + 2;
+            idx[ 3 ] = first + 2;
+            idx[ 4 ] = first + 3;
+            idx[ 5 ] = first;
+        }
+
+        commit( quads * 4, quads * 6 );
     }
+}
 
-    for ( size_t i{}; i < m_gs_instance_count; ++i ) {
-        if ( m_gs_instances[ i ] )
-            m_gs_instances[ i ]->Release();
+void Renderer::measure_text( TextLayout_t &layout, const uint32_t font, std::string_view text, const float size ) {
+    BakedFont   *baked = m_text.baked( font );
+    const float scale  = baked ? size / baked->header().m_em_size : 1.f;
+    const float line   = m_text.line_height( font, size );
+    Vector2     pen{};
+    size_t      offset{};
+    uint32_t    codepoint;
+
+    layout.m_size     = { 0.f, line };
+    layout.m_bounds   = { { INFINITY, INFINITY }, { -INFINITY, -INFINITY } };
+    layout.m_complete = false;
+
+    while ( TextCache::decode_utf8( text, offset, codepoint ) ) {
+        if ( codepoint == '\n' ) {
+            pen.x            = 0.f;
+            pen.y           += line;
+            layout.m_size.y += line;
+            continue;
+        }
+
+        float   advance{};
+        Vector2 min, max;
+        bool    visible{};
+
+        if ( baked ) {
+            const BakedGlyph_t *glyph = baked->find( codepoint );
+
+            if ( !glyph && !( glyph = baked->find( TextCache::REPLACEMENT ) ) )
+                continue;
+
+            if ( ( visible = glyph->m_width != 0 ) ) {
+                min = { pen.x + glyph->m_offset_x * scale, pen.y + glyph->m_offset_y * scale };
+                max = { min.x + glyph->m_width * scale, min.y + glyph->m_height * scale };
+            }
+
+            advance = glyph->m_advance * scale;
+        }
+
+        // rasterizing only fills the glyph cache, the atlas is left alone until the string is drawn
+        else {
+            uint64_t   key{};
+            const auto *glyph = m_text.glyph( font, codepoint, size, key );
+
+            if ( !glyph )
+                break;
+
+            if ( ( visible = glyph->m_width && glyph->m_height ) ) {
+                min = { pen.x + glyph->m_offset_x, pen.y + glyph->m_offset_y };
+                max = { min.x + ( float ) glyph->m_width, min.y + ( float ) glyph->m_height };
+            }
+
+            advance = glyph->m_advance;
+        }
+
+        if ( visible )
+            layout.m_bounds = { { std::min( layout.m_bounds.m_min.x, min.x ), std::min( layout.m_bounds.m_min.y, min.y ) },
+                                { std::max( layout.m_bounds.m_max.x, max.x ), std::max( layout.m_bounds.m_max.y, max.y ) } };
+
+        pen.x           += advance;
+        layout.m_size.x  = std::max( layout.m_size.x, pen.x );
     }
+}
 
-    // set topology
-    m_dev_ctx->IASetPrimitiveTopology( m_primitive_topology );
+void Renderer::layout_text( TextLayout_t &layout, const uint32_t font, std::string_view text, const float size ) {
+    BakedFont   *baked = m_text.baked( font );
+    const float scale  = baked ? size / baked->header().m_em_size : 1.f;
+    const float line   = m_text.line_height( font, size );
+    const auto  col    = Vertex::pack( Color::white() );
+    Vector2     pen{};
+    size_t      offset{};
+    uint32_t    codepoint;
+
+    // glyph quads tagged with their texture, grouped into runs once the string is placed, a codepoint takes at least a byte
+    auto   *quads = scratch< std::pair< uint32_t, std::array< Vertex, 4 > > >( text.size() );
+    size_t quad_count{};
+
+    layout.m_vertices.clear();
+    layout.m_runs.clear();
+    layout.m_shelves.clear();
+    layout.m_complete = true;
+
+    while ( TextCache::decode_utf8( text, offset, codepoint ) ) {
+        if ( codepoint == '\n' ) {
+            pen.x  = 0.f;
+            pen.y += line;
+            continue;
+        }
+
+        uint32_t texture = Batch_t::NO_TEXTURE;
+        float    advance{};
+        Vector2  min, max, uv_min, uv_max;
+
+        // baked glyphs are scaled from the baked size, their pages are never evicted
+        if ( baked ) {
+            const BakedGlyph_t *glyph = baked->find( codepoint );
+
+            if ( !glyph && !( glyph = baked->find( TextCache::REPLACEMENT ) ) )
+                continue;
+
+            if ( glyph->m_width ) {
+                const auto &header = baked->header();
+
+                if ( ( texture = baked_texture( font, *baked, glyph->m_page ) ) == Batch_t::NO_TEXTURE )
+                    layout.m_complete = false;
+
+                min    = { pen.x + glyph->m_offset_x * scale, pen.y + glyph->m_offset_y * scale };
+                max    = { min.x + glyph->m_width * scale, min.y + glyph->m_height * scale };
+                uv_min = { ( float ) glyph->m_x / ( float ) header.m_page_width, ( float ) glyph->m_y / ( float ) header.m_page_height };
+                uv_max = { ( float ) ( glyph->m_x + glyph->m_width ) / ( float ) header.m_page_width, ( float ) ( glyph->m_y + glyph->m_height ) / ( float ) header.m_page_height };
+            }
+
+            advance = glyph->m_advance * scale;
+        }
+
+        // rasterized glyphs are placed into the atlas, blank ones only advance the pen
+        else {
+            uint64_t      key{};
+            AtlasRegion_t region;
+            const auto    *glyph = m_text.glyph( font, codepoint, size, key );
+
+            if ( !glyph )
+                break;
+
+            if ( glyph->m_width && glyph->m_height ) {
+                if ( acquire_image( key | TextCache::GLYPH_KEY, glyph->m_width, glyph->m_height, glyph->m_pixels, region ) ) {
+                    const auto &page = m_atlas.pages()[ region.m_page ];
+
+                    texture = m_atlas_textures[ region.m_page ];
+                    min     = { pen.x + glyph->m_offset_x, pen.y + glyph->m_offset_y };
+                    max     = { min.x + ( float ) glyph->m_width, min.y + ( float ) glyph->m_height };
+                    uv_min  = { ( float ) region.m_x / ( float ) page.m_width, ( float ) region.m_y / ( float ) page.m_height };
+                    uv_max  = { ( float ) ( region.m_x + region.m_width ) / ( float ) page.m_width, ( float ) ( region.m_y + region.m_height ) / ( float ) page.m_height };
+
+                    if ( std::none_of( layout.m_shelves.begin(), layout.m_shelves.end(), [ & ]( const TextShelf_t &s ) { return s.m_page == region.m_page && s.m_shelf == region.m_shelf; } ) )
+                        layout.m_shelves.push_back( { region.m_page, region.m_shelf, m_atlas.generation( region.m_page, region.m_shelf ) } );
+                }
+
+                // retry the missing glyphs the next time the string is drawn
+                else
+                    layout.m_complete = false;
+            }
+
+            advance = glyph->m_advance;
+        }
+
+        if ( texture != Batch_t::NO_TEXTURE )
+            quads[ quad_count++ ] = { texture, {
+                Vertex{ min.x, min.y, col, Vertex::pack_uv( uv_min.x, uv_min.y ) },
+                Vertex{ max.x, min.y, col, Vertex::pack_uv( uv_max.x, uv_min.y ) },
+                Vertex{ max.x, max.y, col, Vertex::pack_uv( uv_max.x, uv_max.y ) },
+                Vertex{ min.x, max.y, col, Vertex::pack_uv( uv_min.x, uv_max.y ) }
+            } };
+
+        pen.x += advance;
+    }
 
-    // set input layout
-    m_dev_ctx->IASetInputLayout( m_input_layout ); 
-    if ( m_input_layout ) 
-        m_input_layout->Release();
+    const auto by_texture = []( const auto &a, const auto &b ) { return a.first < b.first; };
 
-    // set buffers
-    m_dev_ctx->VSSetConstantBuffers( 0, 1, &m_constant_buffer );
-    if ( m_constant_buffer )
-        m_constant_buffer->Release();
+    // glyphs rarely span textures, keep the string order within a texture and only sort, and take a buffer from the heap, when they do
+    if ( !std::is_sorted( quads, quads + quad_count, by_texture ) )
+        std::stable_sort( quads, quads + quad_count, by_texture );
 
-    m_dev_ctx->IASetVertexBuffers( 0, 1, &m_vertex_buffer, &m_vertex_buffer_stride, &m_vertex_buffer_offset );
-    if ( m_vertex_buffer ) 
-        m_vertex_buffer->Release();
+    layout.m_vertices.reserve( quad_count * 4 );
 
-    m_dev_ctx->IASetIndexBuffer( m_index_buffer, m_index_buffer_format, m_index_buffer_offset );
-    if ( m_index_buffer )
-        m_index_buffer->Release();
-}
\ No newline at end of file
+    for ( const auto &[ texture, quad ] : std::span( quads, quad_count ) ) {
+        if ( layout.m_runs.empty() || layout.m_runs.back().m_texture != texture )
+            layout.m_runs.push_back( { texture, ( uint32_t ) layout.m_vertices.size(), 0 } );
+
+        layout.m_vertices.insert( layout.m_vertices.end(), quad.begin(), quad.end() );
+        layout.m_runs.back().m_count += 4;
+    }
+}
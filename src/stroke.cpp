@@ -0,0 +1,41 @@
+#include "stroke.h"
+
+using namespace dx;
+
+void Stroke::normals( std::span< const Vector2 > points, Vector2 *normals ) {
+    const size_t count = points.size() - 1;
+    size_t       i{};
+
+#ifdef DX_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps( -0.f );
+
+    // four segments per register, the points are split into x and y lanes and the normals interleaved again
+    for ( ; i + 4 <= count; i += 4 ) {
+        const __m128 a0 = _mm_loadu_ps( &points[ i ].x );
+        const __m128 a1 = _mm_loadu_ps( &points[ i + 2 ].x );
+        const __m128 b0 = _mm_loadu_ps( &points[ i + 1 ].x );
+        const __m128 b1 = _mm_loadu_ps( &points[ i + 3 ].x );
+
+        const __m128 dx  = _mm_sub_ps( _mm_shuffle_ps( b0, b1, _MM_SHUFFLE( 2, 0, 2, 0 ) ), _mm_shuffle_ps( a0, a1, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+        const __m128 dy  = _mm_sub_ps( _mm_shuffle_ps( b0, b1, _MM_SHUFFLE( 3, 1, 3, 1 ) ), _mm_shuffle_ps( a0, a1, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+        const __m128 len = _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) ) );
+
+        // segments without length keep a zero normal
+        const __m128 valid = _mm_cmpgt_ps( len, zero );
+        const __m128 nx    = _mm_and_ps( valid, _mm_div_ps( _mm_xor_ps( dy, sign ), len ) );
+        const __m128 ny    = _mm_and_ps( valid, _mm_div_ps( dx, len ) );
+
+        _mm_storeu_ps( &normals[ i ].x, _mm_unpacklo_ps( nx, ny ) );
+        _mm_storeu_ps( &normals[ i + 2 ].x, _mm_unpackhi_ps( nx, ny ) );
+    }
+#endif
+
+    for ( ; i < count; ++i ) {
+        const float dx  = points[ i + 1 ].x - points[ i ].x;
+        const float dy  = points[ i + 1 ].y - points[ i ].y;
+        const float len = std::sqrt( dx * dx + dy * dy );
+
+        normals[ i ] = len > 0.f ? Vector2( -dy / len, dx / len ) : Vector2();
+    }
+}
@@ -0,0 +1,111 @@
+#include "text.h"
+
+using namespace dx;
+
+const Glyph_t *TextCache::glyph( const uint32_t font, const uint32_t codepoint, const float size, uint64_t &key ) {
+    if ( font >= m_fonts.size() )
+        return nullptr;
+
+    key = font_size( font, size ) | ( codepoint & 0x1fffff );
+
+    if ( const auto it = m_glyphs.find( key ); it != m_glyphs.end() ) {
+        it->second.m_last_used = m_frame;
+        return &it->second.m_glyph;
+    }
+
+    // rasterize at the quantized size, so every size sharing the key gets the same bitmap
+    const float quantized = ( float ) ( ( key >> 21 ) & 0x7ffff ) * 0.25f;
+    Glyph_t     glyph{};
+
+    if ( !m_fonts[ font ]->rasterize( codepoint, quantized, glyph ) && !m_fonts[ font ]->rasterize( REPLACEMENT, quantized, glyph ) )
+        glyph = {};
+
+    return &m_glyphs.emplace( key, CachedGlyph_t{ std::move( glyph ), m_frame } ).first->second.m_glyph;
+}
+
+TextLayout_t &TextCache::layout( const uint32_t font, std::string_view text, const float size, bool &created ) {
+    const uint64_t key = font_size( font, size );
+    auto           it  = m_layouts.find( LayoutView_t{ key, text } );
+
+    if ( ( created = it == m_layouts.end() ) ) {
+        // labels that change every frame take the place of those dropped before, so they stop allocating once the cache cycles
+        if ( !m_free.empty() ) {
+            auto node = std::move( m_free.back() );
+
+            m_free.pop_back();
+
+            node.key().m_font_size = key;
+            node.key().m_text.assign( text );
+
+            it = m_layouts.insert( std::move( node ) ).position;
+        }
+
+        else
+            it = m_layouts.emplace( LayoutKey_t{ key, std::string{ text } }, TextLayout_t{} ).first;
+    }
+
+    it->second.m_last_used = m_frame;
+
+    return it->second;
+}
+
+void TextCache::end_frame() {
+    // labels drawn every frame stay, strings that changed are dropped in bulk once they pile up
+    if ( m_layouts.size() > MAX_LAYOUTS ) {
+        for ( auto it = m_layouts.begin(); it != m_layouts.end(); ) {
+            if ( it->second.m_last_used < m_frame )
+                m_free.push_back( m_layouts.extract( it++ ) );
+
+            else
+                ++it;
+        }
+    }
+
+    // the bitmaps are only read to place glyphs into the atlas, one dropped is rasterized again when a layout needs it
+    if ( m_glyphs.size() > MAX_GLYPHS )
+        std::erase_if( m_glyphs, [ this ]( const auto &entry ) { return entry.second.m_last_used < m_frame; } );
+
+    ++m_frame;
+}
+
+bool TextCache::decode_utf8( std::string_view text, size_t &offset, uint32_t &codepoint ) {
+    if ( offset >= text.size() )
+        return false;
+
+    const uint8_t lead = ( uint8_t ) text[ offset++ ];
+    size_t        length{};
+
+    if ( lead < 0x80 ) {
+        codepoint = lead;
+        return true;
+    }
+
+    if ( ( lead & 0xe0 ) == 0xc0 ) {
+        codepoint = lead & 0x1f;
+        length    = 1;
+    }
+    else if ( ( lead & 0xf0 ) == 0xe0 ) {
+        codepoint = lead & 0x0f;
+        length    = 2;
+    }
+    else if ( ( lead & 0xf8 ) == 0xf0 ) {
+        codepoint = lead & 0x07;
+        length    = 3;
+    }
+    else {
+        codepoint = REPLACEMENT;
+        return true;
+    }
+
+    // a truncated sequence consumes only the bytes that continue it
+    for ( ; length; --length, ++offset ) {
+        if ( offset >= text.size() || ( ( uint8_t ) text[ offset ] & 0xc0 ) != 0x80 ) {
+            codepoint = REPLACEMENT;
+            return true;
+        }
+
+        codepoint = codepoint << 6 | ( ( uint8_t ) text[ offset ] & 0x3f );
+    }
+
+    return true;
+}
@@ -0,0 +1,129 @@
+#include "texture_atlas.h"
+
+using namespace dx;
+
+AtlasResult TextureAtlas::acquire( const uint64_t key, const uint32_t width, const uint32_t height, AtlasRegion_t &region ) {
+    const uint32_t padded_width  = width + PADDING;
+    const uint32_t padded_height = height + PADDING;
+    uint32_t       page{};
+    uint32_t       shelf{};
+    bool           placed{};
+
+    // keep the shelf of a resident image from being evicted this frame
+    if ( const auto it = m_entries.find( key ); it != m_entries.end() ) {
+        region = it->second;
+
+        m_pages[ region.m_page ].m_shelves[ region.m_shelf ].m_last_used = m_frame;
+
+        return AtlasResult::RESIDENT;
+    }
+
+    // fill the existing pages first, so sprites keep sharing a texture
+    for ( ; page < m_pages.size(); ++page ) {
+        if ( ( placed = place( page, padded_width, padded_height, shelf ) ) )
+            break;
+    }
+
+    // reuse a shelf the frame does not need before growing the atlas
+    if ( !placed )
+        placed = evict( padded_width, padded_height, page, shelf );
+
+    // open a new page, an image larger than a page gets a page of its own size
+    if ( !placed && m_pages.size() < m_max_pages ) {
+        m_pages.push_back( { std::max( m_page_size, padded_width ), std::max( m_page_size, padded_height ), 0, {} } );
+
+        page   = ( uint32_t ) m_pages.size() - 1;
+        placed = place( page, padded_width, padded_height, shelf );
+    }
+
+    if ( !placed )
+        return AtlasResult::FAILED;
+
+    auto &s = m_pages[ page ].m_shelves[ shelf ];
+
+    region = { page, shelf, s.m_cursor, s.m_y, width, height };
+
+    s.m_cursor   += padded_width;
+    s.m_last_used = m_frame;
+    s.m_keys.push_back( key );
+
+    m_entries.emplace( key, region );
+
+    return AtlasResult::ALLOCATED;
+}
+
+bool TextureAtlas::place( const uint32_t page, const uint32_t width, const uint32_t height, uint32_t &shelf ) {
+    auto           &p   = m_pages[ page ];
+    const uint32_t none = UINT32_MAX;
+    uint32_t       best = none;
+
+    // find the lowest shelf the image fits into
+    for ( uint32_t i{}; i < p.m_shelves.size(); ++i ) {
+        const auto &s = p.m_shelves[ i ];
+
+        if ( s.m_height >= height && s.m_cursor + width <= p.m_width && ( best == none || s.m_height < p.m_shelves[ best ].m_height ) )
+            best = i;
+    }
+
+    // a much taller shelf would waste its height, open a new one while the page has room
+    if ( best != none && p.m_shelves[ best ].m_height <= height + height / 2 ) {
+        shelf = best;
+        return true;
+    }
+
+    if ( width <= p.m_width && p.m_shelf_end + height <= p.m_height ) {
+        p.m_shelves.push_back( { p.m_shelf_end, height, 0, 0, m_frame, {} } );
+        p.m_shelf_end += height;
+
+        shelf = ( uint32_t ) p.m_shelves.size() - 1;
+        return true;
+    }
+
+    if ( best != none ) {
+        shelf = best;
+        return true;
+    }
+
+    return false;
+}
+
+bool TextureAtlas::evict( const uint32_t width, const uint32_t height, uint32_t &page, uint32_t &shelf ) {
+    AtlasShelf_t *victim{};
+
+    // find the least recently used shelf that fits the image, images drawn this frame have to stay
+    for ( uint32_t i{}; i < m_pages.size(); ++i ) {
+        if ( width > m_pages[ i ].m_width )
+            continue;
+
+        for ( uint32_t j{}; j < m_pages[ i ].m_shelves.size(); ++j ) {
+            auto &s = m_pages[ i ].m_shelves[ j ];
+
+            if ( s.m_last_used >= m_frame || s.m_height < height )
+                continue;
+
+            if ( !victim || s.m_last_used < victim->m_last_used || ( s.m_last_used == victim->m_last_used && s.m_height < victim->m_height ) ) {
+                victim = &s;
+                page   = i;
+                shelf  = j;
+            }
+        }
+    }
+
+    if ( !victim )
+        return false;
+
+    for ( const uint64_t key : victim->m_keys )
+        m_entries.erase( key );
+
+    m_evictions += victim->m_keys.size();
+
+    if ( victim->m_cursor )
+        m_evicted.push_back( { page, shelf, 0, victim->m_y, victim->m_cursor, victim->m_height } );
+
+    victim->m_keys.clear();
+    victim->m_cursor = 0;
+
+    ++victim->m_generation;
+
+    return true;
+}
@@ -0,0 +1,32 @@
+#include "unit_circle.h"
+
+using namespace dx;
+
+std::span< const SinCos_t > UnitCircleCache::lookup( const size_t segment_count ) {
+    switch ( segment_count ) {
+        case 8:   return UNIT_CIRCLE< 8 >;
+        case 12:  return UNIT_CIRCLE< 12 >;
+        case 16:  return UNIT_CIRCLE< 16 >;
+        case 24:  return UNIT_CIRCLE< 24 >;
+        case 32:  return UNIT_CIRCLE< 32 >;
+        case 48:  return UNIT_CIRCLE< 48 >;
+        case 64:  return UNIT_CIRCLE< 64 >;
+        case 128: return UNIT_CIRCLE< 128 >;
+        default:  break;
+    }
+
+    auto &table = m_tables[ segment_count ];
+
+    // compute the table on first use
+    if ( table.empty() ) {
+        table.resize( segment_count );
+
+        for ( size_t i{}; i < segment_count; ++i ) {
+            const double angle = 2.0 * std::numbers::pi * ( double ) i / ( double ) segment_count;
+
+            table[ i ] = { ( float ) std::cos( angle ), ( float ) std::sin( angle ) };
+        }
+    }
+
+    return table;
+}
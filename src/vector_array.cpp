@@ -0,0 +1,411 @@
+#include "vector_array.h"
+
+using namespace dx;
+
+#ifdef DX_SSE2
+namespace {
+    /**
+     * @brief This function loads four 2-dimensional vectors split into components
+     * @param src first vector
+     * @param x output x-components
+     * @param y output y-components
+    */
+    FORCEINLINE void load( const Vector2 *src, __m128 &x, __m128 &y ) {
+        const __m128 a = _mm_loadu_ps( &src[ 0 ].x );
+        const __m128 b = _mm_loadu_ps( &src[ 2 ].x );
+
+        x = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+        y = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+    }
+
+    /**
+     * @brief This function stores four 2-dimensional vectors from their components
+     * @param dst first vector
+     * @param x x-components
+     * @param y y-components
+    */
+    FORCEINLINE void store( Vector2 *dst, const __m128 &x, const __m128 &y ) {
+        _mm_storeu_ps( &dst[ 0 ].x, _mm_unpacklo_ps( x, y ) );
+        _mm_storeu_ps( &dst[ 2 ].x, _mm_unpackhi_ps( x, y ) );
+    }
+
+    /**
+     * @brief This function loads four 3-dimensional vectors split into components
+     * @param src first vector
+     * @param x output x-components
+     * @param y output y-components
+     * @param z output z-components
+    */
+    FORCEINLINE void load( const Vector3 *src, __m128 &x, __m128 &y, __m128 &z ) {
+        const float  *f  = &src[ 0 ].x;
+        const __m128 r0 = _mm_loadu_ps( f );     // x0 y0 z0 x1
+        const __m128 r1 = _mm_loadu_ps( f + 4 ); // y1 z1 x2 y2
+        const __m128 r2 = _mm_loadu_ps( f + 8 ); // z2 x3 y3 z3
+
+        x = _mm_shuffle_ps( r0, _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+        y = _mm_shuffle_ps( _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 0, 0, 1, 1 ) ), _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 2, 2, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+        z = _mm_shuffle_ps( _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _mm_shuffle_ps( r2, r2, _MM_SHUFFLE( 3, 3, 0, 0 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    }
+
+    /**
+     * @brief This function stores four 3-dimensional vectors from their components
+     * @param dst first vector
+     * @param x x-components
+     * @param y y-components
+     * @param z z-components
+    */
+    FORCEINLINE void store( Vector3 *dst, const __m128 &x, const __m128 &y, const __m128 &z ) {
+        float        *f  = &dst[ 0 ].x;
+        const __m128 lo = _mm_unpacklo_ps( x, y ); // x0 y0 x1 y1
+        const __m128 hi = _mm_unpackhi_ps( x, y ); // x2 y2 x3 y3
+
+        _mm_storeu_ps( f, _mm_shuffle_ps( lo, _mm_shuffle_ps( z, lo, _MM_SHUFFLE( 2, 2, 0, 0 ) ), _MM_SHUFFLE( 2, 0, 1, 0 ) ) );
+        _mm_storeu_ps( f + 4, _mm_shuffle_ps( _mm_shuffle_ps( lo, z, _MM_SHUFFLE( 1, 1, 3, 3 ) ), _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 1, 1, 0, 0 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+        _mm_storeu_ps( f + 8, _mm_shuffle_ps( _mm_shuffle_ps( z, hi, _MM_SHUFFLE( 2, 2, 2, 2 ) ), _mm_shuffle_ps( hi, z, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+    }
+
+    /**
+     * @brief This function divides vectors by their length where it is not zero, matching Vector2::normalize and Vector3::normalize
+     * @param len lengths
+     * @param c component
+     * @return normalized component
+    */
+    FORCEINLINE __m128 divide_nonzero( const __m128 &len, const __m128 &c ) {
+        const __m128 nonzero = _mm_cmpneq_ps( len, _mm_setzero_ps() );
+
+        return _mm_or_ps( _mm_and_ps( nonzero, _mm_div_ps( c, len ) ), _mm_andnot_ps( nonzero, c ) );
+    }
+
+    /**
+     * @brief This function returns the smaller components, ordering negative zero below positive zero like smaller
+     * @param a first components
+     * @param b second components
+     * @return smaller components
+    */
+    FORCEINLINE __m128 smaller( const __m128 &a, const __m128 &b ) {
+        // each order returns its second operand on a tie, so or-ing both keeps a negative zero
+        return _mm_or_ps( _mm_min_ps( a, b ), _mm_min_ps( b, a ) );
+    }
+
+    /**
+     * @brief This function returns the larger components, ordering positive zero above negative zero like larger
+     * @param a first components
+     * @param b second components
+     * @return larger components
+    */
+    FORCEINLINE __m128 larger( const __m128 &a, const __m128 &b ) {
+        // each order returns its second operand on a tie, so and-ing both keeps a positive zero
+        return _mm_and_ps( _mm_max_ps( a, b ), _mm_max_ps( b, a ) );
+    }
+}
+#endif
+
+namespace {
+    /**
+     * @brief This function returns the smaller of two values, negative zero is smaller than positive zero so the
+     * bounds do not depend on the order of the points
+     * @param a first value
+     * @param b second value
+     * @return smaller value
+    */
+    FORCEINLINE float smaller( const float a, const float b ) {
+        return a < b || ( a == b && std::signbit( a ) ) ? a : b;
+    }
+
+    /**
+     * @brief This function returns the larger of two values, positive zero is larger than negative zero so the
+     * bounds do not depend on the order of the points
+     * @param a first value
+     * @param b second value
+     * @return larger value
+    */
+    FORCEINLINE float larger( const float a, const float b ) {
+        return a > b || ( a == b && !std::signbit( a ) ) ? a : b;
+    }
+}
+
+void VectorArray::add( std::span< Vector2 > points, const Vector2 &offset ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    // the offset repeats every two floats, so the points are added as they are laid out
+    const __m128 o = _mm_setr_ps( offset.x, offset.y, offset.x, offset.y );
+
+    for ( ; i + 2 <= points.size(); i += 2 )
+        _mm_storeu_ps( &points[ i ].x, _mm_add_ps( _mm_loadu_ps( &points[ i ].x ), o ) );
+#endif
+
+    for ( ; i < points.size(); ++i )
+        points[ i ] += offset;
+}
+
+void VectorArray::add( std::span< Vector3 > points, const Vector3 &offset ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    // the offset repeats every three floats, four points fill three registers
+    const __m128 o0 = _mm_setr_ps( offset.x, offset.y, offset.z, offset.x );
+    const __m128 o1 = _mm_setr_ps( offset.y, offset.z, offset.x, offset.y );
+    const __m128 o2 = _mm_setr_ps( offset.z, offset.x, offset.y, offset.z );
+
+    for ( ; i + 4 <= points.size(); i += 4 ) {
+        float *f = &points[ i ].x;
+
+        _mm_storeu_ps( f, _mm_add_ps( _mm_loadu_ps( f ), o0 ) );
+        _mm_storeu_ps( f + 4, _mm_add_ps( _mm_loadu_ps( f + 4 ), o1 ) );
+        _mm_storeu_ps( f + 8, _mm_add_ps( _mm_loadu_ps( f + 8 ), o2 ) );
+    }
+#endif
+
+    for ( ; i < points.size(); ++i )
+        points[ i ] += offset;
+}
+
+void VectorArray::scale( std::span< Vector2 > points, const Vector2 &factor ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    const __m128 s = _mm_setr_ps( factor.x, factor.y, factor.x, factor.y );
+
+    for ( ; i + 2 <= points.size(); i += 2 )
+        _mm_storeu_ps( &points[ i ].x, _mm_mul_ps( _mm_loadu_ps( &points[ i ].x ), s ) );
+#endif
+
+    for ( ; i < points.size(); ++i )
+        points[ i ] *= factor;
+}
+
+void VectorArray::scale( std::span< Vector3 > points, const Vector3 &factor ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    const __m128 s0 = _mm_setr_ps( factor.x, factor.y, factor.z, factor.x );
+    const __m128 s1 = _mm_setr_ps( factor.y, factor.z, factor.x, factor.y );
+    const __m128 s2 = _mm_setr_ps( factor.z, factor.x, factor.y, factor.z );
+
+    for ( ; i + 4 <= points.size(); i += 4 ) {
+        float *f = &points[ i ].x;
+
+        _mm_storeu_ps( f, _mm_mul_ps( _mm_loadu_ps( f ), s0 ) );
+        _mm_storeu_ps( f + 4, _mm_mul_ps( _mm_loadu_ps( f + 4 ), s1 ) );
+        _mm_storeu_ps( f + 8, _mm_mul_ps( _mm_loadu_ps( f + 8 ), s2 ) );
+    }
+#endif
+
+    for ( ; i < points.size(); ++i )
+        points[ i ] *= factor;
+}
+
+void VectorArray::transform( std::span< Vector2 > points, const Affine2_t &transform ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    const __m128 xx = _mm_set1_ps( transform.m_x.x ), xy = _mm_set1_ps( transform.m_x.y );
+    const __m128 yx = _mm_set1_ps( transform.m_y.x ), yy = _mm_set1_ps( transform.m_y.y );
+    const __m128 ox = _mm_set1_ps( transform.m_origin.x ), oy = _mm_set1_ps( transform.m_origin.y );
+
+    for ( ; i + 4 <= points.size(); i += 4 ) {
+        __m128 x, y;
+
+        load( &points[ i ], x, y );
+
+        store( &points[ i ], _mm_add_ps( _mm_add_ps( _mm_mul_ps( xx, x ), _mm_mul_ps( yx, y ) ), ox ),
+                             _mm_add_ps( _mm_add_ps( _mm_mul_ps( xy, x ), _mm_mul_ps( yy, y ) ), oy ) );
+    }
+#endif
+
+    for ( ; i < points.size(); ++i ) {
+        const Vector2 p = points[ i ];
+
+        points[ i ] = { transform.m_x.x * p.x + transform.m_y.x * p.y + transform.m_origin.x,
+                        transform.m_x.y * p.x + transform.m_y.y * p.y + transform.m_origin.y };
+    }
+}
+
+void VectorArray::transform( std::span< Vector3 > points, const Affine3_t &transform ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    const __m128 xx = _mm_set1_ps( transform.m_x.x ), xy = _mm_set1_ps( transform.m_x.y ), xz = _mm_set1_ps( transform.m_x.z );
+    const __m128 yx = _mm_set1_ps( transform.m_y.x ), yy = _mm_set1_ps( transform.m_y.y ), yz = _mm_set1_ps( transform.m_y.z );
+    const __m128 zx = _mm_set1_ps( transform.m_z.x ), zy = _mm_set1_ps( transform.m_z.y ), zz = _mm_set1_ps( transform.m_z.z );
+    const __m128 ox = _mm_set1_ps( transform.m_origin.x ), oy = _mm_set1_ps( transform.m_origin.y ), oz = _mm_set1_ps( transform.m_origin.z );
+
+    for ( ; i + 4 <= points.size(); i += 4 ) {
+        __m128 x, y, z;
+
+        load( &points[ i ], x, y, z );
+
+        store( &points[ i ], _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( xx, x ), _mm_mul_ps( yx, y ) ), _mm_mul_ps( zx, z ) ), ox ),
+                             _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( xy, x ), _mm_mul_ps( yy, y ) ), _mm_mul_ps( zy, z ) ), oy ),
+                             _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( xz, x ), _mm_mul_ps( yz, y ) ), _mm_mul_ps( zz, z ) ), oz ) );
+    }
+#endif
+
+    for ( ; i < points.size(); ++i ) {
+        const Vector3 p = points[ i ];
+
+        points[ i ] = { transform.m_x.x * p.x + transform.m_y.x * p.y + transform.m_z.x * p.z + transform.m_origin.x,
+                        transform.m_x.y * p.x + transform.m_y.y * p.y + transform.m_z.y * p.z + transform.m_origin.y,
+                        transform.m_x.z * p.x + transform.m_y.z * p.y + transform.m_z.z * p.z + transform.m_origin.z };
+    }
+}
+
+void VectorArray::normalize( std::span< Vector2 > vectors ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    for ( ; i + 4 <= vectors.size(); i += 4 ) {
+        __m128 x, y;
+
+        load( &vectors[ i ], x, y );
+
+        const __m128 len = _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ) );
+
+        store( &vectors[ i ], divide_nonzero( len, x ), divide_nonzero( len, y ) );
+    }
+#endif
+
+    for ( ; i < vectors.size(); ++i )
+        vectors[ i ].normalize();
+}
+
+void VectorArray::normalize( std::span< Vector3 > vectors ) {
+    size_t i{};
+
+#ifdef DX_SSE2
+    for ( ; i + 4 <= vectors.size(); i += 4 ) {
+        __m128 x, y, z;
+
+        load( &vectors[ i ], x, y, z );
+
+        const __m128 len = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) ) );
+
+        store( &vectors[ i ], divide_nonzero( len, x ), divide_nonzero( len, y ), divide_nonzero( len, z ) );
+    }
+#endif
+
+    for ( ; i < vectors.size(); ++i )
+        vectors[ i ].normalize();
+}
+
+void VectorArray::bounds( std::span< const Vector2 > points, Vector2 &min, Vector2 &max ) {
+    size_t i{};
+
+    min = max = points[ 0 ];
+
+#ifdef DX_SSE2
+    // two points per register and two registers per step, the registers and then the lanes are folded together at the end.
+    // The ordering of zeros makes the fold independent of how the points are grouped
+    if ( points.size() >= 2 ) {
+        __m128 lo  = _mm_loadu_ps( &points[ 0 ].x );
+        __m128 hi  = lo;
+        __m128 lo2 = lo;
+        __m128 hi2 = lo;
+
+        for ( ; i + 4 <= points.size(); i += 4 ) {
+            const __m128 a = _mm_loadu_ps( &points[ i ].x );
+            const __m128 b = _mm_loadu_ps( &points[ i + 2 ].x );
+
+            lo  = smaller( lo, a );
+            hi  = larger( hi, a );
+            lo2 = smaller( lo2, b );
+            hi2 = larger( hi2, b );
+        }
+
+        for ( ; i + 2 <= points.size(); i += 2 ) {
+            const __m128 xy = _mm_loadu_ps( &points[ i ].x );
+
+            lo = smaller( lo, xy );
+            hi = larger( hi, xy );
+        }
+
+        lo = smaller( lo, lo2 );
+        hi = larger( hi, hi2 );
+        lo = smaller( lo, _mm_movehl_ps( lo, lo ) );
+        hi = larger( hi, _mm_movehl_ps( hi, hi ) );
+
+        min = { _mm_cvtss_f32( lo ), _mm_cvtss_f32( _mm_shuffle_ps( lo, lo, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) };
+        max = { _mm_cvtss_f32( hi ), _mm_cvtss_f32( _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) };
+    }
+#endif
+
+    for ( ; i < points.size(); ++i ) {
+        min = { smaller( min.x, points[ i ].x ), smaller( min.y, points[ i ].y ) };
+        max = { larger( max.x, points[ i ].x ), larger( max.y, points[ i ].y ) };
+    }
+}
+
+void VectorArray::bounds( std::span< const Vector3 > points, Vector3 &min, Vector3 &max ) {
+    size_t i{};
+
+    min = max = points[ 0 ];
+
+#ifdef DX_SSE2
+    // four points per register of each component, the lanes are folded together at the end
+    if ( points.size() >= 4 ) {
+        __m128 lo[ 3 ], hi[ 3 ];
+
+        load( points.data(), lo[ 0 ], lo[ 1 ], lo[ 2 ] );
+
+        for ( size_t k{}; k < 3; ++k )
+            hi[ k ] = lo[ k ];
+
+        for ( i = 4; i + 4 <= points.size(); i += 4 ) {
+            __m128 c[ 3 ];
+
+            load( &points[ i ], c[ 0 ], c[ 1 ], c[ 2 ] );
+
+            for ( size_t k{}; k < 3; ++k ) {
+                lo[ k ] = smaller( lo[ k ], c[ k ] );
+                hi[ k ] = larger( hi[ k ], c[ k ] );
+            }
+        }
+
+        float folded[ 2 ][ 3 ];
+
+        for ( size_t k{}; k < 3; ++k ) {
+            lo[ k ] = smaller( lo[ k ], _mm_movehl_ps( lo[ k ], lo[ k ] ) );
+            hi[ k ] = larger( hi[ k ], _mm_movehl_ps( hi[ k ], hi[ k ] ) );
+
+            folded[ 0 ][ k ] = _mm_cvtss_f32( smaller( lo[ k ], _mm_shuffle_ps( lo[ k ], lo[ k ], _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+            folded[ 1 ][ k ] = _mm_cvtss_f32( larger( hi[ k ], _mm_shuffle_ps( hi[ k ], hi[ k ], _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+        }
+
+        min = { folded[ 0 ][ 0 ], folded[ 0 ][ 1 ], folded[ 0 ][ 2 ] };
+        max = { folded[ 1 ][ 0 ], folded[ 1 ][ 1 ], folded[ 1 ][ 2 ] };
+    }
+#endif
+
+    for ( ; i < points.size(); ++i ) {
+        min = { smaller( min.x, points[ i ].x ), smaller( min.y, points[ i ].y ), smaller( min.z, points[ i ].z ) };
+        max = { larger( max.x, points[ i ].x ), larger( max.y, points[ i ].y ), larger( max.z, points[ i ].z ) };
+    }
+}
+
+void VectorArray::place( std::span< Vertex > vertices, const Vector2 &offset, const Vertex::color_t &color ) {
+    size_t i{};
+
+#if defined( DX_SSE2 ) && defined( DX_COMPACT_VERTEX )
+    // the position is added to, the color replaced, and the texture coordinates kept, none of their bits pass through a float add
+    const __m128 o   = _mm_setr_ps( offset.x, offset.y, 0.f, 0.f );
+    const __m128 xy  = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, 0, 0 ) );
+    const __m128 uv  = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+    const __m128 col = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, ( int ) color, 0 ) );
+
+    for ( ; i < vertices.size(); ++i ) {
+        float        *f = &vertices[ i ].coordinates().x;
+        const __m128 v  = _mm_loadu_ps( f );
+
+        _mm_storeu_ps( f, _mm_or_ps( _mm_and_ps( _mm_add_ps( v, o ), xy ), _mm_or_ps( _mm_and_ps( v, uv ), col ) ) );
+    }
+#endif
+
+    for ( ; i < vertices.size(); ++i ) {
+        auto &v = vertices[ i ];
+
+        v.coordinates().x += offset.x;
+        v.coordinates().y += offset.y;
+        v.color()          = color;
+    }
+}
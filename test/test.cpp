@@ -0,0 +1,76 @@
+#include "test.h"
+
+using namespace dx::test;
+
+bool Context::check( const bool passed, const char *expression, const char *file, const int line ) {
+    ++m_checks;
+
+    if ( !passed ) {
+        ++m_failures;
+
+        std::printf( "    %s:%d: check failed: %s\n", file, line, expression );
+    }
+
+    return passed;
+}
+
+//
+// test registry
+//
+Test_t *&dx::test::tests() {
+    static Test_t *head{};
+
+    return head;
+}
+
+Test_t::Test_t( const char *name, fn_t fn ) : m_name{ name }, m_fn{ fn }, m_next{} {
+    Test_t **it = &tests();
+
+    // append to keep the tests in link order
+    while ( *it )
+        it = &( *it )->m_next;
+
+    *it = this;
+}
+
+int main( int argc, char **argv ) {
+    std::string filter;
+    size_t      ran{};
+    size_t      failed{};
+
+    for ( int i{ 1 }; i < argc; ++i ) {
+        const std::string arg{ argv[ i ] };
+
+        if ( arg == "--filter" && i + 1 < argc )
+            filter = argv[ ++i ];
+
+        else {
+            std::printf( "usage: %s [--filter name]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    for ( auto *test = tests(); test; test = test->m_next ) {
+        Context context;
+
+        if ( !filter.empty() && std::string( test->m_name ).find( filter ) == std::string::npos )
+            continue;
+
+        std::printf( "%s\n", test->m_name );
+        std::fflush( stdout );
+
+        test->m_fn( context );
+
+        std::printf( "    %s, %zu checks\n", context.failures() ? "FAILED" : "passed", context.checks() );
+
+        ++ran;
+
+        if ( context.failures() )
+            ++failed;
+    }
+
+    std::printf( "%zu of %zu tests passed\n", ran - failed, ran );
+
+    // a filter matching nothing is a mistake in the test list
+    return ran && !failed ? 0 : 1;
+}
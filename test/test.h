@@ -0,0 +1,88 @@
+#pragma once
+
+#include "includes.h"
+
+#include <cstdio>
+#include <string>
+
+namespace dx::test {
+    /**
+     * @brief This class is passed to each test to record its failed checks
+    */
+    class Context {
+    public:
+        /**
+         * @brief The constructor for the Context class
+        */
+        FORCEINLINE Context() : m_checks{}, m_failures{} {
+
+        }
+
+        /**
+         * @brief This function records a check, printing it when it failed
+         * @param passed result of the check
+         * @param expression checked expression
+         * @param file source file of the check
+         * @param line source line of the check
+         * @return passed, so a test can stop on a check later ones depend on
+        */
+        NOINLINE bool check( const bool passed, const char *expression, const char *file, const int line );
+
+        /**
+         * @brief This function returns the number of checks made
+         * @return check count
+        */
+        FORCEINLINE size_t checks() const {
+            return m_checks;
+        }
+
+        /**
+         * @brief This function returns the number of failed checks
+         * @return failure count
+        */
+        FORCEINLINE size_t failures() const {
+            return m_failures;
+        }
+
+    private:
+        size_t m_checks;   // checks made
+        size_t m_failures; // checks that failed
+    };
+
+    /**
+     * @brief This struct registers a test with the runner at start-up
+    */
+    struct Test_t {
+        using fn_t = void( * )( Context &context );
+
+        /**
+         * @brief The constructor for the Test_t struct, it links the test into the global list
+         * @param name test name, its suite followed by a slash and the case
+         * @param fn test entry point
+        */
+        NOINLINE Test_t( const char *name, fn_t fn );
+
+        const char *m_name; // test name
+        fn_t        m_fn;   // test entry point
+        Test_t     *m_next; // next registered test
+    };
+
+    /**
+     * @brief This function returns the head of the registered test list
+     * @return first test
+    */
+    Test_t *&tests();
+}
+
+//
+// defines and registers a test, named suite/name so ctest can run a suite through the name filter
+//
+#define DX_TEST( suite, name )                                                  \
+    static void test_##suite##_##name( dx::test::Context &context );            \
+    static dx::test::Test_t test_reg_##suite##_##name{ #suite "/" #name, test_##suite##_##name }; \
+    static void test_##suite##_##name( dx::test::Context &context )
+
+//
+// checks an expression, the test goes on when it fails
+//
+#define DX_CHECK( expression ) context.check( ( expression ), #expression, __FILE__, __LINE__ )
@@ -0,0 +1,154 @@
+#include "test.h"
+#include "alloc_counter.h"
+#include "renderer.h"
+#include "null_backend.h"
+
+#include <charconv>
+
+using namespace dx;
+using namespace dx::bench;
+using namespace dx::test;
+
+namespace {
+    constexpr size_t WARM_UP  = 300; // frames recorded before counting, long enough for the text cache to drop and reuse layouts
+    constexpr size_t MEASURED = 100; // frames that may not allocate
+
+    /**
+     * @brief This function records a frame of every kind of primitive, the panel is recolored and the labels change with the frame
+     * @param renderer renderer
+     * @param image sprite image id
+     * @param frame frame number
+    */
+    void record( Renderer &renderer, const uint32_t image, const size_t frame ) {
+        const Vector2 polyline[] = { { 10.f, 300.f }, { 60.f, 340.f }, { 110.f, 300.f }, { 160.f, 340.f } };
+
+        renderer.draw_filled_rect( { 0.f, 0.f }, { 640.f, 480.f }, Color( 20, 20, 20, 255 ) );
+
+        for ( size_t i{}; i < 256; ++i ) {
+            const float x     = ( float ) ( i % 32 ) * 20.f;
+            const float y     = ( float ) ( i / 32 ) * 20.f;
+            const Color color = i % 16 == frame % 16 ? Color( 255, 160, 0, 255 ) : Color( 30, 30, 30, 255 );
+
+            switch ( i % 4 ) {
+                case 0: renderer.draw_filled_rect( { x, y }, { 18.f, 18.f }, color ); break;
+                case 1: renderer.draw_filled_circle( { x + 9.f, y + 9.f }, 8.f, color, 16 ); break;
+                case 2: renderer.draw_filled_rounded_rect( { x, y }, { 18.f, 18.f }, 4.f, color ); break;
+                default: renderer.draw_line( { x, y }, { x + 18.f, y + 18.f }, color, 2.f ); break;
+            }
+        }
+
+        renderer.draw_polyline( polyline, Color::green(), 3.f );
+        renderer.draw_image( image, { 200.f, 300.f }, { 32.f, 32.f } );
+
+        // a caption drawn every frame and counters of a fixed width that change every frame
+        renderer.draw_text( { 10.f, 400.f }, "frame time", Color::white() );
+
+        for ( size_t i{}; i < 16; ++i ) {
+            char label[ 16 ] = "000000";
+
+            std::to_chars( label, label + 6, ( frame * 16 + i ) % 1000000 + 100000 );
+            renderer.draw_text( { ( float ) ( i % 8 ) * 80.f, 420.f + ( float ) ( i / 8 ) * 20.f }, { label, 6 }, Color::white() );
+        }
+    }
+
+    /**
+     * @brief This function warms a renderer up and counts the allocations of the measured frames
+     * @param context test context
+     * @param configure function setting the renderer up
+    */
+    template < typename Fn >
+    void check_frames( Context &context, Fn &&configure ) {
+        NullBackend backend;
+        Renderer    renderer;
+
+        if ( !DX_CHECK( renderer.create( &backend ) ) )
+            return;
+
+        const std::vector< uint32_t > pixels( 32 * 32, 0xffffffff );
+        const uint32_t                image = renderer.add_image( 32, 32, pixels );
+
+        configure( renderer );
+
+        for ( size_t frame{}; frame < WARM_UP; ++frame ) {
+            record( renderer, image, frame );
+            renderer.perform();
+        }
+
+        const size_t allocs = AllocCounter::count();
+
+        for ( size_t frame{ WARM_UP }; frame < WARM_UP + MEASURED; ++frame ) {
+            record( renderer, image, frame );
+            renderer.perform();
+        }
+
+        DX_CHECK( AllocCounter::count() - allocs == 0 );
+
+        renderer.destroy();
+    }
+}
+
+DX_TEST( allocations, counts_through_the_hook ) {
+    const size_t allocs = AllocCounter::count();
+
+    // an explicit call cannot be elided, so it shows whether the replaced operator new is linked in
+    ::operator delete( ::operator new( 16 ) );
+
+    DX_CHECK( AllocCounter::count() - allocs == 1 );
+}
+
+DX_TEST( allocations, ring_upload ) {
+    check_frames( context, []( Renderer & ) {} );
+}
+
+DX_TEST( allocations, instancing ) {
+    check_frames( context, []( Renderer &renderer ) { renderer.set_instancing( true ); } );
+}
+
+DX_TEST( allocations, sorted_batches ) {
+    check_frames( context, []( Renderer &renderer ) { renderer.set_sort_batches( true ); } );
+}
+
+DX_TEST( allocations, diffed_upload ) {
+    check_frames( context, []( Renderer &renderer ) { renderer.set_diff_upload( true ); } );
+}
+
+DX_TEST( allocations, partial_redraw ) {
+    check_frames( context, []( Renderer &renderer ) { renderer.set_partial_redraw( true ); } );
+}
+
+DX_TEST( allocations, skip_unchanged ) {
+    check_frames( context, []( Renderer &renderer ) { renderer.set_skip_unchanged( true ); } );
+}
+
+DX_TEST( allocations, clock_label ) {
+    NullBackend backend;
+    Renderer    renderer;
+
+    if ( !DX_CHECK( renderer.create( &backend ) ) )
+        return;
+
+    renderer.set_partial_redraw( true );
+
+    // one new string per frame, new layouts are allocated until the cache first fills and drops the stale ones
+    const auto tick = [ & ]( const size_t frame ) {
+        char label[ 8 ] = "000000";
+
+        std::to_chars( label, label + 6, frame % 900000 + 100000 );
+
+        renderer.draw_filled_rect( { 560.f, 8.f }, { 72.f, 20.f }, Color::black() );
+        renderer.draw_text( { 564.f, 10.f }, { label, 6 }, Color::white() );
+        renderer.perform();
+    };
+
+    for ( size_t frame{}; frame < TextCache::MAX_LAYOUTS + 2; ++frame )
+        tick( frame );
+
+    const size_t allocs = AllocCounter::count();
+
+    for ( size_t frame{ TextCache::MAX_LAYOUTS + 2 }; frame < TextCache::MAX_LAYOUTS + 2 + MEASURED; ++frame )
+        tick( frame );
+
+    DX_CHECK( AllocCounter::count() - allocs == 0 );
+
+    renderer.destroy();
+}
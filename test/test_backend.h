@@ -0,0 +1,198 @@
+#pragma once
+
+#include "includes.h"
+#include "null_backend.h"
+
+#include <unordered_map>
+
+namespace dx::test {
+    /**
+     * @brief This struct holds a draw submitted to the recording backend, with the vertices or instances it read
+    */
+    struct RecordedDraw_t {
+        bool                           m_instanced;   // drawn from a unit mesh
+        Topology                       m_topology;    // primitive topology of an indexed draw
+        IndexFormat                    m_format;      // index format of an indexed draw
+        uint32_t                       m_mesh;        // unit mesh of an instanced draw
+        uint32_t                       m_texture;     // texture of an indexed draw
+        std::vector< Vector2 >         m_positions;   // vertex positions of an indexed draw, in index order
+        std::vector< uint32_t >        m_colors;      // packed rgba8 vertex colors of an indexed draw, in index order
+        std::vector< ShapeInstance_t > m_instances;   // instances of an instanced draw
+        uint32_t                       m_static;      // static geometry drawn from, or Batch_t::NO_STATIC
+        Vector2                        m_translation; // translation of the static geometry, applied to the positions
+        bool                           m_scissored;   // a scissor rect was set
+        ClipRect_t                     m_scissor;     // scissor rect while scissored
+    };
+
+    /**
+     * @brief This struct holds static geometry created through the recording backend
+    */
+    struct RecordedStatic_t {
+        std::vector< Vertex >          m_vertices;  // immutable vertices
+        std::vector< uint8_t >         m_indices;   // immutable indices, narrowed per batch
+        std::vector< ShapeInstance_t > m_instances; // immutable instances
+    };
+
+    /**
+     * @brief This struct holds a texture region written through the recording backend
+    */
+    struct RecordedUpdate_t {
+        uint32_t m_texture;     // written texture
+        uint32_t m_x;           // left edge in texels
+        uint32_t m_y;           // top edge in texels
+        uint32_t m_width;       // width in texels
+        uint32_t m_height;      // height in texels
+        bool     m_transparent; // every written texel is zero
+    };
+
+    /**
+     * @brief This class contains a null backend that resolves every draw against the mapped buffers when it is submitted.
+     * The ring is overwritten by later chunks, so what a draw read is only known at the time it is drawn
+    */
+    class RecordingBackend : public NullBackend {
+    public:
+        /**
+         * @brief The constructor for the RecordingBackend class
+         * @param screen_size reported render target size
+        */
+        FORCEINLINE RecordingBackend( const Vector2 &screen_size = { 640.f, 480.f } ) : NullBackend{ screen_size }, m_draws{}, m_maps{}, m_updates{}, m_binds{}, m_statics{},
+            m_memory{}, m_bound{ Batch_t::NO_STATIC }, m_translation{}, m_scissored{}, m_scissor{} {
+
+        }
+
+        void *map( BufferType type, MapMode mode ) override {
+            auto *data = NullBackend::map( type, mode );
+
+            m_maps.push_back( { type, mode } );
+            m_memory[ ( size_t ) type ] = ( const uint8_t * ) data;
+
+            return data;
+        }
+
+        void draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) override {
+            auto       &draw     = m_draws.emplace_back( RecordedDraw_t{ false, topology, format, Batch_t::NO_MESH, texture, {}, {}, {}, m_bound, m_translation, m_scissored, m_scissor } );
+            const auto *geometry = m_bound != Batch_t::NO_STATIC ? &m_statics.at( m_bound ) : nullptr;
+            const auto *vertices = geometry ? geometry->m_vertices.data() : ( const Vertex * ) m_memory[ ( size_t ) BufferType::VERTEX ];
+            const auto *indices  = geometry ? geometry->m_indices.data() : m_memory[ ( size_t ) BufferType::INDEX ];
+
+            NullBackend::draw( topology, format, index_count, start_index, base_vertex, texture );
+
+            for ( size_t i{}; i < index_count; ++i ) {
+                const size_t index  = format == IndexFormat::U16 ? ( ( const uint16_t * ) indices )[ start_index + i ] : ( ( const uint32_t * ) indices )[ start_index + i ];
+                Vertex       vertex = vertices[ base_vertex + index ];
+
+                draw.m_positions.emplace_back( vertex.coordinates().x + m_translation.x, vertex.coordinates().y + m_translation.y );
+                draw.m_colors.push_back( Vertex::rgba8( vertex.color() ) );
+            }
+        }
+
+        void draw_instanced( const uint32_t mesh, const size_t index_count, const size_t instance_count, const size_t start_instance ) override {
+            auto       &draw      = m_draws.emplace_back( RecordedDraw_t{ true, Topology::TRIANGLE_LIST, IndexFormat::U16, mesh, Batch_t::NO_TEXTURE, {}, {}, {}, m_bound, m_translation,
+                                                                      m_scissored, m_scissor } );
+            const auto *instances = m_bound != Batch_t::NO_STATIC ? m_statics.at( m_bound ).m_instances.data() : ( const ShapeInstance_t * ) m_memory[ ( size_t ) BufferType::INSTANCE ];
+
+            NullBackend::draw_instanced( mesh, index_count, instance_count, start_instance );
+
+            draw.m_instances.assign( instances + start_instance, instances + start_instance + instance_count );
+        }
+
+        void update_texture( const uint32_t texture, const uint32_t x, const uint32_t y, const uint32_t width, const uint32_t height, std::span< const uint32_t > pixels ) override {
+            NullBackend::update_texture( texture, x, y, width, height, pixels );
+
+            m_updates.push_back( { texture, x, y, width, height, std::all_of( pixels.begin(), pixels.end(), []( const uint32_t texel ) { return !texel; } ) } );
+        }
+
+        void set_scissor( const ClipRect_t *clip ) override {
+            NullBackend::set_scissor( clip );
+
+            m_scissored = clip != nullptr;
+            m_scissor   = clip ? *clip : ClipRect_t{};
+        }
+
+        bool create_static( const uint32_t geometry, std::span< const Vertex > vertices, std::span< const uint8_t > indices, std::span< const ShapeInstance_t > instances ) override {
+            NullBackend::create_static( geometry, vertices, indices, instances );
+
+            m_statics[ geometry ] = { { vertices.begin(), vertices.end() }, { indices.begin(), indices.end() }, { instances.begin(), instances.end() } };
+
+            return true;
+        }
+
+        void destroy_static( const uint32_t geometry ) override {
+            NullBackend::destroy_static( geometry );
+
+            m_statics.erase( geometry );
+        }
+
+        void set_static( const uint32_t geometry, const Vector2 &translation ) override {
+            NullBackend::set_static( geometry, translation );
+
+            m_binds.push_back( { geometry, translation } );
+            m_bound       = geometry;
+            m_translation = geometry != Batch_t::NO_STATIC ? translation : Vector2{};
+        }
+
+        /**
+         * @brief This function forgets the recorded draws, maps, texture updates and static geometry binds, the counters
+         * and the static geometry are kept
+        */
+        FORCEINLINE void clear() {
+            m_draws.clear();
+            m_maps.clear();
+            m_updates.clear();
+            m_binds.clear();
+        }
+
+        /**
+         * @brief This function returns the draws submitted since the last clear
+         * @return draws in submission order
+        */
+        FORCEINLINE const std::vector< RecordedDraw_t > &draws() const {
+            return m_draws;
+        }
+
+        /**
+         * @brief This function returns the maps made since the last clear
+         * @return buffer and map mode pairs in map order
+        */
+        FORCEINLINE const std::vector< std::pair< BufferType, MapMode > > &maps() const {
+            return m_maps;
+        }
+
+        /**
+         * @brief This function returns the texture updates made since the last clear
+         * @return updates in submission order
+        */
+        FORCEINLINE const std::vector< RecordedUpdate_t > &updates() const {
+            return m_updates;
+        }
+
+        /**
+         * @brief This function returns the static geometry binds made since the last clear
+         * @return geometry and translation pairs in bind order, Batch_t::NO_STATIC going back to the rings
+        */
+        FORCEINLINE const std::vector< std::pair< uint32_t, Vector2 > > &binds() const {
+            return m_binds;
+        }
+
+        /**
+         * @brief This function returns the static geometry that was created and not destroyed
+         * @return static geometry by handle
+        */
+        FORCEINLINE const std::unordered_map< uint32_t, RecordedStatic_t > &statics() const {
+            return m_statics;
+        }
+
+    private:
+        std::vector< RecordedDraw_t >                    m_draws;   // submitted draws
+        std::vector< std::pair< BufferType, MapMode > >  m_maps;    // buffer maps
+        std::vector< RecordedUpdate_t >                  m_updates; // texture updates
+        std::vector< std::pair< uint32_t, Vector2 > >    m_binds;   // static geometry binds
+        std::unordered_map< uint32_t, RecordedStatic_t > m_statics; // static geometry created and not destroyed
+
+        std::array< const uint8_t *, 3 > m_memory;      // memory last mapped for each buffer type
+        uint32_t                         m_bound;       // static geometry the draws read, or Batch_t::NO_STATIC
+        Vector2                          m_translation; // translation of the bound static geometry
+        bool                             m_scissored;   // a scissor rect is set
+        ClipRect_t                       m_scissor;     // scissor rect while scissored
+    };
+}
@@ -0,0 +1,135 @@
+#include "test.h"
+#include "baked_font.h"
+#include "font.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This function returns a path in the temporary directory for a test file
+     * @param name file name
+     * @return file path
+    */
+    std::string temp_path( const char *name ) {
+        return ( std::filesystem::temp_directory_path() / name ).string();
+    }
+
+    /**
+     * @brief This function bakes the bitmap font and reads the file back
+     * @param path output file path
+     * @param bytes output file contents
+     * @return true, if baked. false, otherwise
+    */
+    bool bake_bitmap_font( const std::string &path, std::vector< uint8_t > &bytes ) {
+        BitmapFont source;
+
+        if ( !BakedFont::bake( source, path.c_str() ) )
+            return false;
+
+        std::ifstream file{ path, std::ios::binary };
+
+        bytes.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+
+        return bytes.size() > sizeof( BakedFontHeader_t );
+    }
+
+    /**
+     * @brief This function writes a file with a changed header and tries to open it
+     * @param path file path
+     * @param bytes valid file contents
+     * @param size bytes of the contents to write
+     * @param edit changes the header
+     * @return whether the file opened
+    */
+    template< typename Fn >
+    bool open_edited( const std::string &path, const std::vector< uint8_t > &bytes, const size_t size, Fn &&edit ) {
+        BakedFontHeader_t header;
+        BakedFont         font;
+
+        std::memcpy( &header, bytes.data(), sizeof( header ) );
+        edit( header );
+
+        {
+            std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+
+            file.write( ( const char * ) &header, sizeof( header ) );
+            file.write( ( const char * ) bytes.data() + sizeof( header ), ( std::streamsize ) ( size - sizeof( header ) ) );
+        }
+
+        return font.open( path.c_str() );
+    }
+}
+
+DX_TEST( baked_font, opens_a_baked_file ) {
+    const std::string      path = temp_path( "dx11-renderer-test.dxbf" );
+    std::vector< uint8_t > bytes;
+    BakedFont              font;
+
+    if ( !DX_CHECK( bake_bitmap_font( path, bytes ) ) )
+        return;
+
+    if ( !DX_CHECK( font.open( path.c_str() ) ) )
+        return;
+
+    const auto &header = font.header();
+
+    DX_CHECK( header.m_page_count > 0 && header.m_glyph_count > 0 );
+    DX_CHECK( header.m_page_offset % BakedFont::PAGE_ALIGNMENT == 0 && header.m_page_stride % BakedFont::PAGE_ALIGNMENT == 0 );
+    DX_CHECK( font.find( 'A' ) && !font.find( 0x2603 ) );
+
+    // the last page ends within the file
+    const uint8_t *base = font.page( 0 ).data() - header.m_page_offset;
+    const auto     last = font.page( header.m_page_count - 1 );
+
+    DX_CHECK( last.size() == ( size_t ) header.m_page_width * header.m_page_height );
+    DX_CHECK( last.data() + last.size() <= base + bytes.size() );
+}
+
+DX_TEST( baked_font, rejects_corrupted_headers ) {
+    const std::string      path = temp_path( "dx11-renderer-test-corrupted.dxbf" );
+    std::vector< uint8_t > bytes;
+
+    if ( !DX_CHECK( bake_bitmap_font( path, bytes ) ) )
+        return;
+
+    // the untouched header opens, so each rejection below comes from its edit
+    DX_CHECK( open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t & ) {} ) );
+
+    // count * stride wraps around to zero, page( 1 ) would land 2^63 bytes past the mapping
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t &h ) {
+        h.m_page_count  = 2;
+        h.m_page_stride = 1ull << 63;
+    } ) );
+
+    // offset + count * stride wraps around to zero with a valid stride
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t &h ) {
+        h.m_page_offset = UINT64_MAX - h.m_page_count * h.m_page_stride + 1;
+    } ) );
+
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), [ & ]( BakedFontHeader_t &h ) {
+        h.m_page_offset = bytes.size() + 1;
+    } ) );
+
+    // a stride of zero would place every page on the first
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t &h ) {
+        h.m_page_width  = 0;
+        h.m_page_stride = 0;
+    } ) );
+
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t &h ) {
+        h.m_page_count = UINT32_MAX;
+    } ) );
+
+    DX_CHECK( !open_edited( path, bytes, bytes.size(), []( BakedFontHeader_t &h ) {
+        h.m_glyph_count = UINT32_MAX;
+    } ) );
+
+    // a file cut short of its last page
+    DX_CHECK( !open_edited( path, bytes, bytes.size() - 1, []( BakedFontHeader_t & ) {} ) );
+}
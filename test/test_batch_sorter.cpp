@@ -0,0 +1,187 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+
+#include <algorithm>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This class contains a renderer that also records line strips, which no primitive of the context does
+    */
+    class StripRenderer : public Renderer {
+    public:
+        /**
+         * @brief This function draws a pixel thick line strip through the points
+         * @param points strip points
+         * @param color rgba color
+        */
+        void draw_strip( std::span< const Vector2 > points, const Color &color ) {
+            const auto col = Vertex::pack( color );
+            Vector2    min{ INFINITY, INFINITY }, max{ -INFINITY, -INFINITY };
+            uint32_t   scissor;
+
+            for ( const auto &point : points ) {
+                min = { std::min( min.x, point.x ), std::min( min.y, point.y ) };
+                max = { std::max( max.x, point.x ), std::max( max.y, point.y ) };
+            }
+
+            if ( !scissor_test( min, max, scissor ) )
+                return;
+
+            auto r = m_render_list.reserve( points.size(), points.size(), Topology::LINE_STRIP, Batch_t::NO_TEXTURE, scissor );
+
+            for ( size_t i{}; i < points.size(); ++i ) {
+                r.m_vertices[ i ] = { points[ i ].x, points[ i ].y, col };
+                r.m_indices[ i ]  = r.m_base_index + ( uint32_t ) i;
+            }
+
+            commit( points.size(), points.size() );
+        }
+    };
+
+    /**
+     * @brief This function checks whether a draw reads a vertex at a position
+     * @param draw recorded draw
+     * @param position vertex position
+     * @return true, if read. false, otherwise
+    */
+    bool reads( const RecordedDraw_t &draw, const Vector2 &position ) {
+        return std::find( draw.m_positions.begin(), draw.m_positions.end(), position ) != draw.m_positions.end();
+    }
+}
+
+DX_TEST( batch_sorter, keeps_the_order_of_overlapping_batches ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_sort_batches( true );
+
+    // sorting takes effect on the lists recorded after the next flush
+    renderer.perform();
+    backend.clear();
+
+    // the second rect is compatible with the first, but the line in between overlaps both, so it stays above the line
+    renderer.draw_filled_rect( { 0.f, 0.f }, { 100.f, 100.f }, Color::red() );
+    renderer.draw_line( { 10.f, 50.f }, { 90.f, 50.f }, Color::green() );
+    renderer.draw_filled_rect( { 20.f, 20.f }, { 60.f, 60.f }, Color::blue() );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_merged == 0 );
+
+    if ( !DX_CHECK( backend.draws().size() == 3 ) )
+        return;
+
+    const auto &draws = backend.draws();
+
+    DX_CHECK( draws[ 0 ].m_topology == Topology::TRIANGLE_LIST && reads( draws[ 0 ], { 0.f, 0.f } ) );
+    DX_CHECK( draws[ 1 ].m_topology == Topology::LINE_LIST && reads( draws[ 1 ], { 10.f, 50.f } ) );
+    DX_CHECK( draws[ 2 ].m_topology == Topology::TRIANGLE_LIST && reads( draws[ 2 ], { 20.f, 20.f } ) );
+
+    renderer.destroy();
+}
+
+DX_TEST( batch_sorter, merges_compatible_batches_that_do_not_overlap ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_sort_batches( true );
+    renderer.perform();
+    backend.clear();
+
+    // the line is away from both rects, so the second rect moves back to the first and the two are drawn as one
+    renderer.draw_filled_rect( { 0.f, 0.f }, { 50.f, 50.f }, Color::red() );
+    renderer.draw_line( { 300.f, 300.f }, { 400.f, 300.f }, Color::green() );
+    renderer.draw_filled_rect( { 100.f, 0.f }, { 50.f, 50.f }, Color::blue() );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_merged == 1 );
+
+    if ( !DX_CHECK( backend.draws().size() == 2 ) )
+        return;
+
+    const auto &rects = backend.draws()[ 0 ];
+    const auto &line  = backend.draws()[ 1 ];
+
+    // the merged indices are offset onto the vertices of the second rect, which keeps its place after the first
+    DX_CHECK( rects.m_topology == Topology::TRIANGLE_LIST && rects.m_positions.size() == 12 );
+    DX_CHECK( std::all_of( rects.m_positions.begin(), rects.m_positions.begin() + 6, []( const Vector2 &p ) { return p.x <= 50.f; } ) );
+    DX_CHECK( std::all_of( rects.m_positions.begin() + 6, rects.m_positions.end(), []( const Vector2 &p ) { return p.x >= 100.f; } ) );
+    DX_CHECK( line.m_topology == Topology::LINE_LIST && line.m_positions.size() == 2 );
+
+    renderer.destroy();
+}
+
+DX_TEST( batch_sorter, expands_line_strips_so_they_do_not_join ) {
+    RecordingBackend backend;
+    StripRenderer    renderer;
+
+    renderer.create( &backend );
+    renderer.set_sort_batches( true );
+    renderer.perform();
+    backend.clear();
+
+    const Vector2 first[]  = { { 0.f, 0.f }, { 10.f, 0.f }, { 10.f, 10.f } };
+    const Vector2 second[] = { { 100.f, 0.f }, { 110.f, 0.f }, { 110.f, 10.f } };
+
+    // the rect in between splits the strips into batches of their own until the sort merges them
+    renderer.draw_strip( first, Color::white() );
+    renderer.draw_filled_rect( { 50.f, 50.f }, { 10.f, 10.f }, Color::red() );
+    renderer.draw_strip( second, Color::white() );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_merged == 1 );
+
+    if ( !DX_CHECK( backend.draws().size() == 2 ) )
+        return;
+
+    const auto &strips = backend.draws()[ 0 ];
+
+    // each strip is drawn as its two segments, with no segment from the end of the first to the start of the second
+    DX_CHECK( strips.m_topology == Topology::LINE_LIST );
+
+    if ( DX_CHECK( strips.m_positions.size() == 8 ) ) {
+        const Vector2 expected[] = { first[ 0 ], first[ 1 ], first[ 1 ], first[ 2 ], second[ 0 ], second[ 1 ], second[ 1 ], second[ 2 ] };
+
+        DX_CHECK( std::equal( strips.m_positions.begin(), strips.m_positions.end(), std::begin( expected ) ) );
+    }
+
+    renderer.destroy();
+}
+
+DX_TEST( batch_sorter, splits_merged_batches_at_16_bit_indices ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_sort_batches( true );
+    renderer.perform();
+    backend.clear();
+
+    // rects alternate with lines away from them, so every rect and line is a batch of its own until sorted
+    constexpr size_t count = 20000;
+
+    for ( size_t i{}; i < count; ++i ) {
+        renderer.draw_filled_rect( { ( float ) ( i % 100 ), ( float ) ( i / 100 % 100 ) }, { 4.f, 4.f }, Color::red() );
+        renderer.draw_line( { 300.f, 300.f + ( float ) ( i % 100 ) }, { 400.f, 300.f + ( float ) ( i % 100 ) }, Color::green() );
+    }
+
+    renderer.perform();
+
+    // the rects take two batches, 16383 rects of four vertices fit below 0xffff, the lines take one
+    DX_CHECK( renderer.stats().m_merged == ( count - 2 ) + ( count - 1 ) );
+    DX_CHECK( std::all_of( backend.draws().begin(), backend.draws().end(), []( const RecordedDraw_t &draw ) { return draw.m_format == IndexFormat::U16; } ) );
+
+    size_t rect_indices{}, line_indices{};
+
+    for ( const auto &draw : backend.draws() )
+        ( draw.m_topology == Topology::TRIANGLE_LIST ? rect_indices : line_indices ) += draw.m_positions.size();
+
+    DX_CHECK( rect_indices == count * 6 && line_indices == count * 2 );
+
+    renderer.destroy();
+}
@@ -0,0 +1,141 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+
+#include <algorithm>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This function checks that the positions of a draw are inside of a rect
+     * @param draw recorded draw
+     * @param rect rect
+     * @return true, if inside. false, otherwise
+    */
+    bool inside( const RecordedDraw_t &draw, const ClipRect_t &rect ) {
+        return std::all_of( draw.m_positions.begin(), draw.m_positions.end(), [ & ]( const Vector2 &p ) { return rect.contains( p, p ); } );
+    }
+}
+
+DX_TEST( clip_rect, clips_quads_with_their_texture_coordinates ) {
+    const ClipRect_t rect{ { 10.f, 10.f }, { 20.f, 20.f } };
+
+    // the visible part of the quad samples the texels it did before
+    Vector2 min{ 0.f, 5.f }, max{ 40.f, 25.f }, uv_min{ 0.f, 0.f }, uv_max{ 1.f, 1.f };
+
+    DX_CHECK( rect.clip( min, max, uv_min, uv_max ) );
+    DX_CHECK( min == Vector2( 10.f, 10.f ) && max == Vector2( 20.f, 20.f ) );
+    DX_CHECK( uv_min == Vector2( 0.25f, 0.25f ) && uv_max == Vector2( 0.5f, 0.75f ) );
+
+    // a flipped texture is interpolated the same way
+    min    = { 15.f, 0.f };
+    max    = { 25.f, 40.f };
+    uv_min = { 1.f, 0.5f };
+    uv_max = { 0.f, 1.f };
+
+    DX_CHECK( rect.clip( min, max, uv_min, uv_max ) );
+    DX_CHECK( min == Vector2( 15.f, 10.f ) && max == Vector2( 20.f, 20.f ) );
+    DX_CHECK( uv_min == Vector2( 1.f, 0.625f ) && uv_max == Vector2( 0.5f, 0.75f ) );
+
+    // a quad inside is left as is, one outside or only touching an edge is dropped
+    min    = { 12.f, 12.f };
+    max    = { 18.f, 18.f };
+    uv_min = { 0.f, 0.f };
+    uv_max = { 1.f, 1.f };
+
+    DX_CHECK( rect.clip( min, max, uv_min, uv_max ) );
+    DX_CHECK( min == Vector2( 12.f, 12.f ) && max == Vector2( 18.f, 18.f ) && uv_min == Vector2( 0.f, 0.f ) && uv_max == Vector2( 1.f, 1.f ) );
+
+    min = { 20.f, 12.f };
+    max = { 30.f, 18.f };
+
+    DX_CHECK( !rect.clip( min, max, uv_min, uv_max ) );
+    DX_CHECK( !ClipRect_t{}.clip( min, max, uv_min, uv_max ) );
+}
+
+DX_TEST( clip_rect, counts_rejected_clipped_and_scissored_primitives ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+    const ClipRect_t rect{ { 100.f, 100.f }, { 200.f, 200.f } };
+
+    renderer.create( &backend );
+
+    renderer.push_clip_rect( rect.m_min, rect.m_max - rect.m_min );
+
+    // outside, dropped before they are tessellated
+    renderer.draw_filled_rect( { 0.f, 0.f }, { 50.f, 50.f }, Color::red() );
+    renderer.draw_filled_circle( { 300.f, 300.f }, 10.f, Color::red() );
+
+    // inside, drawn as they are
+    renderer.draw_filled_rect( { 120.f, 120.f }, { 10.f, 10.f }, Color::green() );
+    renderer.draw_line( { 110.f, 110.f }, { 190.f, 110.f }, Color::green() );
+
+    // crossing, the rect is cut on the cpu and the line scissored
+    renderer.draw_filled_rect( { 150.f, 150.f }, { 100.f, 100.f }, Color::blue() );
+    renderer.draw_line( { 50.f, 150.f }, { 250.f, 150.f }, Color::blue() );
+
+    renderer.pop_clip_rect();
+    renderer.perform();
+
+    const auto &stats = renderer.stats();
+
+    DX_CHECK( stats.m_primitives == 6 );
+    DX_CHECK( stats.m_rejected == 2 );
+    DX_CHECK( stats.m_clipped == 1 );
+    DX_CHECK( stats.m_scissored == 1 );
+
+    // the cut rect lies inside the clip rect and needs no scissor, the crossing line is drawn scissored to it
+    if ( DX_CHECK( backend.draws().size() == 4 ) ) {
+        const auto &cut  = backend.draws()[ 2 ];
+        const auto &line = backend.draws()[ 3 ];
+
+        DX_CHECK( cut.m_topology == Topology::TRIANGLE_LIST && cut.m_positions.size() == 6 && inside( cut, rect ) && !cut.m_scissored );
+        DX_CHECK( line.m_topology == Topology::LINE_LIST && line.m_scissored && !inside( line, rect ) );
+    }
+
+    renderer.destroy();
+}
+
+DX_TEST( clip_rect, splits_batches_by_scissor_only ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    renderer.push_clip_rect( { 100.f, 100.f }, { 100.f, 100.f } );
+
+    // lines inside need no scissor, those crossing share a batch scissored to the clip rect
+    renderer.draw_line( { 110.f, 110.f }, { 190.f, 110.f }, Color::white() );
+    renderer.draw_line( { 50.f, 120.f }, { 250.f, 120.f }, Color::white() );
+    renderer.draw_line( { 50.f, 130.f }, { 250.f, 130.f }, Color::white() );
+
+    // a nested clip rect is a scissor of its own
+    renderer.push_clip_rect( { 150.f, 150.f }, { 100.f, 100.f } );
+    renderer.draw_line( { 50.f, 160.f }, { 250.f, 160.f }, Color::white() );
+    renderer.pop_clip_rect();
+
+    // cut on the cpu, rects never split a batch
+    renderer.draw_filled_rect( { 110.f, 110.f }, { 10.f, 10.f }, Color::white() );
+    renderer.draw_filled_rect( { 150.f, 150.f }, { 100.f, 100.f }, Color::white() );
+    renderer.draw_filled_rect( { 130.f, 110.f }, { 10.f, 10.f }, Color::white() );
+
+    renderer.pop_clip_rect();
+    renderer.perform();
+
+    if ( !DX_CHECK( backend.draws().size() == 4 ) )
+        return;
+
+    const auto &draws = backend.draws();
+
+    DX_CHECK( !draws[ 0 ].m_scissored && draws[ 0 ].m_positions.size() == 2 );
+    DX_CHECK( draws[ 1 ].m_scissored && draws[ 1 ].m_scissor.m_min == Vector2( 100.f, 100.f ) && draws[ 1 ].m_scissor.m_max == Vector2( 200.f, 200.f ) );
+    DX_CHECK( draws[ 1 ].m_positions.size() == 4 );
+    DX_CHECK( draws[ 2 ].m_scissored && draws[ 2 ].m_scissor.m_min == Vector2( 150.f, 150.f ) && draws[ 2 ].m_scissor.m_max == Vector2( 200.f, 200.f ) );
+    DX_CHECK( !draws[ 3 ].m_scissored && draws[ 3 ].m_topology == Topology::TRIANGLE_LIST && draws[ 3 ].m_positions.size() == 18 );
+
+    DX_CHECK( renderer.stats().m_scissored == 3 && renderer.stats().m_clipped == 1 );
+
+    renderer.destroy();
+}
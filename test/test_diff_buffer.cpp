@@ -0,0 +1,170 @@
+#include "test.h"
+#include "diff_buffer.h"
+
+#include <cstring>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This class contains a diff buffer committing into a mirror of the gpu buffer, so what was written can be checked
+    */
+    class Mirror {
+    public:
+        /**
+         * @brief The constructor for the Mirror class
+         * @param capacity buffer size in bytes
+        */
+        Mirror( const size_t capacity ) : m_diff{}, m_gpu( capacity ), m_writes{} {
+            m_diff.reset( capacity );
+        }
+
+        /**
+         * @brief This function lays out a range after the previous one and commits its bytes where they are
+         * @param bytes bytes of the range
+         * @return diff counters
+        */
+        DiffResult_t upload( std::span< const uint8_t > bytes ) {
+            size_t offset;
+
+            if ( !m_diff.allocate( bytes.size(), 1, offset ) )
+                return {};
+
+            return m_diff.commit( bytes.data(), [ & ]( const size_t at, std::span< const uint8_t > range ) {
+                memcpy( m_gpu.data() + at, range.data(), range.size() );
+                m_writes.emplace_back( at, range.size() );
+            } );
+        }
+
+        DiffBuffer                                 m_diff;   // buffer under test
+        std::vector< uint8_t >                     m_gpu;    // bytes the writes left in the buffer
+        std::vector< std::pair< size_t, size_t > > m_writes; // offset and size of every write
+    };
+}
+
+DX_TEST( diff_buffer, writes_the_changed_blocks ) {
+    Mirror                 mirror{ 4096 };
+    std::vector< uint8_t > frame( 4096, 7 );
+
+    // bytes never written are unknown, the first frame is written whole
+    mirror.m_diff.begin_frame();
+
+    auto result = mirror.upload( frame );
+
+    DX_CHECK( result.m_compared == 4096 && result.m_written == 4096 && result.m_ranges == 1 && !result.m_fallback );
+
+    // the same frame again writes nothing
+    mirror.m_diff.begin_frame();
+    mirror.m_writes.clear();
+
+    result = mirror.upload( frame );
+
+    DX_CHECK( result.m_written == 0 && result.m_ranges == 0 && mirror.m_writes.empty() );
+
+    // a changed byte writes its block, blocks further apart than the merge gap are written apart
+    frame[ 100 ]  = 1;
+    frame[ 3000 ] = 2;
+
+    mirror.m_diff.begin_frame();
+    mirror.m_writes.clear();
+
+    result = mirror.upload( frame );
+
+    DX_CHECK( result.m_ranges == 2 && result.m_written == 2 * DiffBuffer::BLOCK_SIZE );
+    DX_CHECK( mirror.m_writes.size() == 2 );
+    DX_CHECK( mirror.m_writes[ 0 ].first == 64 && mirror.m_writes[ 0 ].second == DiffBuffer::BLOCK_SIZE );
+    DX_CHECK( mirror.m_writes[ 1 ].first == 2944 && mirror.m_writes[ 1 ].second == DiffBuffer::BLOCK_SIZE );
+    DX_CHECK( mirror.m_gpu == frame );
+}
+
+DX_TEST( diff_buffer, merges_close_blocks ) {
+    Mirror                 mirror{ 4096 };
+    std::vector< uint8_t > frame( 4096, 7 );
+
+    mirror.m_diff.begin_frame();
+    mirror.upload( frame );
+
+    // the unchanged bytes between the blocks are written along with them
+    frame[ 0 ]                                             = 1;
+    frame[ DiffBuffer::BLOCK_SIZE + DiffBuffer::MERGE_GAP ] = 2;
+
+    mirror.m_diff.begin_frame();
+
+    const auto result = mirror.upload( frame );
+
+    DX_CHECK( result.m_ranges == 1 && result.m_written == 2 * DiffBuffer::BLOCK_SIZE + DiffBuffer::MERGE_GAP );
+    DX_CHECK( mirror.m_gpu == frame );
+}
+
+DX_TEST( diff_buffer, falls_back_past_the_range_budget ) {
+    constexpr size_t STRIDE = DiffBuffer::BLOCK_SIZE * 2 + DiffBuffer::MERGE_GAP; // changed bytes too far apart to merge
+
+    const size_t           size = STRIDE * ( DiffBuffer::MAX_RANGES + 8 );
+    Mirror                 mirror{ size };
+    std::vector< uint8_t > frame( size, 7 );
+
+    mirror.m_diff.begin_frame();
+    mirror.upload( frame );
+
+    // one changed byte per stride needs more ranges than a frame writes, they become one from the first to the last
+    for ( size_t i = STRIDE; i < size; i += STRIDE )
+        frame[ i ] = 1;
+
+    mirror.m_diff.begin_frame();
+    mirror.m_writes.clear();
+
+    auto result = mirror.upload( frame );
+
+    DX_CHECK( result.m_fallback && result.m_ranges == 1 );
+    DX_CHECK( mirror.m_writes.size() == 1 && mirror.m_writes[ 0 ].first == STRIDE && mirror.m_writes[ 0 ].second == size - STRIDE - STRIDE + DiffBuffer::BLOCK_SIZE );
+    DX_CHECK( mirror.m_gpu == frame );
+
+    // the copy matches the buffer, so the next frame compares against what was written
+    mirror.m_diff.begin_frame();
+
+    result = mirror.upload( frame );
+
+    DX_CHECK( result.m_ranges == 0 && !result.m_fallback );
+}
+
+DX_TEST( diff_buffer, shares_the_budget_within_a_frame ) {
+    constexpr size_t STRIDE = DiffBuffer::BLOCK_SIZE * 2 + DiffBuffer::MERGE_GAP; // changed bytes too far apart to merge
+
+    const size_t           first_size = STRIDE * ( DiffBuffer::MAX_RANGES - 1 );
+    Mirror                 mirror{ first_size + STRIDE * 2 };
+    std::vector< uint8_t > first( first_size, 7 ), second( STRIDE * 2, 7 );
+
+    mirror.m_diff.begin_frame();
+    mirror.upload( first );
+    mirror.upload( second );
+
+    for ( auto *range : { &first, &second } ) {
+        for ( size_t i{}; i < range->size(); i += STRIDE )
+            ( *range )[ i ] = 1;
+    }
+
+    // the first range takes all but one write of the frame, the two of the second range no longer fit
+    mirror.m_diff.begin_frame();
+
+    auto result = mirror.upload( first );
+
+    DX_CHECK( result.m_ranges == DiffBuffer::MAX_RANGES - 1 && !result.m_fallback );
+
+    result = mirror.upload( second );
+
+    DX_CHECK( result.m_ranges == 1 && result.m_fallback );
+
+    // the next frame starts with the whole budget
+    for ( size_t i{}; i < second.size(); i += STRIDE )
+        second[ i ] = 2;
+
+    mirror.m_diff.begin_frame();
+
+    DX_CHECK( mirror.upload( first ).m_ranges == 0 );
+
+    result = mirror.upload( second );
+
+    DX_CHECK( result.m_ranges == 2 && !result.m_fallback );
+    DX_CHECK( std::equal( first.begin(), first.end(), mirror.m_gpu.begin() ) && std::equal( second.begin(), second.end(), mirror.m_gpu.begin() + first_size ) );
+}
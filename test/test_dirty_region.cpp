@@ -0,0 +1,368 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+#include "dirty_region.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    const Vector2 screen{ 640.f, 480.f };
+
+    /**
+     * @brief This function returns the pixel rect a changed primitive dirties
+     * @param min top-left of the primitive bounds
+     * @param max bottom-right of the primitive bounds
+     * @return bounds grown by the padding
+    */
+    ClipRect_t padded( const Vector2 &min, const Vector2 &max ) {
+        return { { min.x - DirtyRegion::PADDING, min.y - DirtyRegion::PADDING }, { max.x + DirtyRegion::PADDING, max.y + DirtyRegion::PADDING } };
+    }
+
+    /**
+     * @brief This function checks whether the rects of a region are exactly the expected ones, in any order
+     * @param region dirty region
+     * @param expected expected rects
+     * @return true, if equal. false, otherwise
+    */
+    bool rects_are( const DirtyRegion &region, std::initializer_list< ClipRect_t > expected ) {
+        const auto &rects = region.rects();
+
+        return !region.full() && rects.size() == expected.size() && std::all_of( expected.begin(), expected.end(), [ & ]( const ClipRect_t &rect ) {
+            return std::any_of( rects.begin(), rects.end(), [ & ]( const ClipRect_t &r ) { return r.m_min == rect.m_min && r.m_max == rect.m_max; } );
+        } );
+    }
+
+    /**
+     * @brief This function adds a frame of 10 pixel squares, one per key, placed on a row by their index
+     * @param region dirty region
+     * @param keys keys of the squares in draw order
+    */
+    void add_squares( DirtyRegion &region, std::initializer_list< uint64_t > keys ) {
+        region.begin_frame();
+
+        for ( const uint64_t key : keys )
+            region.add( { { ( float ) key * 20.f, 10.f }, { ( float ) key * 20.f + 10.f, 20.f } }, key );
+
+        region.update( screen, true, false );
+    }
+
+    /**
+     * @brief This class contains a recording backend that rasterizes its draws into a pixel buffer kept across frames, like a back
+     * buffer that is not discarded. Opaque pixels replace the buffer, translucent ones are folded into it so that a pixel drawn
+     * twice or in another order ends up different
+    */
+    class RasterBackend : public RecordingBackend {
+    public:
+        /**
+         * @brief The constructor for the RasterBackend class
+        */
+        RasterBackend() : RecordingBackend{ screen }, m_pixels( ( size_t ) ( screen.x * screen.y ) ), m_scissor{} {
+
+        }
+
+        void draw( Topology topology, IndexFormat format, const size_t index_count, const size_t start_index, const size_t base_vertex, const uint32_t texture ) override {
+            RecordingBackend::draw( topology, format, index_count, start_index, base_vertex, texture );
+
+            const auto &draw = draws().back();
+
+            if ( topology == Topology::LINE_LIST ) {
+                for ( size_t i{}; i + 1 < draw.m_positions.size(); i += 2 )
+                    line( draw.m_positions[ i ], draw.m_positions[ i + 1 ], draw.m_colors[ i ] );
+            }
+
+            else {
+                for ( size_t i{}; i + 2 < draw.m_positions.size(); i += 3 )
+                    triangle( draw.m_positions[ i ], draw.m_positions[ i + 1 ], draw.m_positions[ i + 2 ], draw.m_colors[ i ] );
+            }
+
+            // the positions were only needed to rasterize, the frames would pile them up
+            clear();
+        }
+
+        void set_scissor( const ClipRect_t *clip ) override {
+            RecordingBackend::set_scissor( clip );
+
+            m_scissor = clip ? std::optional< ClipRect_t >{ *clip } : std::nullopt;
+        }
+
+        /**
+         * @brief This function returns the pixels drawn so far
+         * @return rows of folded colors
+        */
+        const std::vector< uint32_t > &pixels() const {
+            return m_pixels;
+        }
+
+    private:
+        std::vector< uint32_t >     m_pixels;  // back buffer
+        std::optional< ClipRect_t > m_scissor; // scissor rect, the whole screen if none
+
+        /**
+         * @brief This function writes a pixel inside of the screen and the scissor rect
+         * @param x pixel column
+         * @param y pixel row
+         * @param color packed rgba8 color
+        */
+        void plot( const int32_t x, const int32_t y, const uint32_t color ) {
+            if ( x < 0 || y < 0 || x >= ( int32_t ) screen.x || y >= ( int32_t ) screen.y )
+                return;
+
+            if ( m_scissor && ( ( float ) x < m_scissor->m_min.x || ( float ) y < m_scissor->m_min.y || ( float ) x >= m_scissor->m_max.x || ( float ) y >= m_scissor->m_max.y ) )
+                return;
+
+            auto &pixel = m_pixels[ ( size_t ) y * ( size_t ) screen.x + ( size_t ) x ];
+
+            pixel = color >> 24 == 0xff ? color : pixel * 31 + color;
+        }
+
+        /**
+         * @brief This function fills the pixels whose centers are inside of a triangle of either winding
+        */
+        void triangle( const Vector2 &a, const Vector2 &b, const Vector2 &c, const uint32_t color ) {
+            const auto edge = []( const Vector2 &p, const Vector2 &q, const float x, const float y ) { return ( q.x - p.x ) * ( y - p.y ) - ( q.y - p.y ) * ( x - p.x ); };
+
+            for ( int32_t y{ ( int32_t ) std::floor( std::min( { a.y, b.y, c.y } ) ) }; y <= ( int32_t ) std::ceil( std::max( { a.y, b.y, c.y } ) ); ++y ) {
+                for ( int32_t x{ ( int32_t ) std::floor( std::min( { a.x, b.x, c.x } ) ) }; x <= ( int32_t ) std::ceil( std::max( { a.x, b.x, c.x } ) ); ++x ) {
+                    const float px = ( float ) x + 0.5f, py = ( float ) y + 0.5f;
+                    const float e0 = edge( a, b, px, py ), e1 = edge( b, c, px, py ), e2 = edge( c, a, px, py );
+
+                    if ( ( e0 >= 0.f && e1 >= 0.f && e2 >= 0.f ) || ( e0 <= 0.f && e1 <= 0.f && e2 <= 0.f ) )
+                        plot( x, y, color );
+                }
+            }
+        }
+
+        /**
+         * @brief This function steps a line one pixel at a time, writing each pixel it enters once
+        */
+        void line( const Vector2 &a, const Vector2 &b, const uint32_t color ) {
+            const int32_t steps = std::max( 1, ( int32_t ) std::ceil( std::max( std::abs( b.x - a.x ), std::abs( b.y - a.y ) ) ) );
+            int32_t       last_x{ INT32_MIN }, last_y{ INT32_MIN };
+
+            for ( int32_t i{}; i <= steps; ++i ) {
+                const float   t = ( float ) i / ( float ) steps;
+                const int32_t x = ( int32_t ) std::floor( a.x + ( b.x - a.x ) * t );
+                const int32_t y = ( int32_t ) std::floor( a.y + ( b.y - a.y ) * t );
+
+                if ( x != last_x || y != last_y )
+                    plot( x, y, color );
+
+                last_x = x;
+                last_y = y;
+            }
+        }
+    };
+
+    /**
+     * @brief This function records a frame of an animated scene, with primitives that move, change color, appear, and disappear
+     * @param renderer renderer to record to
+     * @param frame frame number
+    */
+    void record_scene( Renderer &renderer, const size_t frame ) {
+        const float t = ( float ) frame;
+
+        // the frame covers the screen itself, so a redrawn rect starts from the background
+        renderer.draw_filled_rect( { 0.f, 0.f }, screen, Color( 20, 20, 30, 255 ) );
+
+        for ( size_t i{}; i < 24; ++i ) {
+            const Color color = i == 5 && frame / 15 % 2 ? Color( 200, 40, 40, 128 ) : Color( 60, 120, 200, 128 );
+
+            renderer.draw_filled_rect( { 20.f + ( float ) ( i % 6 ) * 100.f, 20.f + ( float ) ( i / 6 ) * 100.f }, { 80.f, 60.f }, color );
+        }
+
+        // a translucent rect sliding over the grid, blended with whatever it crosses
+        renderer.draw_filled_rect( { 10.f + t * 7.f, 50.f + t * 2.f }, { 40.f, 30.f }, Color( 250, 250, 80, 100 ) );
+        renderer.draw_line( { 320.f, 240.f }, { 320.f + std::cos( t * 0.1f ) * 100.f, 240.f + std::sin( t * 0.1f ) * 100.f }, Color( 255, 255, 255, 200 ) );
+        renderer.draw_filled_circle( { 500.f, 400.f + ( float ) ( frame % 20 ) }, 20.f, Color( 80, 220, 80, 160 ), 24 );
+
+        // a rect that comes and goes moves every primitive after it in the draw order
+        if ( frame / 10 % 2 )
+            renderer.draw_filled_rect( { 200.f, 300.f }, { 50.f, 50.f }, Color( 255, 128, 0, 90 ) );
+
+        // clipped primitives are scissored to their clip rect and to the dirty rect together
+        renderer.push_clip_rect( { 400.f, 100.f }, { 120.f, 120.f } );
+        renderer.draw_filled_rect( { 380.f + ( float ) ( frame % 30 ) * 3.f, 150.f }, { 60.f, 40.f }, Color( 255, 0, 255, 120 ) );
+        renderer.draw_line( { 390.f, 110.f }, { 540.f, 210.f }, Color( 0, 255, 255, 200 ) );
+        renderer.pop_clip_rect();
+
+        renderer.draw_filled_rect( { 600.f, 440.f }, { 30.f, 30.f }, Color( 255, 255, 255, 60 ) );
+    }
+}
+
+DX_TEST( dirty_region, redraws_where_changed_primitives_were_and_are ) {
+    DirtyRegion region;
+
+    // with no previous frame to compare with the first is drawn whole
+    add_squares( region, { 1, 2, 3 } );
+    DX_CHECK( region.full() && region.rects().empty() );
+
+    add_squares( region, { 1, 2, 3 } );
+    DX_CHECK( !region.full() && region.rects().empty() );
+
+    // a primitive replaced at its place dirties both the old and the new bounds
+    region.begin_frame();
+    region.add( { { 20.f, 10.f }, { 30.f, 20.f } }, 1 );
+    region.add( { { 100.f, 100.f }, { 110.f, 110.f } }, 7 );
+    region.add( { { 60.f, 10.f }, { 70.f, 20.f } }, 3 );
+    region.update( screen, true, false );
+
+    DX_CHECK( rects_are( region, { padded( { 40.f, 10.f }, { 50.f, 20.f } ), padded( { 100.f, 100.f }, { 110.f, 110.f } ) } ) );
+}
+
+DX_TEST( dirty_region, redraws_added_and_removed_primitives_between_the_common_ends ) {
+    DirtyRegion region;
+
+    add_squares( region, { 1, 2, 3, 4 } );
+    add_squares( region, { 1, 2, 3, 4 } );
+
+    // an insertion shifts the primitives after it, the common prefix and suffix leave only it dirty
+    add_squares( region, { 1, 2, 9, 3, 4 } );
+    DX_CHECK( rects_are( region, { padded( { 180.f, 10.f }, { 190.f, 20.f } ) } ) );
+
+    // a removal dirties where the removed primitive was
+    add_squares( region, { 1, 9, 3, 4 } );
+    DX_CHECK( rects_are( region, { padded( { 40.f, 10.f }, { 50.f, 20.f } ) } ) );
+
+    // at the end of the frame the suffix is empty
+    add_squares( region, { 1, 9, 3, 4, 6 } );
+    DX_CHECK( rects_are( region, { padded( { 120.f, 10.f }, { 130.f, 20.f } ) } ) );
+
+    // with no common ends every primitive of either frame is dirty, the five before and the two after
+    add_squares( region, { 2, 5 } );
+    DX_CHECK( !region.full() && region.rects().size() == 7 );
+}
+
+DX_TEST( dirty_region, merges_changes_into_at_most_max_rects ) {
+    DirtyRegion region;
+    const auto  frame = [ & ]( const uint64_t salt ) {
+        region.begin_frame();
+
+        // a grid of small primitives far apart, so no two changes overlap
+        for ( uint64_t i{}; i < 16; ++i )
+            region.add( { { ( float ) ( i % 4 ) * 150.f + 10.f, ( float ) ( i / 4 ) * 100.f + 10.f }, { ( float ) ( i % 4 ) * 150.f + 14.f, ( float ) ( i / 4 ) * 100.f + 14.f } }, i + salt );
+
+        region.update( screen, true, false );
+    };
+
+    frame( 0 );
+    frame( 0 );
+    frame( 100 );
+
+    const auto &rects = region.rects();
+
+    if ( !DX_CHECK( !region.full() && rects.size() == DirtyRegion::MAX_RECTS ) )
+        return;
+
+    // the merged rects stay disjoint and still cover every change
+    for ( size_t a{}; a < rects.size(); ++a ) {
+        for ( size_t b{ a + 1 }; b < rects.size(); ++b )
+            DX_CHECK( rects[ a ].m_min.x >= rects[ b ].m_max.x || rects[ b ].m_min.x >= rects[ a ].m_max.x || rects[ a ].m_min.y >= rects[ b ].m_max.y || rects[ b ].m_min.y >= rects[ a ].m_max.y );
+    }
+
+    for ( uint64_t i{}; i < 16; ++i ) {
+        const Vector2 center{ ( float ) ( i % 4 ) * 150.f + 12.f, ( float ) ( i / 4 ) * 100.f + 12.f };
+
+        DX_CHECK( std::any_of( rects.begin(), rects.end(), [ & ]( const ClipRect_t &r ) { return !r.outside( center, center ); } ) );
+    }
+}
+
+DX_TEST( dirty_region, draws_the_frame_whole_past_max_coverage ) {
+    DirtyRegion region;
+    const float width = screen.x * 0.9f;
+    const auto  frame = [ & ]( const float height, const uint64_t key ) {
+        region.begin_frame();
+        region.add( { { 0.f, 0.f }, { width, height } }, key );
+        region.update( screen, true, false );
+    };
+
+    frame( 100.f, 1 );
+    frame( 100.f, 1 );
+
+    // a change below the coverage is redrawn in its rect
+    frame( 100.f, 2 );
+    DX_CHECK( !region.full() && region.rects().size() == 1 );
+
+    // one above it redraws the frame whole, with no rects
+    frame( screen.y * 0.7f, 3 );
+    DX_CHECK( region.full() && region.rects().empty() );
+}
+
+DX_TEST( dirty_region, draws_incomplete_and_resized_frames_whole ) {
+    DirtyRegion region;
+
+    add_squares( region, { 1, 2 } );
+    add_squares( region, { 1, 2 } );
+    DX_CHECK( !region.full() );
+
+    // a frame missing primitives is drawn whole, and so is the next, as the missing ones cannot be compared with
+    region.begin_frame();
+    region.add( { { 20.f, 10.f }, { 30.f, 20.f } }, 1 );
+    region.update( screen, false, false );
+    DX_CHECK( region.full() );
+
+    add_squares( region, { 1, 2 } );
+    DX_CHECK( region.full() );
+
+    add_squares( region, { 1, 2 } );
+    DX_CHECK( !region.full() && region.rects().empty() );
+
+    // a resized screen moves everything
+    region.begin_frame();
+    region.add( { { 20.f, 10.f }, { 30.f, 20.f } }, 1 );
+    region.add( { { 40.f, 10.f }, { 50.f, 20.f } }, 2 );
+    region.update( { 800.f, 600.f }, true, false );
+    DX_CHECK( region.full() );
+
+    // a frame whose texels changed is drawn whole, and one the caller did not draw is forgotten
+    region.begin_frame();
+    region.add( { { 20.f, 10.f }, { 30.f, 20.f } }, 1 );
+    region.add( { { 40.f, 10.f }, { 50.f, 20.f } }, 2 );
+    region.update( { 800.f, 600.f }, true, true );
+    DX_CHECK( region.full() );
+
+    region.invalidate();
+    region.begin_frame();
+    region.add( { { 20.f, 10.f }, { 30.f, 20.f } }, 1 );
+    region.add( { { 40.f, 10.f }, { 50.f, 20.f } }, 2 );
+    region.update( { 800.f, 600.f }, true, false );
+    DX_CHECK( region.full() );
+}
+
+DX_TEST( dirty_region, matches_a_full_redraw_pixel_for_pixel ) {
+    RasterBackend full_backend, partial_backend;
+    Renderer      full, partial;
+
+    full.create( &full_backend );
+    partial.create( &partial_backend );
+    partial.set_partial_redraw( true );
+
+    // tracking takes effect on the lists recorded after the next flush
+    partial.perform();
+
+    size_t partial_frames{};
+
+    for ( size_t frame{}; frame < 60; ++frame ) {
+        record_scene( full, frame );
+        record_scene( partial, frame );
+
+        full.perform();
+
+        if ( partial.perform() && !partial.dirty_rects().empty() )
+            ++partial_frames;
+
+        // the first frame to differ is enough, every later one would differ as well
+        if ( !DX_CHECK( full_backend.pixels() == partial_backend.pixels() ) )
+            break;
+    }
+
+    // most frames only redraw what moved, so the comparison covers the partial path
+    DX_CHECK( partial_frames > 40 );
+
+    full.destroy();
+    partial.destroy();
+}
@@ -0,0 +1,178 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This function checks every field of an instance record
+     * @param context test context
+     * @param instance recorded instance
+     * @param expected expected instance
+     * @return true, if equal. false, otherwise
+    */
+    bool check_instance( Context &context, const ShapeInstance_t &instance, const ShapeInstance_t &expected ) {
+        return DX_CHECK( instance.m_kind == expected.m_kind ) && DX_CHECK( instance.m_pos == expected.m_pos ) && DX_CHECK( instance.m_size == expected.m_size ) &&
+               DX_CHECK( instance.m_params == expected.m_params ) && DX_CHECK( instance.m_color == expected.m_color );
+    }
+}
+
+DX_TEST( instancing, builds_instance_records ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_instancing( true );
+
+    renderer.draw_filled_rect( { 10.f, 20.f }, { 30.f, 40.f }, Color::red() );
+    renderer.draw_line( { 5.f, 6.f }, { 50.f, 60.f }, Color::green(), 4.f );
+    renderer.draw_filled_circle( { 100.f, 110.f }, 12.f, Color::blue(), 24 );
+    renderer.perform();
+
+    if ( !DX_CHECK( backend.draws().size() == 2 ) )
+        return;
+
+    const auto &quads = backend.draws()[ 0 ];
+    const auto &fans  = backend.draws()[ 1 ];
+
+    // rects and lines share the unit quad, circles are drawn from a fan of their segment count
+    DX_CHECK( quads.m_instanced && quads.m_mesh == ShapeMesh_t::QUAD );
+    DX_CHECK( fans.m_instanced && fans.m_mesh != ShapeMesh_t::QUAD );
+
+    if ( DX_CHECK( quads.m_instances.size() == 2 ) ) {
+        check_instance( context, quads.m_instances[ 0 ], { { 10.f, 20.f }, { 30.f, 40.f }, {}, Color::red().pack(), ShapeKind::RECT } );
+        check_instance( context, quads.m_instances[ 1 ], { { 5.f, 6.f }, { 50.f, 60.f }, { 4.f, 0.f }, Color::green().pack(), ShapeKind::LINE } );
+    }
+
+    if ( DX_CHECK( fans.m_instances.size() == 1 ) )
+        check_instance( context, fans.m_instances[ 0 ], { { 100.f, 110.f }, { 12.f, 12.f }, {}, Color::blue().pack(), ShapeKind::ELLIPSE } );
+
+    DX_CHECK( renderer.stats().m_instances == 3 );
+    DX_CHECK( renderer.stats().m_vertices == 0 );
+    DX_CHECK( backend.stats().m_indices == 2 * 6 + 24 * 3 );
+
+    renderer.destroy();
+}
+
+DX_TEST( instancing, collapses_consecutive_instances ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_instancing( true );
+
+    // consecutive shapes of a mesh share a draw, each change of mesh or an indexed primitive starts a new one
+    for ( size_t i{}; i < 100; ++i )
+        renderer.draw_filled_rect( { ( float ) i, 10.f }, { 4.f, 4.f }, Color::red() );
+
+    for ( size_t i{}; i < 50; ++i )
+        renderer.draw_filled_circle( { ( float ) i, 100.f }, 3.f, Color::blue(), 16 );
+
+    for ( size_t i{}; i < 20; ++i )
+        renderer.draw_filled_circle( { ( float ) i, 200.f }, 3.f, Color::blue(), 32 );
+
+    renderer.draw_line( { 0.f, 300.f }, { 100.f, 300.f }, Color::white() );
+
+    for ( size_t i{}; i < 10; ++i )
+        renderer.draw_line( { 0.f, ( float ) i }, { 100.f, ( float ) i }, Color::white(), 2.f );
+
+    renderer.perform();
+
+    if ( !DX_CHECK( backend.draws().size() == 5 ) )
+        return;
+
+    const auto &draws = backend.draws();
+
+    DX_CHECK( draws[ 0 ].m_instanced && draws[ 0 ].m_mesh == ShapeMesh_t::QUAD && draws[ 0 ].m_instances.size() == 100 );
+    DX_CHECK( draws[ 1 ].m_instanced && draws[ 1 ].m_instances.size() == 50 );
+    DX_CHECK( draws[ 2 ].m_instanced && draws[ 2 ].m_instances.size() == 20 && draws[ 2 ].m_mesh != draws[ 1 ].m_mesh );
+    DX_CHECK( !draws[ 3 ].m_instanced && draws[ 3 ].m_topology == Topology::LINE_LIST && draws[ 3 ].m_positions.size() == 2 );
+    DX_CHECK( draws[ 4 ].m_instanced && draws[ 4 ].m_mesh == ShapeMesh_t::QUAD && draws[ 4 ].m_instances.size() == 10 );
+
+    // the instances keep their submission order within a draw
+    for ( size_t i{}; i < draws[ 0 ].m_instances.size(); ++i ) {
+        if ( !DX_CHECK( draws[ 0 ].m_instances[ i ].m_pos.x == ( float ) i ) )
+            break;
+    }
+
+    // a fan created once is reused by the frames after it
+    const size_t meshes = backend.stats().m_meshes;
+
+    renderer.draw_filled_circle( { 10.f, 10.f }, 3.f, Color::blue(), 16 );
+    renderer.perform();
+
+    DX_CHECK( backend.stats().m_meshes == meshes );
+
+    renderer.destroy();
+}
+
+DX_TEST( instancing, falls_back_to_indexed_geometry ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // with instancing off the same shapes are tessellated
+    renderer.draw_filled_rect( { 10.f, 20.f }, { 30.f, 40.f }, Color::red() );
+    renderer.draw_filled_circle( { 100.f, 110.f }, 12.f, Color::blue(), 24 );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_instances == 0 );
+
+    for ( const auto &draw : backend.draws() )
+        DX_CHECK( !draw.m_instanced );
+
+    // a fan past the 16-bit mesh indices is tessellated even while instancing
+    backend.clear();
+    renderer.set_instancing( true );
+
+    renderer.draw_filled_circle( { 100.f, 110.f }, 12.f, Color::blue(), Batch_t::MAX_NARROW_VERTICES );
+    renderer.perform();
+
+    if ( DX_CHECK( backend.draws().size() == 1 ) ) {
+        DX_CHECK( !backend.draws()[ 0 ].m_instanced );
+        DX_CHECK( backend.draws()[ 0 ].m_format == IndexFormat::U32 );
+        DX_CHECK( backend.draws()[ 0 ].m_positions.size() == Batch_t::MAX_NARROW_VERTICES * 3 );
+    }
+
+    renderer.destroy();
+}
+
+DX_TEST( instancing, keeps_instances_across_chunks ) {
+    RecordingBackend              backend;
+    Renderer                      renderer;
+    std::vector< RectInstance_t > rects;
+
+    renderer.create( &backend );
+    renderer.set_instancing( true );
+
+    // more instances than the instance ring starts with, split at batch boundaries by the thin lines between them
+    for ( size_t i{}; i < 3000; ++i )
+        rects.push_back( { { ( float ) ( i % 600 ), ( float ) ( i / 600 ) }, { 2.f, 2.f }, Color( ( uint8_t ) i, 0, 0, 255 ) } );
+
+    for ( size_t i{}; i < rects.size(); i += 500 ) {
+        renderer.draw_filled_rects( std::span< const RectInstance_t >( rects ).subspan( i, 500 ) );
+        renderer.draw_line( { 0.f, 0.f }, { 1.f, 1.f }, Color::white() );
+    }
+
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_chunks > 1 );
+    DX_CHECK( renderer.stats().m_instances == rects.size() );
+
+    std::vector< ShapeInstance_t > drawn;
+
+    for ( const auto &draw : backend.draws() )
+        drawn.insert( drawn.end(), draw.m_instances.begin(), draw.m_instances.end() );
+
+    if ( DX_CHECK( drawn.size() == rects.size() ) ) {
+        for ( size_t i{}; i < rects.size(); ++i ) {
+            if ( !check_instance( context, drawn[ i ], { rects[ i ].m_pos, rects[ i ].m_size, {}, rects[ i ].m_color.pack(), ShapeKind::RECT } ) )
+                break;
+        }
+    }
+
+    renderer.destroy();
+}
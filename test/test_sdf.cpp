@@ -0,0 +1,170 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+#include "sdf.h"
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    constexpr float PI = std::numbers::pi_v< float >; // half turn in radians
+
+    /**
+     * @brief This function evaluates a packed shape the way shape_vertex_shader and shape_pixel_shader do, written
+     * from resource/shape.fx and resource/sdf.fx. The local position is interpolated across the quad, so at a pixel it
+     * is the pixel relative to the center, and pixels outside of the padded quad are not rasterized
+     * @param shape shape instance as uploaded
+     * @param point pixel center
+     * @return coverage the pixel shader writes to alpha
+    */
+    float shader_coverage( const ShapeInstance_t &shape, const Vector2 &point ) {
+        // m_shape = float4( m_size, m_params )
+        const float half_x = shape.m_size.x;
+        const float half_y = shape.m_size.y;
+        const float radius = shape.m_params.x;
+        const float stroke = shape.m_params.y;
+
+        // m_local = ( m_unit * 2 - 1 ) * ( m_size + SDF_AA_PADDING ), interpolated
+        const float local_x = point.x - shape.m_pos.x;
+        const float local_y = point.y - shape.m_pos.y;
+
+        if ( std::abs( local_x ) > half_x + Sdf::AA_PADDING || std::abs( local_y ) > half_y + Sdf::AA_PADDING )
+            return 0.f;
+
+        const float qx   = std::abs( local_x ) - half_x + radius;
+        const float qy   = std::abs( local_y ) - half_y + radius;
+        float       dist = std::sqrt( std::max( qx, 0.f ) * std::max( qx, 0.f ) + std::max( qy, 0.f ) * std::max( qy, 0.f ) ) + std::min( std::max( qx, qy ), 0.f ) - radius;
+
+        if ( stroke > 0.f )
+            dist = std::abs( dist + stroke * 0.5f ) - stroke * 0.5f;
+
+        // saturate( 0.5 - dist )
+        return std::min( std::max( 0.5f - dist, 0.f ), 1.f );
+    }
+
+    /**
+     * @brief This function compares the reference coverage with the shader's on a grid over and around the shape
+     * @param context test context
+     * @param shape shape instance
+     * @param area expected covered area in pixels
+    */
+    void check_shape( Context &context, const ShapeInstance_t &shape, const float area ) {
+        constexpr float STEP = 0.25f; // grid spacing in pixels
+
+        const Vector2 extent{ shape.m_size.x + 3.f, shape.m_size.y + 3.f };
+        double        covered{};
+        float         worst{};
+
+        for ( float y = shape.m_pos.y - extent.y; y <= shape.m_pos.y + extent.y; y += STEP ) {
+            for ( float x = shape.m_pos.x - extent.x; x <= shape.m_pos.x + extent.x; x += STEP ) {
+                const float reference = Sdf::coverage( shape, { x, y } );
+
+                worst    = std::max( worst, std::abs( reference - shader_coverage( shape, { x, y } ) ) );
+                covered += reference * STEP * STEP;
+            }
+        }
+
+        // the padded quad holds the whole faded edge, so the two agree outside of it as well
+        DX_CHECK( worst < 1e-5f );
+        DX_CHECK( std::abs( covered - area ) < area * 0.01 + 1.0 );
+    }
+}
+
+DX_TEST( sdf, circle_matches_the_shader ) {
+    const auto circle = Sdf::circle( { 50.f, 40.f }, 10.f, 0.f, 0xffffffff );
+
+    DX_CHECK( Sdf::distance( circle, { 50.f, 40.f } ) == -10.f );
+    DX_CHECK( std::abs( Sdf::distance( circle, { 60.f, 40.f } ) ) < 1e-5f );
+    DX_CHECK( std::abs( Sdf::distance( circle, { 50.f + 10.f * std::cos( 0.7f ), 40.f + 10.f * std::sin( 0.7f ) } ) ) < 1e-4f );
+
+    // a pixel centered on the edge is half covered, one a pixel off it in either direction is covered or not at all
+    DX_CHECK( std::abs( Sdf::coverage( circle, { 60.f, 40.f } ) - 0.5f ) < 1e-5f );
+    DX_CHECK( Sdf::coverage( circle, { 59.f, 40.f } ) == 1.f );
+    DX_CHECK( Sdf::coverage( circle, { 61.f, 40.f } ) == 0.f );
+
+    check_shape( context, circle, PI * 10.f * 10.f );
+}
+
+DX_TEST( sdf, ring_matches_the_shader ) {
+    const auto ring = Sdf::circle( { 50.f, 40.f }, 10.f, 3.f, 0xffffffff );
+
+    // hollow inside the stroke, covered in the middle of it, and half covered on both of its edges
+    DX_CHECK( Sdf::coverage( ring, { 50.f, 40.f } ) == 0.f );
+    DX_CHECK( Sdf::coverage( ring, { 58.5f, 40.f } ) == 1.f );
+    DX_CHECK( std::abs( Sdf::coverage( ring, { 57.f, 40.f } ) - 0.5f ) < 1e-5f );
+    DX_CHECK( std::abs( Sdf::coverage( ring, { 60.f, 40.f } ) - 0.5f ) < 1e-5f );
+
+    check_shape( context, ring, PI * ( 10.f * 10.f - 7.f * 7.f ) );
+}
+
+DX_TEST( sdf, rounded_rect_matches_the_shader ) {
+    const auto rect = Sdf::rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, 0.f, 0xffffffff );
+
+    // packed around its center with half dimensions
+    DX_CHECK( rect.m_pos == Vector2( 40.f, 35.f ) );
+    DX_CHECK( rect.m_size == Vector2( 30.f, 15.f ) );
+    DX_CHECK( rect.m_params == Vector2( 6.f, 0.f ) );
+    DX_CHECK( rect.m_kind == ShapeKind::SDF_ROUNDED_RECT );
+
+    // the straight edges are where the rect is, the corners are cut by the radius
+    DX_CHECK( std::abs( Sdf::coverage( rect, { 40.f, 20.f } ) - 0.5f ) < 1e-5f );
+    DX_CHECK( std::abs( Sdf::coverage( rect, { 70.f, 35.f } ) - 0.5f ) < 1e-5f );
+    DX_CHECK( Sdf::coverage( rect, { 10.5f, 20.5f } ) == 0.f );
+    DX_CHECK( Sdf::coverage( rect, { 17.f, 27.f } ) == 1.f );
+
+    check_shape( context, rect, 60.f * 30.f - ( 4.f - PI ) * 6.f * 6.f );
+
+    // an outlined rect only covers its stroke
+    const auto outline = Sdf::rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, 2.f, 0xffffffff );
+
+    DX_CHECK( Sdf::coverage( outline, { 40.f, 35.f } ) == 0.f );
+    DX_CHECK( Sdf::coverage( outline, { 40.f, 21.f } ) == 1.f );
+
+    check_shape( context, outline, 60.f * 30.f - ( 4.f - PI ) * 6.f * 6.f - ( 56.f * 26.f - ( 4.f - PI ) * 4.f * 4.f ) );
+}
+
+DX_TEST( sdf, packing_normalizes_its_parameters ) {
+    // a negative size spans the same rect, the radius is limited to half the smaller side, a negative stroke fills
+    const auto flipped = Sdf::rounded_rect( { 70.f, 50.f }, { -60.f, -30.f }, 100.f, -2.f, 0xffffffff );
+
+    DX_CHECK( flipped.m_pos == Vector2( 40.f, 35.f ) );
+    DX_CHECK( flipped.m_size == Vector2( 30.f, 15.f ) );
+    DX_CHECK( flipped.m_params == Vector2( 15.f, 0.f ) );
+
+    const auto circle = Sdf::circle( { 5.f, 6.f }, -4.f, -1.f, 0xffffffff );
+
+    DX_CHECK( circle.m_size == Vector2( 4.f, 4.f ) );
+    DX_CHECK( circle.m_params == Vector2( 4.f, 0.f ) );
+}
+
+DX_TEST( sdf, renderer_uploads_the_packed_shapes ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // the shapes are instanced whether or not instancing is on, each one as packed by Sdf
+    renderer.draw_filled_smooth_circle( { 50.f, 40.f }, 10.f, Color::red() );
+    renderer.draw_smooth_circle( { 50.f, 40.f }, 10.f, Color::red(), 3.f );
+    renderer.draw_filled_rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, Color::green() );
+    renderer.draw_rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, Color::green(), 0.f );
+    renderer.perform();
+
+    const ShapeInstance_t expected[] = {
+        Sdf::circle( { 50.f, 40.f }, 10.f, 0.f, Color::red().pack() ),
+        Sdf::circle( { 50.f, 40.f }, 10.f, 3.f, Color::red().pack() ),
+        Sdf::rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, 0.f, Color::green().pack() ),
+        Sdf::rounded_rect( { 10.f, 20.f }, { 60.f, 30.f }, 6.f, 1.f, Color::green().pack() )
+    };
+
+    if ( !DX_CHECK( backend.draws().size() == 1 && backend.draws()[ 0 ].m_instances.size() == std::size( expected ) ) )
+        return;
+
+    for ( size_t i{}; i < std::size( expected ); ++i ) {
+        const auto &instance = backend.draws()[ 0 ].m_instances[ i ];
+
+        DX_CHECK( std::memcmp( &instance, &expected[ i ], sizeof( ShapeInstance_t ) ) == 0 );
+    }
+
+    renderer.destroy();
+}
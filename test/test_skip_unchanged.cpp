@@ -0,0 +1,177 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This class contains a recording backend whose render target can be resized between frames
+    */
+    class ResizableBackend : public RecordingBackend {
+    public:
+        Vector2 get_screen_size() override {
+            return m_size;
+        }
+
+        Vector2 m_size{ 640.f, 480.f }; // reported render target size
+    };
+
+    /**
+     * @brief This class contains a renderer that can count texels as written while a frame is recorded, standing in for an
+     * image or glyph uploaded to the atlas by a frame that draws the same vertices
+    */
+    class UploadingRenderer : public Renderer {
+    public:
+        /**
+         * @brief This function counts texels as written this frame
+         * @param bytes written bytes
+        */
+        void write_texels( const size_t bytes ) {
+            m_recorded.m_texture_bytes += bytes;
+        }
+    };
+
+    /**
+     * @brief This function records the same frame every time
+     * @param renderer renderer to record to
+     * @param x left edge of the rect
+    */
+    void record_frame( Renderer &renderer, const float x = 10.f ) {
+        renderer.draw_filled_rect( { x, 10.f }, { 100.f, 50.f }, Color::red() );
+        renderer.draw_line( { 0.f, 200.f }, { 300.f, 200.f }, Color::green() );
+    }
+}
+
+DX_TEST( skip_unchanged, skips_a_frame_the_same_as_the_last_drawn ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_skip_unchanged( true );
+
+    // hashing takes effect on the lists recorded after the next flush, the first hashed frame has nothing to compare with
+    renderer.perform();
+
+    record_frame( renderer );
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.draws().empty() );
+
+    // the same frame is neither uploaded nor drawn
+    backend.clear();
+    record_frame( renderer );
+
+    DX_CHECK( !renderer.changed() );
+    DX_CHECK( !renderer.perform() );
+    DX_CHECK( backend.maps().empty() && backend.draws().empty() );
+    DX_CHECK( renderer.stats().m_unchanged == 1 );
+
+    // skipping does not change what the next frame is compared with
+    record_frame( renderer );
+    DX_CHECK( !renderer.perform() );
+    DX_CHECK( backend.maps().empty() && backend.draws().empty() );
+
+    renderer.destroy();
+}
+
+DX_TEST( skip_unchanged, draws_changed_vertices ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_skip_unchanged( true );
+    renderer.perform();
+
+    record_frame( renderer );
+    renderer.perform();
+
+    // a rect moved by a pixel changes the hash
+    backend.clear();
+    record_frame( renderer, 11.f );
+
+    DX_CHECK( renderer.changed() );
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.maps().empty() && backend.draws().size() == 2 );
+
+    // a primitive more changes it as well, and the frame after it is compared with it
+    backend.clear();
+    record_frame( renderer, 11.f );
+    renderer.draw_filled_rect( { 300.f, 300.f }, { 10.f, 10.f }, Color::blue() );
+
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.draws().empty() );
+
+    backend.clear();
+    record_frame( renderer, 11.f );
+    renderer.draw_filled_rect( { 300.f, 300.f }, { 10.f, 10.f }, Color::blue() );
+
+    DX_CHECK( !renderer.perform() );
+    DX_CHECK( backend.draws().empty() );
+
+    renderer.destroy();
+}
+
+DX_TEST( skip_unchanged, draws_after_texels_were_written ) {
+    RecordingBackend  backend;
+    UploadingRenderer renderer;
+
+    renderer.create( &backend );
+    renderer.set_skip_unchanged( true );
+    renderer.perform();
+
+    record_frame( renderer );
+    renderer.perform();
+
+    // the vertices are the same, but the texels they sample may not be
+    backend.clear();
+    record_frame( renderer );
+    renderer.write_texels( 64 );
+
+    DX_CHECK( renderer.changed() );
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.draws().empty() );
+
+    // a frame that writes texels is not compared with, so the next one is drawn as well, and the one after it skipped
+    backend.clear();
+    record_frame( renderer );
+
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.draws().empty() );
+
+    backend.clear();
+    record_frame( renderer );
+
+    DX_CHECK( !renderer.perform() );
+    DX_CHECK( backend.draws().empty() );
+
+    renderer.destroy();
+}
+
+DX_TEST( skip_unchanged, draws_after_the_screen_was_resized ) {
+    ResizableBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+    renderer.set_skip_unchanged( true );
+    renderer.perform();
+
+    record_frame( renderer );
+    renderer.perform();
+
+    // the same vertices are drawn again into the resized target
+    backend.clear();
+    backend.m_size = { 800.f, 600.f };
+    record_frame( renderer );
+
+    DX_CHECK( renderer.perform() );
+    DX_CHECK( !backend.draws().empty() );
+
+    backend.clear();
+    record_frame( renderer );
+
+    DX_CHECK( !renderer.perform() );
+    DX_CHECK( backend.draws().empty() );
+
+    renderer.destroy();
+}
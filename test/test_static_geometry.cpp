@@ -0,0 +1,158 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+
+#include <algorithm>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This function checks a scissor rect of a draw
+     * @param draw recorded draw
+     * @param min expected top-left
+     * @param max expected bottom-right
+     * @return true, if scissored to the rect. false, otherwise
+    */
+    bool scissored_to( const RecordedDraw_t &draw, const Vector2 &min, const Vector2 &max ) {
+        return draw.m_scissored && draw.m_scissor.m_min == min && draw.m_scissor.m_max == max;
+    }
+
+    /**
+     * @brief This function counts the draws read from static geometry
+     * @param backend recording backend
+     * @return static draws
+    */
+    size_t static_draws( const RecordingBackend &backend ) {
+        return ( size_t ) std::count_if( backend.draws().begin(), backend.draws().end(), []( const RecordedDraw_t &draw ) { return draw.m_static != Batch_t::NO_STATIC; } );
+    }
+}
+
+DX_TEST( static_geometry, draws_a_capture_from_its_own_buffers ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // a clipped line and an unclipped one, each a batch of its own
+    renderer.begin_static();
+    renderer.push_clip_rect( { 10.f, 10.f }, { 50.f, 50.f } );
+    renderer.draw_line( { 0.f, 0.f }, { 100.f, 100.f }, Color::red() );
+    renderer.pop_clip_rect();
+    renderer.draw_line( { 0.f, 50.f }, { 100.f, 50.f }, Color::green() );
+
+    const uint32_t geometry = renderer.end_static();
+
+    if ( !DX_CHECK( geometry != Batch_t::NO_STATIC && renderer.static_valid( geometry ) ) )
+        return;
+
+    // the capture is uploaded once, none of it goes into the frame
+    if ( DX_CHECK( backend.statics().count( geometry ) == 1 ) )
+        DX_CHECK( backend.statics().at( geometry ).m_vertices.size() == 4 );
+
+    renderer.perform();
+    DX_CHECK( backend.draws().empty() );
+
+    // drawn translated, inside a clip rect of the frame
+    backend.clear();
+    renderer.push_clip_rect( { 30.f, 30.f }, { 100.f, 100.f } );
+    renderer.draw_static( geometry, { 20.f, 5.f } );
+    renderer.pop_clip_rect();
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_vertices == 0 && renderer.stats().m_static_draws == 1 );
+
+    // the geometry is bound with its translation for its draws and unbound after them
+    if ( DX_CHECK( backend.binds().size() == 2 ) ) {
+        DX_CHECK( backend.binds()[ 0 ].first == geometry && backend.binds()[ 0 ].second == Vector2( 20.f, 5.f ) );
+        DX_CHECK( backend.binds()[ 1 ].first == Batch_t::NO_STATIC );
+    }
+
+    if ( !DX_CHECK( backend.draws().size() == 2 && static_draws( backend ) == 2 ) )
+        return;
+
+    const auto &clipped   = backend.draws()[ 0 ];
+    const auto &unclipped = backend.draws()[ 1 ];
+
+    DX_CHECK( clipped.m_positions == std::vector< Vector2 >( { { 20.f, 5.f }, { 120.f, 105.f } } ) );
+    DX_CHECK( unclipped.m_positions == std::vector< Vector2 >( { { 20.f, 55.f }, { 120.f, 55.f } } ) );
+
+    // the clip rect of the capture moves with it and is nested in the one of the frame, the other batch gets the frame's alone
+    DX_CHECK( scissored_to( clipped, { 30.f, 30.f }, { 80.f, 65.f } ) );
+    DX_CHECK( scissored_to( unclipped, { 30.f, 30.f }, { 130.f, 130.f } ) );
+
+    renderer.destroy();
+}
+
+DX_TEST( static_geometry, skips_invalidated_geometry ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    renderer.begin_static();
+    renderer.draw_filled_rect( { 10.f, 10.f }, { 20.f, 20.f }, Color::red() );
+
+    const uint32_t geometry = renderer.end_static();
+
+    if ( !DX_CHECK( geometry != Batch_t::NO_STATIC ) )
+        return;
+
+    // invalidated after it was drawn this frame, the draw is skipped and the buffers are released
+    renderer.draw_static( geometry );
+    renderer.invalidate_static( geometry );
+    renderer.perform();
+
+    DX_CHECK( !renderer.static_valid( geometry ) && backend.statics().empty() );
+    DX_CHECK( backend.binds().empty() && static_draws( backend ) == 0 );
+
+    // later draws of it are dropped, and its handle is not handed out again
+    backend.clear();
+    renderer.draw_static( geometry );
+    renderer.perform();
+
+    DX_CHECK( backend.binds().empty() && backend.draws().empty() );
+
+    renderer.begin_static();
+    renderer.draw_filled_rect( { 10.f, 10.f }, { 20.f, 20.f }, Color::red() );
+
+    DX_CHECK( renderer.end_static() != geometry );
+
+    renderer.destroy();
+}
+
+DX_TEST( static_geometry, refuses_atlas_draws_while_capturing ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    std::vector< uint32_t > pixels( 8 * 8, 0xffffffff );
+    const uint32_t          image = renderer.add_image( 8, 8, pixels );
+
+    // sprites and rasterized text sample the atlas, which can evict them, only the rect is captured
+    renderer.begin_static();
+    renderer.draw_image( image, { 0.f, 0.f }, { 8.f, 8.f } );
+    renderer.draw_text( { 0.f, 20.f }, "text", Color::white() );
+    renderer.draw_filled_rect( { 10.f, 10.f }, { 20.f, 20.f }, Color::red() );
+
+    const uint32_t geometry = renderer.end_static();
+
+    if ( DX_CHECK( geometry != Batch_t::NO_STATIC && backend.statics().count( geometry ) == 1 ) )
+        DX_CHECK( backend.statics().at( geometry ).m_vertices.size() == 4 );
+
+    // nothing was placed into the atlas
+    DX_CHECK( backend.updates().empty() );
+    DX_CHECK( renderer.atlas().pages().empty() || renderer.atlas().pages()[ 0 ].m_shelves.empty() );
+
+    // the same calls draw once the capture ended, the sprite and the glyphs share the atlas page
+    renderer.draw_image( image, { 0.f, 0.f }, { 8.f, 8.f } );
+    renderer.draw_text( { 0.f, 20.f }, "text", Color::white() );
+    renderer.perform();
+
+    DX_CHECK( !backend.updates().empty() );
+    DX_CHECK( backend.draws().size() == 1 && backend.draws()[ 0 ].m_positions.size() == 6 + 4 * 6 );
+
+    renderer.destroy();
+}
@@ -0,0 +1,73 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+#include "text.h"
+
+using namespace dx;
+using namespace dx::test;
+
+DX_TEST( text, drops_glyphs_not_used_last_frame ) {
+    TextCache cache;
+    uint64_t  key;
+
+    cache.add_font( std::make_unique< BitmapFont >() );
+
+    // codepoints the font does not have are replaced, but cached under keys of their own
+    for ( uint32_t codepoint{ 0x10000 }; codepoint <= 0x10000 + TextCache::MAX_GLYPHS; ++codepoint )
+        cache.glyph( TextCache::DEFAULT_FONT, codepoint, 8.f, key );
+
+    // glyphs used this frame are kept even past the limit
+    cache.end_frame();
+
+    DX_CHECK( cache.glyphs() == TextCache::MAX_GLYPHS + 1 );
+
+    cache.glyph( TextCache::DEFAULT_FONT, 'A', 8.f, key );
+    cache.end_frame();
+
+    DX_CHECK( cache.glyphs() == 1 );
+
+    // under the limit nothing is dropped
+    cache.glyph( TextCache::DEFAULT_FONT, 'B', 8.f, key );
+    cache.end_frame();
+    cache.end_frame();
+
+    DX_CHECK( cache.glyphs() == 2 );
+}
+
+DX_TEST( text, places_glyphs_only_inside_the_clip_rect ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // a new string outside of the clip rect is measured, but neither uploaded nor placed into the atlas
+    renderer.push_clip_rect( { 0.f, 0.f }, { 100.f, 100.f } );
+    renderer.draw_text( { 200.f, 200.f }, "hidden", Color::white(), 16.f );
+    renderer.pop_clip_rect();
+    renderer.perform();
+
+    DX_CHECK( backend.updates().empty() && backend.draws().empty() );
+    DX_CHECK( renderer.atlas().pages().empty() || renderer.atlas().pages()[ 0 ].m_shelves.empty() );
+    DX_CHECK( renderer.stats().m_rejected == 1 );
+
+    // once it is drawn inside the clip rect its glyphs are placed and drawn
+    backend.clear();
+    renderer.draw_text( { 10.f, 10.f }, "hidden", Color::white(), 16.f );
+    renderer.perform();
+
+    DX_CHECK( !backend.updates().empty() );
+    DX_CHECK( backend.draws().size() == 1 && backend.draws()[ 0 ].m_positions.size() == 6 * 6 );
+
+    // a string crossing the clip rect keeps the glyphs inside of it, measured from the same bounds
+    backend.clear();
+    renderer.push_clip_rect( { 0.f, 0.f }, { 10.f + 16.f * 2.f, 100.f } );
+    renderer.draw_text( { 10.f, 10.f }, "hidden", Color::white(), 16.f );
+    renderer.pop_clip_rect();
+    renderer.perform();
+
+    DX_CHECK( backend.updates().empty() );
+    DX_CHECK( renderer.stats().m_clipped == 1 );
+    DX_CHECK( backend.draws().size() == 1 && backend.draws()[ 0 ].m_positions.size() < 6 * 6 );
+
+    renderer.destroy();
+}
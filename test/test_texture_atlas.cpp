@@ -0,0 +1,226 @@
+#include "test.h"
+#include "test_backend.h"
+#include "renderer.h"
+#include "texture_atlas.h"
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    /**
+     * @brief This function sums the bytes of the images uploaded since the last clear, leaving out cleared shelves
+     * @param backend recording backend
+     * @return uploaded image bytes
+    */
+    size_t image_bytes( const RecordingBackend &backend ) {
+        size_t bytes{};
+
+        for ( const auto &update : backend.updates() )
+            bytes += update.m_transparent ? 0 : ( size_t ) update.m_width * update.m_height * sizeof( uint32_t );
+
+        return bytes;
+    }
+}
+
+DX_TEST( texture_atlas, reuses_shelves_of_similar_height ) {
+    TextureAtlas  atlas{ 256, 1 };
+    AtlasRegion_t a, b, c, d, again;
+
+    // images of about the same height share a shelf, side by side with padding between them
+    DX_CHECK( atlas.acquire( 1, 10, 10, a ) == AtlasResult::ALLOCATED );
+    DX_CHECK( atlas.acquire( 2, 10, 10, b ) == AtlasResult::ALLOCATED );
+    DX_CHECK( a.m_shelf == b.m_shelf && a.m_y == b.m_y );
+    DX_CHECK( a.m_x == 0 && b.m_x == 10 + TextureAtlas::PADDING );
+
+    // a taller image opens a shelf below, a shorter one goes into the lowest shelf it fits
+    DX_CHECK( atlas.acquire( 3, 10, 12, c ) == AtlasResult::ALLOCATED );
+    DX_CHECK( c.m_shelf != a.m_shelf && c.m_y == 10 + TextureAtlas::PADDING );
+    DX_CHECK( atlas.acquire( 4, 10, 8, d ) == AtlasResult::ALLOCATED );
+    DX_CHECK( d.m_shelf == a.m_shelf && d.m_x == 2 * ( 10 + TextureAtlas::PADDING ) );
+
+    // an image already in the atlas keeps its region
+    DX_CHECK( atlas.acquire( 1, 10, 10, again ) == AtlasResult::RESIDENT );
+    DX_CHECK( again.m_page == a.m_page && again.m_shelf == a.m_shelf && again.m_x == a.m_x && again.m_y == a.m_y );
+
+    DX_CHECK( atlas.pages().size() == 1 && atlas.pages()[ 0 ].m_shelves.size() == 2 );
+    DX_CHECK( atlas.evictions() == 0 );
+}
+
+DX_TEST( texture_atlas, gives_oversize_images_their_own_page ) {
+    TextureAtlas  atlas{ 256, 2 };
+    AtlasRegion_t small, wide, next, huge;
+
+    DX_CHECK( atlas.acquire( 1, 10, 10, small ) == AtlasResult::ALLOCATED );
+
+    // an image wider than a page gets a page sized to hold it
+    DX_CHECK( atlas.acquire( 2, 300, 100, wide ) == AtlasResult::ALLOCATED );
+    DX_CHECK( wide.m_page == 1 && wide.m_x == 0 && wide.m_y == 0 );
+    DX_CHECK( atlas.pages()[ 1 ].m_width == 300 + TextureAtlas::PADDING && atlas.pages()[ 1 ].m_height == 256 );
+
+    // later images fill the first page again
+    DX_CHECK( atlas.acquire( 3, 10, 10, next ) == AtlasResult::ALLOCATED );
+    DX_CHECK( next.m_page == small.m_page );
+
+    // without a page left and no shelf large enough, the image does not fit
+    DX_CHECK( atlas.acquire( 4, 400, 400, huge ) == AtlasResult::FAILED );
+    DX_CHECK( atlas.pages().size() == 2 );
+}
+
+DX_TEST( texture_atlas, never_evicts_shelves_used_this_frame ) {
+    TextureAtlas  atlas{ 64, 1 };
+    AtlasRegion_t regions[ 5 ];
+
+    // four images of a full row each fill the page
+    for ( uint64_t key{}; key < 4; ++key )
+        DX_CHECK( atlas.acquire( key, 63, 15, regions[ key ] ) == AtlasResult::ALLOCATED );
+
+    // every shelf holds an image of this frame, so there is nothing to make room with
+    DX_CHECK( atlas.acquire( 4, 63, 15, regions[ 4 ] ) == AtlasResult::FAILED );
+    DX_CHECK( atlas.evictions() == 0 );
+
+    for ( uint64_t key{}; key < 4; ++key )
+        DX_CHECK( atlas.acquire( key, 63, 15, regions[ key ] ) == AtlasResult::RESIDENT );
+
+    atlas.end_frame();
+
+    // next frame only the shelf nothing was acquired from is given up, touching a shelf keeps it like acquiring
+    DX_CHECK( atlas.touch( regions[ 0 ].m_page, regions[ 0 ].m_shelf, 0 ) );
+    DX_CHECK( atlas.acquire( 1, 63, 15, regions[ 1 ] ) == AtlasResult::RESIDENT );
+    DX_CHECK( atlas.acquire( 3, 63, 15, regions[ 3 ] ) == AtlasResult::RESIDENT );
+    DX_CHECK( atlas.acquire( 4, 63, 15, regions[ 4 ] ) == AtlasResult::ALLOCATED );
+    DX_CHECK( regions[ 4 ].m_shelf == regions[ 2 ].m_shelf && regions[ 4 ].m_y == regions[ 2 ].m_y );
+    DX_CHECK( atlas.evictions() == 1 );
+
+    // the evicted image is gone, and with every shelf in use it cannot come back this frame
+    DX_CHECK( atlas.acquire( 2, 63, 15, regions[ 2 ] ) == AtlasResult::FAILED );
+
+    for ( const uint64_t key : { 0, 1, 3, 4 } )
+        DX_CHECK( atlas.acquire( key, 63, 15, regions[ key ] ) == AtlasResult::RESIDENT );
+}
+
+DX_TEST( texture_atlas, bumps_the_generation_of_evicted_shelves ) {
+    TextureAtlas  atlas{ 64, 1 };
+    AtlasRegion_t first, second;
+
+    DX_CHECK( atlas.acquire( 1, 63, 63, first ) == AtlasResult::ALLOCATED );
+    DX_CHECK( atlas.generation( first.m_page, first.m_shelf ) == 0 );
+
+    atlas.end_frame();
+
+    // a region cached before the eviction no longer touches the shelf, one cached after it does
+    DX_CHECK( atlas.acquire( 2, 63, 63, second ) == AtlasResult::ALLOCATED );
+    DX_CHECK( second.m_page == first.m_page && second.m_shelf == first.m_shelf );
+    DX_CHECK( atlas.generation( first.m_page, first.m_shelf ) == 1 );
+    DX_CHECK( !atlas.touch( first.m_page, first.m_shelf, 0 ) );
+    DX_CHECK( atlas.touch( second.m_page, second.m_shelf, 1 ) );
+}
+
+DX_TEST( texture_atlas, reports_evicted_shelves_to_clear ) {
+    TextureAtlas  atlas{ 64, 1 };
+    AtlasRegion_t a, b, c;
+
+    // two images side by side in a shelf as tall as the page
+    DX_CHECK( atlas.acquire( 1, 20, 62, a ) == AtlasResult::ALLOCATED );
+    DX_CHECK( atlas.acquire( 2, 20, 62, b ) == AtlasResult::ALLOCATED );
+    DX_CHECK( atlas.evicted().empty() );
+
+    atlas.end_frame();
+
+    // the shelf is evicted whole, its rect spans the images and their padding
+    DX_CHECK( atlas.acquire( 3, 40, 50, c ) == AtlasResult::ALLOCATED );
+
+    if ( DX_CHECK( atlas.evicted().size() == 1 ) ) {
+        const auto &shelf = atlas.evicted().front();
+
+        DX_CHECK( shelf.m_page == a.m_page && shelf.m_shelf == a.m_shelf );
+        DX_CHECK( shelf.m_x == 0 && shelf.m_y == a.m_y );
+        DX_CHECK( shelf.m_width == 2 * ( 20 + TextureAtlas::PADDING ) && shelf.m_height == 62 + TextureAtlas::PADDING );
+    }
+
+    atlas.clear_evicted();
+
+    DX_CHECK( atlas.evicted().empty() );
+}
+
+DX_TEST( texture_atlas, clears_evicted_shelves_before_reusing_them ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // a tall sprite opens the first shelf
+    std::vector< uint32_t > tall( 500 * 200, 0xff0000ff );
+
+    renderer.draw_image( renderer.add_image( 500, 200, tall ), { 0.f, 0.f }, { 500.f, 200.f } );
+    renderer.perform();
+
+    // the next frame fills the atlas with flat sprites until the tall sprite's shelf is taken over
+    std::vector< uint32_t > flat( 1023 * 8, 0xffffffff );
+
+    for ( size_t i{}; i < 1024 && renderer.atlas().evictions() == 0; ++i ) {
+        backend.clear();
+        renderer.draw_image( renderer.add_image( 1023, 8, flat ), { 0.f, 0.f }, { 100.f, 8.f } );
+    }
+
+    renderer.perform();
+
+    DX_CHECK( renderer.atlas().evictions() == 1 );
+
+    // the whole rect the tall sprite and its padding held is cleared, then the sprite taking its place is uploaded into it
+    if ( DX_CHECK( backend.updates().size() == 2 ) ) {
+        const auto &clear  = backend.updates()[ 0 ];
+        const auto &sprite = backend.updates()[ 1 ];
+
+        DX_CHECK( clear.m_transparent && !sprite.m_transparent && clear.m_texture == sprite.m_texture );
+        DX_CHECK( clear.m_x == 0 && clear.m_y == 0 && clear.m_width == 500 + TextureAtlas::PADDING && clear.m_height == 200 + TextureAtlas::PADDING );
+        DX_CHECK( sprite.m_x == 0 && sprite.m_y == 0 && sprite.m_height < clear.m_height );
+    }
+
+    // the frame counts the cleared texels along with the uploaded images
+    DX_CHECK( renderer.stats().m_texture_bytes == backend.stats().m_texture_bytes - tall.size() * sizeof( uint32_t ) );
+
+    renderer.destroy();
+}
+
+DX_TEST( texture_atlas, rebuilds_layouts_of_evicted_glyphs ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // the glyphs of the string are packed into a shelf of their own height
+    renderer.draw_text( { 10.f, 10.f }, "A", Color::white(), 16.f );
+    renderer.perform();
+
+    const size_t glyph_bytes = backend.stats().m_texture_bytes;
+
+    DX_CHECK( glyph_bytes > 0 );
+
+    // fill the atlas with flat sprites, the glyph shelf is the only one not used by this frame and gets evicted
+    std::vector< uint32_t > pixels( 1023 * 8, 0xffffffff );
+
+    for ( size_t i{}; i < 1024 && renderer.atlas().evictions() == 0; ++i )
+        renderer.draw_image( renderer.add_image( 1023, 8, pixels ), { 0.f, 0.f }, { 100.f, 8.f } );
+
+    renderer.perform();
+
+    DX_CHECK( renderer.atlas().evictions() > 0 );
+
+    // the cached layout samples a shelf that now holds a sprite, drawing it again uploads the glyph again
+    backend.clear();
+    renderer.draw_text( { 10.f, 10.f }, "A", Color::white(), 16.f );
+    renderer.perform();
+
+    DX_CHECK( image_bytes( backend ) == glyph_bytes );
+    DX_CHECK( backend.draws().size() == 1 && backend.draws()[ 0 ].m_positions.size() == 6 );
+
+    // once rebuilt the layout is resident again
+    const size_t uploaded = backend.stats().m_texture_bytes;
+
+    renderer.draw_text( { 10.f, 10.f }, "A", Color::white(), 16.f );
+    renderer.perform();
+
+    DX_CHECK( backend.stats().m_texture_bytes == uploaded );
+
+    renderer.destroy();
+}
@@ -0,0 +1,283 @@
+#include "test.h"
+#include "test_backend.h"
+#include "upload_ring.h"
+#include "renderer.h"
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    constexpr size_t RING_VERTICES = 1024; // vertices the vertex ring is created with
+
+    /**
+     * @brief This function records rects and thin lines in turn, every primitive breaks the batch of the one before it
+     * @param renderer renderer to record to
+     * @param pairs rect and line pairs
+     * @param expected output positions the draws should read, in index order
+    */
+    void record_alternating( Renderer &renderer, const size_t pairs, std::vector< Vector2 > &expected ) {
+        for ( size_t i{}; i < pairs; ++i ) {
+            const Vector2 pos{ ( float ) ( i % 60 ) * 10.f, ( float ) ( i / 60 ) * 10.f };
+            const Vector2 max{ pos + Vector2( 8.f, 8.f ) };
+
+            renderer.draw_filled_rect( pos, { 8.f, 8.f }, Color::red() );
+            renderer.draw_line( pos, max, Color::blue() );
+
+            for ( const Vector2 &v : { pos, Vector2( max.x, pos.y ), max, max, Vector2( pos.x, max.y ), pos } )
+                expected.push_back( v );
+
+            expected.push_back( pos );
+            expected.push_back( max );
+        }
+    }
+
+    /**
+     * @brief This function checks that the draws read the expected positions in order
+     * @param context test context
+     * @param backend backend the draws were submitted to
+     * @param expected positions in index order
+    */
+    void check_positions( Context &context, const RecordingBackend &backend, const std::vector< Vector2 > &expected ) {
+        std::vector< Vector2 > drawn;
+
+        for ( const auto &draw : backend.draws() )
+            drawn.insert( drawn.end(), draw.m_positions.begin(), draw.m_positions.end() );
+
+        if ( !DX_CHECK( drawn.size() == expected.size() ) )
+            return;
+
+        DX_CHECK( std::equal( drawn.begin(), drawn.end(), expected.begin(), []( const Vector2 &a, const Vector2 &b ) { return a.x == b.x && a.y == b.y; } ) );
+    }
+
+    /**
+     * @brief This function counts the maps of a buffer with a mode
+     * @param backend recording backend
+     * @param type buffer type
+     * @param mode map mode
+     * @return map count
+    */
+    size_t count_maps( const RecordingBackend &backend, const BufferType type, const MapMode mode ) {
+        return ( size_t ) std::count( backend.maps().begin(), backend.maps().end(), std::pair{ type, mode } );
+    }
+}
+
+DX_TEST( upload_ring, appends_until_it_wraps ) {
+    UploadRing       ring;
+    RingAllocation_t a{}, b{}, c{};
+
+    ring.reset( 1000 );
+
+    // the first range discards whatever the buffer held, the next ones append at the alignment
+    DX_CHECK( ring.allocate( 100, 36, a ) );
+    DX_CHECK( a.m_offset == 0 && a.m_mode == MapMode::DISCARD );
+
+    DX_CHECK( ring.allocate( 50, 36, b ) );
+    DX_CHECK( b.m_offset == 108 && b.m_mode == MapMode::NO_OVERWRITE );
+
+    // a range past the end wraps to the start and orphans the pending ones
+    DX_CHECK( ring.allocate( 900, 36, c ) );
+    DX_CHECK( c.m_offset == 0 && c.m_mode == MapMode::DISCARD );
+
+    DX_CHECK( ring.allocate( 100, 4, a ) );
+    DX_CHECK( a.m_offset == 900 && a.m_mode == MapMode::NO_OVERWRITE );
+}
+
+DX_TEST( upload_ring, rejects_ranges_larger_than_the_buffer ) {
+    UploadRing       ring;
+    RingAllocation_t a{};
+
+    ring.reset( 1000 );
+
+    DX_CHECK( !ring.allocate( 1001, 4, a ) );
+    DX_CHECK( ring.allocate( 1000, 4, a ) );
+    DX_CHECK( a.m_offset == 0 && a.m_mode == MapMode::DISCARD );
+
+    // a new buffer starts out discarded
+    ring.reset( 2000 );
+
+    DX_CHECK( ring.allocate( 4, 4, a ) );
+    DX_CHECK( a.m_offset == 0 && a.m_mode == MapMode::DISCARD );
+}
+
+DX_TEST( upload_ring, grows_to_the_high_water_mark ) {
+    UploadRing       ring;
+    RingAllocation_t a{};
+
+    ring.reset( 1000 );
+
+    ring.allocate( 300, 4, a );
+    ring.allocate( 400, 4, a );
+    ring.end_frame();
+
+    ring.allocate( 100, 4, a );
+    ring.end_frame();
+
+    DX_CHECK( ring.high_water() == 700 );
+
+    // the capacity doubles until the size fits, limited to the max capacity but never shrinking
+    DX_CHECK( ring.wanted_capacity( 700, SIZE_MAX ) == 1000 );
+    DX_CHECK( ring.wanted_capacity( 2500, SIZE_MAX ) == 4000 );
+    DX_CHECK( ring.wanted_capacity( 2500, 3000 ) == 3000 );
+    DX_CHECK( ring.wanted_capacity( 2500, 500 ) == 1000 );
+}
+
+DX_TEST( upload_ring, maps_without_overwrite_between_wraps ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+    const size_t     frames = RING_VERTICES / 4 + 8;
+    size_t           discarded{};
+
+    renderer.create( &backend );
+
+    // each frame appends one rect to the vertex ring, it is discarded on the first frame and again when it wraps
+    for ( size_t i{}; i < frames; ++i ) {
+        std::vector< Vector2 > expected;
+
+        backend.clear();
+
+        renderer.draw_filled_rect( { 10.f, 10.f }, { 8.f, 8.f }, Color::red() );
+        renderer.perform();
+
+        for ( const Vector2 &v : { Vector2( 10.f, 10.f ), Vector2( 18.f, 10.f ), Vector2( 18.f, 18.f ), Vector2( 18.f, 18.f ), Vector2( 10.f, 18.f ), Vector2( 10.f, 10.f ) } )
+            expected.push_back( v );
+
+        check_positions( context, backend, expected );
+
+        if ( count_maps( backend, BufferType::VERTEX, MapMode::DISCARD ) ) {
+            DX_CHECK( i == 0 || i == RING_VERTICES / 4 );
+
+            ++discarded;
+        }
+    }
+
+    DX_CHECK( discarded == 2 );
+    DX_CHECK( backend.stats().m_discard_maps + backend.stats().m_no_overwrite_maps == frames * 2 );
+
+    renderer.destroy();
+}
+
+DX_TEST( upload_ring, splits_a_frame_into_chunks ) {
+    RecordingBackend       backend;
+    Renderer               renderer;
+    std::vector< Vector2 > expected;
+
+    renderer.create( &backend );
+
+    // 1800 vertices do not fit the initial ring, the frame is drawn in chunks of whole batches
+    record_alternating( renderer, 300, expected );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_chunks > 1 );
+    DX_CHECK( renderer.stats().m_vertices == 300 * 6 );
+    DX_CHECK( backend.draws().size() == 600 );
+    DX_CHECK( count_maps( backend, BufferType::VERTEX, MapMode::DISCARD ) == renderer.stats().m_chunks );
+
+    check_positions( context, backend, expected );
+
+    // the ring grows to the high-water mark of the frame, the next one fits a single chunk
+    const size_t resizes = backend.stats().m_resizes;
+
+    backend.clear();
+    expected.clear();
+
+    record_alternating( renderer, 300, expected );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_chunks == 1 );
+    DX_CHECK( backend.stats().m_resizes > resizes );
+
+    check_positions( context, backend, expected );
+
+    renderer.destroy();
+}
+
+DX_TEST( upload_ring, grows_for_a_batch_larger_than_the_ring ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // a single fan of more vertices than the ring holds cannot be split, the ring grows past its limit to fit it
+    renderer.draw_filled_circle( { 320.f, 240.f }, 100.f, Color::red(), 2000 );
+    renderer.perform();
+
+    DX_CHECK( renderer.stats().m_chunks == 1 );
+    DX_CHECK( renderer.stats().m_vertices > RING_VERTICES );
+
+    if ( DX_CHECK( backend.draws().size() == 1 ) ) {
+        const auto &draw = backend.draws().front();
+
+        DX_CHECK( draw.m_positions.size() == renderer.stats().m_indices );
+
+        // every triangle of the fan has the center as a corner and its others on the circle
+        for ( size_t i{}; i + 2 < draw.m_positions.size(); i += 3 ) {
+            Vector2 center{ 320.f, 240.f };
+            size_t  on_circle{};
+
+            for ( size_t j{}; j < 3; ++j )
+                on_circle += std::fabs( center.dist( draw.m_positions[ i + j ] ) - 100.f ) < 0.01f;
+
+            if ( !DX_CHECK( on_circle == 2 ) )
+                break;
+        }
+    }
+
+    renderer.destroy();
+}
+
+DX_TEST( upload_ring, narrows_indices_up_to_max_narrow_vertices ) {
+    RecordingBackend backend;
+    Renderer         renderer;
+
+    renderer.create( &backend );
+
+    // thin polylines take a vertex per point, so each batch holds exactly as many vertices as its points
+    const auto polyline = [ & ]( const size_t count, std::vector< Vector2 > &expected ) {
+        std::vector< Vector2 > points( count );
+
+        for ( size_t i{}; i < count; ++i )
+            points[ i ] = { ( float ) ( i % 640 ), ( float ) ( i / 640 ) };
+
+        for ( size_t i{}; i + 1 < count; ++i ) {
+            expected.push_back( points[ i ] );
+            expected.push_back( points[ i + 1 ] );
+        }
+
+        renderer.draw_polyline( points, Color::white() );
+    };
+
+    const struct {
+        size_t      m_count;  // points of the polyline
+        IndexFormat m_format; // index format of its batch
+    } cases[] = { { Batch_t::MAX_NARROW_VERTICES, IndexFormat::U16 }, { Batch_t::MAX_NARROW_VERTICES + 1, IndexFormat::U32 } };
+
+    // the largest batch of 16-bit indices reaches index 0xfffe, one vertex more needs 32-bit indices
+    for ( const auto &c : cases ) {
+        std::vector< Vector2 > expected;
+
+        backend.clear();
+        polyline( c.m_count, expected );
+        renderer.perform();
+
+        if ( DX_CHECK( backend.draws().size() == 1 ) )
+            DX_CHECK( backend.draws()[ 0 ].m_format == c.m_format );
+
+        check_positions( context, backend, expected );
+    }
+
+    // a primitive that fills the batch up to the limit joins it, one past it starts a new batch
+    std::vector< Vector2 > expected;
+
+    backend.clear();
+    polyline( Batch_t::MAX_NARROW_VERTICES - 2, expected );
+    polyline( 2, expected );
+    polyline( 2, expected );
+    renderer.perform();
+
+    if ( DX_CHECK( backend.draws().size() == 2 ) )
+        DX_CHECK( backend.draws()[ 0 ].m_format == IndexFormat::U16 && backend.draws()[ 1 ].m_format == IndexFormat::U16 );
+
+    check_positions( context, backend, expected );
+
+    renderer.destroy();
+}
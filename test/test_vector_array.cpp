@@ -0,0 +1,158 @@
+#include "test.h"
+#include "vector_array.h"
+
+#include <cstring>
+
+using namespace dx;
+using namespace dx::test;
+
+namespace {
+    constexpr size_t LENGTHS[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1001 }; // array lengths covering every tail of the wide paths
+
+    /**
+     * @brief This function fills components with finite values of mixed sign and magnitude, including zeros, denormals,
+     * and values whose squares overflow
+     * @param components components
+     * @param seed generator seed
+    */
+    void fill( std::span< float > components, uint32_t seed ) {
+        constexpr float SPECIALS[] = { 0.f, -0.f, 1e-40f, -1e-40f, 1e30f, -1e30f, 1.f, -1.f };
+
+        for ( size_t i{}; i < components.size(); ++i ) {
+            seed = seed * 1664525u + 1013904223u;
+
+            // every seventh component is special, the rest spread over twelve orders of magnitude
+            if ( seed % 7 == 0 )
+                components[ i ] = SPECIALS[ ( seed >> 8 ) % std::size( SPECIALS ) ];
+            else
+                components[ i ] = ( ( float ) ( seed >> 8 ) / ( float ) ( 1u << 24 ) - 0.5f ) * std::pow( 10.f, ( float ) ( ( seed >> 3 ) % 12 ) - 6.f );
+        }
+    }
+
+    /**
+     * @brief This function runs a kernel over a whole array, and one element at a time so only the scalar path runs,
+     * and compares the results bit for bit
+     * @param context test context
+     * @param length element count
+     * @param kernel kernel changing a span in place
+    */
+    template < typename T, typename Fn >
+    void compare( Context &context, const size_t length, Fn &&kernel ) {
+        std::vector< T > wide( length ), scalar;
+
+        fill( { &wide[ 0 ].x, length * sizeof( T ) / sizeof( float ) }, ( uint32_t ) length );
+        scalar = wide;
+
+        kernel( std::span< T >{ wide } );
+
+        for ( auto &element : scalar )
+            kernel( std::span< T >{ &element, 1 } );
+
+        DX_CHECK( std::memcmp( wide.data(), scalar.data(), length * sizeof( T ) ) == 0 );
+    }
+
+    /**
+     * @brief This function computes the bounds of points one at a time, negative zero below positive zero
+     * @param points points
+     * @param min output smallest components
+     * @param max output largest components
+    */
+    template < typename T >
+    void fold_bounds( std::span< const T > points, T &min, T &max ) {
+        constexpr size_t COMPONENTS = sizeof( T ) / sizeof( float ); // components of a point
+
+        min = max = points[ 0 ];
+
+        for ( size_t i = 1; i < points.size(); ++i ) {
+            for ( size_t k{}; k < COMPONENTS; ++k ) {
+                const float c  = ( &points[ i ].x )[ k ];
+                float       &lo = ( &min.x )[ k ];
+                float       &hi = ( &max.x )[ k ];
+
+                if ( c < lo || ( c == lo && std::signbit( c ) ) )
+                    lo = c;
+
+                if ( c > hi || ( c == hi && !std::signbit( c ) ) )
+                    hi = c;
+            }
+        }
+    }
+
+    /**
+     * @brief This function computes the bounds of points and compares them with those folded one point at a time bit for bit
+     * @param context test context
+     * @param points points
+    */
+    template < typename T >
+    void compare_bounds( Context &context, std::span< const T > points ) {
+        T min, max, scalar_min, scalar_max;
+
+        VectorArray::bounds( points, min, max );
+        fold_bounds( points, scalar_min, scalar_max );
+
+        DX_CHECK( std::memcmp( &min, &scalar_min, sizeof( T ) ) == 0 );
+        DX_CHECK( std::memcmp( &max, &scalar_max, sizeof( T ) ) == 0 );
+    }
+}
+
+DX_TEST( vector_array, add_matches_scalar ) {
+    for ( const size_t length : LENGTHS ) {
+        compare< Vector2 >( context, length, []( std::span< Vector2 > v ) { VectorArray::add( v, { 3.25f, -1e-3f } ); } );
+        compare< Vector3 >( context, length, []( std::span< Vector3 > v ) { VectorArray::add( v, { 3.25f, -1e-3f, 7e5f } ); } );
+    }
+}
+
+DX_TEST( vector_array, scale_matches_scalar ) {
+    for ( const size_t length : LENGTHS ) {
+        compare< Vector2 >( context, length, []( std::span< Vector2 > v ) { VectorArray::scale( v, { 0.1f, -3.f } ); } );
+        compare< Vector3 >( context, length, []( std::span< Vector3 > v ) { VectorArray::scale( v, { 0.1f, -3.f, 1e-20f } ); } );
+    }
+}
+
+DX_TEST( vector_array, transform_matches_scalar ) {
+    const Affine2_t affine2{ { 0.8f, 0.6f }, { -0.6f, 0.8f }, { 12.5f, -3.f } };
+    const Affine3_t affine3{ { 0.5f, 0.1f, -0.3f }, { 0.2f, 0.9f, 0.4f }, { -0.7f, 0.3f, 1.1f }, { 1.f, 2.f, 3.f } };
+
+    for ( const size_t length : LENGTHS ) {
+        compare< Vector2 >( context, length, [ & ]( std::span< Vector2 > v ) { VectorArray::transform( v, affine2 ); } );
+        compare< Vector3 >( context, length, [ & ]( std::span< Vector3 > v ) { VectorArray::transform( v, affine3 ); } );
+    }
+}
+
+DX_TEST( vector_array, normalize_matches_scalar ) {
+    for ( const size_t length : LENGTHS ) {
+        compare< Vector2 >( context, length, []( std::span< Vector2 > v ) { VectorArray::normalize( v ); } );
+        compare< Vector3 >( context, length, []( std::span< Vector3 > v ) { VectorArray::normalize( v ); } );
+    }
+}
+
+DX_TEST( vector_array, bounds_match_scalar ) {
+    for ( const size_t length : LENGTHS ) {
+        std::vector< Vector2 > points2( length );
+        std::vector< Vector3 > points3( length );
+
+        fill( { &points2[ 0 ].x, length * 2 }, ( uint32_t ) length * 31 );
+        fill( { &points3[ 0 ].x, length * 3 }, ( uint32_t ) length * 37 );
+
+        compare_bounds< Vector2 >( context, points2 );
+        compare_bounds< Vector3 >( context, points3 );
+    }
+}
+
+DX_TEST( vector_array, bounds_order_signed_zeros ) {
+    // every mix of zero signs, the extremes tie and only the ordering of the signs decides which zero is kept
+    for ( const size_t length : { 1, 2, 3, 4, 5, 8, 9 } ) {
+        for ( uint32_t signs{}; signs < ( 1u << std::min< size_t >( length * 2, 12 ) ); ++signs ) {
+            std::vector< Vector2 > points2( length );
+            std::vector< Vector3 > points3( length );
+
+            for ( size_t i{}; i < length; ++i ) {
+                points2[ i ] = { signs >> i & 1 ? -0.f : 0.f, signs >> ( i + length ) & 1 ? -0.f : 0.f };
+                points3[ i ] = { points2[ i ].x, points2[ i ].y, signs >> ( ( i + 1 ) % length ) & 1 ? -0.f : 0.f };
+            }
+
+            compare_bounds< Vector2 >( context, points2 );
+            compare_bounds< Vector3 >( context, points3 );
+        }
+    }
+}